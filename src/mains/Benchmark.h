@@ -0,0 +1,613 @@
+/*
+ * (C) Crown copyright 2021, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef MAINS_BENCHMARK_H_
+#define MAINS_BENCHMARK_H_
+
+#include <sys/resource.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include <algorithm>
+#include <chrono>  // NOLINT(build/c++11)
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "eckit/config/LocalConfiguration.h"
+#include "eckit/config/YAMLConfiguration.h"
+#include "eckit/exception/Exceptions.h"
+#include "eckit/filesystem/PathName.h"
+#include "eckit/log/JSON.h"
+
+#include "oops/base/ObsFilters.h"
+#include "oops/base/ObsSpaces.h"
+#include "oops/interface/GeoVaLs.h"
+#include "oops/interface/LinearObsOperator.h"
+#include "oops/interface/Locations.h"
+#include "oops/interface/ObsAuxControl.h"
+#include "oops/interface/ObsAuxIncrement.h"
+#include "oops/interface/ObsDataVector.h"
+#include "oops/interface/ObsDiagnostics.h"
+#include "oops/interface/ObsOperator.h"
+#include "oops/interface/ObsVector.h"
+#include "oops/mpi/mpi.h"
+#include "oops/runs/Application.h"
+#include "oops/util/DateTime.h"
+#include "oops/util/Logger.h"
+#include "oops/util/parameters/OptionalParameter.h"
+#include "oops/util/parameters/Parameter.h"
+#include "oops/util/parameters/Parameters.h"
+#include "oops/util/parameters/RequiredParameter.h"
+
+#include "ufo/SyntheticObsGenerator.h"
+#include "ufo/utils/PerformanceMonitor.h"
+
+namespace ufo {
+
+// -----------------------------------------------------------------------------
+
+/// \brief Options controlling the benchmark of a single observation space.
+template <typename MODEL>
+class BenchmarkObsTypeParameters : public oops::Parameters {
+  OOPS_CONCRETE_PARAMETERS(BenchmarkObsTypeParameters, Parameters)
+
+ public:
+  /// Options used to configure the observation space.
+  oops::Parameter<eckit::LocalConfiguration> obsSpace{
+    "obs space", eckit::LocalConfiguration(), this};
+
+  /// Options used to configure the observation operator. Required by all phases except `filters`
+  /// when the `HofX` option is set.
+  oops::OptionalParameter<eckit::LocalConfiguration> obsOperator{"obs operator", this};
+
+  /// Options used to configure the linear observation operator. If not set, the options from
+  /// `obs operator` are used.
+  oops::OptionalParameter<eckit::LocalConfiguration> linearObsOperator{
+    "linear obs operator", this};
+
+  /// Options used to configure the filters run in the `filters` phase.
+  oops::Parameter<std::vector<oops::ObsFilterParametersWrapper<MODEL>>> obsFilters{
+    "obs filters", {}, this};
+
+  /// Group of variables storing precalculated model equivalents of observations. If set, the
+  /// `filters` phase uses these values instead of running the observation operator.
+  oops::OptionalParameter<std::string> hofx{"HofX", this};
+
+  /// Options used to load the observation diagnostics required by the filters from a file when
+  /// the `HofX` option is set. If not set, the diagnostics are computed by running the
+  /// observation operator once (outside the timed region).
+  oops::OptionalParameter<eckit::LocalConfiguration> obsDiagnostics{"obs diagnostics", this};
+
+  /// Options used to load the GeoVaLs. Either this option or `synthetic` must be set unless no
+  /// GeoVaLs are needed (only the `filters` phase is run, using the `HofX` option, and the
+  /// filters don't require any GeoVaLs).
+  oops::OptionalParameter<eckit::LocalConfiguration> geovals{"geovals", this};
+
+  /// If set, a file holding synthetic observations is written before the observation space is
+  /// created and the observation space reads it (the `obsfile` of its `obsdatain` section is set
+  /// to the `obs file` of this section). Matching GeoVaLs are generated instead of being loaded
+  /// from a file. This makes it possible to benchmark arbitrarily large observation spaces.
+  /// Requires the `obs operator` option.
+  oops::OptionalParameter<SyntheticObsGeneratorParameters> synthetic{"synthetic", this};
+
+  /// Options used to configure the observation bias.
+  oops::Parameter<typename MODEL::ObsAuxControl::Parameters_> obsBias{"obs bias", {}, this};
+
+  /// If set, the RMS of the model equivalents computed in the `simulateObs` phase is checked
+  /// against this value.
+  oops::OptionalParameter<double> rmsRef{"rms ref", this};
+
+  /// Relative tolerance used in the comparison against `rms ref`.
+  oops::Parameter<double> tolerance{"tolerance", 1.0e-6, this};
+};
+
+// -----------------------------------------------------------------------------
+
+/// \brief Top-level options taken by the Benchmark application.
+template <typename MODEL>
+class BenchmarkParameters : public oops::Parameters {
+  OOPS_CONCRETE_PARAMETERS(BenchmarkParameters, Parameters)
+
+ public:
+  /// Only observations taken at times lying in the (`window begin`, `window end`] interval
+  /// will be included in observation spaces.
+  oops::RequiredParameter<util::DateTime> windowBegin{"window begin", this};
+  oops::RequiredParameter<util::DateTime> windowEnd{"window end", this};
+
+  /// Number of times each phase is run.
+  oops::Parameter<int> iterations{"iterations", 1, this};
+
+  /// Numbers of OpenMP threads with which each phase is run, in turn. If not set, each phase is
+  /// run once with the number of threads set through the environment.
+  oops::Parameter<std::vector<int>> threads{"threads", {}, this};
+
+  /// Report written by an earlier run (typically on a single MPI rank). If set, the speedup and
+  /// parallel efficiency of each phase are computed relative to the timing of that phase in this
+  /// report rather than relative to the first entry of `threads`.
+  oops::OptionalParameter<std::string> scalingReference{"scaling reference", this};
+
+  /// Phases to benchmark: any of `simulateObs`, `setTrajectory`, `simulateObsTL`,
+  /// `simulateObsAD` and `filters`.
+  oops::Parameter<std::vector<std::string>> phases{"phases", {"simulateObs"}, this};
+
+  /// If set, a JSON report containing the timings of all phases and the breakdown collected by
+  /// the PerformanceMonitor is written to this file.
+  oops::OptionalParameter<std::string> report{"report", this};
+
+  /// Observation spaces to benchmark.
+  oops::RequiredParameter<std::vector<BenchmarkObsTypeParameters<MODEL>>> observations{
+    "observations", this};
+};
+
+// -----------------------------------------------------------------------------
+
+/// \brief Application measuring the cost of observation operators and filters.
+///
+/// For each observation space, each selected phase (`simulateObs`, `setTrajectory`,
+/// `simulateObsTL`, `simulateObsAD` or `filters`) is run `iterations` times with each number of
+/// OpenMP threads listed in `threads`. Only the phases themselves are timed: filters are
+/// constructed and destroyed outside the timed region. For each phase and number of threads, the
+/// wall-clock time (maximum over ranks), the throughput in locations per second, and the speedup
+/// and parallel efficiency are written to the info log together with the peak resident set size
+/// (maximum over ranks). The speedup is relative to the first number of threads or, if a
+/// `scaling reference` report is given, to the run that wrote it, so that runs on different
+/// numbers of MPI ranks can be compared. Optionally, a JSON report is written as well.
+template <typename MODEL> class Benchmark : public oops::Application {
+  typedef oops::GeoVaLs<MODEL>           GeoVaLs_;
+  typedef oops::LinearObsOperator<MODEL> LinearObsOperator_;
+  typedef oops::Locations<MODEL>         Locations_;
+  typedef oops::ObsAuxControl<MODEL>     ObsAuxCtrl_;
+  typedef oops::ObsAuxIncrement<MODEL>   ObsAuxIncr_;
+  typedef oops::ObsDataVector<MODEL, int> ObsDataInt_;
+  typedef oops::ObsDiagnostics<MODEL>    ObsDiags_;
+  typedef oops::ObsFilters<MODEL>        ObsFilters_;
+  typedef oops::ObsOperator<MODEL>       ObsOperator_;
+  typedef oops::ObsSpace<MODEL>          ObsSpace_;
+  typedef oops::ObsSpaces<MODEL>         ObsSpaces_;
+  typedef oops::ObsVector<MODEL>         ObsVector_;
+
+  /// Timing of one phase run on one observation space with a given number of threads.
+  struct PhaseTiming {
+    std::string obsSpace;
+    std::string phase;
+    size_t nlocs;
+    int threads;
+    double wallTime;
+    /// Ratio of the wall-clock time of the baseline run of this phase to wallTime (0 if there is
+    /// no baseline).
+    double speedup = 0.0;
+    /// Speedup divided by the ratio of the number of cores (ranks times threads) used by this run
+    /// to the number used by the baseline run.
+    double efficiency = 0.0;
+  };
+
+  /// Filters constructed before a timed run, with the arrays they update.
+  struct FilterChain {
+    std::unique_ptr<ObsVector_> obserr;
+    std::shared_ptr<ObsDataInt_> qcflags;
+    std::unique_ptr<ObsFilters_> filters;
+  };
+
+ public:
+// -----------------------------------------------------------------------------
+  explicit Benchmark(const eckit::mpi::Comm & comm = oops::mpi::world()) : Application(comm) {}
+// -----------------------------------------------------------------------------
+  virtual ~Benchmark() {}
+// -----------------------------------------------------------------------------
+  int execute(const eckit::Configuration & fullConfig) const {
+    BenchmarkParameters<MODEL> params;
+    params.validateAndDeserialize(fullConfig);
+
+    const std::vector<std::string> knownPhases{"simulateObs", "setTrajectory", "simulateObsTL",
+                                               "simulateObsAD", "filters"};
+    for (const std::string & phase : params.phases.value())
+      if (std::find(knownPhases.begin(), knownPhases.end(), phase) == knownPhases.end())
+        throw eckit::UserError("Unknown benchmark phase: " + phase, Here());
+    if (params.iterations.value() < 1)
+      throw eckit::UserError("'iterations' must be positive", Here());
+    for (int nthreads : params.threads.value())
+      if (nthreads < 1)
+        throw eckit::UserError("'threads' must be positive", Here());
+
+    if (params.report.value() != boost::none) {
+      // The records are collected in the report written at the end of the run, so they must not
+      // be reported and discarded when the filters and linear operators are destroyed.
+      PerformanceMonitor::instance().setEnabled(true);
+      PerformanceMonitor::instance().setAutomaticReports(false);
+    }
+
+//  Setup observations
+    const eckit::LocalConfiguration obsConfig = writeSyntheticObs(fullConfig, params);
+    ObsSpaces_ obsdb(obsConfig, this->getComm(), params.windowBegin.value(),
+                     params.windowEnd.value());
+
+    std::vector<PhaseTiming> timings;
+    for (std::size_t jj = 0; jj < obsdb.size(); ++jj)
+      benchmarkObsSpace(obsdb[jj], params.observations.value()[jj], params, timings);
+
+    computeSpeedups(timings, params.scalingReference.value());
+    const int64_t peakMemory = globalPeakMemory();
+    printTimings(timings, params.iterations.value(), peakMemory);
+    if (params.report.value() != boost::none)
+      writeReport(*params.report.value(), timings, params.iterations.value(), peakMemory);
+
+    return 0;
+  }
+// -----------------------------------------------------------------------------
+ private:
+  std::string appname() const {
+    return "ufo::Benchmark<" + MODEL::name() + ">";
+  }
+// -----------------------------------------------------------------------------
+  static bool selected(const BenchmarkParameters<MODEL> & params, const std::string & phase) {
+    const std::vector<std::string> & phases = params.phases.value();
+    return std::find(phases.begin(), phases.end(), phase) != phases.end();
+  }
+// -----------------------------------------------------------------------------
+  /// For each number of threads in \p threads, call \p setup (if set) and then time \p body
+  /// called \p iterations times with the iteration index. Append the wall-clock times (maximum
+  /// over ranks) to \p timings.
+  void timePhase(const std::string & obsSpace, const std::string & phase, size_t nlocs,
+                 const BenchmarkParameters<MODEL> & benchParams,
+                 const std::function<void(int)> & body, std::vector<PhaseTiming> & timings,
+                 const std::function<void()> & setup = std::function<void()>()) const {
+    const int iterations = benchParams.iterations.value();
+    const int defaultThreads = numThreads();
+    std::vector<int> threads = benchParams.threads.value();
+    if (threads.empty())
+      threads.push_back(defaultThreads);
+    for (int nthreads : threads) {
+      setThreads(nthreads);
+      if (setup)
+        setup();
+      this->getComm().barrier();
+      const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+      for (int iter = 0; iter < iterations; ++iter)
+        body(iter);
+      const std::chrono::duration<double> duration = std::chrono::steady_clock::now() - start;
+      double elapsed = duration.count();
+      this->getComm().allReduceInPlace(elapsed, eckit::mpi::max());
+      timings.push_back({obsSpace, phase, nlocs, numThreads(), elapsed});
+    }
+    setThreads(defaultThreads);
+  }
+// -----------------------------------------------------------------------------
+  void benchmarkObsSpace(ObsSpace_ & obspace, const BenchmarkObsTypeParameters<MODEL> & params,
+                         const BenchmarkParameters<MODEL> & benchParams,
+                         std::vector<PhaseTiming> & timings) const {
+    const int iterations = benchParams.iterations.value();
+    const bool runFilters = selected(benchParams, "filters");
+    const bool runLinear = selected(benchParams, "setTrajectory") ||
+                           selected(benchParams, "simulateObsTL") ||
+                           selected(benchParams, "simulateObsAD");
+    const bool needHofX = selected(benchParams, "simulateObs") ||
+                          (runFilters && params.hofx.value() == boost::none);
+    if ((needHofX || runLinear || params.synthetic.value() != boost::none) &&
+        params.obsOperator.value() == boost::none)
+      throw eckit::UserError("Observation space " + obspace.obsname() +
+                             " requires an 'obs operator' section", Here());
+    if (params.geovals.value() != boost::none && params.synthetic.value() != boost::none)
+      throw eckit::UserError("Observation space " + obspace.obsname() +
+                             " may have only one of the 'geovals' and 'synthetic' sections",
+                             Here());
+
+    std::unique_ptr<SyntheticObsGenerator> generator;
+    if (params.synthetic.value() != boost::none)
+      generator.reset(new SyntheticObsGenerator(*params.synthetic.value()));
+
+    const size_t nlocs = obspace.obsspace().globalNumLocs();
+    oops::Log::info() << "Benchmark: " << obspace.obsname() << " (" << nlocs << " locations)"
+                      << std::endl;
+
+//  Find out which GeoVaLs and diagnostics are needed
+    std::unique_ptr<ObsOperator_> hop;
+    if (params.obsOperator.value() != boost::none)
+      hop.reset(new ObsOperator_(obspace, *params.obsOperator.value()));
+    const ObsAuxCtrl_ ybias(obspace, params.obsBias.value());
+    oops::Variables geovars;
+    oops::Variables diagvars;
+    if (hop)
+      geovars += hop->requiredVars();
+    geovars += ybias.requiredVars();
+    diagvars += ybias.requiredHdiagnostics();
+    if (runFilters) {
+      const FilterChain chain = makeFilterChain(obspace, params);
+      geovars += chain.filters->requiredVars();
+      diagvars += chain.filters->requiredHdiagnostics();
+    }
+    std::unique_ptr<const GeoVaLs_> gval;
+    if (hop || geovars.size() > 0)
+      gval = makeGeoVaLs(params, obspace, hop.get(), generator.get(), geovars);
+
+//  Nonlinear operator
+    std::unique_ptr<ObsVector_> hofx;
+    std::unique_ptr<ObsDiags_> diags;
+    if (needHofX) {
+      hofx.reset(new ObsVector_(obspace));
+      diags.reset(new ObsDiags_(obspace, hop->locations(), diagvars));
+      if (selected(benchParams, "simulateObs")) {
+        timePhase(obspace.obsname(), "simulateObs", nlocs, benchParams,
+                  [&](int) { hop->simulateObs(*gval, *hofx, ybias, *diags); }, timings);
+      } else {
+        hop->simulateObs(*gval, *hofx, ybias, *diags);
+      }
+
+      if (params.rmsRef.value() != boost::none) {
+        const double rms = hofx->rms();
+        const double ref = *params.rmsRef.value();
+        oops::Log::info() << "Benchmark: " << obspace.obsname() << " H(x) rms = " << rms
+                          << ", reference = " << ref << std::endl;
+        if (std::abs(rms - ref) > params.tolerance.value() * std::abs(ref))
+          throw eckit::BadValue("RMS of H(x) for " + obspace.obsname() +
+                                " differs from the reference value", Here());
+      }
+    } else if (runFilters) {
+      hofx.reset(new ObsVector_(obspace, *params.hofx.value()));
+      if (diagvars.size() == 0 || params.obsDiagnostics.value() != boost::none) {
+        const eckit::LocalConfiguration diagconf = params.obsDiagnostics.value() != boost::none ?
+                                                   *params.obsDiagnostics.value() :
+                                                   eckit::LocalConfiguration();
+        diags.reset(new ObsDiags_(diagconf, obspace, diagvars));
+      } else if (hop) {
+        // The filters use the precalculated H(x), but the diagnostics they need are not stored
+        // in the ObsSpace, so they are produced by the observation operator.
+        diags.reset(new ObsDiags_(obspace, hop->locations(), diagvars));
+        ObsVector_ unused(obspace);
+        hop->simulateObs(*gval, unused, ybias, *diags);
+      } else {
+        throw eckit::UserError("The filters of observation space " + obspace.obsname() +
+                               " require observation diagnostics: set either 'obs diagnostics'"
+                               " or 'obs operator'", Here());
+      }
+    }
+
+//  Filters
+    if (runFilters) {
+      // Construct (and destroy) the filters outside the timed region. Each iteration needs its
+      // own filters, since these update the QC flags and observation errors they are given.
+      std::vector<FilterChain> chains;
+      timePhase(obspace.obsname(), "filters", nlocs, benchParams, [&](int iter) {
+          ObsFilters_ & filters = *chains[iter].filters;
+          filters.preProcess();
+          if (gval)
+            filters.priorFilter(*gval);
+          filters.postFilter(*hofx, *diags);
+        }, timings, [&] {
+          chains.clear();
+          for (int iter = 0; iter < iterations; ++iter)
+            chains.push_back(makeFilterChain(obspace, params));
+        });
+    }
+
+//  Linear operator
+    if (runLinear) {
+      const eckit::LocalConfiguration linConf = params.linearObsOperator.value() != boost::none ?
+                                                *params.linearObsOperator.value() :
+                                                *params.obsOperator.value();
+      LinearObsOperator_ hoptl(obspace, linConf);
+      if (selected(benchParams, "setTrajectory")) {
+        timePhase(obspace.obsname(), "setTrajectory", nlocs, benchParams,
+                  [&](int) { hoptl.setTrajectory(*gval, ybias); }, timings);
+      } else {
+        hoptl.setTrajectory(*gval, ybias);
+      }
+
+      const ObsAuxIncr_ ybiasinc(obspace, params.obsBias.value());
+      if (selected(benchParams, "simulateObsTL")) {
+        const std::unique_ptr<GeoVaLs_> dx = makeGeoVaLs(params, obspace, hop.get(),
+                                                         generator.get(), hoptl.requiredVars());
+        dx->random();
+        ObsVector_ dy(obspace);
+        timePhase(obspace.obsname(), "simulateObsTL", nlocs, benchParams,
+                  [&](int) { hoptl.simulateObsTL(*dx, dy, ybiasinc); }, timings);
+      }
+      if (selected(benchParams, "simulateObsAD")) {
+        const std::unique_ptr<GeoVaLs_> dx = makeGeoVaLs(params, obspace, hop.get(),
+                                                         generator.get(), hoptl.requiredVars());
+        dx->zero();
+        ObsVector_ dy(obspace);
+        dy.random();
+        ObsAuxIncr_ ybiasincad(obspace, params.obsBias.value());
+        timePhase(obspace.obsname(), "simulateObsAD", nlocs, benchParams,
+                  [&](int) { hoptl.simulateObsAD(*dx, dy, ybiasincad); }, timings);
+      }
+    }
+  }
+// -----------------------------------------------------------------------------
+  /// Write the files holding the synthetic observations requested in \p params and return a copy
+  /// of \p fullConfig in which the observation spaces read these files.
+  eckit::LocalConfiguration writeSyntheticObs(const eckit::Configuration & fullConfig,
+                                              const BenchmarkParameters<MODEL> & params) const {
+    eckit::LocalConfiguration config(fullConfig);
+    std::vector<eckit::LocalConfiguration> obsConfs = config.getSubConfigurations("observations");
+    for (size_t jj = 0; jj < obsConfs.size(); ++jj) {
+      const BenchmarkObsTypeParameters<MODEL> & obsParams = params.observations.value()[jj];
+      if (obsParams.synthetic.value() == boost::none)
+        continue;
+      const SyntheticObsGenerator generator(*obsParams.synthetic.value());
+      eckit::LocalConfiguration obsSpaceConf(obsConfs[jj], "obs space");
+      if (obsSpaceConf.has("generate"))
+        throw eckit::UserError("Observation space " + obsSpaceConf.getString("name") +
+                               " can't have both a 'generate' and a 'synthetic' section", Here());
+      const oops::Variables simulated(obsSpaceConf, "simulated variables");
+      generator.writeObsFile(simulated, params.windowBegin.value(), params.windowEnd.value(),
+                             this->getComm());
+
+      eckit::LocalConfiguration obsdatain;
+      if (obsSpaceConf.has("obsdatain"))
+        obsdatain = obsSpaceConf.getSubConfiguration("obsdatain");
+      obsdatain.set("obsfile", generator.obsFile());
+      obsSpaceConf.set("obsdatain", obsdatain);
+      obsConfs[jj].set("obs space", obsSpaceConf);
+    }
+    config.set("observations", obsConfs);
+    return config;
+  }
+// -----------------------------------------------------------------------------
+  static FilterChain makeFilterChain(const ObsSpace_ & obspace,
+                                     const BenchmarkObsTypeParameters<MODEL> & params) {
+    FilterChain chain;
+    chain.obserr.reset(new ObsVector_(obspace, "ObsError"));
+    chain.qcflags.reset(new ObsDataInt_(obspace, obspace.obsvariables()));
+    chain.filters.reset(new ObsFilters_(obspace, params.obsFilters, chain.qcflags, *chain.obserr));
+    return chain;
+  }
+// -----------------------------------------------------------------------------
+  /// Load GeoVaLs of variables \p vars from a file or, if \p generator is set, generate them at
+  /// the locations used by \p hop.
+  static std::unique_ptr<GeoVaLs_> makeGeoVaLs(const BenchmarkObsTypeParameters<MODEL> & params,
+                                               const ObsSpace_ & obspace,
+                                               const ObsOperator_ * hop,
+                                               const SyntheticObsGenerator * generator,
+                                               const oops::Variables & vars) {
+    if (generator == nullptr) {
+      if (params.geovals.value() == boost::none)
+        throw eckit::UserError("Observation space " + obspace.obsname() +
+                               " requires either a 'geovals' or a 'synthetic' section", Here());
+      return std::unique_ptr<GeoVaLs_>(new GeoVaLs_(*params.geovals.value(), obspace, vars));
+    }
+    const Locations_ locs(hop->locations());
+    std::unique_ptr<GeoVaLs_> gval(new GeoVaLs_(locs, vars));
+    generator->fillGeoVaLs(locs.locations(), gval->geovals());
+    return gval;
+  }
+// -----------------------------------------------------------------------------
+  /// Return the peak resident set size (maximum over ranks, in bytes).
+  int64_t globalPeakMemory() const {
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    // On Linux ru_maxrss is expressed in kilobytes.
+    int64_t peakMemory = static_cast<int64_t>(usage.ru_maxrss) * 1024;
+    this->getComm().allReduceInPlace(peakMemory, eckit::mpi::max());
+    return peakMemory;
+  }
+// -----------------------------------------------------------------------------
+  /// Return the number of OpenMP threads used by parallel regions (1 without OpenMP).
+  static int numThreads() {
+#ifdef _OPENMP
+    return omp_get_max_threads();
+#else
+    return 1;
+#endif
+  }
+// -----------------------------------------------------------------------------
+  static void setThreads(int nthreads) {
+#ifdef _OPENMP
+    omp_set_num_threads(nthreads);
+#endif
+  }
+// -----------------------------------------------------------------------------
+  /// Set the speedup and efficiency of each element of \p timings relative to the timing of the
+  /// same phase in the report \p referenceFile (preferably with the same number of threads,
+  /// otherwise with the fewest) or, if not set, relative to the first timing of that phase.
+  void computeSpeedups(std::vector<PhaseTiming> & timings,
+                       const boost::optional<std::string> & referenceFile) const {
+    std::vector<PhaseTiming> reference;
+    int referenceRanks = this->getComm().size();
+    if (referenceFile != boost::none) {
+      const eckit::YAMLConfiguration report{eckit::PathName(*referenceFile)};
+      const eckit::LocalConfiguration benchmark(report, "benchmark");
+      referenceRanks = benchmark.getInt("ranks");
+      for (const eckit::LocalConfiguration & phase : benchmark.getSubConfigurations("phases"))
+        reference.push_back({phase.getString("obs space"), phase.getString("phase"), 0,
+                             phase.getInt("threads"), phase.getDouble("wall time (s)")});
+    } else {
+      reference = timings;
+    }
+
+    const int ranks = this->getComm().size();
+    for (PhaseTiming & timing : timings) {
+      const PhaseTiming * baseline = nullptr;
+      for (const PhaseTiming & candidate : reference) {
+        if (candidate.obsSpace != timing.obsSpace || candidate.phase != timing.phase)
+          continue;
+        if (referenceFile == boost::none) {
+          baseline = &candidate;  // first timing of this phase
+          break;
+        }
+        if (baseline == nullptr || candidate.threads == timing.threads ||
+            (baseline->threads != timing.threads && candidate.threads < baseline->threads))
+          baseline = &candidate;
+      }
+      if (baseline == nullptr || timing.wallTime <= 0.0)
+        continue;
+      timing.speedup = baseline->wallTime / timing.wallTime;
+      timing.efficiency = timing.speedup * (referenceRanks * baseline->threads) /
+                          (ranks * timing.threads);
+    }
+  }
+// -----------------------------------------------------------------------------
+  void printTimings(const std::vector<PhaseTiming> & timings, int iterations,
+                    int64_t peakMemory) const {
+    oops::Log::info() << "Benchmark: " << this->getComm().size() << " MPI ranks, "
+                      << iterations << " iterations per phase" << std::endl;
+    for (const PhaseTiming & timing : timings) {
+      oops::Log::info() << "Benchmark: " << timing.obsSpace << " " << timing.phase
+                        << ", " << this->getComm().size() << " ranks x " << timing.threads
+                        << " threads: total " << timing.wallTime << " s, "
+                        << timing.wallTime / iterations << " s per iteration, "
+                        << timing.nlocs * iterations / timing.wallTime << " locations/s";
+      if (timing.speedup > 0.0)
+        oops::Log::info() << ", speedup " << timing.speedup << ", parallel efficiency "
+                          << timing.efficiency;
+      oops::Log::info() << std::endl;
+    }
+    oops::Log::info() << "Benchmark: peak resident set size " << peakMemory << " bytes"
+                      << std::endl;
+  }
+// -----------------------------------------------------------------------------
+  void writeReport(const std::string & filename, const std::vector<PhaseTiming> & timings,
+                   int iterations, int64_t peakMemory) const {
+    // The PerformanceMonitor report is a collective operation, so it is formed on all ranks.
+    std::stringstream scopes;
+    PerformanceMonitor::instance().report(this->getComm(), scopes);
+    if (this->getComm().rank() != 0)
+      return;
+
+    std::ofstream os(filename);
+    if (!os)
+      throw eckit::CantOpenFile(filename, Here());
+    os << "{\"benchmark\": ";
+    eckit::JSON json(os);
+    json.startObject();
+    json << "ranks" << this->getComm().size();
+    json << "iterations" << iterations;
+    json << "peak resident set size (bytes)" << peakMemory;
+    json << "phases";
+    json.startList();
+    for (const PhaseTiming & timing : timings) {
+      json.startObject();
+      json << "obs space" << timing.obsSpace;
+      json << "phase" << timing.phase;
+      json << "threads" << timing.threads;
+      json << "nlocs" << timing.nlocs;
+      json << "wall time (s)" << timing.wallTime;
+      json << "locations per second" << timing.nlocs * iterations / timing.wallTime;
+      if (timing.speedup > 0.0) {
+        json << "speedup" << timing.speedup;
+        json << "parallel efficiency" << timing.efficiency;
+      }
+      json.endObject();
+    }
+    json.endList();
+    json.endObject();
+    os << ",\n\"instrumentation\": " << scopes.str() << "}" << std::endl;
+  }
+// -----------------------------------------------------------------------------
+};
+
+}  // namespace ufo
+
+#endif  // MAINS_BENCHMARK_H_
@@ -8,10 +8,12 @@
 #ifndef MAINS_RUNCRTM_H_
 #define MAINS_RUNCRTM_H_
 
+#include <cmath>
 #include <string>
 #include <vector>
 
 #include "eckit/config/LocalConfiguration.h"
+#include "eckit/exception/Exceptions.h"
 
 #include "oops/base/Observations.h"
 #include "oops/base/ObsSpaces.h"
@@ -75,8 +77,11 @@ template <typename MODEL> class RunCRTM : public oops::Application {
 
       const double zz = hofx.rms();
       const double xx = conf[jj].getDouble("rms ref");
+      // Relative tolerance, as in the ObsOperator tests (a fraction, not a percentage).
       const double tol = conf[jj].getDouble("tolerance");
-//      BOOST_CHECK_CLOSE(xx, zz, tol);
+      oops::Log::info() << "RunCRTM: H(x) rms = " << zz << ", reference = " << xx << std::endl;
+      if (std::abs(zz - xx) > tol * std::abs(xx))
+        throw eckit::BadValue("RMS of H(x) differs from the reference value", Here());
     }
 
     return 0;
@@ -8,7 +8,9 @@
 #include "ufo/GeoVaLs.h"
 
 #include <cassert>
+#include <cstdlib>
 #include <iomanip>
+#include <string>
 #include <vector>
 
 #include "eckit/config/Configuration.h"
@@ -54,6 +56,7 @@ GeoVaLs::GeoVaLs(const Locations & locs, const oops::Variables & vars)
 {
   oops::Log::trace() << "GeoVaLs contructor starting" << std::endl;
   ufo_geovals_setup_f90(keyGVL_, locs.size(), vars_);
+  if (singlePrecisionMode()) setSinglePrecision(locs.singlePrecisionVars());
   oops::Log::trace() << "GeoVaLs contructor key = " << keyGVL_ << std::endl;
 }
 
@@ -117,6 +120,40 @@ void GeoVaLs::allocate(const int & nlevels, const oops::Variables & vars)
   oops::Log::trace() << "GeoVaLs::allocate done" << std::endl;
 }
 // -----------------------------------------------------------------------------
+/*! \brief Store GeoVaLs for \p vars variables in single precision */
+void GeoVaLs::setSinglePrecision(const oops::Variables & vars)
+{
+  oops::Log::trace() << "GeoVaLs::setSinglePrecision starting" << std::endl;
+  ufo_geovals_set_single_precision_f90(keyGVL_, vars);
+  oops::Log::trace() << "GeoVaLs::setSinglePrecision done" << std::endl;
+}
+// -----------------------------------------------------------------------------
+/*! \brief Store all GeoVaLs in double precision */
+void GeoVaLs::setDoublePrecision()
+{
+  oops::Log::trace() << "GeoVaLs::setDoublePrecision starting" << std::endl;
+  ufo_geovals_set_double_precision_f90(keyGVL_);
+  oops::Log::trace() << "GeoVaLs::setDoublePrecision done" << std::endl;
+}
+// -----------------------------------------------------------------------------
+/*! \brief Whether GeoVaLs for \p var variable are stored in single precision */
+bool GeoVaLs::isSinglePrecision(const std::string & var) const
+{
+  int single;
+  ufo_geovals_is_single_precision_f90(keyGVL_, var.size(), var.c_str(), single);
+  return single != 0;
+}
+// -----------------------------------------------------------------------------
+/*! \brief Whether the UFO_GEOVALS_SINGLE_PRECISION environment variable is set */
+bool GeoVaLs::singlePrecisionMode()
+{
+  static const bool enabled = [] {
+    const char * env = std::getenv("UFO_GEOVALS_SINGLE_PRECISION");
+    return env != nullptr && *env != '\0' && std::string(env) != "0";
+  }();
+  return enabled;
+}
+// -----------------------------------------------------------------------------
 /*! \brief Zero out the GeoVaLs */
 void GeoVaLs::zero() {
   oops::Log::trace() << "GeoVaLs::zero starting" << std::endl;
@@ -67,6 +67,25 @@ class GeoVaLs : public util::Printable,
   ///          allocated with \p nlev.
   void allocate(const int & nlev, const oops::Variables & vars);
 
+  /// \brief Store GeoVaLs for \p vars variables in single precision
+  /// \details Values already allocated are rounded to single precision; variables allocated
+  ///          later are allocated in single precision. Arithmetic modifying these GeoVaLs stores
+  ///          them in double precision again. Operations that only read them, as well as Fortran
+  ///          code reading them through ufo_geovals_get_var, work on temporary double-precision
+  ///          copies instead. Variables that don't exist in GeoVaLs are ignored.
+  void setSinglePrecision(const oops::Variables & vars);
+  /// \brief Store all GeoVaLs in double precision, converting values stored in single precision
+  void setDoublePrecision();
+
+  /// Whether GeoVaLs for \p var variable are stored in single precision
+  bool isSinglePrecision(const std::string & var) const;
+
+  /// \brief Whether the UFO_GEOVALS_SINGLE_PRECISION environment variable is set (to a value
+  ///        other than 0)
+  /// \details In this mode GeoVaLs constructed from Locations store the variables listed by
+  ///          Locations::singlePrecisionVars() in single precision.
+  static bool singlePrecisionMode();
+
   void zero();
   void reorderzdir(const std::string &, const std::string &);
   void random();
@@ -37,6 +37,8 @@ extern "C" {
   void ufo_geovals_default_constr_f90(F90goms &);
   void ufo_geovals_setup_f90(F90goms &, const size_t &, const oops::Variables &);
   void ufo_geovals_allocate_f90(F90goms &, const size_t &, const oops::Variables &);
+  void ufo_geovals_set_single_precision_f90(const F90goms &, const oops::Variables &);
+  void ufo_geovals_set_double_precision_f90(const F90goms &);
   void ufo_geovals_delete_f90(F90goms &);
   void ufo_geovals_copy_f90(const F90goms &, F90goms &);
   void ufo_geovals_copy_one_f90(F90goms &, const F90goms &, int &);
@@ -61,6 +63,7 @@ extern "C" {
   void ufo_geovals_maxloc_f90(const F90goms &, double &, int &, int &);
   void ufo_geovals_nlocs_f90(const F90goms &, size_t &);
   void ufo_geovals_nlevs_f90(const F90goms &, const int &, const char *, int &);
+  void ufo_geovals_is_single_precision_f90(const F90goms &, const int &, const char *, int &);
   void ufo_geovals_get2d_f90(const F90goms &, const int &, const char *, const int &,
                            double &);
   void ufo_geovals_get_f90(const F90goms &, const int &, const char *, const int &,
@@ -71,6 +74,8 @@ extern "C" {
                            const int &, double &);
   void ufo_geovals_putdouble_f90(const F90goms &, const int &, const char *, const int &,
                            const int &, const double &);
+  void ufo_geovals_get_data_f90(const F90goms &, const int &, const char *, int &, int &,
+                                void * &);
   void ufo_geovals_put_loc_f90(const F90goms &, const int &, const char *, const int &,
                                const int &, const double &);
   void ufo_geovals_read_file_f90(const F90goms &,
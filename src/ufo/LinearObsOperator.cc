@@ -7,21 +7,51 @@
 
 #include "ufo/LinearObsOperator.h"
 
+#include <memory>
+#include <string>
 #include <vector>
 
+#include "eckit/exception/Exceptions.h"
+#include "ioda/ObsDataVector.h"
 #include "ioda/ObsVector.h"
+#include "oops/util/assert.h"
+#include "oops/util/Logger.h"
+#include "ufo/filters/QCflags.h"
+#include "ufo/GeoVaLs.h"
 #include "ufo/LinearObsOperatorBase.h"
 #include "ufo/Locations.h"
 #include "ufo/ObsBias.h"
 #include "ufo/ObsBiasIncrement.h"
 #include "ufo/ObsDiagnostics.h"
+#include "ufo/utils/PerformanceMonitor.h"
 
 namespace ufo {
 
+namespace {
+
+/// Return a copy of \p gvals stored in double precision if some of its variables are stored in
+/// single precision (linear operators read their GeoVaLs in double precision), or null otherwise.
+std::unique_ptr<GeoVaLs> doublePrecisionCopy(const GeoVaLs & gvals) {
+  std::unique_ptr<GeoVaLs> copy;
+  const oops::Variables & vars = gvals.getVars();
+  for (size_t jv = 0; jv < vars.size(); ++jv) {
+    if (gvals.isSinglePrecision(vars[jv])) {
+      copy.reset(new GeoVaLs(gvals));
+      copy->setDoublePrecision();
+      break;
+    }
+  }
+  return copy;
+}
+
+}  // namespace
+
 // -----------------------------------------------------------------------------
 
 LinearObsOperator::LinearObsOperator(ioda::ObsSpace & os, const eckit::Configuration & conf)
-  : oper_(LinearObsOperatorFactory::create(os, conf)), odb_(os)
+  : oper_(LinearObsOperatorFactory::create(os, conf)), odb_(os),
+    skipRejected_(conf.getBool("skip rejected observations", false)),
+    monitorPrefix_(os.obsname() + "/" + conf.getString("name") + "/")
 {
   // We use += rather than = to make sure the Variables objects contain no duplicate entries
   // and the variables are sorted alphabetically.
@@ -37,7 +67,16 @@ LinearObsOperator::LinearObsOperator(ioda::ObsSpace & os, const eckit::Configura
 
 // -----------------------------------------------------------------------------
 
+LinearObsOperator::~LinearObsOperator() {
+  // The linear operator is typically used after the filters have been destroyed, so its costs
+  // are reported separately.
+  PerformanceMonitor::instance().reportAndReset(odb_.comm(), monitorPrefix_);
+}
+
+// -----------------------------------------------------------------------------
+
 void LinearObsOperator::setTrajectory(const GeoVaLs & gvals, const ObsBias & bias) {
+  ScopedPerformanceMonitor monitor(monitorPrefix_, "setTrajectory", odb_.nlocs());
   oops::Variables vars;
   vars += bias.requiredHdiagnostics();
   std::vector<float> lons(odb_.nlocs());
@@ -47,10 +86,17 @@ void LinearObsOperator::setTrajectory(const GeoVaLs & gvals, const ObsBias & bia
   odb_.get_db("MetaData", "longitude", lons);
   odb_.get_db("MetaData", "datetime", times);
   ObsDiagnostics ydiags(odb_, Locations(lons, lats, times, odb_.distribution()), vars);
-  oper_->setTrajectory(gvals, bias, ydiags);
+  if (skipRejected_) {
+    if (!qcFlagsSet_)
+      setActiveObservationsFromObsSpace();
+    oper_->setActiveObservations(active_);
+  }
+  const std::unique_ptr<GeoVaLs> gvalsDouble = doublePrecisionCopy(gvals);
+  const GeoVaLs & traj = gvalsDouble ? *gvalsDouble : gvals;
+  oper_->setTrajectory(traj, bias, ydiags);
   if (bias) {
     biasoper_.reset(new LinearObsBiasOperator(odb_));
-    biasoper_->setTrajectory(gvals, bias, ydiags);
+    biasoper_->setTrajectory(traj, bias, ydiags);
   }
 }
 
@@ -58,10 +104,15 @@ void LinearObsOperator::setTrajectory(const GeoVaLs & gvals, const ObsBias & bia
 
 void LinearObsOperator::simulateObsTL(const GeoVaLs & gvals, ioda::ObsVector & yy,
                                       const ObsBiasIncrement & bias) const {
-  oper_->simulateObsTL(gvals, yy);
+  ScopedPerformanceMonitor monitor(monitorPrefix_, "simulateObsTL", odb_.nlocs());
+  const std::unique_ptr<GeoVaLs> gvalsDouble = doublePrecisionCopy(gvals);
+  const GeoVaLs & dx = gvalsDouble ? *gvalsDouble : gvals;
+  oper_->simulateObsTL(dx, yy);
+  for (size_t jobs = 0; jobs < active_.size(); ++jobs)
+    if (!active_[jobs]) yy[jobs] = 0.0;
   if (bias) {
     ioda::ObsVector ybiasinc(odb_);
-    biasoper_->computeObsBiasTL(gvals, bias, ybiasinc);
+    biasoper_->computeObsBiasTL(dx, bias, ybiasinc);
     yy += ybiasinc;
   }
 }
@@ -70,7 +121,17 @@ void LinearObsOperator::simulateObsTL(const GeoVaLs & gvals, ioda::ObsVector & y
 
 void LinearObsOperator::simulateObsAD(GeoVaLs & gvals, const ioda::ObsVector & yy,
                                       ObsBiasIncrement & bias) const {
-  oper_->simulateObsAD(gvals, yy);
+  ScopedPerformanceMonitor monitor(monitorPrefix_, "simulateObsAD", odb_.nlocs());
+  // The adjoint accumulates into the GeoVaLs in double precision.
+  gvals.setDoublePrecision();
+  if (active_.empty()) {
+    oper_->simulateObsAD(gvals, yy);
+  } else {
+    ioda::ObsVector yactive(yy);
+    for (size_t jobs = 0; jobs < active_.size(); ++jobs)
+      if (!active_[jobs]) yactive[jobs] = 0.0;
+    oper_->simulateObsAD(gvals, yactive);
+  }
   if (bias) {
     ioda::ObsVector ybiasinc(yy);
     biasoper_->computeObsBiasAD(gvals, bias, ybiasinc);
@@ -79,6 +140,45 @@ void LinearObsOperator::simulateObsAD(GeoVaLs & gvals, const ioda::ObsVector & y
 
 // -----------------------------------------------------------------------------
 
+void LinearObsOperator::setQCFlags(const ioda::ObsDataVector<int> & flags) {
+  const oops::Variables & vars = odb_.obsvariables();
+  ASSERT(flags.nvars() == vars.size());
+  ASSERT(flags.nlocs() == odb_.nlocs());
+  active_.assign(vars.size() * odb_.nlocs(), 0);
+  size_t nactive = 0;
+  for (size_t jv = 0; jv < vars.size(); ++jv) {
+    for (size_t jloc = 0; jloc < odb_.nlocs(); ++jloc) {
+      // ObsVector elements are ordered by location, then variable.
+      const size_t jobs = jloc * vars.size() + jv;
+      active_[jobs] = flags[jv][jloc] == QCflags::pass;
+      nactive += active_[jobs];
+    }
+  }
+  qcFlagsSet_ = true;
+  oops::Log::debug() << "LinearObsOperator: " << nactive << " of " << active_.size()
+                     << " observations simulated" << std::endl;
+}
+
+// -----------------------------------------------------------------------------
+
+void LinearObsOperator::setActiveObservationsFromObsSpace() {
+  // The filters save their QC flags at the end of outer loop n to the group EffectiveQC<n>.
+  const oops::Variables & vars = odb_.obsvariables();
+  std::string group;
+  for (int jouter = 0; odb_.has("EffectiveQC" + std::to_string(jouter), vars[0]); ++jouter)
+    group = "EffectiveQC" + std::to_string(jouter);
+  if (group.empty())
+    throw eckit::UserError("LinearObsOperator: 'skip rejected observations' is set but no QC "
+                           "flags were passed to setQCFlags() or saved to the ObsSpace of " +
+                           odb_.obsname(), Here());
+  oops::Log::debug() << "LinearObsOperator: using the QC flags from " << group << std::endl;
+  setQCFlags(ioda::ObsDataVector<int>(odb_, vars, group));
+  // Flags saved to the ObsSpace may change between outer loops; read them again next time.
+  qcFlagsSet_ = false;
+}
+
+// -----------------------------------------------------------------------------
+
 const oops::Variables & LinearObsOperator::requiredVars() const {
   return oper_->requiredVars();
 }
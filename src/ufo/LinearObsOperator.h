@@ -9,6 +9,8 @@
 #define UFO_LINEAROBSOPERATOR_H_
 
 #include <memory>
+#include <string>
+#include <vector>
 
 #include <boost/noncopyable.hpp>
 
@@ -26,6 +28,7 @@ namespace oops {
 }
 
 namespace ioda {
+  template <typename DATATYPE> class ObsDataVector;
   class ObsSpace;
   class ObsVector;
 }
@@ -41,20 +44,49 @@ class LinearObsOperator : public util::Printable,
                           private boost::noncopyable {
  public:
   LinearObsOperator(ioda::ObsSpace &, const eckit::Configuration &);
+  /// Reports the costs of this operator recorded by the PerformanceMonitor (if enabled).
+  ~LinearObsOperator();
 
 /// Obs Operator
   void setTrajectory(const GeoVaLs &, const ObsBias &);
   void simulateObsTL(const GeoVaLs &, ioda::ObsVector &, const ObsBiasIncrement &) const;
-  void simulateObsAD(GeoVaLs &, const ioda::ObsVector &, ObsBiasIncrement &) const;
+/// \brief Accumulate the adjoint of simulateObsTL() into \p gvals.
+///
+/// Variables of \p gvals stored in single precision are first converted to double precision
+/// (see GeoVaLs::setDoublePrecision()) and remain so after the call, so that the adjoint
+/// accumulates without rounding. Callers relying on the storage of \p gvals must not assume it
+/// is unchanged.
+  void simulateObsAD(GeoVaLs & gvals, const ioda::ObsVector &, ObsBiasIncrement &) const;
+
+/// \brief Set the QC flags of the observations, before setTrajectory() is called.
+///
+/// Only used if the `skip rejected observations` option is set: the operator is then linearized
+/// about the observations whose flag is QCflags::pass. \p flags must hold one variable for each
+/// simulated variable of the ObsSpace. If this function isn't called, the flags saved to the
+/// ObsSpace by the filters of the latest outer loop (group EffectiveQC<n>) are used instead.
+  void setQCFlags(const ioda::ObsDataVector<int> & flags);
 
 /// Operator input required from Model
   const oops::Variables & requiredVars() const;
 
  private:
   void print(std::ostream &) const;
+  /// Set active_ from the QC flags most recently saved to the ObsSpace. Throws if none are saved.
+  void setActiveObservationsFromObsSpace();
+
   std::unique_ptr<LinearObsOperatorBase> oper_;
   std::unique_ptr<LinearObsBiasOperator> biasoper_;
   ioda::ObsSpace & odb_;
+  /// True if the operator is linearized only about the observations that have passed QC.
+  bool skipRejected_;
+  /// Observations that have passed QC (non-zero) or been rejected (zero), ordered as in
+  /// ioda::ObsVector. Empty if all observations are simulated.
+  std::vector<int> active_;
+  /// True if active_ has been set from QC flags passed to setQCFlags().
+  bool qcFlagsSet_ = false;
+  /// Prefix of the keys under which the costs of this operator are recorded in the
+  /// PerformanceMonitor.
+  std::string monitorPrefix_;
 };
 
 // -----------------------------------------------------------------------------
@@ -10,6 +10,8 @@
 
 #include <map>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include <boost/noncopyable.hpp>
 
@@ -51,14 +53,43 @@ class LinearObsOperatorBase : public util::Printable,
 /// The default implementation returns the list of all simulated variables in the ObsSpace.
   virtual oops::Variables simulatedVars() const;
 
+/// \brief Return true if simulateObsTL() may run concurrently with other operators.
+///
+/// Operators returning true promise that simulateObsTL() only reads the GeoVaLs and the
+/// trajectory stored by setTrajectory(), writes nothing but the rows of the ObsVector
+/// corresponding to simulatedVars() and reads no data from the ObsSpace. The Composite operator
+/// runs such components concurrently. The default implementation returns false.
+  virtual bool isThreadSafe() const { return false; }
+
 /// \brief The space containing the observations to be simulated by this operator.
   const ioda::ObsSpace &obsspace() const { return odb_; }
 
+/// \brief Set the observations that have passed QC, before setTrajectory() is called.
+///
+/// \p active holds one element per location and simulated variable, ordered as in
+/// ioda::ObsVector; zero marks rejected observations. An empty vector marks all observations
+/// as active. Operators may drop rejected observations from their trajectory: the output of
+/// simulateObsTL() for them is then replaced by zero and the input of simulateObsAD() for them
+/// is zero.
+///
+/// \note The CRTM and RTTOV operators drop rejected observations from their Jacobians (see
+/// ufo_compact_jacobian_mod); VertInterp and GnssroBndNBAM skip rejected locations when
+/// computing their trajectory and running the TL and AD; Composite passes the observations to
+/// its components. The other operators, including the other GNSS-RO operators and the marine
+/// operators, still linearize about all locations; for them the `skip rejected observations`
+/// option only zero-fills the TL output and AD input of rejected observations.
+  void setActiveObservations(std::vector<int> active) { active_ = std::move(active); }
+
+ protected:
+/// \brief The observations that have passed QC (see setActiveObservations()).
+  const std::vector<int> & activeObservations() const { return active_; }
+
  private:
   virtual void print(std::ostream &) const = 0;
 
  private:
   const ioda::ObsSpace & odb_;
+  std::vector<int> active_;
 };
 
 // -----------------------------------------------------------------------------
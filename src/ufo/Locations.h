@@ -15,6 +15,7 @@
 
 #include "eckit/mpi/Comm.h"
 #include "ioda/distribution/Distribution.h"
+#include "oops/base/Variables.h"
 #include "oops/util/DateTime.h"
 #include "oops/util/ObjectCounter.h"
 #include "oops/util/Printable.h"
@@ -56,6 +57,10 @@ class Locations : public util::Printable,
   /// accessor to DateTimes (on current MPI task)
   const std::vector<util::DateTime> & times() const {return times_;}
 
+  /// variables whose GeoVaLs at these locations may be stored in single precision
+  /// (see GeoVaLs::singlePrecisionMode)
+  const oops::Variables & singlePrecisionVars() const {return singlePrecisionVars_;}
+  void setSinglePrecisionVars(const oops::Variables & vars) {singlePrecisionVars_ = vars;}
 
  private:
   void print(std::ostream & os) const override;
@@ -64,6 +69,7 @@ class Locations : public util::Printable,
   std::vector<float> lons_;            /// longitudes on current MPI task
   std::vector<float> lats_;            /// latitudes on current MPI task
   std::vector<util::DateTime> times_;  /// times of observations on current MPI task
+  oops::Variables singlePrecisionVars_;  /// variables whose GeoVaLs may use single precision
 };
 
 }  // namespace ufo
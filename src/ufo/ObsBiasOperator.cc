@@ -64,15 +64,28 @@ void ObsBiasOperator::computeObsBias(const GeoVaLs & geovals, ioda::ObsVector &
    * ...|
    */
 
-  std::vector<double> biasTerm(nlocs);
-  //  For each channel: ( nlocs X 1 ) =  ( nlocs X npreds ) * (  npreds X 1 )
+  // Allocate the ObsBiasOperatorTerms (bias_coeff * predictor) saved for QC all at once
+  std::vector<std::string> predictorSuffixes(nvars);
+  std::vector<std::string> termNames;
+  termNames.reserve(nvars * npreds);
   for (std::size_t jvar = 0; jvar < nvars; ++jvar) {
-    std::string predictorSuffix;
     if (correctedVars.channels().empty())
-      predictorSuffix = correctedVars[jvar];
+      predictorSuffixes[jvar] = correctedVars[jvar];
     else
-      predictorSuffix = std::to_string(correctedVars.channels()[jvar]);
+      predictorSuffixes[jvar] = std::to_string(correctedVars.channels()[jvar]);
+    for (std::size_t jp = 0; jp < npreds; ++jp) {
+      const std::string varname = predictors[jp]->name() + "_" + predictorSuffixes[jvar];
+      if (!ydiags.has(varname)) {
+        oops::Log::error() << varname << " is not reserved in ydiags !" << std::endl;
+        ABORT("ObsBiasOperatorTerm variable is not reserved in ydiags");
+      }
+      termNames.push_back(varname);
+    }
+  }
 
+  std::vector<double> biasTerm(nlocs);
+  //  For each channel: ( nlocs X 1 ) =  ( nlocs X npreds ) * (  npreds X 1 )
+  for (std::size_t jvar = 0; jvar < nvars; ++jvar) {
     for (std::size_t jp = 0; jp < npreds; ++jp) {
       // axpy
       const double beta = biascoeffs(jp, jvar);
@@ -83,14 +96,7 @@ void ObsBiasOperator::computeObsBias(const GeoVaLs & geovals, ioda::ObsVector &
         }
       }
       // Save ObsBiasOperatorTerms (bias_coeff * predictor) for QC
-      const std::string varname = predictors[jp]->name() + "_" + predictorSuffix;
-      if (ydiags.has(varname)) {
-        ydiags.allocate(1, oops::Variables({varname}));
-        ydiags.save(biasTerm, varname, 1);
-      } else {
-        oops::Log::error() << varname << " is not reserved in ydiags !" << std::endl;
-        ABORT("ObsBiasOperatorTerm variable is not reserved in ydiags");
-      }
+      ydiags.save(biasTerm, termNames[jvar * npreds + jp], 1);
     }
   }
 
@@ -12,6 +12,7 @@
 #include <vector>
 
 #include "oops/base/Variables.h"
+#include "oops/util/assert.h"
 #include "ufo/Locations.h"
 
 #include "ioda/ObsSpace.h"
@@ -22,11 +23,24 @@ namespace ufo {
 
 ObsDiagnostics::ObsDiagnostics(const ioda::ObsSpace & os, const Locations & locs,
                                const oops::Variables & vars)
-  : obsdb_(os), gdiags_(locs, vars)
+  : ObsDiagnostics(os, locs, vars, std::vector<int>(vars.size(), 1))
 {}
 
 // -----------------------------------------------------------------------------
 
+ObsDiagnostics::ObsDiagnostics(const ioda::ObsSpace & os, const Locations & locs,
+                               const oops::Variables & vars, const std::vector<int> & nlevs)
+  : obsdb_(os), gdiags_(locs, vars)
+{
+  ASSERT(nlevs.size() == vars.size());
+  // Diagnostics are accessed through pointers to double-precision values.
+  gdiags_.setDoublePrecision();
+  for (size_t jvar = 0; jvar < vars.size(); ++jvar)
+    gdiags_.allocate(nlevs[jvar], oops::Variables({vars[jvar]}));
+}
+
+// -----------------------------------------------------------------------------
+
 ObsDiagnostics::ObsDiagnostics(const eckit::Configuration & conf, const ioda::ObsSpace & os,
                                const oops::Variables & vars)
   : obsdb_(os), gdiags_(conf, os, vars)
@@ -34,16 +48,24 @@ ObsDiagnostics::ObsDiagnostics(const eckit::Configuration & conf, const ioda::Ob
 
 // -----------------------------------------------------------------------------
 
-void ObsDiagnostics::allocate(const int nlev, const oops::Variables & vars) {
-  gdiags_.allocate(nlev, vars);
+void ObsDiagnostics::save(const std::vector<double> & vals,
+                          const std::string & var,
+                          const int lev) {
+  const LevelView view = level(var, lev);
+  ASSERT(vals.size() == view.size());
+  for (size_t jloc = 0; jloc < vals.size(); ++jloc)
+    view[jloc] = vals[jloc];
 }
 
 // -----------------------------------------------------------------------------
 
-void ObsDiagnostics::save(const std::vector<double> & vals,
-                          const std::string & var,
-                          const int lev) {
-  gdiags_.put(vals, var, lev);
+ObsDiagnostics::LevelView ObsDiagnostics::level(const std::string & var, const int lev) {
+  // Only looks up the current storage of var, so it doesn't need to be serialized.
+  int nlevs, nlocs;
+  void * data;
+  ufo_geovals_get_data_f90(gdiags_.toFortran(), var.size(), var.c_str(), nlevs, nlocs, data);
+  ASSERT(lev >= 1 && lev <= nlevs);
+  return LevelView(static_cast<double *>(data) + (lev - 1), nlocs, nlevs);
 }
 
 // -----------------------------------------------------------------------------
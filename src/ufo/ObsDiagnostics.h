@@ -31,23 +31,50 @@ namespace ufo {
 
 // -----------------------------------------------------------------------------
 
+/// \brief Diagnostics computed by observation operators and bias predictors for use by filters.
+///
+/// All variables are allocated when the object is constructed, so save() and the views returned
+/// by level() write them in place, without allocating or locking. Operators, bias terms and
+/// filters running concurrently may therefore write diagnostics at the same time, provided that
+/// different threads write different levels or different variables.
+///
+/// Operators implemented in Fortran replace the storage of the diagnostics they compute when
+/// these have a different number of levels; views obtained before the operator ran must not be
+/// used afterwards.
 class ObsDiagnostics : public util::Printable,
                        private boost::noncopyable {
  public:
-  ObsDiagnostics(const ioda::ObsSpace &, const Locations &, const oops::Variables &);
+  /// \brief Values of one level of a diagnostic variable at all locations.
+  /// \details The values stay owned by the ObsDiagnostics object; consecutive locations are
+  /// separated by the number of levels of the variable.
+  class LevelView {
+   public:
+    LevelView(double * data, size_t nlocs, size_t stride)
+      : data_(data), nlocs_(nlocs), stride_(stride) {}
+
+    double & operator[](size_t jloc) const {return data_[jloc * stride_];}
+    size_t size() const {return nlocs_;}
+
+   private:
+    double * data_;
+    size_t nlocs_;
+    size_t stride_;
+  };
+
+  /// Allocate one level of each of \p vars.
+  ObsDiagnostics(const ioda::ObsSpace &, const Locations &, const oops::Variables & vars);
+  /// Allocate \p nlevs[i] levels of variable \p vars[i].
+  ObsDiagnostics(const ioda::ObsSpace &, const Locations &, const oops::Variables & vars,
+                 const std::vector<int> & nlevs);
   ObsDiagnostics(const eckit::Configuration &, const ioda::ObsSpace &,
                  const oops::Variables &);
   ~ObsDiagnostics() {}
 
-  /// \brief Allocate diagnostics for variables \p vars with \p nlev number of levels
-  /// \details Fails if at least one of the \p vars doesn't exist in the ObsDiagnostics object.
-  ///          Only allocates variables that haven't been allocated before.
-  ///          Fails if one of \p vars is already allocated with a number of levels
-  ///          different than \p nlev; doesn't reallocate variables that are already
-  ///          allocated with \p nlev.
-  void allocate(const int nlev, const oops::Variables & vars);
+  /// \brief Save \p vals at level \p lev (numbered from 1) of variable \p var.
+  void save(const std::vector<double> & vals, const std::string & var, const int lev);
 
-  void save(const std::vector<double> &, const std::string &, const int);
+  /// \brief View of level \p lev (numbered from 1) of variable \p var.
+  LevelView level(const std::string & var, const int lev);
 
 // Interfaces
   int & toFortran() {return gdiags_.toFortran();}
@@ -62,6 +89,7 @@ class ObsDiagnostics : public util::Printable,
     gdiags_.write(config);}
  private:
   void print(std::ostream &) const;
+
   const ioda::ObsSpace & obsdb_;
 
   GeoVaLs gdiags_;
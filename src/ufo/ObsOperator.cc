@@ -5,6 +5,7 @@
  * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
  */
 
+#include <string>
 #include <vector>
 
 #include "ufo/ObsOperator.h"
@@ -22,13 +23,15 @@
 #include "ufo/ObsBiasOperator.h"
 #include "ufo/ObsDiagnostics.h"
 #include "ufo/ObsOperatorBase.h"
+#include "ufo/utils/PerformanceMonitor.h"
 
 namespace ufo {
 
 // -----------------------------------------------------------------------------
 
 ObsOperator::ObsOperator(ioda::ObsSpace & os, const eckit::Configuration & conf)
-  : oper_(ObsOperatorFactory::create(os, conf)), odb_(os)
+  : oper_(ObsOperatorFactory::create(os, conf)), odb_(os),
+    monitorPrefix_(os.obsname() + "/" + conf.getString("name") + "/")
 {
   // We use += rather than = to make sure the Variables objects contain no duplicate entries
   // and the variables are sorted alphabetically.
@@ -46,6 +49,7 @@ ObsOperator::ObsOperator(ioda::ObsSpace & os, const eckit::Configuration & conf)
 
 void ObsOperator::simulateObs(const GeoVaLs & gvals, ioda::ObsVector & yy,
                               const ObsBias & bias, ObsDiagnostics & ydiags) const {
+  ScopedPerformanceMonitor monitor(monitorPrefix_, "simulateObs", odb_.nlocs());
   oper_->simulateObs(gvals, yy, ydiags);
   if (bias) {
     ioda::ObsVector ybias(odb_);
@@ -66,7 +70,16 @@ const oops::Variables & ObsOperator::requiredVars() const {
 // -----------------------------------------------------------------------------
 
 std::unique_ptr<Locations> ObsOperator::locations() const {
-  return oper_->locations();
+  std::unique_ptr<Locations> locs = oper_->locations();
+  if (oper_->supportsSinglePrecisionGeoVaLs()) {
+    const oops::Variables & required = oper_->requiredVars();
+    const oops::Variables sensitive = oper_->precisionSensitiveVars();
+    oops::Variables singleVars;
+    for (size_t jv = 0; jv < required.size(); ++jv)
+      if (!sensitive.has(required[jv])) singleVars.push_back(required[jv]);
+    locs->setSinglePrecisionVars(singleVars);
+  }
+  return locs;
 }
 
 // -----------------------------------------------------------------------------
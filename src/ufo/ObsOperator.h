@@ -50,13 +50,17 @@ class ObsOperator : public util::Printable,
 /// Operator input required from Model
   const oops::Variables & requiredVars() const;
 
-/// Operator locations
+/// Operator locations, listing the required variables whose GeoVaLs may be stored in single
+/// precision if the operator supports it
   std::unique_ptr<Locations> locations() const;
 
  private:
   void print(std::ostream &) const;
   std::unique_ptr<ObsOperatorBase> oper_;
   ioda::ObsSpace & odb_;
+  /// Prefix of the keys under which the costs of this operator are recorded in the
+  /// PerformanceMonitor.
+  std::string monitorPrefix_;
 };
 
 // -----------------------------------------------------------------------------
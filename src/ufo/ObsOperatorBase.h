@@ -53,6 +53,30 @@ class ObsOperatorBase : public util::Printable,
 /// The default implementation returns the list of all simulated variables in the ObsSpace.
   virtual oops::Variables simulatedVars() const;
 
+/// \brief Return true if simulateObs() may run concurrently with other operators.
+///
+/// Operators returning true promise that simulateObs() only reads the GeoVaLs, writes nothing
+/// but the rows of the ObsVector corresponding to simulatedVars() and the ObsDiagnostics
+/// variables it owns, and reads no data from the ObsSpace. The Composite operator runs such
+/// components concurrently. The default implementation returns false.
+  virtual bool isThreadSafe() const { return false; }
+
+/// \brief Return true if the operator can read GeoVaLs stored in single precision.
+///
+/// In single-precision GeoVaLs mode (see GeoVaLs::singlePrecisionMode) GeoVaLs of the
+/// required variables other than precisionSensitiveVars() are then stored in single precision.
+/// Operators returning true must read these GeoVaLs only through the GeoVaLs::get methods or,
+/// from Fortran, through ufo_geovals_get_var with a `copy` argument. Filters receive the same
+/// GeoVaLs, so filters reading them from Fortran (e.g. the 1D-Var checks) must do the same. The
+/// default implementation returns false.
+  virtual bool supportsSinglePrecisionGeoVaLs() const { return false; }
+
+/// \brief List of required variables whose GeoVaLs must be stored in double precision.
+///
+/// Only used if supportsSinglePrecisionGeoVaLs() returns true. The default implementation
+/// returns an empty list.
+  virtual oops::Variables precisionSensitiveVars() const { return oops::Variables(); }
+
  private:
   virtual void print(std::ostream &) const = 0;
   const ioda::ObsSpace & odb_;
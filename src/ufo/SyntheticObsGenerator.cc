@@ -0,0 +1,292 @@
+/*
+ * (C) Crown copyright 2021, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#include "ufo/SyntheticObsGenerator.h"
+
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "eckit/exception/Exceptions.h"
+#include "eckit/mpi/Comm.h"
+
+#include "ioda/Engines/Factory.h"
+#include "ioda/ObsGroup.h"
+
+#include "oops/base/Variables.h"
+#include "oops/util/Duration.h"
+#include "oops/util/Logger.h"
+#include "oops/util/missingValues.h"
+
+#include "ufo/GeoVaLs.h"
+#include "ufo/Locations.h"
+#include "ufo/utils/Constants.h"
+
+namespace ufo {
+
+namespace {
+
+/// The SplitMix64 finaliser: a cheap bijective hash with good avalanche properties.
+uint64_t mix(uint64_t x) {
+  x += 0x9e3779b97f4a7c15ULL;
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+  return x ^ (x >> 31);
+}
+
+/// Salts distinguishing the pseudo-random streams used for different purposes.
+const uint64_t stationLatitudeSalt = 1;
+const uint64_t stationLongitudeSalt = 2;
+const uint64_t noiseSalt = 3;
+const uint64_t stationTimeSalt = 4;
+
+}  // namespace
+
+// -----------------------------------------------------------------------------
+
+SyntheticObsGenerator::SyntheticObsGenerator(const SyntheticObsGeneratorParameters & options)
+  : options_(options)
+{
+  if (options_.numLocations.value() < 1)
+    throw eckit::UserError("'number of locations' must be positive", Here());
+  if (options_.numStations.value() < 1)
+    throw eckit::UserError("'number of stations' must be positive", Here());
+  if (options_.levelsPerProfile.value() < 1)
+    throw eckit::UserError("'levels per profile' must be positive", Here());
+  if (options_.modelLevels.value() < 1)
+    throw eckit::UserError("'model levels' must be positive", Here());
+  if (!(options_.topPressure.value() > 0.0 &&
+        options_.topPressure.value() < options_.surfacePressure.value()))
+    throw eckit::UserError("'top pressure' must be positive and lower than 'surface pressure'",
+                           Here());
+}
+
+// -----------------------------------------------------------------------------
+
+SyntheticObsGenerator::SyntheticLocation SyntheticObsGenerator::location(
+    size_t index, const util::DateTime & windowBegin, const util::DateTime & windowEnd) const {
+  const size_t levelsPerProfile = options_.levelsPerProfile.value();
+  const size_t numStations = options_.numStations.value();
+  const size_t numProfiles = (options_.numLocations.value() + levelsPerProfile - 1) /
+                             levelsPerProfile;
+  const size_t visitsPerStation = (numProfiles + numStations - 1) / numStations;
+
+  SyntheticLocation loc;
+  loc.profile = index / levelsPerProfile;
+  loc.station = loc.profile % numStations;
+  const size_t level = index % levelsPerProfile;
+  const size_t visit = loc.profile / numStations;
+
+  const float latSpan = options_.maxLatitude.value() - options_.minLatitude.value();
+  const float lonSpan = options_.maxLongitude.value() - options_.minLongitude.value();
+  loc.lat = options_.minLatitude.value() + latSpan * uniform(loc.station, stationLatitudeSalt);
+  const float lon = options_.minLongitude.value() +
+                    lonSpan * uniform(loc.station, stationLongitudeSalt) +
+                    options_.stationDrift.value() * visit;
+  loc.lon = lon - 360.0f * std::floor((lon + 180.0f) / 360.0f);
+
+  // Levels are ordered from the bottom to the top of each profile.
+  const double logSurfacePressure = std::log(options_.surfacePressure.value());
+  const double logTopPressure = std::log(options_.topPressure.value());
+  const double fraction = levelsPerProfile > 1 ?
+                          static_cast<double>(level) / (levelsPerProfile - 1) : 0.0;
+  loc.pressure = std::exp(logSurfacePressure + fraction * (logTopPressure - logSurfacePressure));
+
+  // The visits of a station are evenly spaced over the window, starting at a pseudo-random
+  // offset, and all locations of a profile share its time. Times lie in (windowBegin, windowEnd].
+  const int64_t windowLength = (windowEnd - windowBegin).toSeconds();
+  const double windowFraction = (visit + uniform(loc.station, stationTimeSalt)) / visitsPerStation;
+  loc.time = windowBegin + util::Duration(
+        1 + static_cast<int64_t>(std::floor((windowLength - 1) * windowFraction)));
+  return loc;
+}
+
+// -----------------------------------------------------------------------------
+
+void SyntheticObsGenerator::writeObsFile(const oops::Variables & simulated,
+                                         const util::DateTime & windowBegin,
+                                         const util::DateTime & windowEnd,
+                                         const eckit::mpi::Comm & comm) const {
+  oops::Log::trace() << "SyntheticObsGenerator::writeObsFile starting" << std::endl;
+
+  if (!(windowBegin < windowEnd))
+    throw eckit::UserError("The assimilation window must not be empty", Here());
+
+  if (comm.rank() == 0) {
+    const size_t nlocs = options_.numLocations.value();
+    std::vector<float> lats(nlocs), lons(nlocs), pressures(nlocs);
+    std::vector<std::string> times(nlocs), stationIds(nlocs);
+    std::vector<int> recordNumbers(nlocs);
+    for (size_t jloc = 0; jloc < nlocs; ++jloc) {
+      const SyntheticLocation loc = location(jloc, windowBegin, windowEnd);
+      lats[jloc] = loc.lat;
+      lons[jloc] = loc.lon;
+      pressures[jloc] = loc.pressure;
+      times[jloc] = loc.time.toString();
+      stationIds[jloc] = stationId(loc.station);
+      recordNumbers[jloc] = loc.profile;
+    }
+
+    ioda::Engines::BackendCreationParameters backendParams;
+    backendParams.fileName = options_.obsFile.value();
+    backendParams.action = ioda::Engines::BackendFileActions::Create;
+    backendParams.createMode = ioda::Engines::BackendCreateModes::Truncate_If_Exists;
+    ioda::Group backend = ioda::Engines::constructBackend(ioda::Engines::BackendNames::Hdf5File,
+                                                          backendParams);
+    ioda::NewDimensionScales_t dims{ioda::NewDimensionScale<int>("nlocs", nlocs, nlocs, nlocs)};
+    ioda::ObsGroup obsgroup = ioda::ObsGroup::generate(backend, dims);
+    const ioda::Variable nlocsVar = obsgroup.vars["nlocs"];
+
+    ioda::VariableCreationParameters floatParams;
+    floatParams.chunk = true;
+    floatParams.compressWithGZIP();
+    floatParams.setFillValue<float>(util::missingValue(float()));
+    ioda::VariableCreationParameters intParams;
+    intParams.chunk = true;
+    intParams.compressWithGZIP();
+    intParams.setFillValue<int>(util::missingValue(int()));
+    ioda::VariableCreationParameters stringParams;
+    stringParams.chunk = true;
+    stringParams.compressWithGZIP();
+
+    obsgroup.vars.createWithScales<float>("MetaData/latitude", {nlocsVar}, floatParams)
+        .write(lats);
+    obsgroup.vars.createWithScales<float>("MetaData/longitude", {nlocsVar}, floatParams)
+        .write(lons);
+    obsgroup.vars.createWithScales<float>("MetaData/air_pressure", {nlocsVar}, floatParams)
+        .write(pressures);
+    obsgroup.vars.createWithScales<std::string>("MetaData/datetime", {nlocsVar}, stringParams)
+        .write(times);
+    obsgroup.vars.createWithScales<std::string>("MetaData/station_id", {nlocsVar}, stringParams)
+        .write(stationIds);
+    obsgroup.vars.createWithScales<int>("MetaData/record_number", {nlocsVar}, intParams)
+        .write(recordNumbers);
+
+    std::vector<float> values(nlocs);
+    for (size_t jvar = 0; jvar < simulated.size(); ++jvar) {
+      const SyntheticVariableParameters & varOptions = variableParameters(simulated[jvar]);
+      const double noise = varOptions.noise.value();
+      for (size_t jloc = 0; jloc < nlocs; ++jloc) {
+        values[jloc] = field(simulated[jvar], lats[jloc], lons[jloc], pressures[jloc]);
+        if (noise > 0.0)
+          values[jloc] += noise * gaussian(jloc, noiseSalt + 2 * (jvar + 1));
+      }
+      obsgroup.vars.createWithScales<float>("ObsValue/" + simulated[jvar], {nlocsVar},
+                                            floatParams).write(values);
+      const std::vector<float> errors(nlocs, varOptions.obsError.value());
+      obsgroup.vars.createWithScales<float>("ObsError/" + simulated[jvar], {nlocsVar},
+                                            floatParams).write(errors);
+    }
+  }
+  // Make sure the file is complete before any rank reads it.
+  comm.barrier();
+
+  oops::Log::trace() << "SyntheticObsGenerator::writeObsFile done" << std::endl;
+}
+
+// -----------------------------------------------------------------------------
+
+std::string SyntheticObsGenerator::stationId(size_t station) {
+  std::ostringstream id;
+  id << std::setw(5) << std::setfill('0') << station;
+  return id.str();
+}
+
+// -----------------------------------------------------------------------------
+
+void SyntheticObsGenerator::fillGeoVaLs(const Locations & locs, GeoVaLs & geovals) const {
+  oops::Log::trace() << "SyntheticObsGenerator::fillGeoVaLs starting" << std::endl;
+
+  const size_t nlocs = locs.size();
+  const int nlevs = options_.modelLevels.value();
+  const double logSurfacePressure = std::log(options_.surfacePressure.value());
+  const double logTopPressure = std::log(options_.topPressure.value());
+  // Pressure at level (or half level) jlev out of nlevels, counted from the top.
+  auto levelPressure = [&](double jlev, int nlevels) {
+    const double fraction = nlevels > 1 ? jlev / (nlevels - 1) : 1.0;
+    return std::exp(logTopPressure + fraction * (logSurfacePressure - logTopPressure));
+  };
+
+  const oops::Variables & vars = geovals.getVars();
+  std::vector<double> values(nlocs);
+  for (size_t jvar = 0; jvar < vars.size(); ++jvar) {
+    const std::string & var = vars[jvar];
+    int nvarlevs = nlevs;
+    if (var == "air_pressure_levels")
+      nvarlevs = nlevs + 1;
+    else if (var == "surface_pressure")
+      nvarlevs = 1;
+    const SyntheticVariableParameters & varOptions = variableParameters(var);
+    if (varOptions.levels.value() != boost::none)
+      nvarlevs = *varOptions.levels.value();
+    geovals.allocate(nvarlevs, oops::Variables({var}));
+
+    for (int jlev = 0; jlev < nvarlevs; ++jlev) {
+      double pressure;
+      if (var == "air_pressure_levels")
+        pressure = levelPressure(jlev, nlevs + 1);
+      else if (var == "surface_pressure" || nvarlevs == 1)
+        pressure = options_.surfacePressure.value();
+      else
+        // Full levels lie halfway (in log(pressure)) between the surrounding half levels.
+        pressure = levelPressure(jlev + 0.5, nvarlevs + 1);
+
+      if (var == "air_pressure" || var == "air_pressure_levels" || var == "surface_pressure") {
+        values.assign(nlocs, pressure);
+      } else {
+        for (size_t jloc = 0; jloc < nlocs; ++jloc)
+          values[jloc] = field(var, locs.lats()[jloc], locs.lons()[jloc], pressure);
+      }
+      geovals.put(values, var, jlev);
+    }
+  }
+
+  oops::Log::trace() << "SyntheticObsGenerator::fillGeoVaLs done" << std::endl;
+}
+
+// -----------------------------------------------------------------------------
+
+double SyntheticObsGenerator::field(const std::string & var, float lat, float lon,
+                                    double pressure) const {
+  const SyntheticVariableParameters & varOptions = variableParameters(var);
+  return varOptions.mean.value() + varOptions.amplitude.value() *
+         std::cos(lat * Constants::deg2rad) * std::cos(lon * Constants::deg2rad) *
+         pressure / options_.surfacePressure.value();
+}
+
+// -----------------------------------------------------------------------------
+
+const SyntheticVariableParameters & SyntheticObsGenerator::variableParameters(
+    const std::string & var) const {
+  for (const SyntheticVariableParameters & varOptions : options_.variables.value())
+    if (varOptions.name.value() == var)
+      return varOptions;
+  return defaultVariable_;
+}
+
+// -----------------------------------------------------------------------------
+
+double SyntheticObsGenerator::uniform(uint64_t key1, uint64_t key2) const {
+  const uint64_t hash = mix(mix(mix(options_.seed.value()) ^ key1) ^ key2);
+  // Use the 53 most significant bits to form a double in [0, 1).
+  return (hash >> 11) * (1.0 / 9007199254740992.0);
+}
+
+// -----------------------------------------------------------------------------
+
+double SyntheticObsGenerator::gaussian(uint64_t key1, uint64_t key2) const {
+  // Box-Muller transform.
+  const double u1 = 1.0 - uniform(key1, key2);  // in (0, 1]
+  const double u2 = uniform(key1, key2 + 1);
+  return std::sqrt(-2.0 * std::log(u1)) * std::cos(2.0 * M_PI * u2);
+}
+
+// -----------------------------------------------------------------------------
+
+}  // namespace ufo
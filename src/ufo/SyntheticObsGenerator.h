@@ -0,0 +1,198 @@
+/*
+ * (C) Crown copyright 2021, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef UFO_SYNTHETICOBSGENERATOR_H_
+#define UFO_SYNTHETICOBSGENERATOR_H_
+
+#include <cstddef>  // for size_t
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "oops/util/DateTime.h"
+#include "oops/util/ObjectCounter.h"
+#include "oops/util/parameters/OptionalParameter.h"
+#include "oops/util/parameters/Parameter.h"
+#include "oops/util/parameters/Parameters.h"
+#include "oops/util/parameters/RequiredParameter.h"
+
+namespace eckit {
+  namespace mpi {
+    class Comm;
+  }
+}
+
+namespace oops {
+  class Variables;
+}
+
+namespace ufo {
+  class GeoVaLs;
+  class Locations;
+
+/// \brief Options controlling the synthetic values of a single variable.
+class SyntheticVariableParameters : public oops::Parameters {
+  OOPS_CONCRETE_PARAMETERS(SyntheticVariableParameters, Parameters)
+
+ public:
+  oops::RequiredParameter<std::string> name{"name", this};
+
+  /// Mean value of the analytic field.
+  oops::Parameter<double> mean{"mean", 0.0, this};
+
+  /// Amplitude of the horizontal and vertical variations of the analytic field.
+  oops::Parameter<double> amplitude{"amplitude", 1.0, this};
+
+  /// Standard deviation of the Gaussian noise added to observed values.
+  oops::Parameter<double> noise{"noise", 0.0, this};
+
+  /// Observation error assigned to observed values.
+  oops::Parameter<float> obsError{"obs error", 1.0f, this};
+
+  /// Number of levels of the GeoVaL. If not set, `model levels` is used.
+  oops::OptionalParameter<int> levels{"levels", this};
+};
+
+/// \brief Options controlling the SyntheticObsGenerator.
+class SyntheticObsGeneratorParameters : public oops::Parameters {
+  OOPS_CONCRETE_PARAMETERS(SyntheticObsGeneratorParameters, Parameters)
+
+ public:
+  /// File to which the observations are written (see SyntheticObsGenerator::writeObsFile()).
+  oops::RequiredParameter<std::string> obsFile{"obs file", this};
+
+  /// Total number of locations.
+  oops::RequiredParameter<int> numLocations{"number of locations", this};
+
+  /// Number of distinct stations (or platforms). Consecutive profiles are assigned to stations
+  /// in a round-robin fashion.
+  oops::Parameter<int> numStations{"number of stations", 100, this};
+
+  /// Number of consecutive locations forming a single profile (1 for surface observations).
+  oops::Parameter<int> levelsPerProfile{"levels per profile", 1, this};
+
+  /// Bounding box within which the stations are placed (degrees).
+  oops::Parameter<float> minLatitude{"min latitude", -90.0f, this};
+  oops::Parameter<float> maxLatitude{"max latitude", 90.0f, this};
+  oops::Parameter<float> minLongitude{"min longitude", -180.0f, this};
+  oops::Parameter<float> maxLongitude{"max longitude", 180.0f, this};
+
+  /// Eastward displacement of a station between consecutive profiles (degrees). Non-zero
+  /// values produce moving platforms (ships, aircraft) rather than fixed stations.
+  oops::Parameter<float> stationDrift{"station drift", 0.0f, this};
+
+  /// Pressure at the bottom and at the top of the model atmosphere (Pa). Observation pressures
+  /// are spaced uniformly in log(pressure) between these two values.
+  oops::Parameter<double> surfacePressure{"surface pressure", 100000.0, this};
+  oops::Parameter<double> topPressure{"top pressure", 1000.0, this};
+
+  /// Number of levels of the generated GeoVaLs.
+  oops::Parameter<int> modelLevels{"model levels", 70, this};
+
+  /// Seed of the generator of station positions and observation noise.
+  oops::Parameter<int> seed{"random seed", 0, this};
+
+  /// Analytic fields of observed and model variables. Variables not listed here are given the
+  /// default options.
+  oops::Parameter<std::vector<SyntheticVariableParameters>> variables{"variables", {}, this};
+};
+
+// -----------------------------------------------------------------------------
+
+/// \brief Generates observation files and GeoVaLs of arbitrary size with synthetic, mutually
+/// consistent values for use in tests and benchmarks.
+///
+/// writeObsFile() writes an ioda file holding `number of locations` observations with a realistic
+/// structure: the location with index `g` is assigned to profile `g / (levels per profile)`,
+/// profiles are distributed among stations round-robin and each station is placed at a
+/// pseudo-random position (shifted by `station drift` after each profile). The successive
+/// profiles of a station are launched at regular intervals spanning the assimilation window,
+/// starting at a pseudo-random offset. The file holds the MetaData variables `latitude`,
+/// `longitude`, `datetime`, `air_pressure`, `station_id` and `record_number`, and ObsValue and
+/// ObsError for all simulated variables. As in real data files, `station_id` holds strings (see
+/// stationId()). Since the file is written before the ObsSpace is created, ioda distributes the
+/// observations among MPI tasks and groups them into records (e.g. with `obsgrouping` on
+/// `station_id`) just as it does for real data:
+///
+/// \code{.yaml}
+///   obs space:
+///     name: Synthetic sondes
+///     simulated variables: [air_temperature]
+///     obsdatain:
+///       obsfile: synthetic_sondes.nc4  # the `obs file` of the generator
+///       obsgrouping:
+///         group variables: [station_id]
+/// \endcode
+///
+/// fillGeoVaLs() allocates and fills GeoVaLs with the same analytic fields, so that model
+/// equivalents computed by interpolation operators are close to the observed values.
+///
+/// All values depend only on the options and on location indices, so results do not depend on
+/// the number of MPI tasks.
+class SyntheticObsGenerator : private util::ObjectCounter<SyntheticObsGenerator> {
+ public:
+  static const std::string classname() {return "ufo::SyntheticObsGenerator";}
+
+  explicit SyntheticObsGenerator(const SyntheticObsGeneratorParameters &);
+
+  /// \brief Write the observations of the variables \p simulated taken in the (\p windowBegin,
+  /// \p windowEnd] window to the file `obs file`.
+  ///
+  /// This is a collective operation: rank 0 of \p comm writes the file, which all ranks can read
+  /// on return.
+  void writeObsFile(const oops::Variables & simulated, const util::DateTime & windowBegin,
+                    const util::DateTime & windowEnd, const eckit::mpi::Comm & comm) const;
+
+  const std::string & obsFile() const {return options_.obsFile.value();}
+
+  /// \brief Allocate and fill all variables of \p geovals at locations \p locs.
+  ///
+  /// Vertical levels are ordered from the top to the bottom of the atmosphere. `air_pressure`
+  /// and `air_pressure_levels` hold pressures at `model levels` full levels and at the
+  /// `model levels` + 1 surrounding half levels; `surface_pressure` holds `surface pressure`.
+  void fillGeoVaLs(const Locations & locs, GeoVaLs & geovals) const;
+
+  /// Value of the analytic field \p var at the given position and pressure.
+  double field(const std::string & var, float lat, float lon, double pressure) const;
+
+  /// Station identifier (`station_id` MetaData) of station number \p station: the number
+  /// zero-padded to five digits, like WMO station identifiers.
+  static std::string stationId(size_t station);
+
+ private:
+  /// MetaData of a single location.
+  struct SyntheticLocation {
+    float lat;
+    float lon;
+    float pressure;
+    util::DateTime time;
+    size_t station;
+    size_t profile;
+  };
+
+  /// Return the MetaData of the location with index \p index.
+  SyntheticLocation location(size_t index, const util::DateTime & windowBegin,
+                             const util::DateTime & windowEnd) const;
+
+  const SyntheticVariableParameters & variableParameters(const std::string & var) const;
+
+  /// Return a pseudo-random number uniformly distributed in [0, 1) depending only on the seed
+  /// and on \p key1 and \p key2.
+  double uniform(uint64_t key1, uint64_t key2) const;
+  /// Return a pseudo-random number from the standard normal distribution depending only on the
+  /// seed and on \p key1 and \p key2.
+  double gaussian(uint64_t key1, uint64_t key2) const;
+
+  SyntheticObsGeneratorParameters options_;
+  SyntheticVariableParameters defaultVariable_;
+};
+
+// -----------------------------------------------------------------------------
+
+}  // namespace ufo
+
+#endif  // UFO_SYNTHETICOBSGENERATOR_H_
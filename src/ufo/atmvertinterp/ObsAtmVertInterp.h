@@ -45,6 +45,8 @@ class ObsAtmVertInterp : public ObsOperatorBase,
 
 // Other
   const oops::Variables & requiredVars() const override {return varin_;}
+  /// Profiles and the vertical coordinate are read into double-precision copies.
+  bool supportsSinglePrecisionGeoVaLs() const override {return true;}
 
   oops::Variables simulatedVars() const override {return operatorVars_;}
 
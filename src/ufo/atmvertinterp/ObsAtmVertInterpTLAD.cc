@@ -54,6 +54,12 @@ void ObsAtmVertInterpTLAD::setTrajectory(const GeoVaLs & geovals, const ObsBias
                                          ObsDiagnostics &) {
   oops::Log::trace() << "ObsAtmVertInterpTLAD::setTrajectory entering" << std::endl;
 
+  if (!activeObservations().empty()) {
+    const int nvars = obsspace().obsvariables().size();
+    const int nlocs = obsspace().nlocs();
+    ufo_atmvertinterp_tlad_set_active_f90(keyOperAtmVertInterp_, nvars, nlocs,
+                                          activeObservations()[0]);
+  }
   ufo_atmvertinterp_tlad_settraj_f90(keyOperAtmVertInterp_, geovals.toFortran(), obsspace());
 
   oops::Log::trace() << "ObsAtmVertInterpTLAD::setTrajectory exiting" << std::endl;
@@ -51,6 +51,8 @@ class ObsAtmVertInterpTLAD : public LinearObsOperatorBase,
 
   oops::Variables simulatedVars() const override {return operatorVars_;}
 
+  bool isThreadSafe() const override {return true;}
+
   int & toFortran() {return keyOperAtmVertInterp_;}
   const int & toFortran() const {return keyOperAtmVertInterp_;}
 
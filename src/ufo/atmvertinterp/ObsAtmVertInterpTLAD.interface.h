@@ -46,6 +46,8 @@ extern "C" {
                                         const int numOperatorVarIndices,
                                         oops::Variables &requiredVars);
   void ufo_atmvertinterp_tlad_delete_f90(F90hop &);
+  void ufo_atmvertinterp_tlad_set_active_f90(const F90hop &, const int &, const int &,
+                                             const int &);
   void ufo_atmvertinterp_tlad_settraj_f90(const F90hop &, const F90goms &, const ioda::ObsSpace &);
   void ufo_atmvertinterp_simobs_tl_f90(const F90hop &, const F90goms &, const ioda::ObsSpace &,
                                     const int &, const int &, double &);
@@ -94,6 +94,8 @@ class ObsBackgroundErrorIdentity : public ObsOperatorBase,
 
   oops::Variables simulatedVars() const override;
 
+  bool isThreadSafe() const override { return true; }
+
  private:
   void print(std::ostream &) const override;
 
@@ -8,6 +8,7 @@
 #include "ufo/compositeoper/ObsComposite.h"
 
 #include <algorithm>
+#include <future>  // NOLINT(build/c++11)
 #include <ostream>
 #include <utility>
 #include <vector>
@@ -57,8 +58,23 @@ void ObsComposite::simulateObs(const GeoVaLs & gv, ioda::ObsVector & ovec,
                               ObsDiagnostics & ydiags) const {
   oops::Log::trace() << "ObsComposite: simulateObs entered" << std::endl;
 
+  // Launch the thread-safe components first so that they overlap with the remaining ones.
+  std::vector<std::future<void>> concurrentRuns;
+  for (const std::unique_ptr<ObsOperatorBase> &component : components_) {
+    if (component->isThreadSafe()) {
+      concurrentRuns.push_back(std::async(std::launch::async,
+                                          [&component, &gv, &ovec, &ydiags]
+                                          { component->simulateObs(gv, ovec, ydiags); }));
+    }
+  }
+
   for (const std::unique_ptr<ObsOperatorBase> &component : components_)
-    component->simulateObs(gv, ovec, ydiags);
+    if (!component->isThreadSafe())
+      component->simulateObs(gv, ovec, ydiags);
+
+  // get() rethrows any exception raised by a component.
+  for (std::future<void> &run : concurrentRuns)
+    run.get();
 
   oops::Log::trace() << "ObsComposite: simulateObs exit " <<  std::endl;
 }
@@ -84,6 +100,31 @@ oops::Variables ObsComposite::simulatedVars() const {
 
 // -----------------------------------------------------------------------------
 
+bool ObsComposite::isThreadSafe() const {
+  return std::all_of(components_.begin(), components_.end(),
+                     [](const std::unique_ptr<ObsOperatorBase> &component)
+                     { return component->isThreadSafe(); });
+}
+
+// -----------------------------------------------------------------------------
+
+bool ObsComposite::supportsSinglePrecisionGeoVaLs() const {
+  return std::all_of(components_.begin(), components_.end(),
+                     [](const std::unique_ptr<ObsOperatorBase> &component)
+                     { return component->supportsSinglePrecisionGeoVaLs(); });
+}
+
+// -----------------------------------------------------------------------------
+
+oops::Variables ObsComposite::precisionSensitiveVars() const {
+  oops::Variables vars;
+  for (const std::unique_ptr<ObsOperatorBase> &component : components_)
+    vars += component->precisionSensitiveVars();
+  return vars;
+}
+
+// -----------------------------------------------------------------------------
+
 void ObsComposite::print(std::ostream & os) const {
   os << "ObsComposite with the following components:\n";
   for (size_t i = 0; i < components_.size(); ++i) {
@@ -55,6 +55,11 @@ namespace ufo {
 ///
 /// \note Only some operators (currently VertInterp and Identity) currently support the `variables`
 /// option and thus can be used to simulate only a subset of variables.
+///
+/// Components whose isThreadSafe() method returns true are run concurrently, each on its own
+/// thread, while the remaining components are run one after another on the calling thread. Since
+/// components simulate disjoint sets of variables, each writes to its own rows of the ObsVector
+/// and the results do not depend on the order in which the components finish.
 class ObsComposite : public ObsOperatorBase,
                      private util::ObjectCounter<ObsComposite> {
  public:
@@ -69,6 +74,15 @@ class ObsComposite : public ObsOperatorBase,
 
   oops::Variables simulatedVars() const override;
 
+  /// Return true if all components are thread-safe.
+  bool isThreadSafe() const override;
+
+  /// Return true if all components can read GeoVaLs stored in single precision.
+  bool supportsSinglePrecisionGeoVaLs() const override;
+
+  /// Return the variables that any component needs in double precision.
+  oops::Variables precisionSensitiveVars() const override;
+
  private:
   void print(std::ostream &) const override;
 
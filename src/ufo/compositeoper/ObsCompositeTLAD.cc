@@ -7,8 +7,11 @@
 
 #include "ufo/compositeoper/ObsCompositeTLAD.h"
 
+#include <algorithm>
+#include <future>  // NOLINT(build/c++11)
 #include <ostream>
 #include <utility>
+#include <vector>
 
 #include "ioda/ObsSpace.h"
 #include "ioda/ObsVector.h"
@@ -56,8 +59,11 @@ void ObsCompositeTLAD::setTrajectory(const GeoVaLs & geovals, const ObsBias & bi
                                     ObsDiagnostics & ydiags) {
   oops::Log::trace() << "ObsCompositeTLAD: setTrajectory entered" << std::endl;
 
-  for (const std::unique_ptr<LinearObsOperatorBase> &component : components_)
+  for (const std::unique_ptr<LinearObsOperatorBase> &component : components_) {
+    // The mask covers all simulated variables of the ObsSpace, so it applies to each component.
+    component->setActiveObservations(activeObservations());
     component->setTrajectory(geovals, bias, ydiags);
+  }
 
   oops::Log::trace() << "ObsCompositeTLAD: setTrajectory exit " <<  std::endl;
 }
@@ -67,8 +73,23 @@ void ObsCompositeTLAD::setTrajectory(const GeoVaLs & geovals, const ObsBias & bi
 void ObsCompositeTLAD::simulateObsTL(const GeoVaLs & geovals, ioda::ObsVector & ovec) const {
   oops::Log::trace() << "ObsCompositeTLAD: simulateObsTL entered" << std::endl;
 
+  // Launch the thread-safe components first so that they overlap with the remaining ones.
+  std::vector<std::future<void>> concurrentRuns;
+  for (const std::unique_ptr<LinearObsOperatorBase> &component : components_) {
+    if (component->isThreadSafe()) {
+      concurrentRuns.push_back(std::async(std::launch::async,
+                                          [&component, &geovals, &ovec]
+                                          { component->simulateObsTL(geovals, ovec); }));
+    }
+  }
+
   for (const std::unique_ptr<LinearObsOperatorBase> &component : components_)
-    component->simulateObsTL(geovals, ovec);
+    if (!component->isThreadSafe())
+      component->simulateObsTL(geovals, ovec);
+
+  // get() rethrows any exception raised by a component.
+  for (std::future<void> &run : concurrentRuns)
+    run.get();
 
   oops::Log::trace() << "ObsCompositeTLAD: simulateObsTL exit " <<  std::endl;
 }
@@ -105,6 +126,14 @@ oops::Variables ObsCompositeTLAD::simulatedVars() const {
 
 // -----------------------------------------------------------------------------
 
+bool ObsCompositeTLAD::isThreadSafe() const {
+  return std::all_of(components_.begin(), components_.end(),
+                     [](const std::unique_ptr<LinearObsOperatorBase> &component)
+                     { return component->isThreadSafe(); });
+}
+
+// -----------------------------------------------------------------------------
+
 void ObsCompositeTLAD::print(std::ostream & os) const {
   os << "ObsComposite with the following components:\n";
   for (size_t i = 0; i < components_.size(); ++i) {
@@ -35,6 +35,11 @@ namespace ufo {
 
 // -----------------------------------------------------------------------------
 /// Composite TL/AD observation operator class
+///
+/// In simulateObsTL(), components whose isThreadSafe() method returns true are run concurrently,
+/// each on its own thread, while the remaining components are run on the calling thread.
+/// setTrajectory() and simulateObsAD() run the components one after another: the former may
+/// allocate ObsDiagnostics and the latter accumulates into GeoVaLs shared by several components.
 class ObsCompositeTLAD : public LinearObsOperatorBase,
                         private util::ObjectCounter<ObsCompositeTLAD> {
  public:
@@ -51,6 +56,9 @@ class ObsCompositeTLAD : public LinearObsOperatorBase,
 
   oops::Variables simulatedVars() const override;
 
+  /// Return true if all components are thread-safe.
+  bool isThreadSafe() const override;
+
  private:
   void print(std::ostream &) const override;
 
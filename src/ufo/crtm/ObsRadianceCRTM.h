@@ -46,6 +46,8 @@ class ObsRadianceCRTM : public ObsOperatorBase,
 
 // Other
   const oops::Variables & requiredVars() const override {return varin_;}
+  /// The CRTM atmosphere and surface are filled from double-precision copies of the GeoVaLs.
+  bool supportsSinglePrecisionGeoVaLs() const override {return true;}
 
   int & toFortran() {return keyOperRadianceCRTM_;}
   const int & toFortran() const {return keyOperRadianceCRTM_;}
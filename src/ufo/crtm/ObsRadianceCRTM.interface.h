@@ -32,6 +32,11 @@ extern "C" {
   void ufo_radiancecrtm_simobs_f90(const F90hop &, const F90goms &, const ioda::ObsSpace &,
                                const int &, const int &, double &, const F90goms &);
 // -----------------------------------------------------------------------------
+//  Coefficients shared by all CRTM operators
+// -----------------------------------------------------------------------------
+  /// Return the number of times coefficients have been loaded in this process.
+  int ufo_crtm_coefs_load_count_f90();
+// -----------------------------------------------------------------------------
 
 }  // extern C
 
@@ -55,6 +55,11 @@ void ObsRadianceCRTMTLAD::setTrajectory(const GeoVaLs & geovals, const ObsBias &
                                         ObsDiagnostics & ydiags) {
   ufo_radiancecrtm_tlad_settraj_f90(keyOperRadianceCRTM_, geovals.toFortran(), obsspace(),
                                     ydiags.toFortran());
+  if (!activeObservations().empty()) {
+    const int nvars = obsspace().obsvariables().size();
+    const int nlocs = obsspace().nlocs();
+    ufo_radiancecrtm_tlad_compact_f90(keyOperRadianceCRTM_, nvars, nlocs, activeObservations()[0]);
+  }
   oops::Log::trace() << "ObsRadianceCRTMTLAD::setTrajectory done" << std::endl;
 }
 
@@ -0,0 +1,89 @@
+/*
+ * (C) Crown copyright 2021, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#include "ufo/filters/ActiveObsIndex.h"
+
+#include <algorithm>
+
+#include "ioda/ObsDataVector.h"
+#include "ufo/filters/QCflags.h"
+
+namespace ufo {
+
+// -----------------------------------------------------------------------------
+
+ActiveObsIndex::ActiveObsIndex(const std::shared_ptr<const QCFlags_t> & flags)
+  : flags_(flags), active_(flags->nvars()), built_(flags->nvars(), false)
+{}
+
+// -----------------------------------------------------------------------------
+
+void ActiveObsIndex::refresh(size_t ivar) const {
+  ASSERT(ivar < active_.size());
+  const std::vector<int> & varFlags = (*flags_)[ivar];
+  std::vector<size_t> & active = active_[ivar];
+  if (built_[ivar]) {
+    active.erase(std::remove_if(active.begin(), active.end(),
+                                [&varFlags](size_t loc) {return varFlags[loc] != QCflags::pass;}),
+                 active.end());
+  } else {
+    active.clear();
+    for (size_t jobs = 0; jobs < varFlags.size(); ++jobs)
+      if (varFlags[jobs] == QCflags::pass)
+        active.push_back(jobs);
+    built_[ivar] = true;
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+const std::vector<size_t> & ActiveObsIndex::activeLocations(size_t ivar) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  refresh(ivar);
+  return active_[ivar];
+}
+
+// -----------------------------------------------------------------------------
+
+std::vector<size_t> ActiveObsIndex::activeLocations(size_t ivar,
+                                                    const std::vector<bool> & apply) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  refresh(ivar);
+  std::vector<size_t> result;
+  result.reserve(active_[ivar].size());
+  for (size_t loc : active_[ivar])
+    if (apply[loc])
+      result.push_back(loc);
+  return result;
+}
+
+// -----------------------------------------------------------------------------
+
+size_t ActiveObsIndex::numActive(size_t ivar) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  refresh(ivar);
+  return active_[ivar].size();
+}
+
+// -----------------------------------------------------------------------------
+
+void ActiveObsIndex::invalidate(size_t ivar) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  ASSERT(ivar < active_.size());
+  built_[ivar] = false;
+}
+
+// -----------------------------------------------------------------------------
+
+void ActiveObsIndex::invalidate() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  built_.assign(built_.size(), false);
+}
+
+// -----------------------------------------------------------------------------
+
+}  // namespace ufo
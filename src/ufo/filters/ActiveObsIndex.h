@@ -0,0 +1,105 @@
+/*
+ * (C) Crown copyright 2021, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef UFO_FILTERS_ACTIVEOBSINDEX_H_
+#define UFO_FILTERS_ACTIVEOBSINDEX_H_
+
+#include <cstddef>  // for size_t
+#include <memory>
+#include <mutex>  // NOLINT(build/c++11)
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+
+#include "oops/util/assert.h"
+
+namespace ioda {
+  template <typename DATATYPE> class ObsDataVector;
+}
+
+namespace ufo {
+
+/// \brief Lists of the locations at which each variable currently passes QC.
+///
+/// Most filters only need to visit the locations at which a filter variable has not been rejected
+/// yet. Once thinning or earlier checks have rejected most observations, looping over all
+/// locations and testing each QC flag wastes most of the filter's time. An ActiveObsIndex keeps,
+/// for each variable of a QC flags ObsDataVector, the sorted list of locations whose flag is
+/// QCflags::pass, so that filters can iterate over live observations only.
+///
+/// The index of a filter chain is owned by the chain's FilterChainState, next to the QC flags it
+/// describes. Code writing to the flags doesn't need to notify it:
+///
+/// * the list of a variable is built from the flags when it is first requested;
+/// * locations that stop passing QC are removed from the list the next time it is requested
+///   (only the entries of the list are inspected, not all locations);
+/// * ObsProcessorBase invalidates the lists of the variables a processor may modify once the
+///   processor has run, so that locations set back to QCflags::pass (e.g. by the `accept` action
+///   or by flags read back from Fortran) are picked up when the lists are next requested.
+///
+/// All member functions are thread-safe. The lists of different variables may be requested
+/// concurrently; the list of a variable must not be in use while another thread modifies the
+/// flags of that variable or invalidates its list.
+class ActiveObsIndex : private boost::noncopyable {
+ public:
+  typedef ioda::ObsDataVector<int> QCFlags_t;
+
+  explicit ActiveObsIndex(const std::shared_ptr<const QCFlags_t> & flags);
+
+  /// \brief Return the (increasing) locations at which variable \p ivar passes QC.
+  ///
+  /// The reference remains valid until the list of \p ivar is next requested or invalidated.
+  const std::vector<size_t> & activeLocations(size_t ivar) const;
+
+  /// Return the (increasing) locations at which \p apply is true and variable \p ivar passes QC.
+  std::vector<size_t> activeLocations(size_t ivar, const std::vector<bool> & apply) const;
+
+  /// Return the number of locations at which variable \p ivar passes QC.
+  size_t numActive(size_t ivar) const;
+
+  /// Discard the list of variable \p ivar; it will be rebuilt from the QC flags when next
+  /// requested.
+  void invalidate(size_t ivar);
+
+  /// Discard all lists.
+  void invalidate();
+
+ private:
+  /// Make sure the list of variable \p ivar exists and contains only passing locations.
+  /// Must be called with mutex_ locked.
+  void refresh(size_t ivar) const;
+
+  std::shared_ptr<const QCFlags_t> flags_;
+  mutable std::mutex mutex_;
+  mutable std::vector<std::vector<size_t>> active_;
+  mutable std::vector<bool> built_;
+};
+
+// -----------------------------------------------------------------------------
+
+/// Return the elements of \p values at the locations \p locs.
+template <typename T>
+std::vector<T> gather(const std::vector<T> & values, const std::vector<size_t> & locs) {
+  std::vector<T> result;
+  result.reserve(locs.size());
+  for (size_t loc : locs)
+    result.push_back(values[loc]);
+  return result;
+}
+
+/// Copy the elements of \p compact to the locations \p locs of \p values.
+template <typename T>
+void scatter(const std::vector<T> & compact, const std::vector<size_t> & locs,
+             std::vector<T> & values) {
+  ASSERT(compact.size() == locs.size());
+  for (size_t i = 0; i < locs.size(); ++i)
+    values[locs[i]] = compact[i];
+}
+
+}  // namespace ufo
+
+#endif  // UFO_FILTERS_ACTIVEOBSINDEX_H_
@@ -15,6 +15,8 @@
 #include <string>
 #include <vector>
 
+#include <boost/make_unique.hpp>
+
 #include "eckit/config/Configuration.h"
 
 #include "ioda/ObsDataVector.h"
@@ -24,18 +26,120 @@
 #include "oops/util/abor1_cpp.h"
 #include "oops/util/IntSetParser.h"
 #include "oops/util/Logger.h"
+#include "oops/util/missingValues.h"
 
 #include "ufo/filters/getScalarOrFilterData.h"
-#include "ufo/filters/QCflags.h"
 
 namespace ufo {
 
+namespace {
+
+// -----------------------------------------------------------------------------
+
+/// Flags locations at which the (optionally bias-corrected) observation value differs from H(x)
+/// by more than the threshold. Inputs are loaded once, on construction.
+class BackgroundLocationCheck : public LocationCheck {
+ public:
+  BackgroundLocationCheck(const ObsFilterData & data, const BackgroundCheckParameters & parameters,
+                          const Variables & filtervars, const ioda::ObsDataVector<float> & obserr)
+    : obserr_(obserr), useBiasCorrection_(parameters.BiasCorrectionFactor.value() != boost::none)
+  {
+    const size_t nvars = filtervars.nvars();
+    const Variables varobs(filtervars, "ObsValue");
+    const Variables varhofx(filtervars, parameters.test_hofx.value());
+    const Variables varbias(filtervars, "ObsBias");
+    buffers_.resize(3 * nvars);
+    for (size_t jv = 0; jv < nvars; ++jv) {
+      iv_.push_back(obserr.varnames().find(filtervars.variable(jv).variable()));
+      obs_.push_back(&data.getRef(varobs.variable(jv), buffers_[3 * jv]));
+      hofx_.push_back(&data.getRef(varhofx.variable(jv), buffers_[3 * jv + 1]));
+      if (useBiasCorrection_)
+        bias_.push_back(&data.getRef(varbias.variable(jv), buffers_[3 * jv + 2]));
+    }
+
+    if (parameters.functionAbsoluteThreshold.value()) {
+//    Get function absolute threshold
+      const Variable &rtvar = parameters.functionAbsoluteThreshold.value()->front();
+      functionAbsThreshold_.reset(new ioda::ObsDataVector<float>(data.obsspace(),
+                                                                 rtvar.toOopsVariables()));
+      data.get(rtvar, *functionAbsThreshold_);
+    } else {
+//    Threshold for all variables
+      const size_t nlocs = data.nlocs();
+      absThr_.assign(nlocs, std::numeric_limits<float>::max());
+      thr_.assign(nlocs, std::numeric_limits<float>::max());
+      bcFactor_.assign(nlocs, 0.0);
+      if (parameters.absoluteThreshold.value())
+        absThr_ = getScalarOrFilterData(*parameters.absoluteThreshold.value(), data);
+      if (parameters.threshold.value())
+        thr_ = getScalarOrFilterData(*parameters.threshold.value(), data);
+//    Bias Correction parameter
+      if (useBiasCorrection_)
+        bcFactor_ = getScalarOrFilterData(*parameters.BiasCorrectionFactor.value(), data);
+    }
+  }
+
+  void check(size_t jv, const std::vector<size_t> & locs,
+             std::vector<size_t> & failed) const override {
+    const std::vector<float> & obserr = obserr_[iv_[jv]];
+    const std::vector<float> & obs = *obs_[jv];
+    const std::vector<float> & hofx = *hofx_[jv];
+    if (functionAbsThreshold_) {
+      const std::vector<float> & threshold = (*functionAbsThreshold_)[jv];
+      for (size_t jobs : locs) {
+        ASSERT(obserr[jobs] != util::missingValue(obserr[jobs]));
+        ASSERT(obs[jobs] != util::missingValue(obs[jobs]));
+        ASSERT(hofx[jobs] != util::missingValue(hofx[jobs]));
+//      Check distance from background
+        if (std::abs(hofx[jobs] - obs[jobs]) > threshold[jobs])
+          failed.push_back(jobs);
+      }
+    } else {
+      for (size_t jobs : locs) {
+        ASSERT(obserr[jobs] != util::missingValue(obserr[jobs]));
+        ASSERT(obs[jobs] != util::missingValue(obs[jobs]));
+        float bias = 0.0;
+        if (useBiasCorrection_) {
+          const std::vector<float> & obsbias = *bias_[jv];
+          ASSERT(obsbias[jobs] != util::missingValue(obsbias[jobs]));
+          bias = bcFactor_[jobs] * obsbias[jobs];
+        }
+        ASSERT(hofx[jobs] != util::missingValue(hofx[jobs]));
+
+//      Threshold for current observation
+        const float zz = (thr_[jobs] == std::numeric_limits<float>::max()) ? absThr_[jobs] :
+          std::min(absThr_[jobs], thr_[jobs] * obserr[jobs]);
+        ASSERT(zz < std::numeric_limits<float>::max() && zz > 0.0);
+
+//      Check distance from background
+        if (std::abs(hofx[jobs] - obs[jobs] - bias) > zz)
+          failed.push_back(jobs);
+      }
+    }
+  }
+
+ private:
+  const ioda::ObsDataVector<float> & obserr_;
+  bool useBiasCorrection_;
+  std::vector<size_t> iv_;
+  std::vector<std::vector<float>> buffers_;
+  std::vector<const std::vector<float> *> obs_;
+  std::vector<const std::vector<float> *> hofx_;
+  std::vector<const std::vector<float> *> bias_;
+  std::unique_ptr<ioda::ObsDataVector<float>> functionAbsThreshold_;
+  std::vector<float> absThr_;
+  std::vector<float> thr_;
+  std::vector<float> bcFactor_;
+};
+
+}  // namespace
+
 // -----------------------------------------------------------------------------
 
 BackgroundCheck::BackgroundCheck(ioda::ObsSpace & obsdb, const Parameters_ & parameters,
                                  std::shared_ptr<ioda::ObsDataVector<int> > flags,
                                  std::shared_ptr<ioda::ObsDataVector<float> > obserr)
-  : FilterBase(obsdb, parameters, flags, obserr), parameters_(parameters)
+  : LocationCheckFilter(obsdb, parameters, flags, obserr), parameters_(parameters)
 {
   oops::Log::trace() << "BackgroundCheck constructor" << std::endl;
 
@@ -47,6 +151,9 @@ BackgroundCheck::BackgroundCheck(ioda::ObsSpace & obsdb, const Parameters_ & par
       allvars_ += var;
   }
   allvars_ += Variables(filtervars_, test_hofx);
+  allvars_ += Variables(filtervars_, "ObsValue");
+  if (parameters_.BiasCorrectionFactor.value())
+    allvars_ += Variables(filtervars_, "ObsBias");
   ASSERT(parameters_.threshold.value() ||
          parameters_.absoluteThreshold.value() ||
          parameters_.functionAbsoluteThreshold.value());
@@ -65,92 +172,10 @@ BackgroundCheck::~BackgroundCheck() {
 
 // -----------------------------------------------------------------------------
 
-void BackgroundCheck::applyFilter(const std::vector<bool> & apply,
-                                  const Variables & filtervars,
-                                  std::vector<std::vector<bool>> & flagged) const {
-  oops::Log::trace() << "BackgroundCheck postFilter" << std::endl;
-  const oops::Variables observed = obsdb_.obsvariables();
-  const float missing = util::missingValue(missing);
+std::unique_ptr<LocationCheck> BackgroundCheck::locationCheck(const ObsFilterData & data) const {
+  oops::Log::trace() << "BackgroundCheck locationCheck" << std::endl;
   oops::Log::debug() << "BackgroundCheck obserr: " << *obserr_;
-
-  ioda::ObsDataVector<float> obs(obsdb_, filtervars.toOopsVariables(), "ObsValue");
-  ioda::ObsDataVector<float> obsbias(obsdb_, filtervars.toOopsVariables(), "ObsBias", false);
-  std::string test_hofx = parameters_.test_hofx.value();
-
-// Get function absolute threshold
-
-  if (parameters_.functionAbsoluteThreshold.value()) {
-//  Get function absolute threshold info from configuration
-    const Variable &rtvar = parameters_.functionAbsoluteThreshold.value()->front();
-    ioda::ObsDataVector<float> function_abs_threshold(obsdb_, rtvar.toOopsVariables());
-    data_.get(rtvar, function_abs_threshold);
-
-    Variables varhofx(filtervars_, test_hofx);
-    for (size_t jv = 0; jv < filtervars.nvars(); ++jv) {
-      size_t iv = observed.find(filtervars.variable(jv).variable());
-//    H(x)
-      std::vector<float> hofx;
-      data_.get(varhofx.variable(jv), hofx);
-      for (size_t jobs = 0; jobs < obsdb_.nlocs(); ++jobs) {
-        if (apply[jobs] && (*flags_)[iv][jobs] == QCflags::pass) {
-          ASSERT((*obserr_)[iv][jobs] != util::missingValue((*obserr_)[iv][jobs]));
-          ASSERT(obs[jv][jobs] != util::missingValue(obs[jv][jobs]));
-          ASSERT(hofx[jobs] != util::missingValue(hofx[jobs]));
-
-//        Threshold for current observation
-          float zz = function_abs_threshold[jv][jobs];
-//        Check distance from background
-          if (std::abs(static_cast<float>(hofx[jobs]) - obs[jv][jobs]) > zz) {
-            flagged[jv][jobs] = true;
-          }
-        }
-      }
-    }
-  } else {
-    Variables varhofx(filtervars_, test_hofx);
-    for (size_t jv = 0; jv < filtervars.nvars(); ++jv) {
-      size_t iv = observed.find(filtervars.variable(jv).variable());
-//    H(x)
-      std::vector<float> hofx;
-      data_.get(varhofx.variable(jv), hofx);
-
-//    Threshold for current variable
-      std::vector<float> abs_thr(obsdb_.nlocs(), std::numeric_limits<float>::max());
-      std::vector<float> thr(obsdb_.nlocs(), std::numeric_limits<float>::max());
-      std::vector<float> bc_factor(obsdb_.nlocs(), 0.0);
-
-      if (parameters_.absoluteThreshold.value())
-        abs_thr = getScalarOrFilterData(*parameters_.absoluteThreshold.value(), data_);
-      if (parameters_.threshold.value())
-        thr = getScalarOrFilterData(*parameters_.threshold.value(), data_);
-
-//    Bias Correction parameter
-      if (parameters_.BiasCorrectionFactor.value())
-        bc_factor = getScalarOrFilterData(*parameters_.BiasCorrectionFactor.value(), data_);
-
-      for (size_t jobs = 0; jobs < obsdb_.nlocs(); ++jobs) {
-        if (apply[jobs] && (*flags_)[iv][jobs] == QCflags::pass) {
-          ASSERT((*obserr_)[iv][jobs] != util::missingValue((*obserr_)[iv][jobs]));
-          ASSERT(obs[jv][jobs] != util::missingValue(obs[jv][jobs]));
-          if (parameters_.BiasCorrectionFactor.value()) {
-            ASSERT(obsbias[jv][jobs] != util::missingValue(obsbias[jv][jobs]));
-            bc_factor[jobs] = bc_factor[jobs]*obsbias[jv][jobs];
-          }
-          ASSERT(hofx[jobs] != util::missingValue(hofx[jobs]));
-
-//        Threshold for current observation
-          float zz = (thr[jobs] == std::numeric_limits<float>::max()) ? abs_thr[jobs] :
-            std::min(abs_thr[jobs], thr[jobs] * (*obserr_)[iv][jobs]);
-          ASSERT(zz < std::numeric_limits<float>::max() && zz > 0.0);
-
-//        Check distance from background
-          if (std::abs(static_cast<float>(hofx[jobs]) - obs[jv][jobs] - bc_factor[jobs]) > zz) {
-            flagged[jv][jobs] = true;
-          }
-        }
-      }
-    }
-  }
+  return boost::make_unique<BackgroundLocationCheck>(data, parameters_, filtervars_, *obserr_);
 }
 
 // -----------------------------------------------------------------------------
@@ -16,7 +16,7 @@
 #include "oops/util/ObjectCounter.h"
 #include "oops/util/parameters/OptionalParameter.h"
 #include "oops/util/Printable.h"
-#include "ufo/filters/FilterBase.h"
+#include "ufo/filters/LocationCheckFilter.h"
 #include "ufo/filters/QCflags.h"
 #include "ufo/filters/Variable.h"
 #include "ufo/utils/parameters/ParameterTraitsVariable.h"
@@ -71,7 +71,7 @@ class BackgroundCheckParameters : public FilterParametersBase {
 /// BackgroundCheck: check observation closeness to background.
 ///
 /// See BackgroundCheckParameters for the documentation of the parameters controlling this filter.
-class BackgroundCheck : public FilterBase,
+class BackgroundCheck : public LocationCheckFilter,
                         private util::ObjectCounter<BackgroundCheck> {
  public:
   /// The type of parameters accepted by the constructor of this filter.
@@ -85,10 +85,14 @@ class BackgroundCheck : public FilterBase,
                   std::shared_ptr<ioda::ObsDataVector<float> >);
   ~BackgroundCheck();
 
+  bool isThreadSafe() const override {return true;}
+
+  std::unique_ptr<LocationCheck> locationCheck(const ObsFilterData &) const override;
+
  private:
   void print(std::ostream &) const override;
-  void applyFilter(const std::vector<bool> &, const Variables &,
-                   std::vector<std::vector<bool>> &) const override;
+  /// Observations already rejected may lack a valid obs error or H(x).
+  bool checksPassingObsOnly() const override {return true;}
   int qcFlag() const override {return QCflags::fguess;}
 
   Parameters_ parameters_;
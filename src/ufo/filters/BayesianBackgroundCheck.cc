@@ -133,8 +133,6 @@ void BayesianBackgroundCheck::applyFilter(const std::vector<bool> & apply,
       // QC flags:
       std::vector<int> qcflags1(obsdb_.nlocs());
       std::vector<float> firstComponentObVal, secondComponentObVal;
-      // make note of conditions on apply and flags_:
-      std::vector<bool> applycondition(obsdb_.nlocs(), false);
       // index mapping between full and reduced vectors:
       std::vector<size_t> j_reduced;
 
@@ -154,12 +152,9 @@ void BayesianBackgroundCheck::applyFilter(const std::vector<bool> & apply,
           data_.get(varflags.variable(filterVarIndex-1), qcflags1);
           oops::Log::debug() << "Got qcflags1 from file: " << qcflags1 << std::endl;
         }
-        for (size_t jobs=0; jobs < obsdb_.nlocs(); ++jobs) {
-          if (apply[jobs] && (*flags_)[iv1][jobs] == QCflags::pass
-                          && (*flags_)[iv2][jobs] == QCflags::pass) {
-            applycondition[jobs] = true;
+        for (size_t jobs : activeObs_->activeLocations(iv1, apply)) {
+          if ((*flags_)[iv2][jobs] == QCflags::pass)
             j_reduced.push_back(jobs);
-          }
         }
       } else {
         varname1 = filtervars.variable(filterVarIndex).variable();
@@ -173,15 +168,10 @@ void BayesianBackgroundCheck::applyFilter(const std::vector<bool> & apply,
           data_.get(varflags.variable(filterVarIndex), qcflags1);
           oops::Log::debug() << "Got qcflags1 from file: " << qcflags1 << std::endl;
         }
-        for (size_t jobs=0; jobs < obsdb_.nlocs(); ++jobs) {
-          if (apply[jobs] && (*flags_)[iv1][jobs] == QCflags::pass) {
-            applycondition[jobs] = true;
-            j_reduced.push_back(jobs);
-          }
-        }
+        j_reduced = activeObs_->activeLocations(iv1, apply);
       }
 
-      // create reduced vectors, copied from full ones, fulfilling applycondition:
+      // create reduced vectors, copied from full ones, at the locations j_reduced:
       std::vector<float> firstComponentObVal_reduced = reduceVector(firstComponentObVal,
                                                                     j_reduced);
       std::vector<float> ObsErr_reduced = reduceVector((*obserr_)[iv1], j_reduced);
@@ -54,6 +54,8 @@ class BlackList : public FilterBase,
             std::shared_ptr<ioda::ObsDataVector<float> >);
   ~BlackList();
 
+  bool isThreadSafe() const override {return true;}
+
  private:
   void print(std::ostream &) const override;
   void applyFilter(const std::vector<bool> &, const Variables &,
@@ -0,0 +1,178 @@
+/*
+ * (C) Crown copyright 2021, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#include "ufo/filters/ConcurrentFilters.h"
+
+#include <algorithm>
+#include <future>  // NOLINT(build/c++11)
+#include <memory>
+#include <utility>
+
+#include "ioda/ObsDataVector.h"
+#include "ioda/ObsSpace.h"
+#include "ioda/ObsVector.h"
+
+#include "oops/util/Logger.h"
+
+#include "ufo/GeoVaLs.h"
+#include "ufo/ObsDiagnostics.h"
+
+namespace ufo {
+
+// -----------------------------------------------------------------------------
+
+ConcurrentFilters::ConcurrentFilters(ioda::ObsSpace & obsdb, const Parameters_ & parameters,
+                                     std::shared_ptr<ioda::ObsDataVector<int> > flags,
+                                     std::shared_ptr<ioda::ObsDataVector<float> > obserr)
+  : runConcurrently_(parameters.runConcurrently), chain_(FilterChainState::find(*flags))
+{
+  oops::Log::trace() << "ConcurrentFilters constructor starting" << std::endl;
+
+  // Filters running concurrently read the ObsSpace through the column store of their chain.
+  if (!chain_) runConcurrently_ = false;
+
+  for (const eckit::LocalConfiguration & filterConf : parameters.filters.value()) {
+    std::unique_ptr<ObsProcessorBase> member =
+        ObsProcessorFactory::create(obsdb, filterConf, flags, obserr);
+    names_.push_back(filterConf.getString("filter"));
+    concurrent_.push_back(member->mayRunConcurrently());
+    const oops::Variables modified = member->modifiedVars();
+    const oops::Variables inspected = member->inspectedVars();
+    modifiedVars_.emplace_back(modified.variables().begin(), modified.variables().end());
+    inspectedVars_.emplace_back(inspected.variables().begin(), inspected.variables().end());
+    geovars_ += member->requiredVars();
+    diagvars_ += member->requiredHdiagnostics();
+    members_.push_back(std::move(member));
+  }
+
+  // The stage at which each member is applied is known only once all members have been
+  // constructed, so the groups are formed here rather than in the loop above.
+  for (Stage stage : {Stage::PRE, Stage::PRIOR, Stage::POST}) {
+    std::vector<std::vector<size_t>> & groups = schedules_[stage];
+    std::vector<size_t> groupOf(members_.size(), 0);
+    for (size_t i = 0; i < members_.size(); ++i) {
+      if (members_[i]->stage() != stage) continue;
+      size_t group = 0;
+      for (size_t j = 0; j < i; ++j)
+        if (members_[j]->stage() == stage && conflict(j, i))
+          group = std::max(group, groupOf[j] + 1);
+      groupOf[i] = group;
+      if (groups.size() <= group) groups.resize(group + 1);
+      groups[group].push_back(i);
+    }
+  }
+
+  oops::Log::debug() << *this << std::endl;
+  oops::Log::trace() << "ConcurrentFilters constructor done" << std::endl;
+}
+
+// -----------------------------------------------------------------------------
+
+ConcurrentFilters::~ConcurrentFilters() {
+  oops::Log::trace() << "ConcurrentFilters destructed" << std::endl;
+}
+
+// -----------------------------------------------------------------------------
+
+bool ConcurrentFilters::conflict(size_t i, size_t j) const {
+  if (!runConcurrently_ || !concurrent_[i] || !concurrent_[j])
+    return true;
+  auto intersect = [](const std::set<std::string> & a, const std::set<std::string> & b) {
+    return std::any_of(a.begin(), a.end(),
+                       [&b](const std::string & var) {return b.count(var) != 0;});
+  };
+  return intersect(modifiedVars_[i], inspectedVars_[j]) ||
+         intersect(modifiedVars_[j], inspectedVars_[i]);
+}
+
+// -----------------------------------------------------------------------------
+
+const std::vector<std::vector<size_t>> & ConcurrentFilters::schedule(Stage stage) const {
+  return schedules_.at(stage);
+}
+
+// -----------------------------------------------------------------------------
+
+template <typename Process>
+void ConcurrentFilters::run(Stage stage, const Process & process) {
+  for (const std::unique_ptr<ObsProcessorBase> & member : members_)
+    if (member->stage() != stage)
+      process(*member);
+
+  for (const std::vector<size_t> & group : schedules_.at(stage)) {
+    // The members of a group mustn't read the ObsSpace while running concurrently, so all the
+    // ObsSpace data they use are read now and reading any other data from the ObsSpace fails.
+    std::unique_ptr<ObsColumnStore::ConcurrentAccess> concurrentAccess;
+    if (group.size() > 1) {
+      for (size_t i : group)
+        chain_->columns().require(members_[i]->requiredVariables());
+      concurrentAccess.reset(new ObsColumnStore::ConcurrentAccess(chain_->columns()));
+    }
+    // Declared after concurrentAccess, so that the destructors of the futures (which wait for
+    // the concurrent runs to finish) are called first.
+    std::vector<std::future<void>> concurrentRuns;
+    for (size_t k = 1; k < group.size(); ++k) {
+      ObsProcessorBase & member = *members_[group[k]];
+      concurrentRuns.push_back(std::async(std::launch::async,
+                                          [&process, &member] { process(member); }));
+    }
+    process(*members_[group.front()]);
+    // get() rethrows any exception raised by a member.
+    for (std::future<void> & concurrentRun : concurrentRuns)
+      concurrentRun.get();
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+void ConcurrentFilters::preProcess() {
+  oops::Log::trace() << "ConcurrentFilters preProcess begin" << std::endl;
+  // Declare the ObsSpace data used by all members before applying any of them, so that these
+  // data are read together.
+  if (chain_)
+    for (const std::unique_ptr<ObsProcessorBase> & member : members_)
+      chain_->columns().require(member->requiredVariables());
+  run(Stage::PRE, [](ObsProcessorBase & member) { member.preProcess(); });
+  oops::Log::trace() << "ConcurrentFilters preProcess end" << std::endl;
+}
+
+// -----------------------------------------------------------------------------
+
+void ConcurrentFilters::priorFilter(const GeoVaLs & gv) {
+  oops::Log::trace() << "ConcurrentFilters priorFilter begin" << std::endl;
+  run(Stage::PRIOR, [&gv](ObsProcessorBase & member) { member.priorFilter(gv); });
+  oops::Log::trace() << "ConcurrentFilters priorFilter end" << std::endl;
+}
+
+// -----------------------------------------------------------------------------
+
+void ConcurrentFilters::postFilter(const ioda::ObsVector & hofx, const ObsDiagnostics & diags) {
+  oops::Log::trace() << "ConcurrentFilters postFilter begin" << std::endl;
+  run(Stage::POST, [&hofx, &diags](ObsProcessorBase & member) {
+      member.postFilter(hofx, diags);
+    });
+  oops::Log::trace() << "ConcurrentFilters postFilter end" << std::endl;
+}
+
+// -----------------------------------------------------------------------------
+
+void ConcurrentFilters::print(std::ostream & os) const {
+  const std::map<Stage, std::string> stageNames{
+    {Stage::PRE, "pre"}, {Stage::PRIOR, "prior"}, {Stage::POST, "post"}};
+  os << "ConcurrentFilters with " << members_.size() << " filters";
+  for (const auto & stageAndGroups : schedules_) {
+    for (const std::vector<size_t> & group : stageAndGroups.second) {
+      os << "\n  " << stageNames.at(stageAndGroups.first) << ":";
+      for (size_t i : group)
+        os << " [" << i << "] " << names_[i] << (i == group.back() ? "" : " |");
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+}  // namespace ufo
@@ -0,0 +1,142 @@
+/*
+ * (C) Crown copyright 2021, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef UFO_FILTERS_CONCURRENTFILTERS_H_
+#define UFO_FILTERS_CONCURRENTFILTERS_H_
+
+#include <map>
+#include <memory>
+#include <ostream>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "eckit/config/LocalConfiguration.h"
+#include "oops/base/ObsFilterParametersBase.h"
+#include "oops/base/Variables.h"
+#include "oops/util/ObjectCounter.h"
+#include "oops/util/parameters/Parameter.h"
+#include "oops/util/parameters/RequiredParameter.h"
+#include "oops/util/Printable.h"
+#include "ufo/filters/FilterChainState.h"
+#include "ufo/filters/ObsProcessorBase.h"
+
+namespace ioda {
+  template <typename DATATYPE> class ObsDataVector;
+  class ObsSpace;
+  class ObsVector;
+}
+
+namespace ufo {
+  class GeoVaLs;
+  class ObsDiagnostics;
+
+/// Options controlling the ConcurrentFilters processor.
+class ConcurrentFiltersParameters : public oops::ObsFilterParametersBase {
+  OOPS_CONCRETE_PARAMETERS(ConcurrentFiltersParameters, ObsFilterParametersBase)
+
+ public:
+  /// Configurations of the filters to apply, listed in the order in which they would be applied
+  /// if they were listed directly in the `obs filters` section.
+  oops::RequiredParameter<std::vector<eckit::LocalConfiguration>> filters{"filters", this};
+
+  /// If set to false, the filters are applied one by one in the order in which they are listed.
+  oops::Parameter<bool> runConcurrently{"run concurrently", true, this};
+};
+
+/// \brief Applies a list of filters, running independent filters concurrently.
+///
+/// The results are the same as if the filters were listed directly in the `obs filters` section,
+/// but filters that neither read nor write each other's outputs run on separate threads. Example:
+///
+/// \code{.yaml}
+///   obs filters:
+///   - filter: Concurrent Filters
+///     filters:
+///     - filter: Bounds Check
+///       filter variables:
+///       - name: brightness_temperature
+///         channels: 1-5
+///       minvalue: 100
+///       maxvalue: 400
+///     - filter: Domain Check
+///       filter variables:
+///       - name: air_temperature
+///       where:
+///       - variable:
+///           name: air_pressure@MetaData
+///         minvalue: 10000
+/// \endcode
+///
+/// Each member filter is applied at the same stage (pre, prior or post) as it would be on its own.
+/// At each stage, the member filters applied at that stage are partitioned into a sequence of
+/// groups: a filter joins the group following the last group containing an earlier filter it
+/// conflicts with. Two filters conflict if either may not run concurrently with other filters
+/// (see ObsProcessorBase::mayRunConcurrently(); filters using ObsFunctions never may) or if
+/// one of them modifies the QC flags or obs errors of a variable inspected by the other. Groups
+/// are then applied one after another and the filters in each group concurrently, so conflicting
+/// filters are always applied in their original order. Filters run concurrently only in a filter
+/// chain started by a QCmanager, since they must read the ObsSpace through the chain's
+/// ObsColumnStore.
+///
+/// Members are created by the ObsProcessorFactory, so QCmanager, PreQC and other processors
+/// not derived from ObsProcessorBase can't be used.
+class ConcurrentFilters : public util::Printable,
+                          private util::ObjectCounter<ConcurrentFilters> {
+ public:
+  /// The type of parameters accepted by the constructor of this filter.
+  /// This typedef is used by the FilterFactory.
+  typedef ConcurrentFiltersParameters Parameters_;
+  typedef ObsProcessorBase::Stage Stage;
+
+  static const std::string classname() {return "ufo::ConcurrentFilters";}
+
+  ConcurrentFilters(ioda::ObsSpace &, const Parameters_ &,
+                    std::shared_ptr<ioda::ObsDataVector<int> >,
+                    std::shared_ptr<ioda::ObsDataVector<float> >);
+  ~ConcurrentFilters();
+
+  void preProcess();
+  void priorFilter(const GeoVaLs &);
+  void postFilter(const ioda::ObsVector &, const ObsDiagnostics &);
+
+  const oops::Variables & requiredVars() const {return geovars_;}
+  const oops::Variables & requiredHdiagnostics() const {return diagvars_;}
+
+  /// \brief Return the groups of member filters applied at stage \p stage.
+  ///
+  /// Groups are applied in the order in which they are returned. Members are identified by
+  /// their positions in the `filters` list.
+  const std::vector<std::vector<size_t>> & schedule(Stage stage) const;
+
+ private:
+  void print(std::ostream &) const override;
+
+  /// Return true if the members \p i and \p j mustn't run concurrently.
+  bool conflict(size_t i, size_t j) const;
+
+  /// Pass all members not applied at stage \p stage to \p process, one by one, and then all
+  /// members applied at that stage, following their schedule.
+  template <typename Process>
+  void run(Stage stage, const Process & process);
+
+  std::vector<std::unique_ptr<ObsProcessorBase>> members_;
+  std::vector<std::string> names_;
+  std::vector<bool> concurrent_;
+  std::vector<std::set<std::string>> modifiedVars_;
+  std::vector<std::set<std::string>> inspectedVars_;
+  std::map<Stage, std::vector<std::vector<size_t>>> schedules_;
+  bool runConcurrently_;
+  oops::Variables geovars_;
+  oops::Variables diagvars_;
+  /// State of the filter chain the members belong to; null if there is no QCmanager.
+  std::shared_ptr<FilterChainState> chain_;
+};
+
+}  // namespace ufo
+
+#endif  // UFO_FILTERS_CONCURRENTFILTERS_H_
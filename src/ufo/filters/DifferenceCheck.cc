@@ -10,21 +10,66 @@
 #include <cmath>
 #include <vector>
 
+#include <boost/make_unique.hpp>
+
 #include "eckit/config/Configuration.h"
 
 #include "ioda/ObsDataVector.h"
 #include "ioda/ObsSpace.h"
 
 #include "oops/util/Logger.h"
+#include "oops/util/missingValues.h"
 
 namespace ufo {
 
+namespace {
+
+// -----------------------------------------------------------------------------
+
+/// Flags locations at which the test or reference value is missing or their difference lies
+/// outside [vmin, vmax]. The result is the same for all filter variables.
+class DifferenceLocationCheck : public LocationCheck {
+ public:
+  DifferenceLocationCheck(const ObsFilterData & data, const DifferenceCheckParameters & parameters,
+                          float vmin, float vmax)
+    : ref_(data.getRef(parameters.ref, refBuffer_)), val_(data.getRef(parameters.val, valBuffer_)),
+      vmin_(vmin), vmax_(vmax)
+  {
+    ASSERT(ref_.size() == val_.size());
+  }
+
+  void check(size_t, const std::vector<size_t> & locs,
+             std::vector<size_t> & failed) const override {
+    const float missing = util::missingValue(missing);
+    for (size_t jobs : locs) {
+      // check to see if one of the reference or value is missing
+      if (val_[jobs] == missing || ref_[jobs] == missing) {
+        failed.push_back(jobs);
+      } else {
+        // Check if difference is within min/max value range
+        const float diff = val_[jobs] - ref_[jobs];
+        if ((vmin_ != missing && diff < vmin_) || (vmax_ != missing && diff > vmax_))
+          failed.push_back(jobs);
+      }
+    }
+  }
+
+ private:
+  std::vector<float> refBuffer_, valBuffer_;
+  const std::vector<float> & ref_;
+  const std::vector<float> & val_;
+  float vmin_;
+  float vmax_;
+};
+
+}  // namespace
+
 // -----------------------------------------------------------------------------
 
 DifferenceCheck::DifferenceCheck(ioda::ObsSpace & obsdb, const Parameters_ & parameters,
                                  std::shared_ptr<ioda::ObsDataVector<int> > flags,
                                  std::shared_ptr<ioda::ObsDataVector<float> > obserr)
-  : FilterBase(obsdb, parameters, flags, obserr),
+  : LocationCheckFilter(obsdb, parameters, flags, obserr),
     parameters_(parameters)
 {
   oops::Log::trace() << "DifferenceCheck contructor starting" << std::endl;
@@ -40,13 +85,10 @@ DifferenceCheck::~DifferenceCheck() {
 
 // -----------------------------------------------------------------------------
 
-void DifferenceCheck::applyFilter(const std::vector<bool> & apply,
-                                  const Variables & filtervars,
-                                  std::vector<std::vector<bool>> & flagged) const {
-  oops::Log::trace() << "DifferenceCheck priorFilter" << std::endl;
+std::unique_ptr<LocationCheck> DifferenceCheck::locationCheck(const ObsFilterData & data) const {
+  oops::Log::trace() << "DifferenceCheck locationCheck" << std::endl;
 
   const float missing = util::missingValue(missing);
-  const size_t nlocs = obsdb_.nlocs();
 
 // min/max value setup
   float vmin = parameters_.minvalue.value().value_or(missing);
@@ -59,30 +101,7 @@ void DifferenceCheck::applyFilter(const std::vector<bool> & apply,
     vmax = thresh;
   }
 
-// Get reference values and values to compare (as floats)
-  std::vector<float> ref, val;
-  data_.get(parameters_.ref, ref);
-  data_.get(parameters_.val, val);
-  ASSERT(ref.size() == val.size());
-
-// Loop over all obs
-  for (size_t jobs = 0; jobs < nlocs; ++jobs) {
-    if (apply[jobs]) {
-      // check to see if one of the reference or value is missing
-      if (val[jobs] == missing || ref[jobs] == missing) {
-        for (size_t jv = 0; jv < filtervars.nvars(); ++jv) {
-          flagged[jv][jobs] = true;
-        }
-      } else {
-// Check if difference is within min/max value range and set flag
-        float diff = val[jobs] - ref[jobs];
-        for (size_t jv = 0; jv < filtervars.nvars(); ++jv) {
-          if (vmin != missing && diff < vmin) flagged[jv][jobs] = true;
-          if (vmax != missing && diff > vmax) flagged[jv][jobs] = true;
-        }
-      }
-    }
-  }
+  return boost::make_unique<DifferenceLocationCheck>(data, parameters_, vmin, vmax);
 }
 
 // -----------------------------------------------------------------------------
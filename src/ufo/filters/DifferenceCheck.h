@@ -16,7 +16,7 @@
 #include "oops/util/ObjectCounter.h"
 #include "oops/util/parameters/OptionalParameter.h"
 #include "oops/util/parameters/RequiredParameter.h"
-#include "ufo/filters/FilterBase.h"
+#include "ufo/filters/LocationCheckFilter.h"
 #include "ufo/filters/QCflags.h"
 #include "ufo/filters/Variable.h"
 #include "ufo/utils/parameters/ParameterTraitsVariable.h"
@@ -59,7 +59,7 @@ class DifferenceCheckParameters : public FilterParametersBase {
 /// flags observations for which this difference is outside of a prescribed range.
 ///
 /// See DifferenceCheckParameters for the documentation of the parameters controlling this filter.
-class DifferenceCheck : public FilterBase,
+class DifferenceCheck : public LocationCheckFilter,
                         private util::ObjectCounter<DifferenceCheck> {
  public:
   /// The type of parameters accepted by the constructor of this filter.
@@ -73,10 +73,12 @@ class DifferenceCheck : public FilterBase,
                   std::shared_ptr<ioda::ObsDataVector<float> >);
   ~DifferenceCheck();
 
+  bool isThreadSafe() const override {return true;}
+
+  std::unique_ptr<LocationCheck> locationCheck(const ObsFilterData &) const override;
+
  private:
   void print(std::ostream &) const override;
-  void applyFilter(const std::vector<bool> &, const Variables &,
-                   std::vector<std::vector<bool>> &) const override;
   int qcFlag() const override {return QCflags::diffref;}
 
   Parameters_ parameters_;
@@ -7,6 +7,7 @@
 
 #include "ufo/filters/FilterBase.h"
 
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -24,6 +25,7 @@
 #include "ufo/filters/processWhere.h"
 #include "ufo/GeoVaLs.h"
 #include "ufo/ObsDiagnostics.h"
+#include "ufo/utils/PerformanceMonitor.h"
 
 namespace ufo {
 
@@ -37,7 +39,8 @@ FilterBase::FilterBase(ioda::ObsSpace & os,
     config_(parameters.toConfiguration()),
     filtervars_(),
     whereParameters_(parameters.where),
-    actionParameters_(parameters.action().clone())
+    actionParameters_(parameters.action().clone()),
+    monitorPrefix_(os.obsname() + "/" + config_.getString("filter", "Filter") + "/")
 {
   oops::Log::trace() << "FilterBase constructor" << std::endl;
   allvars_ += getAllWhereVariables(parameters.where);
@@ -77,20 +80,32 @@ FilterBase::~FilterBase() {
 void FilterBase::doFilter() const {
   oops::Log::trace() << "FilterBase doFilter begin" << std::endl;
 
+  const size_t nlocs = obsdb_.nlocs();
+
 // Select locations to which the filter will be applied
-  std::vector<bool> apply = processWhere(whereParameters_, data_);
+  std::vector<bool> apply;
+  {
+    ScopedPerformanceMonitor monitor(monitorPrefix_, "processWhere", nlocs);
+    apply = processWhere(whereParameters_, data_);
+  }
 
 // Allocate flagged obs indicator (false by default)
   const size_t nvars = filtervars_.nvars();
   std::vector<std::vector<bool>> flagged(nvars);
-  for (size_t jv = 0; jv < flagged.size(); ++jv) flagged[jv].resize(obsdb_.nlocs());
+  for (size_t jv = 0; jv < flagged.size(); ++jv) flagged[jv].resize(nlocs);
 
 // Apply filter
-  this->applyFilter(apply, filtervars_, flagged);
+  {
+    ScopedPerformanceMonitor monitor(monitorPrefix_, "applyFilter", nlocs);
+    this->applyFilter(apply, filtervars_, flagged);
+  }
 
 // Take action
-  FilterAction action(*actionParameters_);
-  action.apply(filtervars_, flagged, data_, this->qcFlag(), *flags_, *obserr_);
+  {
+    ScopedPerformanceMonitor monitor(monitorPrefix_, "action", nlocs);
+    FilterAction action(*actionParameters_);
+    action.apply(filtervars_, flagged, data_, this->qcFlag(), *flags_, *obserr_);
+  }
 
 // Done
   oops::Log::trace() << "FilterBase doFilter end" << std::endl;
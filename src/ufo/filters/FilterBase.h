@@ -52,22 +52,30 @@ class FilterBase : public ObsProcessorBase {
              std::shared_ptr<ioda::ObsDataVector<float> >);
   ~FilterBase();
 
+  /// Return the filter variables: the action modifies only their QC flags and obs errors.
+  oops::Variables modifiedVars() const override {return filtervars_.toOopsVariables();}
+
  protected:
   /// For backward compatibility, the full set of filter options (including those required only by
   /// the concrete subclass, not by FilterBase) is stored in this LocalConfiguration object.
   /// It will be removed once all filters have been converted to use Parameters.
   const eckit::LocalConfiguration config_;
   ufo::Variables filtervars_;
+  std::vector<WhereParameters> whereParameters_;
+  std::unique_ptr<FilterActionParametersBase> actionParameters_;
+
+  /// Return the QC flag assigned to observations rejected by this filter.
+  virtual int qcFlag() const = 0;
 
  private:
   void doFilter() const override;
   void print(std::ostream &) const override = 0;
   virtual void applyFilter(const std::vector<bool> &, const Variables &,
                            std::vector<std::vector<bool>> &) const = 0;
-  virtual int qcFlag() const = 0;
 
-  std::vector<WhereParameters> whereParameters_;
-  std::unique_ptr<FilterActionParametersBase> actionParameters_;
+  /// Prefix of the keys under which the costs of this filter are recorded in the
+  /// PerformanceMonitor.
+  std::string monitorPrefix_;
 };
 
 }  // namespace ufo
@@ -0,0 +1,73 @@
+/*
+ * (C) Crown copyright 2021, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#include "ufo/filters/FilterChainState.h"
+
+#include <map>
+#include <mutex>  // NOLINT(build/c++11)
+
+#include "ioda/ObsDataVector.h"
+#include "oops/util/assert.h"
+
+namespace ufo {
+
+namespace {
+
+/// States of the chains that currently exist, keyed by their QC flags. The states aren't kept
+/// alive by this map; each removes itself from it when destroyed. A state keeps its QC flags
+/// alive, so their address can't be reused by another ObsDataVector while the state exists.
+typedef std::map<const FilterChainState::QCFlags_t *, std::weak_ptr<FilterChainState>> Chains;
+
+std::mutex chainsMutex;
+
+Chains & chains() {
+  static Chains theChains;
+  return theChains;
+}
+
+}  // namespace
+
+// -----------------------------------------------------------------------------
+
+std::shared_ptr<FilterChainState> FilterChainState::create(
+    ioda::ObsSpace & obsdb, const std::shared_ptr<QCFlags_t> & flags) {
+  ASSERT(flags);
+  std::shared_ptr<FilterChainState> state(new FilterChainState(obsdb, flags));
+  std::lock_guard<std::mutex> lock(chainsMutex);
+  chains()[flags.get()] = state;
+  return state;
+}
+
+// -----------------------------------------------------------------------------
+
+std::shared_ptr<FilterChainState> FilterChainState::find(const QCFlags_t & flags) {
+  std::lock_guard<std::mutex> lock(chainsMutex);
+  const Chains::const_iterator it = chains().find(&flags);
+  if (it == chains().end())
+    return nullptr;
+  return it->second.lock();
+}
+
+// -----------------------------------------------------------------------------
+
+FilterChainState::FilterChainState(ioda::ObsSpace & obsdb,
+                                   const std::shared_ptr<QCFlags_t> & flags)
+  : flags_(flags.get()), activeObs_(flags), columns_(obsdb)
+{}
+
+// -----------------------------------------------------------------------------
+
+FilterChainState::~FilterChainState() {
+  std::lock_guard<std::mutex> lock(chainsMutex);
+  const Chains::iterator it = chains().find(flags_);
+  if (it != chains().end() && it->second.expired())
+    chains().erase(it);
+}
+
+// -----------------------------------------------------------------------------
+
+}  // namespace ufo
@@ -0,0 +1,62 @@
+/*
+ * (C) Crown copyright 2021, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef UFO_FILTERS_FILTERCHAINSTATE_H_
+#define UFO_FILTERS_FILTERCHAINSTATE_H_
+
+#include <memory>
+
+#include <boost/noncopyable.hpp>
+
+#include "ufo/filters/ActiveObsIndex.h"
+#include "ufo/filters/ObsColumnStore.h"
+
+namespace ioda {
+  template <typename DATATYPE> class ObsDataVector;
+  class ObsSpace;
+}
+
+namespace ufo {
+
+/// \brief State shared by the filters of a chain, i.e. by the filters an oops::ObsFilters object
+/// applies to the same QC flags.
+///
+/// oops::ObsFilters creates a QCmanager before any other filter of a chain; the QCmanager creates
+/// the state of the chain and keeps it alive. The other filters of the chain, which are given the
+/// same QC flags, retrieve it with find(). Filters created without a QCmanager have no chain
+/// state and must keep their own.
+class FilterChainState : private boost::noncopyable {
+ public:
+  typedef ioda::ObsDataVector<int> QCFlags_t;
+
+  /// Create the state of the chain of filters applied to \p flags of observations from \p obsdb.
+  static std::shared_ptr<FilterChainState> create(ioda::ObsSpace & obsdb,
+                                                  const std::shared_ptr<QCFlags_t> & flags);
+
+  /// Return the state of the chain of filters applied to \p flags, or a null pointer if no
+  /// QCmanager applied to these flags exists.
+  static std::shared_ptr<FilterChainState> find(const QCFlags_t & flags);
+
+  ~FilterChainState();
+
+  /// Locations at which each variable of the chain's QC flags currently passes QC.
+  ActiveObsIndex & activeObs() {return activeObs_;}
+
+  /// ObsSpace data read by the filters of the chain.
+  ObsColumnStore & columns() {return columns_;}
+
+ private:
+  FilterChainState(ioda::ObsSpace & obsdb, const std::shared_ptr<QCFlags_t> & flags);
+
+  const QCFlags_t * flags_;
+  ActiveObsIndex activeObs_;
+  ObsColumnStore columns_;
+};
+
+}  // namespace ufo
+
+#endif  // UFO_FILTERS_FILTERCHAINSTATE_H_
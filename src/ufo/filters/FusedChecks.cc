@@ -0,0 +1,248 @@
+/*
+ * (C) Crown copyright 2021, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#include "ufo/filters/FusedChecks.h"
+
+#include <algorithm>
+#include <iterator>
+#include <map>
+#include <utility>
+
+#include <boost/make_unique.hpp>
+
+#include "ioda/ObsDataVector.h"
+#include "ioda/ObsSpace.h"
+#include "ioda/ObsVector.h"
+
+#include "oops/util/Logger.h"
+
+#include "ufo/filters/LocationCheckFilter.h"
+#include "ufo/GeoVaLs.h"
+#include "ufo/ObsDiagnostics.h"
+#include "ufo/utils/PerformanceMonitor.h"
+
+namespace ufo {
+
+namespace {
+
+// -----------------------------------------------------------------------------
+
+/// \brief Applies a sequence of fusable filters applied at the same stage in one pass over the
+/// observations.
+class FusedCheckGroup : public ObsProcessorBase {
+ public:
+  typedef ObsProcessorBase::Stage Stage;
+
+  FusedCheckGroup(ioda::ObsSpace & obsdb, Stage stage,
+                  std::vector<std::unique_ptr<LocationCheckFilter>> members,
+                  std::shared_ptr<ioda::ObsDataVector<int> > flags,
+                  std::shared_ptr<ioda::ObsDataVector<float> > obserr)
+    : ObsProcessorBase(obsdb, stage == Stage::POST, std::move(flags), std::move(obserr)),
+      members_(std::move(members))
+  {
+    for (const std::unique_ptr<LocationCheckFilter> & member : members_)
+      allvars_ += member->requiredVariables();
+    ASSERT(this->stage() == stage);
+  }
+
+  bool isThreadSafe() const override {
+    return std::all_of(members_.begin(), members_.end(),
+                       [](const std::unique_ptr<LocationCheckFilter> & member)
+                       { return member->isThreadSafe(); });
+  }
+
+  // Members are simple checks reading but never writing the ObsSpace.
+  bool modifiesObsSpace() const override {return false;}
+
+  oops::Variables modifiedVars() const override {
+    oops::Variables vars;
+    for (const std::unique_ptr<LocationCheckFilter> & member : members_)
+      vars += member->modifiedVars();
+    return vars;
+  }
+
+ private:
+  void print(std::ostream & os) const override {
+    os << "FusedCheckGroup with " << members_.size() << " filters";
+  }
+
+  void doFilter() const override;
+
+  /// Number of locations visited by each member before moving on to the next.
+  static constexpr size_t blockSize_ = 1024;
+
+  std::vector<std::unique_ptr<LocationCheckFilter>> members_;
+};
+
+constexpr size_t FusedCheckGroup::blockSize_;
+
+// -----------------------------------------------------------------------------
+
+void FusedCheckGroup::doFilter() const {
+  oops::Log::trace() << "FusedCheckGroup doFilter begin" << std::endl;
+  ScopedPerformanceMonitor monitor(obsdb_.obsname(), "/Fused Checks/doFilter", obsdb_.nlocs());
+
+  // Select the locations and load the inputs of all members before applying any of them. This is
+  // valid because members don't read QC flags and don't modify anything else.
+  const size_t nmembers = members_.size();
+  std::vector<std::vector<bool>> apply(nmembers);
+  std::vector<std::unique_ptr<LocationCheck>> tests(nmembers);
+  // For each variable (identified by its index in flags_), the members testing it, in order, and
+  // the index of that variable among their filter variables.
+  std::map<size_t, std::vector<std::pair<size_t, size_t>>> testsOfVariable;
+  for (size_t m = 0; m < nmembers; ++m) {
+    apply[m] = members_[m]->selectLocations(data_);
+    tests[m] = members_[m]->locationCheck(data_);
+    const Variables & filtervars = members_[m]->filterVariables();
+    for (size_t jv = 0; jv < filtervars.nvars(); ++jv) {
+      const size_t iv = flags_->varnames().find(filtervars.variable(jv).variable());
+      testsOfVariable[iv].emplace_back(m, jv);
+    }
+  }
+
+  std::vector<size_t> candidates, selected, failed, survivors;
+  for (const auto & variableAndTests : testsOfVariable) {
+    const size_t iv = variableAndTests.first;
+    const std::vector<size_t> & active = activeObs_->activeLocations(iv);
+    for (size_t begin = 0; begin < active.size(); begin += blockSize_) {
+      const size_t end = std::min(begin + blockSize_, active.size());
+      candidates.assign(active.begin() + begin, active.begin() + end);
+      for (const std::pair<size_t, size_t> & test : variableAndTests.second) {
+        const size_t m = test.first;
+        selected.clear();
+        for (size_t jobs : candidates)
+          if (apply[m][jobs]) selected.push_back(jobs);
+        failed.clear();
+        tests[m]->check(test.second, selected, failed);
+        if (failed.empty()) continue;
+
+        const int qcflag = members_[m]->rejectionFlag();
+        for (size_t jobs : failed)
+          (*flags_)[iv][jobs] = qcflag;
+
+        // Later members only test the locations that still pass QC. Both lists are increasing.
+        survivors.clear();
+        std::set_difference(candidates.begin(), candidates.end(), failed.begin(), failed.end(),
+                            std::back_inserter(survivors));
+        candidates.swap(survivors);
+      }
+    }
+  }
+
+  oops::Log::trace() << "FusedCheckGroup doFilter end" << std::endl;
+}
+
+}  // namespace
+
+// -----------------------------------------------------------------------------
+
+FusedChecks::FusedChecks(ioda::ObsSpace & obsdb, const Parameters_ & parameters,
+                         std::shared_ptr<ioda::ObsDataVector<int> > flags,
+                         std::shared_ptr<ioda::ObsDataVector<float> > obserr)
+  : chain_(FilterChainState::find(*flags))
+{
+  oops::Log::trace() << "FusedChecks constructor starting" << std::endl;
+
+  std::vector<std::unique_ptr<ObsProcessorBase>> members;
+  for (const eckit::LocalConfiguration & filterConf : parameters.filters.value()) {
+    std::unique_ptr<ObsProcessorBase> member =
+        ObsProcessorFactory::create(obsdb, filterConf, flags, obserr);
+    names_.push_back(filterConf.getString("filter"));
+    geovars_ += member->requiredVars();
+    diagvars_ += member->requiredHdiagnostics();
+    members.push_back(std::move(member));
+  }
+
+  // Each fusable member joins the run of fusable members at its stage, unless a member that
+  // can't be fused has been met at that stage since the start of the run. The stage at which
+  // each member is applied is known only once it has been fully constructed.
+  std::map<Stage, size_t> openRun;
+  for (size_t i = 0; i < members.size(); ++i) {
+    const Stage stage = members[i]->stage();
+    const LocationCheckFilter * check = dynamic_cast<const LocationCheckFilter *>(members[i].get());
+    if (parameters.fuse && check != nullptr && check->isFusable()) {
+      const auto run = openRun.find(stage);
+      if (run != openRun.end()) {
+        unitMembers_[run->second].push_back(i);
+        continue;
+      }
+      openRun[stage] = unitMembers_.size();
+    } else {
+      openRun.erase(stage);
+    }
+    unitMembers_.push_back({i});
+  }
+
+  for (const std::vector<size_t> & unit : unitMembers_) {
+    if (unit.size() == 1) {
+      units_.push_back(std::move(members[unit.front()]));
+    } else {
+      const Stage stage = members[unit.front()]->stage();
+      std::vector<std::unique_ptr<LocationCheckFilter>> checks;
+      for (size_t i : unit)
+        checks.emplace_back(static_cast<LocationCheckFilter *>(members[i].release()));
+      units_.push_back(boost::make_unique<FusedCheckGroup>(obsdb, stage, std::move(checks),
+                                                           flags, obserr));
+    }
+  }
+
+  oops::Log::debug() << *this << std::endl;
+  oops::Log::trace() << "FusedChecks constructor done" << std::endl;
+}
+
+// -----------------------------------------------------------------------------
+
+FusedChecks::~FusedChecks() {
+  oops::Log::trace() << "FusedChecks destructed" << std::endl;
+}
+
+// -----------------------------------------------------------------------------
+
+void FusedChecks::preProcess() {
+  oops::Log::trace() << "FusedChecks preProcess begin" << std::endl;
+  // Declare the ObsSpace data used by all members before applying any of them, so that these
+  // data are read together.
+  if (chain_)
+    for (const std::unique_ptr<ObsProcessorBase> & unit : units_)
+      chain_->columns().require(unit->requiredVariables());
+  for (const std::unique_ptr<ObsProcessorBase> & unit : units_)
+    unit->preProcess();
+  oops::Log::trace() << "FusedChecks preProcess end" << std::endl;
+}
+
+// -----------------------------------------------------------------------------
+
+void FusedChecks::priorFilter(const GeoVaLs & gv) {
+  oops::Log::trace() << "FusedChecks priorFilter begin" << std::endl;
+  for (const std::unique_ptr<ObsProcessorBase> & unit : units_)
+    unit->priorFilter(gv);
+  oops::Log::trace() << "FusedChecks priorFilter end" << std::endl;
+}
+
+// -----------------------------------------------------------------------------
+
+void FusedChecks::postFilter(const ioda::ObsVector & hofx, const ObsDiagnostics & diags) {
+  oops::Log::trace() << "FusedChecks postFilter begin" << std::endl;
+  for (const std::unique_ptr<ObsProcessorBase> & unit : units_)
+    unit->postFilter(hofx, diags);
+  oops::Log::trace() << "FusedChecks postFilter end" << std::endl;
+}
+
+// -----------------------------------------------------------------------------
+
+void FusedChecks::print(std::ostream & os) const {
+  os << "FusedChecks with " << names_.size() << " filters";
+  for (const std::vector<size_t> & unit : unitMembers_) {
+    os << "\n  " << (unit.size() == 1 ? "alone:" : "fused:");
+    for (size_t i : unit)
+      os << " [" << i << "] " << names_[i];
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+}  // namespace ufo
@@ -0,0 +1,131 @@
+/*
+ * (C) Crown copyright 2021, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef UFO_FILTERS_FUSEDCHECKS_H_
+#define UFO_FILTERS_FUSEDCHECKS_H_
+
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "eckit/config/LocalConfiguration.h"
+#include "oops/base/ObsFilterParametersBase.h"
+#include "oops/base/Variables.h"
+#include "oops/util/ObjectCounter.h"
+#include "oops/util/parameters/Parameter.h"
+#include "oops/util/parameters/RequiredParameter.h"
+#include "oops/util/Printable.h"
+#include "ufo/filters/FilterChainState.h"
+#include "ufo/filters/ObsProcessorBase.h"
+
+namespace ioda {
+  template <typename DATATYPE> class ObsDataVector;
+  class ObsSpace;
+  class ObsVector;
+}
+
+namespace ufo {
+  class GeoVaLs;
+  class ObsDiagnostics;
+
+/// Options controlling the FusedChecks processor.
+class FusedChecksParameters : public oops::ObsFilterParametersBase {
+  OOPS_CONCRETE_PARAMETERS(FusedChecksParameters, ObsFilterParametersBase)
+
+ public:
+  /// Configurations of the filters to apply, listed in the order in which they would be applied
+  /// if they were listed directly in the `obs filters` section.
+  oops::RequiredParameter<std::vector<eckit::LocalConfiguration>> filters{"filters", this};
+
+  /// If set to false, the filters are applied one by one in the order in which they are listed.
+  oops::Parameter<bool> fuse{"fuse", true, this};
+};
+
+/// \brief Applies a list of filters, carrying out consecutive simple threshold checks together in
+/// a single pass over the observations.
+///
+/// The results are the same as if the filters were listed directly in the `obs filters` section.
+/// Example:
+///
+/// \code{.yaml}
+///   obs filters:
+///   - filter: Fused Checks
+///     filters:
+///     - filter: Bounds Check
+///       filter variables:
+///       - name: brightness_temperature
+///         channels: 1-5
+///       minvalue: 100
+///       maxvalue: 400
+///     - filter: Background Check
+///       filter variables:
+///       - name: brightness_temperature
+///         channels: 1-5
+///       absolute threshold: 3.5
+/// \endcode
+///
+/// Filters flagging each location independently of all others (Bounds Check, Background Check,
+/// Difference Check and ModelOb Threshold, see LocationCheckFilter) can be fused if they reject
+/// the observations they flag (the default action) and don't read any QC flags. Each run of
+/// consecutive fusable members applied at the same stage (pre, prior or post) is replaced by a
+/// single processor that:
+///
+/// * evaluates the `where` options and loads the inputs of all its members;
+/// * for each filter variable, visits the locations at which it passes QC in blocks small enough
+///   to stay in cache and carries out the tests of all members in turn on each block, dropping
+///   rejected locations before the next test.
+///
+/// Since each location is rejected by the first member whose test it fails, the QC flags are the
+/// same as those set by the members applied one after another. Members that can't be fused are
+/// applied on their own at their usual stage, between the fused runs preceding and following them.
+///
+/// Members are created by the ObsProcessorFactory, so QCmanager, PreQC and other processors
+/// not derived from ObsProcessorBase can't be used.
+class FusedChecks : public util::Printable,
+                    private util::ObjectCounter<FusedChecks> {
+ public:
+  /// The type of parameters accepted by the constructor of this filter.
+  /// This typedef is used by the FilterFactory.
+  typedef FusedChecksParameters Parameters_;
+  typedef ObsProcessorBase::Stage Stage;
+
+  static const std::string classname() {return "ufo::FusedChecks";}
+
+  FusedChecks(ioda::ObsSpace &, const Parameters_ &,
+              std::shared_ptr<ioda::ObsDataVector<int> >,
+              std::shared_ptr<ioda::ObsDataVector<float> >);
+  ~FusedChecks();
+
+  void preProcess();
+  void priorFilter(const GeoVaLs &);
+  void postFilter(const ioda::ObsVector &, const ObsDiagnostics &);
+
+  const oops::Variables & requiredVars() const {return geovars_;}
+  const oops::Variables & requiredHdiagnostics() const {return diagvars_;}
+
+  /// \brief Return the sets of members applied together, in the order in which they are applied.
+  ///
+  /// Members are identified by their positions in the `filters` list. Members applied on their
+  /// own form single-element sets.
+  const std::vector<std::vector<size_t>> & units() const {return unitMembers_;}
+
+ private:
+  void print(std::ostream &) const override;
+
+  std::vector<std::unique_ptr<ObsProcessorBase>> units_;
+  std::vector<std::vector<size_t>> unitMembers_;
+  std::vector<std::string> names_;
+  oops::Variables geovars_;
+  oops::Variables diagvars_;
+  /// State of the filter chain the members belong to; null if there is no QCmanager.
+  std::shared_ptr<FilterChainState> chain_;
+};
+
+}  // namespace ufo
+
+#endif  // UFO_FILTERS_FUSEDCHECKS_H_
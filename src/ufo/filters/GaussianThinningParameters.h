@@ -132,6 +132,13 @@ class GaussianThinningParameters : public FilterParametersBase {
   ///   is enabled are taken into account).
   oops::Parameter<DistanceNorm> distanceNorm{"distance_norm", DistanceNorm::GEODESIC, this};
 
+  // Memory usage
+
+  /// If true, the observation data gathered from all MPI ranks (needed unless each category is
+  /// held on a single rank) are stored once per (shared-memory) node rather than once per rank.
+  /// This reduces the memory used by the filter when many ranks run on each node.
+  oops::Parameter<bool> nodeSharedMemory{"node_shared_memory", false, this};
+
  private:
   static float defaultHorizontalMesh() {
     return static_cast<float>(2 * M_PI * Constants::mean_earth_rad / 360.0);
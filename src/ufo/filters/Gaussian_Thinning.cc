@@ -27,6 +27,7 @@
 #include "ufo/utils/EquispacedBinSelector.h"
 #include "ufo/utils/GeodesicDistanceCalculator.h"
 #include "ufo/utils/MaxNormDistanceCalculator.h"
+#include "ufo/utils/NodeSharedVector.h"
 #include "ufo/utils/RecursiveSplitter.h"
 #include "ufo/utils/SpatialBinSelector.h"
 
@@ -75,12 +76,12 @@ void Gaussian_Thinning::applyFilter(const std::vector<bool> & apply,
 // -----------------------------------------------------------------------------
 
 ObsAccessor Gaussian_Thinning::createObsAccessor() const {
-  if (options_.categoryVariable.value() != boost::none) {
-    return ObsAccessor::toObservationsSplitIntoIndependentGroupsByVariable(
-          obsdb_, *options_.categoryVariable.value());
-  } else {
-    return ObsAccessor::toAllObservations(obsdb_);
-  }
+  ObsAccessor obsAccessor = options_.categoryVariable.value() != boost::none ?
+        ObsAccessor::toObservationsSplitIntoIndependentGroupsByVariable(
+          obsdb_, *options_.categoryVariable.value()) :
+        ObsAccessor::toAllObservations(obsdb_);
+  obsAccessor.setNodeSharedMemory(options_.nodeSharedMemory);
+  return obsAccessor;
 }
 
 // -----------------------------------------------------------------------------
@@ -113,36 +114,39 @@ void Gaussian_Thinning::groupObservationsBySpatialLocation(
   oops::Log::debug() << "Gaussian_Thinning: number of horizontal bins = "
                      << binSelector->totalNumBins() << std::endl;
 
-  std::vector<float> lat = obsAccessor.getFloatVariableFromObsSpace("MetaData", "latitude");
-  std::vector<float> lon = obsAccessor.getFloatVariableFromObsSpace("MetaData", "longitude");
+  const NodeSharedVector<float> lat =
+      obsAccessor.getSharedFloatVariableFromObsSpace("MetaData", "latitude");
+  const NodeSharedVector<float> lon =
+      obsAccessor.getSharedFloatVariableFromObsSpace("MetaData", "longitude");
   // Longitudes will typically be either in the [-180, 180] degree range or in the [0, 360]
   // degree range. The spatial bin selector is written with the latter convention in mind,
-  // so let's shift any negative longitudes up by 360 degrees.
-  for (float &longitude : lon)
-    if (longitude < 0)
-      longitude += 360;
+  // so let's shift any negative longitudes up by 360 degrees. The shifted longitudes of valid
+  // observations are kept in a local array, since the gathered ones may be shared with other
+  // processes.
+  std::vector<float> validLon;
+  validLon.reserve(validObsIds.size());
+  for (size_t obsId : validObsIds)
+    validLon.push_back(lon[obsId] < 0 ? lon[obsId] + 360 : lon[obsId]);
 
   std::vector<size_t> latBins;
   std::vector<size_t> lonBins;
   latBins.reserve(validObsIds.size());
   lonBins.reserve(validObsIds.size());
-  for (size_t obsId : validObsIds) {
-    const size_t latBin = binSelector->latitudeBin(lat[obsId]);
+  for (size_t validObsIndex = 0; validObsIndex < validObsIds.size(); ++validObsIndex) {
+    const size_t latBin = binSelector->latitudeBin(lat[validObsIds[validObsIndex]]);
     latBins.push_back(latBin);
-    lonBins.push_back(binSelector->longitudeBin(latBin, lon[obsId]));
+    lonBins.push_back(binSelector->longitudeBin(latBin, validLon[validObsIndex]));
   }
   splitter.groupBy(latBins);
   splitter.groupBy(lonBins);
 
-  oops::Log::debug() << "Gaussian_Thinning: latitudes  = " << lat << std::endl;
-  oops::Log::debug() << "Gaussian_Thinning: longitudes = " << lon << std::endl;
   oops::Log::debug() << "Gaussian_Thinning: lat bins   = " << latBins << std::endl;
   oops::Log::debug() << "Gaussian_Thinning: lon bins   = " << lonBins << std::endl;
 
   for (size_t validObsIndex = 0; validObsIndex < validObsIds.size(); ++validObsIndex) {
     const size_t obsId = validObsIds[validObsIndex];
     float component = distanceCalculator.spatialDistanceComponent(
-          lat[obsId], lon[obsId],
+          lat[obsId], validLon[validObsIndex],
           binSelector->latitudeBinCenter(latBins[validObsIndex]),
           binSelector->longitudeBinCenter(latBins[validObsIndex], lonBins[validObsIndex]),
           binSelector->inverseLatitudeBinWidth(),
@@ -195,7 +199,8 @@ void Gaussian_Thinning::groupObservationsByPressure(
   oops::Log::debug() << "Gaussian_Thinning: number of vertical bins = "
                      << binSelector->numBins() << std::endl;
 
-  std::vector<float> pres = obsAccessor.getFloatVariableFromObsSpace("MetaData", "air_pressure");
+  const NodeSharedVector<float> pres =
+      obsAccessor.getSharedFloatVariableFromObsSpace("MetaData", "air_pressure");
 
   std::vector<size_t> bins;
   bins.reserve(validObsIds.size());
@@ -205,7 +210,6 @@ void Gaussian_Thinning::groupObservationsByPressure(
   }
   splitter.groupBy(bins);
 
-  oops::Log::debug() << "Gaussian_Thinning: pressures     = " << pres << std::endl;
   oops::Log::debug() << "Gaussian_Thinning: pressure bins = " << bins << std::endl;
 
   for (size_t validObsIndex = 0; validObsIndex < validObsIds.size(); ++validObsIndex) {
@@ -354,12 +358,10 @@ std::function<bool(size_t, size_t)> Gaussian_Thinning::makeObservationComparator
 
   const ufo::Variable priorityVariable = options_.priorityVariable.value().get();
 
-  std::vector<int> priorities = obsAccessor.getIntVariableFromObsSpace(
+  // Copies of a NodeSharedVector share its storage, so capturing it by value is cheap.
+  const NodeSharedVector<int> priorities = obsAccessor.getSharedIntVariableFromObsSpace(
         priorityVariable.group(), priorityVariable.variable());
 
-  oops::Log::debug() << "priorities = " << priorities << std::endl;
-
-  // TODO(wsmigaj): In C++14, use move capture for 'priorities'.
   return [priorities, &validObsIds, &distancesToBinCenter]
          (size_t validObsIndexA, size_t validObsIndexB) {
       // Prefer observations with large priorities and small distances
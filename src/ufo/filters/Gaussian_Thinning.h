@@ -69,6 +69,8 @@ class Gaussian_Thinning : public FilterBase,
                     std::shared_ptr<ioda::ObsDataVector<int> > flags,
                     std::shared_ptr<ioda::ObsDataVector<float> > obserr);
 
+  bool modifiesObsSpace() const override {return false;}
+
  private:
   void print(std::ostream &) const override;
   void applyFilter(const std::vector<bool> &, const Variables &,
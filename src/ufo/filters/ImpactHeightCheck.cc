@@ -106,13 +106,14 @@ void ImpactHeightCheck::applyFilter(const std::vector<bool> & apply,
 
   // Read in the observation impact parameter for each observation
   Variable impactVariable = Variable("impact_parameter@MetaData");
-  std::vector<float> impactParameter;
-  data_.get(impactVariable, impactParameter);
+  std::vector<float> impactBuffer;
+  const std::vector<float> & impactParameter = data_.getRef(impactVariable, impactBuffer);
 
   // Read in the earth's radius of curvature for each observation
   Variable radiusCurvatureParameter = Variable("earth_radius_of_curvature@MetaData");
-  std::vector<float> radiusCurvature;
-  data_.get(radiusCurvatureParameter, radiusCurvature);
+  std::vector<float> radiusBuffer;
+  const std::vector<float> & radiusCurvature = data_.getRef(radiusCurvatureParameter,
+                                                            radiusBuffer);
 
   // For each variable, perform the filter
   for (size_t iFilterVar = 0; iFilterVar < filtervars.nvars(); ++iFilterVar) {
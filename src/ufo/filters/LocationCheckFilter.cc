@@ -0,0 +1,80 @@
+/*
+ * (C) Crown copyright 2021, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#include "ufo/filters/LocationCheckFilter.h"
+
+#include <string>
+#include <utility>
+
+#include "ioda/ObsDataVector.h"
+#include "ioda/ObsSpace.h"
+
+#include "oops/util/Logger.h"
+
+#include "ufo/filters/actions/FilterActionBase.h"
+#include "ufo/filters/ObsFilterData.h"
+#include "ufo/filters/processWhere.h"
+
+namespace ufo {
+
+// -----------------------------------------------------------------------------
+
+LocationCheckFilter::LocationCheckFilter(ioda::ObsSpace & obsdb,
+                                         const FilterParametersBaseWithAbstractAction & parameters,
+                                         std::shared_ptr<ioda::ObsDataVector<int> > flags,
+                                         std::shared_ptr<ioda::ObsDataVector<float> > obserr)
+  : FilterBase(obsdb, parameters, std::move(flags), std::move(obserr))
+{}
+
+// -----------------------------------------------------------------------------
+
+LocationCheckFilter::~LocationCheckFilter() {}
+
+// -----------------------------------------------------------------------------
+
+bool LocationCheckFilter::isFusable() const {
+  const boost::optional<std::string> & action = actionParameters_->name.value();
+  return action != boost::none && *action == "reject" &&
+         !allvars_.allFromGroup("QCflagsData");
+}
+
+// -----------------------------------------------------------------------------
+
+std::vector<bool> LocationCheckFilter::selectLocations(const ObsFilterData & data) const {
+  return processWhere(whereParameters_, data);
+}
+
+// -----------------------------------------------------------------------------
+
+void LocationCheckFilter::applyFilter(const std::vector<bool> & apply,
+                                      const Variables & filtervars,
+                                      std::vector<std::vector<bool>> & flagged) const {
+  const std::unique_ptr<LocationCheck> test = this->locationCheck(data_);
+
+  std::vector<size_t> selected;
+  if (!this->checksPassingObsOnly()) {
+    for (size_t jobs = 0; jobs < apply.size(); ++jobs)
+      if (apply[jobs]) selected.push_back(jobs);
+  }
+
+  std::vector<size_t> failed;
+  for (size_t jv = 0; jv < filtervars.nvars(); ++jv) {
+    failed.clear();
+    if (this->checksPassingObsOnly()) {
+      const size_t iv = flags_->varnames().find(filtervars.variable(jv).variable());
+      test->check(jv, activeObs_->activeLocations(iv, apply), failed);
+    } else {
+      test->check(jv, selected, failed);
+    }
+    for (size_t jobs : failed)
+      flagged[jv][jobs] = true;
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+}  // namespace ufo
@@ -0,0 +1,92 @@
+/*
+ * (C) Crown copyright 2021, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef UFO_FILTERS_LOCATIONCHECKFILTER_H_
+#define UFO_FILTERS_LOCATIONCHECKFILTER_H_
+
+#include <cstddef>  // for size_t
+#include <memory>
+#include <vector>
+
+#include "ufo/filters/FilterBase.h"
+
+namespace eckit {
+  class Configuration;
+}
+
+namespace ioda {
+  template <typename DATATYPE> class ObsDataVector;
+  class ObsSpace;
+}
+
+namespace ufo {
+  class ObsFilterData;
+
+/// \brief Test carried out by a filter at each location independently of all other locations.
+///
+/// Objects of this type are created by LocationCheckFilter::locationCheck() once all the inputs
+/// of the test are available, and hold (references to) these inputs.
+class LocationCheck {
+ public:
+  virtual ~LocationCheck() {}
+
+  /// Append to \p failed the locations from the (increasing) list \p locs at which filter
+  /// variable \p jv fails the test.
+  virtual void check(size_t jv, const std::vector<size_t> & locs,
+                     std::vector<size_t> & failed) const = 0;
+};
+
+/// \brief Base class for filters flagging each location independently of all others.
+///
+/// Subclasses implement locationCheck() rather than applyFilter(). When a filter of this type is
+/// applied on its own, the test is carried out at all locations selected by the `where` option
+/// (or, if checksPassingObsOnly() returns true, only at those where the filter variable passes
+/// QC). The FusedChecks processor can instead apply a sequence of such filters together, carrying
+/// out all their tests in a single pass over the observations.
+class LocationCheckFilter : public FilterBase {
+ public:
+  LocationCheckFilter(ioda::ObsSpace &, const FilterParametersBaseWithAbstractAction &,
+                      std::shared_ptr<ioda::ObsDataVector<int> >,
+                      std::shared_ptr<ioda::ObsDataVector<float> >);
+  ~LocationCheckFilter();
+
+  /// \brief Return true if this filter can be fused with other filters by FusedChecks.
+  ///
+  /// This requires the filter to reject the observations it flags (the default action) and not
+  /// to read any QC flags, which the filters fused with it would modify.
+  bool isFusable() const;
+
+  /// Return the filter variables.
+  const Variables & filterVariables() const {return filtervars_;}
+
+  /// Return the QC flag assigned to observations rejected by this filter.
+  int rejectionFlag() const {return qcFlag();}
+
+  /// Return the locations selected by the `where` option, evaluated with the data from \p data.
+  std::vector<bool> selectLocations(const ObsFilterData & data) const;
+
+  /// \brief Return the test carried out by this filter at each location, with inputs taken
+  /// from \p data.
+  ///
+  /// Must be called at the stage at which the filter is applied and with \p data holding all the
+  /// variables returned by requiredVariables(). The returned object may refer to data owned by
+  /// \p data and by the filter, so it mustn't outlive either.
+  virtual std::unique_ptr<LocationCheck> locationCheck(const ObsFilterData & data) const = 0;
+
+ protected:
+  /// Return true if the test should be carried out only at locations at which the filter
+  /// variable passes QC, for example because it requires a valid obs error.
+  virtual bool checksPassingObsOnly() const {return false;}
+
+ private:
+  void applyFilter(const std::vector<bool> &, const Variables &,
+                   std::vector<std::vector<bool>> &) const override;
+};
+
+}  // namespace ufo
+
+#endif  // UFO_FILTERS_LOCATIONCHECKFILTER_H_
@@ -7,6 +7,11 @@
 
 #include "ufo/filters/ModelObThreshold.h"
 
+#include <string>
+#include <vector>
+
+#include <boost/make_unique.hpp>
+
 #include "eckit/config/Configuration.h"
 
 #include "ioda/ObsDataVector.h"
@@ -15,6 +20,7 @@
 #include "oops/base/ObsFilterBase.h"
 #include "oops/interface/ObsFilter.h"
 #include "oops/util/Logger.h"
+#include "oops/util/missingValues.h"
 #include "oops/util/PropertiesOfNVectors.h"
 
 #include "ufo/GeoVaLs.h"
@@ -26,12 +32,88 @@ constexpr char ThresholdTypeParameterTraitsHelper::enumTypeName[];
 constexpr util::NamedEnumerator<ThresholdType>
   ThresholdTypeParameterTraitsHelper::namedValues[];
 
+namespace {
+
+// -----------------------------------------------------------------------------
+
+/// Flags locations at which the model profile interpolated to the observation height lies
+/// outside the threshold interpolated to the same height. The result is the same for all
+/// filter variables, so it is computed once per location.
+class ModelObLocationCheck : public LocationCheck {
+ public:
+  ModelObLocationCheck(const ObsFilterData & data, const ModelObThresholdParameters & parameters)
+    : gvals_(data.getGeoVaLs()),
+      model_profile_name_(Variable(parameters.model_profile).variable()),
+      model_vcoord_name_(Variable(parameters.model_vcoord).variable()),
+      interp_thresholds_(parameters.coord_vals.value(), parameters.thresholds.value()),
+      threshold_type_(parameters.threshold_type),
+      obs_height_(data.getRef(parameters.obs_height, obsHeightBuffer_)),
+      failed_(data.nlocs(), Unknown)
+  {}
+
+  void check(size_t, const std::vector<size_t> & locs,
+             std::vector<size_t> & failed) const override {
+    for (size_t iloc : locs) {
+      if (failed_[iloc] == Unknown)
+        failed_[iloc] = fails(iloc) ? Yes : No;
+      if (failed_[iloc] == Yes)
+        failed.push_back(iloc);
+    }
+  }
+
+ private:
+  enum Outcome : char {Unknown, No, Yes};
+
+  bool fails(size_t iloc) const {
+    const float missing = util::missingValue(missing);
+
+    // interpolate threshold values to observation height
+    float bg_threshold = interp_thresholds_(obs_height_[iloc]);
+
+    // Vectors storing GeoVaL column for current location.
+    std::vector <double> model_profile_column;
+    std::vector <double> model_vcoord_column;
+    model_profile_column.assign(gvals_->nlevs(model_profile_name_), 0.0);
+    model_vcoord_column.assign(gvals_->nlevs(model_vcoord_name_), 0.0);
+    // Get GeoVaLs at the specified location.
+    gvals_->getAtLocation(model_profile_column, model_profile_name_, iloc);
+    gvals_->getAtLocation(model_vcoord_column, model_vcoord_name_, iloc);
+
+    // interpolate model profile values to observation height
+    ufo::PiecewiseLinearInterpolation interp_model(model_vcoord_column, model_profile_column);
+    float bg_model = interp_model(obs_height_[iloc]);
+
+    // check to see if one of the compared values is missing
+    if (bg_model == missing || bg_threshold == missing)
+      return true;
+    // Check if model value is outside threshold
+    if (threshold_type_ == ThresholdType::MIN)
+      return bg_model < bg_threshold;
+    return bg_model > bg_threshold;
+  }
+
+  const ufo::GeoVaLs * gvals_;
+  std::string model_profile_name_;
+  std::string model_vcoord_name_;
+// Setup interpolation of height-dependent thresholds
+// N.B. inputs to interp must be double precision
+  ufo::PiecewiseLinearInterpolation interp_thresholds_;
+  ThresholdType threshold_type_;
+  // Declared before obs_height_, which may refer to it.
+  std::vector<float> obsHeightBuffer_;
+  // The observation height
+  const std::vector<float> & obs_height_;
+  mutable std::vector<Outcome> failed_;
+};
+
+}  // namespace
+
 // -----------------------------------------------------------------------------
 
 ModelObThreshold::ModelObThreshold(ioda::ObsSpace & obsdb, const Parameters_ & parameters,
                                std::shared_ptr<ioda::ObsDataVector<int> > flags,
                                std::shared_ptr<ioda::ObsDataVector<float> > obserr)
-  : FilterBase(obsdb, parameters, flags, obserr), parameters_(parameters)
+  : LocationCheckFilter(obsdb, parameters, flags, obserr), parameters_(parameters)
 {
   oops::Log::trace() << "ModelObThreshold contructor starting" << std::endl;
   allvars_ += parameters_.model_profile;
@@ -88,25 +170,16 @@ ModelObThreshold::~ModelObThreshold() {
  * \date 12/03/2021: Created
  */
 
-void ModelObThreshold::applyFilter(const std::vector<bool> & apply,
-                                   const Variables & filtervars,
-                                   std::vector<std::vector<bool>> & flagged) const {
-  oops::Log::trace() << "ModelObThreshold priorFilter" << std::endl;
+std::unique_ptr<LocationCheck> ModelObThreshold::locationCheck(const ObsFilterData & data) const {
+  oops::Log::trace() << "ModelObThreshold locationCheck" << std::endl;
   print(oops::Log::trace());
 
-  const float missing = util::missingValue(missing);
-  const size_t nlocs = obsdb_.nlocs();
-
 // Get piece-wise parameters from options.
   const std::vector<double> coord_vals = parameters_.coord_vals.value();
   const std::vector<double> thresholds = parameters_.thresholds.value();
   oops::Log::debug() << "QC coord vals are " << coord_vals << std::endl;
   oops::Log::debug() << "QC thresholds are " << thresholds << std::endl;
 
-// get names of GeoVal variables
-  const std::string model_profile_name = Variable(parameters_.model_profile).variable();
-  const std::string model_vcoord_name = Variable(parameters_.model_vcoord).variable();
-
   std::ostringstream errString;
 // Ensure same size vectors (coord_vals and threshold); Also ensure more than one value in each.
   if (coord_vals.size() <= 1 || coord_vals.size() != thresholds.size()) {
@@ -115,60 +188,7 @@ void ModelObThreshold::applyFilter(const std::vector<bool> & apply,
       throw eckit::BadValue(errString.str());
   }
 
-// Get variables from ObsSpace
-// Get obs_height, the observation height
-  std::vector<float> obs_height;
-  data_.get(parameters_.obs_height, obs_height);
-
-// Get GeoVaLs
-  const ufo::GeoVaLs * gvals = data_.getGeoVaLs();
-
-// Setup interpolation of height-dependent thresholds
-// N.B. inputs to interp must be double precision
-  ufo::PiecewiseLinearInterpolation interp_thresholds(coord_vals, thresholds);
-
-// Loop through locations
-  for (size_t iloc=0; iloc < nlocs; ++iloc) {
-    // interpolate threshold values to observation height
-    float bg_threshold = interp_thresholds(obs_height[iloc]);
-
-    // Vectors storing GeoVaL column for current location.
-    std::vector <double> model_profile_column;
-    std::vector <double> model_vcoord_column;
-    model_profile_column.assign(gvals->nlevs(model_profile_name), 0.0);
-    model_vcoord_column.assign(gvals->nlevs(model_vcoord_name), 0.0);
-    // Get GeoVaLs at the specified location.
-    gvals->getAtLocation(model_profile_column, model_profile_name, iloc);
-    gvals->getAtLocation(model_vcoord_column, model_vcoord_name, iloc);
-
-    // interpolate model profile values to observation height
-    ufo::PiecewiseLinearInterpolation interp_model(model_vcoord_column, model_profile_column);
-    float bg_model = interp_model(obs_height[iloc]);
-
-    // Apply threshold
-    if (apply[iloc]) {
-      // check to see if one of the compared values is missing
-      if (bg_model == missing || bg_threshold == missing) {
-        for (size_t jv = 0; jv < filtervars.nvars(); ++jv) {
-          flagged[jv][iloc] = true;
-        }
-      } else {
-      // Check if model value is outside threshold and set flag
-        for (size_t jv = 0; jv < filtervars.nvars(); ++jv) {
-          if (parameters_.threshold_type == ThresholdType::MIN) {
-            if (bg_model < (bg_threshold)) {
-              flagged[jv][iloc] = true;
-            }
-          }
-          if (parameters_.threshold_type == ThresholdType::MAX) {
-            if (bg_model > (bg_threshold)) {
-              flagged[jv][iloc] = true;
-            }
-          }
-        }
-      }
-    }
-  }
+  return boost::make_unique<ModelObLocationCheck>(data, parameters_);
 }
 
 // -----------------------------------------------------------------------------
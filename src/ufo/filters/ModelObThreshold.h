@@ -17,7 +17,7 @@
 #include "oops/util/parameters/OptionalParameter.h"
 #include "oops/util/parameters/RequiredParameter.h"
 
-#include "ufo/filters/FilterBase.h"
+#include "ufo/filters/LocationCheckFilter.h"
 #include "ufo/filters/QCflags.h"
 #include "ufo/filters/Variable.h"
 #include "ufo/utils/parameters/ParameterTraitsVariable.h"
@@ -85,7 +85,7 @@ class ModelObThresholdParameters : public FilterParametersBase {
 /// specified limit.
 ///
 /// See ModelObThresholdParameters for the documentation of the parameters controlling this filter.
-class ModelObThreshold : public FilterBase,
+class ModelObThreshold : public LocationCheckFilter,
                        private util::ObjectCounter<ModelObThreshold> {
  public:
   /// The type of parameters accepted by the constructor of this filter.
@@ -99,10 +99,12 @@ class ModelObThreshold : public FilterBase,
                   std::shared_ptr<ioda::ObsDataVector<float> >);
   ~ModelObThreshold();
 
+  bool isThreadSafe() const override {return true;}
+
+  std::unique_ptr<LocationCheck> locationCheck(const ObsFilterData &) const override;
+
  private:
   void print(std::ostream &) const override;
-  void applyFilter(const std::vector<bool> &, const Variables &,
-                   std::vector<std::vector<bool>> &) const override;
   int qcFlag() const override {return QCflags::modelobthresh;}
 
   Parameters_ parameters_;
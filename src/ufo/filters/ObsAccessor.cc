@@ -9,6 +9,7 @@
 
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "ioda/distribution/InefficientDistribution.h"
@@ -31,11 +32,44 @@ std::vector<VariableType> getVariableFromObsSpaceImpl(
   return result;
 }
 
+/// Gather the vector \p localValues held on all ranks into node-shared memory if \p layout is
+/// set or into a vector held by each rank otherwise.
+template <typename VariableType>
+NodeSharedVector<VariableType> gatherShared(
+    std::vector<VariableType> localValues, const ioda::Distribution &obsDistribution,
+    const std::shared_ptr<const NodeSharedLayout> &layout) {
+  if (layout == nullptr) {
+    obsDistribution.allGatherv(localValues);
+    return NodeSharedVector<VariableType>(std::move(localValues));
+  }
+  return NodeSharedVector<VariableType>(layout, localValues);
+}
+
+template <typename VariableType>
+NodeSharedVector<VariableType> getSharedVariableFromObsSpaceImpl(
+    const std::string &group, const std::string &variable,
+    const ioda::ObsSpace &obsdb, const ioda::Distribution &obsDistribution,
+    const std::shared_ptr<const NodeSharedLayout> &layout) {
+  std::vector<VariableType> result(obsdb.nlocs());
+  obsdb.get_db(group, variable, result);
+  return gatherShared(std::move(result), obsDistribution, layout);
+}
+
+/// Return the indices of the nonzero elements of \p isValid.
+template <typename Container>
+std::vector<size_t> getNonzeroElementIndices(const Container &isValid) {
+  std::vector<size_t> validObsIds;
+  for (size_t obsId = 0; obsId < isValid.size(); ++obsId)
+    if (isValid[obsId])
+      validObsIds.push_back(obsId);
+  return validObsIds;
+}
+
 /// Return the vector of elements of \p categories with indices \p validObsIds.
-template <typename T>
-std::vector<T> getValidObservationCategories(const std::vector<T> &categories,
-                                             const std::vector<size_t> &validObsIds) {
-  std::vector<T> validObsCategories(validObsIds.size());
+template <typename Container>
+std::vector<typename Container::value_type> getValidObservationCategories(
+    const Container &categories, const std::vector<size_t> &validObsIds) {
+  std::vector<typename Container::value_type> validObsCategories(validObsIds.size());
   for (size_t validObsIndex = 0; validObsIndex < validObsIds.size(); ++validObsIndex) {
     validObsCategories[validObsIndex] = categories[validObsIds[validObsIndex]];
   }
@@ -59,6 +93,29 @@ void groupObservationsByVariableImpl(
   splitter.groupBy(validObsCategories);
 }
 
+template <typename VariableType>
+void groupObservationsByVariableImpl(
+    const Variable &variable,
+    const std::vector<size_t> &validObsIds,
+    const ioda::ObsSpace &obsdb,
+    const ioda::Distribution &obsDistribution,
+    const std::shared_ptr<const NodeSharedLayout> &layout,
+    RecursiveSplitter &splitter) {
+  if (layout == nullptr) {
+    groupObservationsByVariableImpl<VariableType>(variable, validObsIds, obsdb, obsDistribution,
+                                                  splitter);
+    return;
+  }
+  const NodeSharedVector<VariableType> obsCategories =
+      getSharedVariableFromObsSpaceImpl<VariableType>(variable.group(), variable.variable(),
+                                                      obsdb, obsDistribution, layout);
+
+  const std::vector<VariableType> validObsCategories = getValidObservationCategories(
+        obsCategories, validObsIds);
+
+  splitter.groupBy(validObsCategories);
+}
+
 }  // namespace
 
 ObsAccessor::ObsAccessor(const ioda::ObsSpace &obsdb,
@@ -99,32 +156,36 @@ ObsAccessor ObsAccessor::toObservationsSplitIntoIndependentGroupsByVariable(
 
 std::vector<size_t> ObsAccessor::getValidObservationIds(
     const std::vector<bool> &apply, const ioda::ObsDataVector<int> &flags) const {
+  if (nodeSharedLayout_ != nullptr) {
+    std::vector<unsigned char> localApply(apply.size());
+    for (size_t obsId = 0; obsId < apply.size(); ++obsId)
+      localApply[obsId] = apply[obsId] && flags[0][obsId] == QCflags::pass;
+    return getNonzeroElementIndices(NodeSharedVector<unsigned char>(nodeSharedLayout_,
+                                                                    localApply));
+  }
+
   // TODO(wsmigaj): use std::vector<unsigned char> to save space
   std::vector<int> globalApply(apply.size());
   for (size_t obsId = 0; obsId < apply.size(); ++obsId)
     globalApply[obsId] = apply[obsId] && flags[0][obsId] == QCflags::pass;
   obsDistribution_->allGatherv(globalApply);
 
-  std::vector<size_t> validObsIds;
-  for (size_t obsId = 0; obsId < globalApply.size(); ++obsId)
-    if (globalApply[obsId])
-      validObsIds.push_back(obsId);
-
-  return validObsIds;
+  return getNonzeroElementIndices(globalApply);
 }
 
 std::vector<size_t> ObsAccessor::getValidObservationIds(
     const std::vector<bool> &apply) const {
+  if (nodeSharedLayout_ != nullptr) {
+    const std::vector<unsigned char> localApply(apply.begin(), apply.end());
+    return getNonzeroElementIndices(NodeSharedVector<unsigned char>(nodeSharedLayout_,
+                                                                    localApply));
+  }
+
   // TODO(wsmigaj): use std::vector<unsigned char> to save space
   std::vector<int> globalApply(apply.begin(), apply.end());
   obsDistribution_->allGatherv(globalApply);
 
-  std::vector<size_t> validObsIds;
-  for (size_t obsId = 0; obsId < globalApply.size(); ++obsId)
-    if (globalApply[obsId])
-      validObsIds.push_back(obsId);
-
-  return validObsIds;
+  return getNonzeroElementIndices(globalApply);
 }
 
 std::vector<int> ObsAccessor::getIntVariableFromObsSpace(
@@ -152,12 +213,34 @@ std::vector<util::DateTime> ObsAccessor::getDateTimeVariableFromObsSpace(
   return getVariableFromObsSpaceImpl<util::DateTime>(group, variable, *obsdb_, *obsDistribution_);
 }
 
+NodeSharedVector<int> ObsAccessor::getSharedIntVariableFromObsSpace(
+    const std::string &group, const std::string &variable) const {
+  return getSharedVariableFromObsSpaceImpl<int>(group, variable, *obsdb_, *obsDistribution_,
+                                                nodeSharedLayout_);
+}
+
+NodeSharedVector<float> ObsAccessor::getSharedFloatVariableFromObsSpace(
+    const std::string &group, const std::string &variable) const {
+  return getSharedVariableFromObsSpaceImpl<float>(group, variable, *obsdb_, *obsDistribution_,
+                                                  nodeSharedLayout_);
+}
+
+NodeSharedVector<double> ObsAccessor::getSharedDoubleVariableFromObsSpace(
+    const std::string &group, const std::string &variable) const {
+  return getSharedVariableFromObsSpaceImpl<double>(group, variable, *obsdb_, *obsDistribution_,
+                                                   nodeSharedLayout_);
+}
+
 std::vector<size_t> ObsAccessor::getRecordIds() const {
   std::vector<size_t> recordIds = obsdb_->recnum();
   obsDistribution_->allGatherv(recordIds);
   return recordIds;
 }
 
+NodeSharedVector<size_t> ObsAccessor::getSharedRecordIds() const {
+  return gatherShared(obsdb_->recnum(), *obsDistribution_, nodeSharedLayout_);
+}
+
 size_t ObsAccessor::totalNumObservations() const {
   return obsdb_->globalNumLocs();
 }
@@ -193,7 +276,7 @@ void ObsAccessor::groupObservationsByCategoryVariable(
   switch (obsdb_->dtype(categoryVariable_->group(), categoryVariable_->variable())) {
   case ioda::ObsDtype::Integer:
     groupObservationsByVariableImpl<int>(*categoryVariable_, validObsIds,
-                                         *obsdb_, *obsDistribution_, splitter);
+                                         *obsdb_, *obsDistribution_, nodeSharedLayout_, splitter);
     break;
 
   case ioda::ObsDtype::String:
@@ -224,6 +307,22 @@ void ObsAccessor::flagRejectedObservations(
   }
 }
 
+void ObsAccessor::setNodeSharedMemory(bool enabled) {
+  nodeSharedLayout_.reset();
+  if (!enabled || groupBy_ == GroupBy::RECORD_ID)
+    return;
+
+  // Data are gathered by concatenating the locations held on successive ranks. This matches the
+  // global location indices used by the distribution only if each location is held by one rank.
+  auto layout = std::make_shared<const NodeSharedLayout>(obsdb_->comm(), obsdb_->nlocs());
+  if (layout->globalSize() == obsdb_->globalNumLocs()) {
+    nodeSharedLayout_ = std::move(layout);
+  } else {
+    oops::Log::trace() << "ObservationAccessor: locations held on multiple ranks, "
+                       << "node-shared mode disabled" << std::endl;
+  }
+}
+
 bool ObsAccessor::wereRecordsGroupedByCategoryVariable() const {
   std::vector<std::string> groupingVars = obsdb_->obs_group_vars();
   std::string groupingVar;
@@ -16,6 +16,7 @@
 
 #include "oops/util/DateTime.h"
 #include "ufo/filters/Variable.h"
+#include "ufo/utils/NodeSharedVector.h"
 
 namespace ioda {
 class Distribution;
@@ -51,6 +52,11 @@ class RecursiveSplitter;
 /// Call splitObservationsIntoIndependentGroups() to construct a RecursiveSplitter object whose
 /// groups() method will return groups of observations that can be processed independently from
 /// each other (according to the criterion specified when the ObsAccessor was constructed).
+///
+/// By default, vectors constructed from data obtained from all MPI ranks are stored separately on
+/// each rank. Call setNodeSharedMemory(true) to store them instead only once per (shared-memory)
+/// node, in memory shared by all ranks running on that node; use the getShared...() methods to
+/// access them.
 class ObsAccessor {
  public:
   ~ObsAccessor() = default;
@@ -140,6 +146,19 @@ class ObsAccessor {
   std::vector<util::DateTime> getDateTimeVariableFromObsSpace(const std::string &group,
                                                               const std::string &variable) const;
 
+  /// \brief Return a read-only view of the values of the specified variable at successive
+  /// observation locations.
+  ///
+  /// The values are the same as those returned by the corresponding get...VariableFromObsSpace()
+  /// method. In the node-shared mode (see setNodeSharedMemory()), values obtained from all ranks
+  /// are stored only once per node.
+  NodeSharedVector<int> getSharedIntVariableFromObsSpace(const std::string &group,
+                                                         const std::string &variable) const;
+  NodeSharedVector<float> getSharedFloatVariableFromObsSpace(const std::string &group,
+                                                             const std::string &variable) const;
+  NodeSharedVector<double> getSharedDoubleVariableFromObsSpace(const std::string &group,
+                                                               const std::string &variable) const;
+
   /// \brief Return the vector of IDs of records successive observation locations belong to.
   ///
   /// If each independent group of observations is stored entirely on a single MPI rank, the
@@ -147,6 +166,13 @@ class ObsAccessor {
   /// only. Otherwise the vector is a concatenation of vectors obtained on all ranks.
   std::vector<size_t> getRecordIds() const;
 
+  /// \brief Return a read-only view of the vector of IDs of records successive observation
+  /// locations belong to.
+  ///
+  /// In the node-shared mode (see setNodeSharedMemory()), record IDs obtained from all ranks are
+  /// stored only once per node.
+  NodeSharedVector<size_t> getSharedRecordIds() const;
+
   /// If each independent group of observations is stored entirely on a single MPI rank, return the
   /// number of observation locations held on the current rank. Otherwise return the total number
   /// of observation locations held on all ranks.
@@ -171,6 +197,21 @@ class ObsAccessor {
   void flagRejectedObservations(const std::vector<bool> &isRejected,
                                 std::vector<std::vector<bool> > &flagged) const;
 
+  /// \brief Enable or disable the node-shared mode (disabled by default).
+  ///
+  /// In this mode, data that need to be obtained from all MPI ranks are gathered into an MPI-3
+  /// shared-memory window allocated once per node. Only one rank on each node takes part in the
+  /// exchange of data between nodes. Data gathered by getValidObservationIds() and the
+  /// getShared...() methods are then stored once per node rather than once per rank.
+  ///
+  /// This is a collective operation. It has no effect if each independent group of observations
+  /// is held on a single MPI rank (no data are then exchanged) or if the observation space
+  /// distribution doesn't assign each location to a single rank.
+  ///
+  /// \note Views returned by the getShared...() methods must be destroyed in the same order on
+  /// all ranks, since releasing shared memory is a collective operation.
+  void setNodeSharedMemory(bool enabled);
+
  private:
   enum class GroupBy { NOTHING, RECORD_ID, VARIABLE };
 
@@ -195,6 +236,8 @@ class ObsAccessor {
 
   GroupBy groupBy_;
   boost::optional<Variable> categoryVariable_;
+  /// Set in the node-shared mode if data need to be gathered from all ranks.
+  std::shared_ptr<const NodeSharedLayout> nodeSharedLayout_;
 };
 
 }  // namespace ufo
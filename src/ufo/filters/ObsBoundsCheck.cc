@@ -9,8 +9,11 @@
 
 #include <algorithm>
 #include <set>
+#include <utility>
 #include <vector>
 
+#include <boost/make_unique.hpp>
+
 #include "eckit/config/Configuration.h"
 
 #include "ioda/ObsDataVector.h"
@@ -30,34 +33,52 @@ namespace {
 
 // -----------------------------------------------------------------------------
 
-/// Set each element of \p flagged to true if the corresponding element of \p apply is true
-/// and the corresponding element of \p testValues is a non-missing value lying outside the
-/// closed interval [\p minValue, \p maxValue].
-void flagWhereOutOfBounds(const std::vector<bool> & apply,
-                          const std::vector<float> & testValues,
-                          float minValue,
-                          float maxValue,
-                          bool treatMissingAsOutOfBounds,
-                          std::vector<bool> &flagged) {
-  const size_t nlocs = testValues.size();
-  ASSERT(apply.size() == nlocs);
-  ASSERT(flagged.size() == nlocs);
-
-  const float missing = util::missingValue(missing);
-  for (size_t i = 0; i < nlocs; ++i) {
-    if (apply[i]) {
-      if (testValues[i] != missing) {
-        if (minValue != missing && testValues[i] < minValue)
-          flagged[i] = true;
-        if (maxValue != missing && testValues[i] > maxValue)
-          flagged[i] = true;
-      } else {
-        if (treatMissingAsOutOfBounds)
-          flagged[i] = true;
-      }
+/// Flags locations at which a test variable is a non-missing value lying outside the closed
+/// interval [minValue, maxValue] (or, optionally, is missing).
+class BoundsLocationCheck : public LocationCheck {
+ public:
+  /// \param testValues
+  ///   Values of all primitive test variables.
+  /// \param flagIfAnyTestVarOutOfBounds
+  ///   If true, each filter variable is flagged wherever any test variable is out of bounds;
+  ///   otherwise the jth filter variable is flagged wherever the jth test variable is.
+  BoundsLocationCheck(std::vector<std::vector<float>> testValues, float minValue, float maxValue,
+                      bool treatMissingAsOutOfBounds, bool flagIfAnyTestVarOutOfBounds)
+    : testValues_(std::move(testValues)), minValue_(minValue), maxValue_(maxValue),
+      treatMissingAsOutOfBounds_(treatMissingAsOutOfBounds),
+      flagIfAnyTestVarOutOfBounds_(flagIfAnyTestVarOutOfBounds)
+  {}
+
+  void check(size_t jv, const std::vector<size_t> & locs,
+             std::vector<size_t> & failed) const override {
+    if (!flagIfAnyTestVarOutOfBounds_) {
+      ASSERT(jv < testValues_.size());
+      for (size_t jobs : locs)
+        if (outOfBounds(testValues_[jv][jobs])) failed.push_back(jobs);
+    } else {
+      for (size_t jobs : locs)
+        if (std::any_of(testValues_.begin(), testValues_.end(),
+                        [&](const std::vector<float> & values)
+                        { return outOfBounds(values[jobs]); }))
+          failed.push_back(jobs);
     }
   }
-}
+
+ private:
+  bool outOfBounds(float value) const {
+    const float missing = util::missingValue(missing);
+    if (value == missing)
+      return treatMissingAsOutOfBounds_;
+    return (minValue_ != missing && value < minValue_) ||
+           (maxValue_ != missing && value > maxValue_);
+  }
+
+  std::vector<std::vector<float>> testValues_;
+  float minValue_;
+  float maxValue_;
+  bool treatMissingAsOutOfBounds_;
+  bool flagIfAnyTestVarOutOfBounds_;
+};
 
 }  // namespace
 
@@ -66,7 +87,7 @@ void flagWhereOutOfBounds(const std::vector<bool> & apply,
 ObsBoundsCheck::ObsBoundsCheck(ioda::ObsSpace & obsdb, const Parameters_ & parameters,
                                std::shared_ptr<ioda::ObsDataVector<int> > flags,
                                std::shared_ptr<ioda::ObsDataVector<float> > obserr)
-  : FilterBase(obsdb, parameters, flags, obserr), parameters_(parameters)
+  : LocationCheckFilter(obsdb, parameters, flags, obserr), parameters_(parameters)
 {
   if (parameters_.testVariables.value() != boost::none) {
     for (const Variable & var : *parameters_.testVariables.value())
@@ -81,9 +102,7 @@ ObsBoundsCheck::~ObsBoundsCheck() {}
 
 // -----------------------------------------------------------------------------
 
-void ObsBoundsCheck::applyFilter(const std::vector<bool> & apply,
-                                 const Variables & filtervars,
-                                 std::vector<std::vector<bool>> & flagged) const {
+std::unique_ptr<LocationCheck> ObsBoundsCheck::locationCheck(const ObsFilterData & data) const {
   // Find the variables that should be tested. Use the variables specified in the 'test variables'
   // option if present, otherwise the filter variables.
   ufo::Variables testvars;
@@ -91,12 +110,12 @@ void ObsBoundsCheck::applyFilter(const std::vector<bool> & apply,
     for (const Variable & var : *parameters_.testVariables.value())
       testvars += var;
   } else {
-    testvars += ufo::Variables(filtervars, "ObsValue");
+    testvars += ufo::Variables(filtervars_, "ObsValue");
   }
   if (!testvars)
     throw eckit::UserError("ObsBoundsCheck: The list of test variables is empty", Here());
 
-  oops::Log::debug() << "ObsBoundsCheck: filtering " << filtervars << " with "
+  oops::Log::debug() << "ObsBoundsCheck: filtering " << filtervars_ << " with "
                      << testvars << std::endl;
 
   // Retrieve the bounds.
@@ -111,34 +130,19 @@ void ObsBoundsCheck::applyFilter(const std::vector<bool> & apply,
        testvars.nvars() == 1);
   const bool treatMissingAsOutOfBounds = parameters_.treatMissingAsOutOfBounds;
 
-  // Do the actual work.
-  if (flagAllFilterVarsIfAnyTestVarOutOfBounds) {
-    std::vector<bool> anyTestVarOutOfBounds(obsdb_.nlocs(), false);
-    // Loop over all channels of all test variables and record all locations where any of these
-    // channels is out of bounds.
-    for (PrimitiveVariable singleChannelTestVar : PrimitiveVariables(testvars, data_)) {
-      const std::vector<float> & testValues = singleChannelTestVar.values();
-      flagWhereOutOfBounds(apply, testValues, vmin, vmax, treatMissingAsOutOfBounds,
-                           anyTestVarOutOfBounds);
-    }
-    // Copy these flags to the flags of all filtered variables.
-    for (std::vector<bool> &f : flagged)
-      f = anyTestVarOutOfBounds;
-  } else {
-    if (filtervars.nvars() != testvars.nvars())
-      throw eckit::UserError("The number of 'primitive' (single-channel) test variables must match "
-                             "that of 'primitive' filter variables unless the 'flag all filter "
-                             "variables if any test variable is out of bounds' option is set");
-    // Loop over all channels of all test variables and for each locations where that channel is out
-    // of bounds, flag the corresponding filter variable channel.
-    ASSERT(filtervars.nvars() == flagged.size());
-    size_t ifiltervar = 0;
-    for (PrimitiveVariable singleChannelTestVar : PrimitiveVariables(testvars, data_)) {
-      const std::vector<float> & testValues = singleChannelTestVar.values();
-      flagWhereOutOfBounds(apply, testValues, vmin, vmax, treatMissingAsOutOfBounds,
-                           flagged[ifiltervar++]);
-    }
-  }
+  if (!flagAllFilterVarsIfAnyTestVarOutOfBounds && filtervars_.nvars() != testvars.nvars())
+    throw eckit::UserError("The number of 'primitive' (single-channel) test variables must match "
+                           "that of 'primitive' filter variables unless the 'flag all filter "
+                           "variables if any test variable is out of bounds' option is set");
+
+  // Collect the values of all channels of all test variables.
+  std::vector<std::vector<float>> testValues;
+  for (PrimitiveVariable singleChannelTestVar : PrimitiveVariables(testvars, data))
+    testValues.push_back(singleChannelTestVar.values());
+
+  return boost::make_unique<BoundsLocationCheck>(std::move(testValues), vmin, vmax,
+                                                 treatMissingAsOutOfBounds,
+                                                 flagAllFilterVarsIfAnyTestVarOutOfBounds);
 }
 
 // -----------------------------------------------------------------------------
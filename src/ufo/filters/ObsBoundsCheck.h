@@ -16,7 +16,7 @@
 #include "oops/util/ObjectCounter.h"
 #include "oops/util/parameters/OptionalParameter.h"
 #include "oops/util/parameters/RequiredParameter.h"
-#include "ufo/filters/FilterBase.h"
+#include "ufo/filters/LocationCheckFilter.h"
 #include "ufo/filters/QCflags.h"
 #include "ufo/filters/Variable.h"
 #include "ufo/utils/parameters/ParameterTraitsVariable.h"
@@ -81,7 +81,7 @@ class ObsBoundsCheckParameters : public FilterParametersBase {
 ///
 /// See ObsBoundsCheckParameters for the documentation of the parameters controlling this filter.
 
-class ObsBoundsCheck : public FilterBase,
+class ObsBoundsCheck : public LocationCheckFilter,
                        private util::ObjectCounter<ObsBoundsCheck> {
  public:
   /// The type of parameters accepted by the constructor of this filter.
@@ -95,10 +95,12 @@ class ObsBoundsCheck : public FilterBase,
                  std::shared_ptr<ioda::ObsDataVector<float> >);
   ~ObsBoundsCheck();
 
+  bool isThreadSafe() const override {return true;}
+
+  std::unique_ptr<LocationCheck> locationCheck(const ObsFilterData &) const override;
+
  private:
   void print(std::ostream &) const override;
-  void applyFilter(const std::vector<bool> &, const Variables &,
-                   std::vector<std::vector<bool>> &) const override;
   int qcFlag() const override {return QCflags::bounds;}
   Parameters_ parameters_;
 };
@@ -0,0 +1,204 @@
+/*
+ * (C) Crown copyright 2021, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#include "ufo/filters/ObsColumnStore.h"
+
+#include "eckit/exception/Exceptions.h"
+
+#include "ioda/ObsSpace.h"
+#include "oops/util/Logger.h"
+#include "ufo/filters/obsfunctions/ObsFunction.h"
+#include "ufo/filters/Variable.h"
+#include "ufo/filters/Variables.h"
+
+namespace ufo {
+
+namespace {
+
+/// Return true if variables from group \p group may be held in the ObsSpace.
+bool isObsSpaceGroup(const std::string & group) {
+  static const std::set<std::string> otherGroups{
+    "GeoVaLs", "HofX", "ObsDiag", "ObsBiasTerm", "ObsFunction", "QCflagsData", "ObsErrorData",
+    "VarMetaData"};
+  return otherGroups.count(group) == 0;
+}
+
+}  // namespace
+
+// -----------------------------------------------------------------------------
+
+ObsColumnStore::ObsColumnStore(ioda::ObsSpace & obsdb)
+  : obsdb_(obsdb)
+{}
+
+// -----------------------------------------------------------------------------
+
+ObsColumnStore::ConcurrentAccess::ConcurrentAccess(ObsColumnStore & store)
+  : store_(store)
+{
+  store_.prefetch();
+  ++store_.concurrentAccess_;
+}
+
+// -----------------------------------------------------------------------------
+
+ObsColumnStore::ConcurrentAccess::~ConcurrentAccess() {
+  --store_.concurrentAccess_;
+}
+
+// -----------------------------------------------------------------------------
+
+template <typename T>
+const std::vector<T> & ObsColumnStore::load(const Key & key) {
+  Columns<T> & cols = columns<T>();
+  typename Columns<T>::iterator it = cols.find(key);
+  if (it == cols.end()) {
+    // Columns are normally loaded by the ConcurrentAccess constructor. Those required but
+    // requested as a different type are loaded now; mutex_ keeps the ObsSpace reads serialized.
+    if (concurrentAccess_ > 0 && required_.count(key) == 0)
+      throw eckit::UserError("ObsColumnStore: " + key.second + "@" + key.first + " is read by "
+                             "a filter running concurrently with others but wasn't declared in "
+                             "its allvars_", Here());
+    std::vector<T> values(obsdb_.nlocs());
+    obsdb_.get_db(key.first, key.second, values);
+    // Inserting into a map doesn't invalidate references to its other elements.
+    it = cols.emplace(key, std::move(values)).first;
+  }
+  return it->second;
+}
+
+// -----------------------------------------------------------------------------
+
+template <>
+ObsColumnStore::Columns<float> & ObsColumnStore::columns<float>() {return floats_;}
+template <>
+ObsColumnStore::Columns<int> & ObsColumnStore::columns<int>() {return ints_;}
+template <>
+ObsColumnStore::Columns<std::string> & ObsColumnStore::columns<std::string>() {return strings_;}
+template <>
+ObsColumnStore::Columns<util::DateTime> & ObsColumnStore::columns<util::DateTime>() {
+  return datetimes_;
+}
+
+// -----------------------------------------------------------------------------
+
+void ObsColumnStore::require(const Variables & vars) {
+  for (size_t ivar = 0; ivar < vars.size(); ++ivar) {
+    const Variable & var = vars[ivar];
+    if (var.group() == "ObsFunction") {
+      ObsFunction obsfunc(var);
+      this->require(obsfunc.requiredVariables());
+    } else if (isObsSpaceGroup(var.group())) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      for (size_t jch = 0; jch < var.size(); ++jch)
+        required_.insert(Key(var.group(), var.variable(jch)));
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+void ObsColumnStore::prefetch() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  size_t nloaded = 0;
+  for (const Key & key : required_) {
+    // Variables that don't exist yet may be created later, e.g. by Variable Transforms.
+    if (!obsdb_.has(key.first, key.second)) continue;
+    switch (obsdb_.dtype(key.first, key.second)) {
+    case ioda::ObsDtype::Integer:
+      if (ints_.count(key) == 0) {load<int>(key); ++nloaded;}
+      break;
+    case ioda::ObsDtype::String:
+      if (strings_.count(key) == 0) {load<std::string>(key); ++nloaded;}
+      break;
+    case ioda::ObsDtype::DateTime:
+      if (datetimes_.count(key) == 0) {load<util::DateTime>(key); ++nloaded;}
+      break;
+    default:
+      if (floats_.count(key) == 0) {load<float>(key); ++nloaded;}
+      break;
+    }
+  }
+  oops::Log::debug() << "ObsColumnStore::prefetch: loaded " << nloaded << " of "
+                     << required_.size() << " required columns" << std::endl;
+}
+
+// -----------------------------------------------------------------------------
+
+bool ObsColumnStore::has(const std::string & group, const std::string & var) const {
+  return isObsSpaceGroup(group) && obsdb_.has(group, var);
+}
+
+// -----------------------------------------------------------------------------
+
+template <typename T>
+const std::vector<T> & ObsColumnStore::column(const std::string & group,
+                                              const std::string & var) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return load<T>(Key(group, var));
+}
+
+template const std::vector<float> & ObsColumnStore::column<float>(
+    const std::string &, const std::string &);
+template const std::vector<int> & ObsColumnStore::column<int>(
+    const std::string &, const std::string &);
+template const std::vector<std::string> & ObsColumnStore::column<std::string>(
+    const std::string &, const std::string &);
+template const std::vector<util::DateTime> & ObsColumnStore::column<util::DateTime>(
+    const std::string &, const std::string &);
+
+// -----------------------------------------------------------------------------
+
+void ObsColumnStore::invalidate() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  clear();
+}
+
+// -----------------------------------------------------------------------------
+
+void ObsColumnStore::startStage() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  ++stage_;
+  clear();
+}
+
+// -----------------------------------------------------------------------------
+
+const std::vector<std::vector<size_t>> & ObsColumnStore::records() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  // The grouping of locations into records is fixed when the ObsSpace is created, so the
+  // indices are kept when the store is invalidated.
+  if (!records_) {
+    records_.reset(new std::vector<std::vector<size_t>>);
+    for (ioda::ObsSpace::RecIdxIter irec = obsdb_.recidx_begin();
+         irec != obsdb_.recidx_end(); ++irec)
+      records_->push_back(obsdb_.recidx_vector(irec));
+  }
+  return *records_;
+}
+
+// -----------------------------------------------------------------------------
+
+void ObsColumnStore::ensureSerial(const std::string & what) const {
+  if (concurrentAccess_ > 0)
+    throw eckit::UserError("ObsColumnStore: " + what + " isn't possible in a filter running "
+                           "concurrently with others; apply this filter outside Concurrent "
+                           "Filters", Here());
+}
+
+// -----------------------------------------------------------------------------
+
+void ObsColumnStore::clear() {
+  floats_.clear();
+  ints_.clear();
+  strings_.clear();
+  datetimes_.clear();
+}
+
+// -----------------------------------------------------------------------------
+
+}  // namespace ufo
@@ -0,0 +1,152 @@
+/*
+ * (C) Crown copyright 2021, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef UFO_FILTERS_OBSCOLUMNSTORE_H_
+#define UFO_FILTERS_OBSCOLUMNSTORE_H_
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>  // NOLINT(build/c++11)
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+
+#include "oops/util/DateTime.h"
+
+namespace ioda {
+  class ObsSpace;
+}
+
+namespace ufo {
+  class Variables;
+
+/// \brief Cache of ObsSpace columns read by the filters applied to an ObsSpace.
+///
+/// Without this cache, every filter and ObsFunction reads and converts its inputs from the
+/// ObsSpace independently, so columns such as latitude@MetaData or the ObsValues are fetched many
+/// times per cycle. An ObsColumnStore holds typed copies of these columns, each read at most once
+/// and then shared by all filters of a chain through ObsFilterData.
+///
+/// Filters declare the variables they use with require(); the columns of all variables required
+/// so far and not loaded yet are read together by prefetch(), which ObsProcessorBase calls before
+/// applying a filter. Columns requested with column() but never required are read on first use.
+///
+/// Cached columns become stale when the ObsSpace is modified. The store must therefore be
+/// invalidated:
+///
+/// * after applying a processor that may write to the ObsSpace (see
+///   ObsProcessorBase::modifiesObsSpace());
+/// * at the start of each filter stage, since the ObsSpace may have been modified by code run
+///   between stages (e.g. observation operators); QCmanager, which is applied before all other
+///   filters at each stage, does this by calling startStage() from preProcess(), priorFilter()
+///   and postFilter().
+///
+/// Each filter chain has its own store, owned by the chain's FilterChainState and shared by the
+/// ObsFilterData objects of the chain's filters; code outside filter chains reads the ObsSpace
+/// directly. All member functions are thread-safe. References returned by column() remain valid
+/// until the next call to invalidate() or startStage().
+///
+/// The ObsSpace itself must not be read by several threads at once. Code running filters
+/// concurrently must therefore create a ConcurrentAccess object beforehand; while it exists,
+/// only columns of required variables and record indices can be retrieved, and code that needs
+/// the ObsSpace for anything else must call ensureSerial() first.
+class ObsColumnStore : private boost::noncopyable {
+ public:
+  /// \brief Marks the section in which the store is used by filters running concurrently.
+  ///
+  /// The constructor loads the columns of all variables required so far. Until the object is
+  /// destroyed, column() throws an exception when asked for a column of a variable that hasn't
+  /// been required.
+  class ConcurrentAccess : private boost::noncopyable {
+   public:
+    explicit ConcurrentAccess(ObsColumnStore & store);
+    ~ConcurrentAccess();
+
+   private:
+    ObsColumnStore & store_;
+  };
+
+  explicit ObsColumnStore(ioda::ObsSpace & obsdb);
+
+  /// Declare that the columns of all variables in \p vars held in the ObsSpace (including
+  /// variables used by ObsFunctions in \p vars) will be needed.
+  void require(const Variables & vars);
+
+  /// Load the columns of all required variables that haven't been loaded yet.
+  void prefetch();
+
+  /// Return true if variable \p var from group \p group is held in the ObsSpace (and so can be
+  /// retrieved with column()).
+  bool has(const std::string & group, const std::string & var) const;
+
+  /// Return the values of variable \p var from group \p group, loading them if necessary.
+  /// T must be float, int, std::string or util::DateTime.
+  ///
+  /// Throws an exception if a ConcurrentAccess object exists and the variable hasn't been
+  /// required.
+  template <typename T>
+  const std::vector<T> & column(const std::string & group, const std::string & var);
+
+  /// Discard all loaded columns; those still required will be loaded again by the next call
+  /// to prefetch() or column().
+  void invalidate();
+
+  /// Start a new filter stage: discard all loaded columns and increment the stage counter.
+  void startStage();
+
+  /// Return the number of filter stages started so far.
+  size_t stage() const {return stage_;}
+
+  /// Return the indices of the locations of each record of the ObsSpace, in the order given by
+  /// ObsSpace::recidx_vector(), loading them if necessary.
+  const std::vector<std::vector<size_t>> & records();
+
+  /// Return true if a ConcurrentAccess object exists, i.e. the ObsSpace mustn't be read other
+  /// than through the store.
+  bool concurrentAccess() const {return concurrentAccess_ > 0;}
+
+  /// Throw an exception if a ConcurrentAccess object exists. To be called before \p what, an
+  /// operation that reads the ObsSpace directly or needs all MPI tasks to take part.
+  void ensureSerial(const std::string & what) const;
+
+ private:
+  typedef std::pair<std::string, std::string> Key;  // group, variable
+
+  template <typename T>
+  using Columns = std::map<Key, std::vector<T>>;
+
+  /// Load column \p key of type T unless it has already been loaded.
+  /// Must be called with mutex_ locked.
+  template <typename T>
+  const std::vector<T> & load(const Key & key);
+
+  /// Return the loaded columns of type T.
+  template <typename T>
+  Columns<T> & columns();
+
+  /// Discard all loaded columns. Must be called with mutex_ locked.
+  void clear();
+
+  ioda::ObsSpace & obsdb_;
+  std::mutex mutex_;
+  std::set<Key> required_;
+  Columns<float> floats_;
+  Columns<int> ints_;
+  Columns<std::string> strings_;
+  Columns<util::DateTime> datetimes_;
+  std::unique_ptr<std::vector<std::vector<size_t>>> records_;
+  size_t stage_ = 0;
+  std::atomic<int> concurrentAccess_{0};
+};
+
+}  // namespace ufo
+
+#endif  // UFO_FILTERS_OBSCOLUMNSTORE_H_
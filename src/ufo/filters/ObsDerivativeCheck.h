@@ -41,6 +41,8 @@ class ObsDerivativeCheck : public FilterBase,
                      std::shared_ptr<ioda::ObsDataVector<float> >);
   ~ObsDerivativeCheck();
 
+  bool modifiesObsSpace() const override {return false;}
+
  private:
   void print(std::ostream &) const override;
   void applyFilter(const std::vector<bool> &, const Variables &,
@@ -56,6 +56,8 @@ class ObsDomainCheck : public FilterBase,
                  std::shared_ptr<ioda::ObsDataVector<float> >);
   ~ObsDomainCheck();
 
+  bool isThreadSafe() const override {return true;}
+
  private:
   void print(std::ostream &) const override;
   void applyFilter(const std::vector<bool> &, const Variables &,
@@ -19,7 +19,8 @@
 #include "oops/util/abor1_cpp.h"
 #include "oops/util/Logger.h"
 #include "oops/util/missingValues.h"
-#include "ufo/filters/obsfunctions/ObsFunctionScattering.h"
+#include "ufo/filters/Variable.h"
+#include "ufo/filters/Variables.h"
 
 namespace ufo {
 
@@ -33,6 +34,8 @@ ObsDomainErrCheck::ObsDomainErrCheck(ioda::ObsSpace & obsdb, const Parameters_ &
 {
   oops::Log::debug() << "ObsDomainErrCheck: config = " << parameters_ << std::endl;
   ASSERT(obserr);
+  allvars_ += Variables(filtervars_, "ObsValue");
+  allvars_ += Variable("Scattering@ObsFunction");
 }
 
 // -----------------------------------------------------------------------------
@@ -46,28 +49,25 @@ void ObsDomainErrCheck::applyFilter(const std::vector<bool> & inside,
                                     std::vector<std::vector<bool>> & flagged) const {
   const oops::Variables observed = obsdb_.obsvariables();
 
-  ioda::ObsDataVector<float> obs(obsdb_, filtervars.toOopsVariables(), "ObsValue");
+  const Variables varobs(filtervars, "ObsValue");
   size_t nlocs = obsdb_.nlocs();
 
 // compute function
-  std::vector<float> values(nlocs);
-  ioda::ObsDataVector<float> vals(obsdb_, "Scattering");
-  ObsFunctionScattering obsdiag;
-  obsdiag.compute(data_, vals);
-  for (size_t jj = 0; jj < nlocs; ++jj) {
-    values[jj] = vals["Scattering"][jj];
-  }
+  std::vector<float> values;
+  data_.get(Variable("Scattering@ObsFunction"), values);
 
   size_t count = 0;
   const float parameter = parameters_.infltparameter;
+  std::vector<float> buffer;
   for (size_t jv = 0; jv < filtervars.nvars(); ++jv) {
     size_t iv = observed.find(filtervars.variable(jv).variable());
-    for (size_t jobs = 0; jobs < obsdb_.nlocs(); ++jobs) {
+    const std::vector<float> & obs = data_.getRef(varobs.variable(jv), buffer);
+    for (size_t jobs = 0; jobs < nlocs; ++jobs) {
       if (!inside[jobs]) {
         flagged[jv][jobs] = true;
       } else {
         ASSERT((*obserr_)[iv][jobs] != util::missingValue((*obserr_)[iv][jobs]));
-        ASSERT(obs[jv][jobs] != util::missingValue(obs[jv][jobs]));
+        ASSERT(obs[jobs] != util::missingValue(obs[jobs]));
         float bound = 2.5 * (*obserr_)[iv][jobs];
         float obserrinc = parameter * std::max((values[jobs]-9.0), 0.0) * (*obserr_)[iv][jobs];
         obserrinc = std::max((*obserr_)[iv][jobs], bound);
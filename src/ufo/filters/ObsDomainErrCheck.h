@@ -53,6 +53,8 @@ class ObsDomainErrCheck : public FilterBase,
                     std::shared_ptr<ioda::ObsDataVector<float> >);
   ~ObsDomainErrCheck();
 
+  bool isThreadSafe() const override {return true;}
+
  private:
   void print(std::ostream &) const override;
   void applyFilter(const std::vector<bool> &, const Variables &,
@@ -7,6 +7,7 @@
 
 #include "ufo/filters/ObsFilterData.h"
 
+#include <algorithm>
 #include <string>
 #include <vector>
 
@@ -15,6 +16,7 @@
 #include "ioda/ObsVector.h"
 #include "oops/util/missingValues.h"
 #include "ufo/filters/obsfunctions/ObsFunction.h"
+#include "ufo/filters/Variables.h"
 #include "ufo/GeoVaLs.h"
 #include "ufo/ObsDiagnostics.h"
 
@@ -61,6 +63,51 @@ void ObsFilterData::associate(const ObsDiagnostics & diags) {
   diags_ = &diags;
 }
 
+// -----------------------------------------------------------------------------
+/*! Declares ObsSpace data needed by the filters (including data needed by ObsFunctions)
+ *  \param vars are variables used by a filter
+ */
+void ObsFilterData::require(const Variables & vars) {
+  if (columns_) columns_->require(vars);
+}
+
+// -----------------------------------------------------------------------------
+/*! Reads all ObsSpace data declared with require() and not read yet (from this or any other
+ *  ObsFilterData using the same ObsColumnStore)
+ */
+void ObsFilterData::prefetch() {
+  if (columns_) columns_->prefetch();
+}
+
+// -----------------------------------------------------------------------------
+/*! Discards ObsSpace data read so far; must be called after modifying the ObsSpace */
+void ObsFilterData::invalidateColumnStore() {
+  if (columns_) columns_->invalidate();
+}
+
+// -----------------------------------------------------------------------------
+/*! Returns the indices of the locations of each record (read through the ObsColumnStore if
+ *  there is one)
+ */
+const std::vector<std::vector<size_t>> & ObsFilterData::records() const {
+  if (columns_) return columns_->records();
+  if (records_.empty()) {
+    for (ioda::ObsSpace::RecIdxIter irec = obsdb_.recidx_begin();
+         irec != obsdb_.recidx_end(); ++irec)
+      records_.push_back(obsdb_.recidx_vector(irec));
+  }
+  return records_;
+}
+
+// -----------------------------------------------------------------------------
+/*! Throws an exception if filters are running concurrently
+ *  \param what describes the operation about to be done (reading the ObsSpace directly or
+ *         communicating with other MPI tasks)
+ */
+void ObsFilterData::ensureSerial(const std::string & what) const {
+  if (columns_) columns_->ensureSerial(what);
+}
+
 // -----------------------------------------------------------------------------
 /*! Returns number of observation locations */
 size_t ObsFilterData::nlocs() const {
@@ -121,6 +168,42 @@ bool ObsFilterData::hasDataVectorInt(const std::string & grp, const std::string
   }
 }
 
+// -----------------------------------------------------------------------------
+/*! Checks if requested data are read from the ObsSpace through the ObsColumnStore */
+bool ObsFilterData::isObsSpaceColumn(const std::string & grp, const std::string & var) const {
+  return columns_ && columns_->has(grp, var) &&
+         !this->hasVector(grp, var) && !this->hasDataVector(grp, var) &&
+         !this->hasDataVectorInt(grp, var);
+}
+
+// -----------------------------------------------------------------------------
+/*! Gets reference to requested data from ObsFilterData
+ *  \param[in] varname is a name of a variable requested
+ *  \param[in,out] buffer is used to store data if they aren't cached in the ObsColumnStore
+ *  \return reference to the cached data or to buffer
+ *  \warning the reference to cached data is valid only until the ObsColumnStore is invalidated,
+ *           i.e. it must not be kept beyond the end of the current filter
+ */
+template <typename T>
+const std::vector<T> & ObsFilterData::getRef(const Variable & varname,
+                                             std::vector<T> & buffer) const {
+  if (varname.channels().empty() &&
+      this->isObsSpaceColumn(varname.group(), varname.variable())) {
+    return columns_->column<T>(varname.group(), varname.variable());
+  }
+  this->get(varname, buffer);
+  return buffer;
+}
+
+template const std::vector<float> & ObsFilterData::getRef<float>(
+    const Variable &, std::vector<float> &) const;
+template const std::vector<int> & ObsFilterData::getRef<int>(
+    const Variable &, std::vector<int> &) const;
+template const std::vector<std::string> & ObsFilterData::getRef<std::string>(
+    const Variable &, std::vector<std::string> &) const;
+template const std::vector<util::DateTime> & ObsFilterData::getRef<util::DateTime>(
+    const Variable &, std::vector<util::DateTime> &) const;
+
 // -----------------------------------------------------------------------------
 /*! Gets requested data from ObsFilterData
  *  \param[in] varname is a name of a variable requested
@@ -132,8 +215,11 @@ void ObsFilterData::get(const Variable & varname, std::vector<float> & values) c
   const std::string grp = varname.group();
 
   if (grp == "VarMetaData") {
+    this->ensureSerial("reading " + var + "@" + grp);
     values.resize(obsdb_.nvars());
     obsdb_.get_db(grp, var, values);
+  } else if (this->isObsSpaceColumn(grp, var)) {
+    values = columns_->column<float>(grp, var);
   } else {
     ioda::ObsDataVector<float> vec(obsdb_, varname.toOopsVariables(), grp, false);
     this->get(varname, vec);
@@ -162,7 +248,10 @@ void ObsFilterData::get(const Variable & varname, std::vector<std::string> & val
                          << std::endl;
     ABORT("ObsFilterData::get std::string, int and util::DateTime values only supported for "
           "ObsSpace");
+  } else if (this->isObsSpaceColumn(grp, var)) {
+    values = columns_->column<std::string>(grp, var);
   } else {
+    this->ensureSerial("reading " + var + "@" + grp);
     values.resize(obsdb_.nlocs());
     obsdb_.get_db(grp, var, values);
   }
@@ -186,7 +275,10 @@ void ObsFilterData::get(const Variable & varname, std::vector<util::DateTime> &
                          << std::endl;
     ABORT("ObsFilterData::get std::string, int and util::DateTime values only supported for "
           "ObsSpace");
+  } else if (this->isObsSpaceColumn(grp, var)) {
+    values = columns_->column<util::DateTime>(grp, var);
   } else {
+    this->ensureSerial("reading " + var + "@" + grp);
     values.resize(obsdb_.nlocs());
     obsdb_.get_db(grp, var, values);
   }
@@ -205,6 +297,7 @@ void ObsFilterData::get(const Variable & varname, std::vector<int> & values) con
   const std::string grp = varname.group();
 
   if (grp == "VarMetaData") {
+    this->ensureSerial("reading " + var + "@" + grp);
     values.resize(obsdb_.nvars());
     obsdb_.get_db(grp, var, values);
   } else {
@@ -214,6 +307,8 @@ void ObsFilterData::get(const Variable & varname, std::vector<int> & values) con
                          << "supported for ObsSpace"
                          << std::endl;
       ABORT("ObsFilterData::get std::string and int values only supported for ObsSpace");
+    } else if (this->isObsSpaceColumn(grp, var)) {
+      values = columns_->column<int>(grp, var);
     } else {
       ioda::ObsDataVector<int> vec(obsdb_, varname.toOopsVariables(), grp, false);
       this->get(varname, vec);
@@ -294,7 +389,8 @@ void ObsFilterData::get(const Variable & varname, ioda::ObsDataVector<float> & v
     std::map<std::string, const ioda::ObsDataVector<float> *>::const_iterator
                           jv = dvecsf_.find(grp);
     values = *jv->second;
-  } else {
+  } else if (!this->readColumns(grp, values)) {
+    this->ensureSerial("reading " + var + "@" + grp);
     values.read(grp);
   }
 }
@@ -311,11 +407,32 @@ void ObsFilterData::get(const Variable & varname, ioda::ObsDataVector<int> & val
   if (this->hasDataVectorInt(grp, var)) {
     std::map<std::string, const ioda::ObsDataVector<int> *>::const_iterator jv = dvecsi_.find(grp);
     values = *jv->second;
-  } else {
+  } else if (!this->readColumns(grp, values)) {
+    this->ensureSerial("reading " + var + "@" + grp);
     values.read(grp);
   }
 }
 
+// -----------------------------------------------------------------------------
+/*! Copies ObsSpace data cached in the ObsColumnStore into ObsDataVector
+ *  \param[in] grp is the group of the variables requested
+ *  \param[out] values on output contains data of all its variables from group grp
+ *         (should be allocated on input)
+ *  \return false (and values unchanged) if any variable isn't cached in the ObsColumnStore
+ */
+template <typename T>
+bool ObsFilterData::readColumns(const std::string & grp, ioda::ObsDataVector<T> & values) const {
+  const oops::Variables & vars = values.varnames();
+  for (size_t jv = 0; jv < vars.size(); ++jv) {
+    if (!this->isObsSpaceColumn(grp, vars[jv])) return false;
+  }
+  for (size_t jv = 0; jv < vars.size(); ++jv) {
+    const std::vector<T> & column = columns_->column<T>(grp, vars[jv]);
+    std::copy(column.begin(), column.end(), values[jv].begin());
+  }
+  return true;
+}
+
 // -----------------------------------------------------------------------------
 /*! Returns number of levels in 3D geovals and obsdiags or
  *  one if not 3D geovals or obsdiag
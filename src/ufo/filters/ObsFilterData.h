@@ -9,6 +9,7 @@
 #define UFO_FILTERS_OBSFILTERDATA_H_
 
 #include <map>
+#include <memory>
 #include <ostream>
 #include <string>
 #include <vector>
@@ -16,6 +17,7 @@
 #include "ioda/ObsDataVector.h"
 #include "oops/util/ObjectCounter.h"
 #include "oops/util/Printable.h"
+#include "ufo/filters/ObsColumnStore.h"
 #include "ufo/filters/Variable.h"
 
 namespace ioda {
@@ -26,6 +28,7 @@ namespace ioda {
 namespace ufo {
   class GeoVaLs;
   class ObsDiagnostics;
+  class Variables;
 
 // -----------------------------------------------------------------------------
 /*! \brief ObsFilterData provides access to all data related to an ObsFilter
@@ -35,6 +38,12 @@ namespace ufo {
  * The latter three can be associated with ObsFilterData by using associate()
  * method.
  *
+ * The ObsFilterData of a filter belonging to a filter chain reads data held in
+ * the ObsSpace through the ObsColumnStore of the chain (see useColumnStore()),
+ * so that each column is read only once per filter stage. While filters run
+ * concurrently, ObsSpace data not cached in the store can't be read. Other
+ * ObsFilterData objects read the ObsSpace directly.
+ *
  */
 class ObsFilterData : public util::Printable,
                       private util::ObjectCounter<ObsFilterData> {
@@ -70,9 +79,29 @@ class ObsFilterData : public util::Printable,
   void get(const Variable &, ioda::ObsDataVector<float> &) const;
   //! Gets requested data from ObsFilterData (ObsDataVector has to be allocated)
   void get(const Variable &, ioda::ObsDataVector<int> &) const;
+  //! Gets reference to requested data from ObsFilterData: to data cached in the
+  //! ObsColumnStore if possible (no copy), otherwise to the buffer passed in
+  //! (filled by get()). Prefer this to get(), which always copies the data.
+  template <typename T>
+  const std::vector<T> & getRef(const Variable &, std::vector<T> &) const;
   //! Checks if requested data exists in ObsFilterData
   bool has(const Variable &) const;
 
+  //! Declares ObsSpace data needed by the filters (read together by prefetch())
+  void require(const Variables &);
+  //! Reads all declared ObsSpace data not read yet
+  void prefetch();
+  //! Discards ObsSpace data read so far (to be called after modifying the ObsSpace)
+  void invalidateColumnStore();
+  //! Reads ObsSpace data through the ObsColumnStore of a filter chain (or directly
+  //! from the ObsSpace if the pointer is null)
+  void useColumnStore(const std::shared_ptr<ObsColumnStore> & columns) {columns_ = columns;}
+  //! Returns indices of the locations of each record, as given by ObsSpace::recidx_vector()
+  const std::vector<std::vector<size_t>> & records() const;
+  //! Throws an exception if filters are running concurrently (to be called before reading
+  //! the ObsSpace directly or communicating with other MPI tasks)
+  void ensureSerial(const std::string &) const;
+
   //! Determines dtype of the provided variable
   ioda::ObsDtype dtype(const Variable &) const;
 
@@ -91,6 +120,9 @@ class ObsFilterData : public util::Printable,
   bool hasVector(const std::string &, const std::string &) const;
   bool hasDataVector(const std::string &, const std::string &) const;
   bool hasDataVectorInt(const std::string &, const std::string &) const;
+  bool isObsSpaceColumn(const std::string &, const std::string &) const;
+  template <typename T>
+  bool readColumns(const std::string &, ioda::ObsDataVector<T> &) const;
 
   ioda::ObsSpace & obsdb_;                 //!< ObsSpace associated with this object
   const GeoVaLs mutable * gvals_;          //!< pointer to GeoVaLs associated with this object
@@ -98,6 +130,9 @@ class ObsFilterData : public util::Printable,
   const ObsDiagnostics mutable * diags_;   //!< pointer to ObsDiagnostics associated with object
   std::map<std::string, const ioda::ObsDataVector<float> *> dvecsf_;  //!< Associated ObsDataVectors
   std::map<std::string, const ioda::ObsDataVector<int> *> dvecsi_;  //!< Associated ObsDataVectors
+  std::shared_ptr<ObsColumnStore> columns_;  //!< Cache of ObsSpace data of the filter chain
+  //! Indices of the locations of each record, if read without an ObsColumnStore
+  mutable std::vector<std::vector<size_t>> records_;
 };
 
 }  // namespace ufo
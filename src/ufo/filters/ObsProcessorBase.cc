@@ -11,12 +11,14 @@
 #include <vector>
 
 #include "eckit/config/Configuration.h"
+#include "eckit/exception/Exceptions.h"
 
 #include "ioda/ObsDataVector.h"
 #include "ioda/ObsSpace.h"
 #include "ioda/ObsVector.h"
 
 #include "oops/interface/ObsFilter.h"
+#include "oops/util/abor1_cpp.h"
 #include "oops/util/Logger.h"
 
 #include "ufo/filters/actions/FilterAction.h"
@@ -33,6 +35,9 @@ ObsProcessorBase::ObsProcessorBase(ioda::ObsSpace & os, bool deferToPost,
                                    std::shared_ptr<ioda::ObsDataVector<float> > obserr)
   : obsdb_(os),
     flags_(flags), obserr_(obserr),
+    chain_(flags ? FilterChainState::find(*flags) : nullptr),
+    activeObs_(chain_ ? std::shared_ptr<ActiveObsIndex>(chain_, &chain_->activeObs())
+               : flags ? std::make_shared<ActiveObsIndex>(flags) : nullptr),
     data_(obsdb_), prior_(false), post_(false),
     deferToPost_(deferToPost)
 {
@@ -51,18 +56,42 @@ ObsProcessorBase::~ObsProcessorBase() {
 
 // -----------------------------------------------------------------------------
 
+ObsProcessorBase::Stage ObsProcessorBase::stage() const {
+  if (allvars_.hasGroup("HofX") || allvars_.hasGroup("ObsDiag") || deferToPost_)
+    return Stage::POST;
+  if (allvars_.hasGroup("GeoVaLs"))
+    return Stage::PRIOR;
+  return Stage::PRE;
+}
+
+// -----------------------------------------------------------------------------
+
+oops::Variables ObsProcessorBase::inspectedVars() const {
+  oops::Variables vars = this->modifiedVars();
+  vars += allvars_.allFromGroup("QCflagsData").toOopsVariables();
+  vars += allvars_.allFromGroup("ObsErrorData").toOopsVariables();
+  return vars;
+}
+
+// -----------------------------------------------------------------------------
+
 void ObsProcessorBase::preProcess() {
   oops::Log::trace() << "ObsProcessorBase preProcess begin" << std::endl;
 // Cannot determine earlier when to apply filter because subclass
 // constructors add to allvars
-  if (allvars_.hasGroup("HofX") || allvars_.hasGroup("ObsDiag") || deferToPost_) {
+  if (chain_ && !this->modifiesObsSpace())
+    data_.useColumnStore(std::shared_ptr<ObsColumnStore>(chain_, &chain_->columns()));
+  data_.require(allvars_);
+  switch (this->stage()) {
+  case Stage::POST:
     post_ = true;
-  } else {
-    if (allvars_.hasGroup("GeoVaLs")) {
-      prior_ = true;
-    } else {
-      this->doFilter();
-    }
+    break;
+  case Stage::PRIOR:
+    prior_ = true;
+    break;
+  case Stage::PRE:
+    this->runFilter();
+    break;
   }
   oops::Log::trace() << "ObsProcessorBase preProcess end" << std::endl;
 }
@@ -72,7 +101,7 @@ void ObsProcessorBase::preProcess() {
 void ObsProcessorBase::priorFilter(const GeoVaLs & gv) {
   oops::Log::trace() << "ObsProcessorBase priorFilter begin" << std::endl;
   if (prior_ || post_) data_.associate(gv);
-  if (prior_) this->doFilter();
+  if (prior_) this->runFilter();
   oops::Log::trace() << "ObsProcessorBase priorFilter end" << std::endl;
 }
 
@@ -83,11 +112,55 @@ void ObsProcessorBase::postFilter(const ioda::ObsVector & hofx, const ObsDiagnos
   if (post_) {
     data_.associate(hofx, "HofX");
     data_.associate(diags);
-    this->doFilter();
+    this->runFilter();
   }
   oops::Log::trace() << "ObsProcessorBase postFilter end" << std::endl;
 }
 
 // -----------------------------------------------------------------------------
 
+void ObsProcessorBase::runFilter() {
+  // An index of this processor's own doesn't see the changes made by other processors.
+  if (!chain_) activeObs_->invalidate();
+  data_.prefetch();
+  this->doFilter();
+  // The processor may have changed the QC flags of these variables in any way, including setting
+  // them back to QCflags::pass, so their lists are rebuilt when next requested.
+  const oops::Variables & flagVars = flags_->varnames();
+  const oops::Variables modified = this->modifiedVars();
+  for (size_t jv = 0; jv < modified.size(); ++jv)
+    if (flagVars.has(modified[jv]))
+      activeObs_->invalidate(flagVars.find(modified[jv]));
+  if (chain_ && this->modifiesObsSpace()) chain_->columns().invalidate();
+}
+
+// -----------------------------------------------------------------------------
+
+ObsProcessorFactory::ObsProcessorFactory(const std::string & name) {
+  if (getMakers().find(name) != getMakers().end()) {
+    oops::Log::error() << name << " already registered in ufo::ObsProcessorFactory." << std::endl;
+    ABORT("Element already registered in ufo::ObsProcessorFactory.");
+  }
+  getMakers()[name] = this;
+}
+
+// -----------------------------------------------------------------------------
+
+std::unique_ptr<ObsProcessorBase> ObsProcessorFactory::create(
+    ioda::ObsSpace & os, const eckit::Configuration & conf,
+    std::shared_ptr<ioda::ObsDataVector<int> > flags,
+    std::shared_ptr<ioda::ObsDataVector<float> > obserr) {
+  oops::Log::trace() << "ObsProcessorFactory::create starting" << std::endl;
+  const std::string id = conf.getString("filter");
+  typename std::map<std::string, ObsProcessorFactory*>::iterator jloc = getMakers().find(id);
+  if (jloc == getMakers().end())
+    throw eckit::UserError(id + " does not exist in ufo::ObsProcessorFactory", Here());
+  std::unique_ptr<ObsProcessorBase> processor =
+      jloc->second->make(os, conf, std::move(flags), std::move(obserr));
+  oops::Log::trace() << "ObsProcessorFactory::create done" << std::endl;
+  return processor;
+}
+
+// -----------------------------------------------------------------------------
+
 }  // namespace ufo
@@ -8,19 +8,22 @@
 #ifndef UFO_FILTERS_OBSPROCESSORBASE_H_
 #define UFO_FILTERS_OBSPROCESSORBASE_H_
 
+#include <map>
 #include <memory>
+#include <string>
 
+#include <boost/make_unique.hpp>
+
+#include "eckit/config/Configuration.h"
 #include "ioda/ObsDataVector.h"
 #include "oops/base/Variables.h"
 #include "oops/util/ObjectCounter.h"
 #include "oops/util/Printable.h"
+#include "ufo/filters/ActiveObsIndex.h"
+#include "ufo/filters/FilterChainState.h"
 #include "ufo/filters/ObsFilterData.h"
 #include "ufo/filters/Variables.h"
 
-namespace eckit {
-  class Configuration;
-}
-
 namespace ioda {
   template <typename DATATYPE> class ObsDataVector;
   class ObsSpace;
@@ -52,16 +55,70 @@ class ObsProcessorBase : public util::Printable {
   oops::Variables requiredHdiagnostics() const {
     return allvars_.allFromGroup("ObsDiag").toOopsVariables();}
 
+  /// Stages at which a processor can be applied.
+  enum class Stage {PRE, PRIOR, POST};
+
+  /// \brief Return the stage at which this processor will be applied.
+  ///
+  /// Valid only once the processor has been fully constructed.
+  Stage stage() const;
+
+  /// \brief Return true if doFilter() may run concurrently with the doFilter() methods of other
+  /// thread-safe processors sharing the same QC flags and obs errors.
+  ///
+  /// Thread-safe processors must not perform MPI communication, modify the ObsSpace or modify
+  /// any state shared with other processors other than the QC flags and obs errors of the
+  /// variables returned by modifiedVars(). They may read the QC flags and obs errors of the
+  /// variables returned by inspectedVars() only. They must read ObsSpace data only through
+  /// ObsFilterData, and only data of variables declared in allvars_: other data can't be read
+  /// while processors run concurrently (see ObsColumnStore::ConcurrentAccess).
+  virtual bool isThreadSafe() const {return false;}
+
+  /// \brief Return true if doFilter() may run concurrently with the doFilter() methods of other
+  /// processors that may do so.
+  ///
+  /// This is the case if the processor is thread-safe and uses no ObsFunctions. ObsFunctions
+  /// access the ObsSpace directly (for example by constructing ObsDataVectors from it or by
+  /// saving their results to it), so their reads can't be served from the ObsColumnStore.
+  bool mayRunConcurrently() const {
+    return this->isThreadSafe() && !allvars_.hasGroup("ObsFunction");
+  }
+
+  /// \brief Return true if doFilter() may write to the ObsSpace.
+  ///
+  /// Processors that may do so read their inputs directly from the ObsSpace rather than from
+  /// the ObsColumnStore of their filter chain, which is invalidated after each call to their
+  /// doFilter().
+  virtual bool modifiesObsSpace() const {return !this->isThreadSafe();}
+
+  /// Return all variables used by this processor.
+  const ufo::Variables & requiredVariables() const {return allvars_;}
+
+  /// Return the variables whose QC flags or obs errors may be modified by this processor.
+  virtual oops::Variables modifiedVars() const {return obsdb_.obsvariables();}
+
+  /// Return the variables whose QC flags or obs errors may be read by this processor.
+  oops::Variables inspectedVars() const;
+
  protected:
   ioda::ObsSpace & obsdb_;
   std::shared_ptr<ioda::ObsDataVector<int>> flags_;
   std::shared_ptr<ioda::ObsDataVector<float>> obserr_;
+  /// State of the filter chain this processor belongs to; null if there is no QCmanager.
+  std::shared_ptr<FilterChainState> chain_;
+  /// Locations at which each variable currently passes QC: the index of the filter chain, or an
+  /// index of this processor's own if there is no filter chain.
+  std::shared_ptr<ActiveObsIndex> activeObs_;
   ufo::Variables allvars_;
   ObsFilterData data_;
 
  private:
   virtual void doFilter() const = 0;
 
+  /// Call doFilter(), making sure the ObsSpace columns and active locations it needs are up to
+  /// date, and invalidate the lists of active locations of the variables it may modify.
+  void runFilter();
+
   bool prior_;
   bool post_;
 
@@ -69,6 +126,73 @@ class ObsProcessorBase : public util::Printable {
   bool deferToPost_;
 };
 
+// -----------------------------------------------------------------------------
+
+/// \brief Factory of observation processors.
+///
+/// Used by processors running other processors (e.g. ConcurrentFilters), which need access to
+/// the ufo interface of their members. Processors are registered together with the oops filter
+/// factory, under the same names, by ufo::instantiateObsFilterFactory().
+class ObsProcessorFactory {
+ public:
+  /// Create the processor whose type is given by the `filter` key of \p conf.
+  static std::unique_ptr<ObsProcessorBase> create(ioda::ObsSpace &, const eckit::Configuration &,
+                                                  std::shared_ptr<ioda::ObsDataVector<int> >,
+                                                  std::shared_ptr<ioda::ObsDataVector<float> >);
+  virtual ~ObsProcessorFactory() = default;
+ protected:
+  explicit ObsProcessorFactory(const std::string &);
+ private:
+  virtual std::unique_ptr<ObsProcessorBase> make(ioda::ObsSpace &, const eckit::Configuration &,
+                                                 std::shared_ptr<ioda::ObsDataVector<int> >,
+                                                 std::shared_ptr<ioda::ObsDataVector<float> >) = 0;
+  static std::map < std::string, ObsProcessorFactory * > & getMakers() {
+    static std::map < std::string, ObsProcessorFactory * > makers_;
+    return makers_;
+  }
+};
+
+// -----------------------------------------------------------------------------
+
+/// \brief Maker of processors of type T.
+///
+/// If T defines a `Parameters_` typedef, the configuration is deserialized into an object of that
+/// type before being passed to the constructor of T; otherwise it is passed unchanged.
+template<class T>
+class ObsProcessorMaker : public ObsProcessorFactory {
+  template <class U>
+  static std::unique_ptr<ObsProcessorBase> makeImpl(
+      ioda::ObsSpace & os, const eckit::Configuration & conf,
+      std::shared_ptr<ioda::ObsDataVector<int> > flags,
+      std::shared_ptr<ioda::ObsDataVector<float> > obserr,
+      typename U::Parameters_ *) {
+    typename U::Parameters_ parameters;
+    parameters.validateAndDeserialize(conf);
+    return boost::make_unique<U>(os, parameters, flags, obserr);
+  }
+
+  template <class U>
+  static std::unique_ptr<ObsProcessorBase> makeImpl(
+      ioda::ObsSpace & os, const eckit::Configuration & conf,
+      std::shared_ptr<ioda::ObsDataVector<int> > flags,
+      std::shared_ptr<ioda::ObsDataVector<float> > obserr,
+      ...) {
+    return boost::make_unique<U>(os, conf, flags, obserr);
+  }
+
+  std::unique_ptr<ObsProcessorBase> make(ioda::ObsSpace & os, const eckit::Configuration & conf,
+                                         std::shared_ptr<ioda::ObsDataVector<int> > flags,
+                                         std::shared_ptr<ioda::ObsDataVector<float> > obserr)
+      override {
+    return makeImpl<T>(os, conf, flags, obserr, nullptr);
+  }
+
+ public:
+  explicit ObsProcessorMaker(const std::string & name) : ObsProcessorFactory(name) {}
+};
+
+// -----------------------------------------------------------------------------
+
 }  // namespace ufo
 
 #endif  // UFO_FILTERS_OBSPROCESSORBASE_H_
@@ -79,6 +79,8 @@ class PerformAction : public FilterBase,
                 std::shared_ptr<ioda::ObsDataVector<int> >,
                 std::shared_ptr<ioda::ObsDataVector<float> >);
 
+  bool isThreadSafe() const override {return true;}
+
  private:
   void print(std::ostream &) const override;
   void applyFilter(const std::vector<bool> &, const Variables &,
@@ -27,6 +27,7 @@
 #include "ufo/filters/ObsAccessor.h"
 #include "ufo/filters/PoissonDiskThinningParameters.h"
 #include "ufo/utils/Constants.h"
+#include "ufo/utils/NodeSharedVector.h"
 #include "ufo/utils/RecursiveSplitter.h"
 
 namespace ufo {
@@ -128,16 +129,16 @@ bool KDTree<numDims_>::isAnyPointInCylinderInterior(
 struct PoissonDiskThinning::ObsData
 {
   boost::optional<util::ScalarOrMap<int, float>> minHorizontalSpacings;
-  boost::optional<std::vector<float>> latitudes;
-  boost::optional<std::vector<float>> longitudes;
+  boost::optional<NodeSharedVector<float>> latitudes;
+  boost::optional<NodeSharedVector<float>> longitudes;
 
   boost::optional<util::ScalarOrMap<int, float>> minVerticalSpacings;
-  boost::optional<std::vector<float>> pressures;
+  boost::optional<NodeSharedVector<float>> pressures;
 
   boost::optional<util::ScalarOrMap<int, util::Duration>> minTimeSpacings;
   boost::optional<std::vector<util::DateTime>> times;
 
-  boost::optional<std::vector<int>> priorities;
+  boost::optional<NodeSharedVector<int>> priorities;
 
   // Total number of observations held by all MPI tasks
   size_t totalNumObs = 0;
@@ -215,12 +216,12 @@ void PoissonDiskThinning::applyFilter(const std::vector<bool> & apply,
 }
 
 ObsAccessor PoissonDiskThinning::createObsAccessor() const {
-  if (options_.categoryVariable.value() != boost::none) {
-    return ObsAccessor::toObservationsSplitIntoIndependentGroupsByVariable(
-          obsdb_, *options_.categoryVariable.value());
-  } else {
-    return ObsAccessor::toAllObservations(obsdb_);
-  }
+  ObsAccessor obsAccessor = options_.categoryVariable.value() != boost::none ?
+        ObsAccessor::toObservationsSplitIntoIndependentGroupsByVariable(
+          obsdb_, *options_.categoryVariable.value()) :
+        ObsAccessor::toAllObservations(obsdb_);
+  obsAccessor.setNodeSharedMemory(options_.nodeSharedMemory);
+  return obsAccessor;
 }
 
 PoissonDiskThinning::ObsData PoissonDiskThinning::getObsData(
@@ -234,15 +235,16 @@ PoissonDiskThinning::ObsData PoissonDiskThinning::getObsData(
   obsData.minHorizontalSpacings = options_.minHorizontalSpacing.value();
   if (obsData.minHorizontalSpacings != boost::none) {
     validateSpacings(*obsData.minHorizontalSpacings, "min_horizontal_spacing");
-    obsData.latitudes = obsAccessor.getFloatVariableFromObsSpace("MetaData", "latitude");
-    obsData.longitudes = obsAccessor.getFloatVariableFromObsSpace("MetaData", "longitude");
+    obsData.latitudes = obsAccessor.getSharedFloatVariableFromObsSpace("MetaData", "latitude");
+    obsData.longitudes = obsAccessor.getSharedFloatVariableFromObsSpace("MetaData", "longitude");
     numSpatialDims = 3;
   }
 
   obsData.minVerticalSpacings = options_.minVerticalSpacing.value();
   if (obsData.minVerticalSpacings != boost::none) {
     validateSpacings(*obsData.minVerticalSpacings, "min_vertical_spacing");
-    obsData.pressures = obsAccessor.getFloatVariableFromObsSpace("MetaData", "air_pressure");
+    obsData.pressures = obsAccessor.getSharedFloatVariableFromObsSpace("MetaData",
+                                                                       "air_pressure");
     ++numNonspatialDims;
   }
 
@@ -255,7 +257,7 @@ PoissonDiskThinning::ObsData PoissonDiskThinning::getObsData(
 
   const boost::optional<Variable> priorityVariable = options_.priorityVariable;
   if (priorityVariable != boost::none) {
-    obsData.priorities = obsAccessor.getIntVariableFromObsSpace(
+    obsData.priorities = obsAccessor.getSharedIntVariableFromObsSpace(
           priorityVariable.get().group(), priorityVariable.get().variable());
   }
 
@@ -295,7 +297,7 @@ std::vector<size_t> PoissonDiskThinning::getValidObservationIds(
     // The user wants to process observations in fixed (non-random) order. Ensure the filter
     // produces the same results regardless of the number of MPI ranks by ordering the observations
     // to be processed as if we were running in serial: by record ID.
-    const std::vector<size_t> recordIds = obsAccessor.getRecordIds();
+    const NodeSharedVector<size_t> recordIds = obsAccessor.getSharedRecordIds();
     std::stable_sort(validObsIds.begin(), validObsIds.end(),
                      [&recordIds](size_t obsIdA, size_t obsIdB)
                      { return recordIds[obsIdA] < recordIds[obsIdB]; });
@@ -331,7 +333,7 @@ void PoissonDiskThinning::groupObservationsByPriority(
     return;
 
   // TODO(wsmigaj): reuse the priority vector from obsData.
-  std::vector<int> priority = obsAccessor.getIntVariableFromObsSpace(
+  const NodeSharedVector<int> priority = obsAccessor.getSharedIntVariableFromObsSpace(
         priorityVariable.get().group(), priorityVariable.get().variable());
 
   auto reverse = [](int i) {
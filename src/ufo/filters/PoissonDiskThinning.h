@@ -62,6 +62,8 @@ class PoissonDiskThinning : public FilterBase,
 
   ~PoissonDiskThinning() override;
 
+  bool modifiesObsSpace() const override {return false;}
+
  private:
   struct ObsData;
 
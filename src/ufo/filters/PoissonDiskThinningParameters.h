@@ -166,6 +166,11 @@ class PoissonDiskThinningParameters : public FilterParametersBase {
   ///
   /// If omitted, a seed will be generated based on the current (calendar) time.
   oops::OptionalParameter<int> randomSeed{"random_seed", this};
+
+  /// If true, the observation data gathered from all MPI ranks (needed unless each category is
+  /// held on a single rank) are stored once per (shared-memory) node rather than once per rank.
+  /// This reduces the memory used by the filter when many ranks run on each node.
+  oops::Parameter<bool> nodeSharedMemory{"node_shared_memory", false, this};
 };
 
 }  // namespace ufo
@@ -55,6 +55,8 @@ class ProfileFewObsCheck : public FilterBase,
                      std::shared_ptr<ioda::ObsDataVector<float> >);
   ~ProfileFewObsCheck();
 
+  bool modifiesObsSpace() const override {return false;}
+
  private:
   void print(std::ostream &) const override;
   void applyFilter(const std::vector<bool> &, const Variables &,
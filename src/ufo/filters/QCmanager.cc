@@ -14,7 +14,6 @@
 
 #include "eckit/config/Configuration.h"
 
-#include "ioda/distribution/Accumulator.h"
 #include "ioda/ObsDataVector.h"
 #include "ioda/ObsSpace.h"
 #include "ioda/ObsVector.h"
@@ -23,6 +22,8 @@
 #include "oops/util/Logger.h"
 #include "oops/util/missingValues.h"
 #include "ufo/filters/QCflags.h"
+#include "ufo/filters/QCstatistics.h"
+#include "ufo/utils/PerformanceMonitor.h"
 
 namespace ufo {
 
@@ -36,7 +37,7 @@ QCmanager::QCmanager(ioda::ObsSpace & obsdb, const eckit::Configuration & config
                      std::shared_ptr<ioda::ObsDataVector<int> > qcflags,
                      std::shared_ptr<ioda::ObsDataVector<float> > obserr)
   : obsdb_(obsdb), config_(config), nogeovals_(), nodiags_(), flags_(qcflags),
-    observed_(obsdb.obsvariables())
+    observed_(obsdb.obsvariables()), chain_(FilterChainState::create(obsdb, qcflags))
 {
   oops::Log::trace() << "QCmanager::QCmanager starting " << config_ << std::endl;
 
@@ -66,17 +67,33 @@ QCmanager::QCmanager(ioda::ObsSpace & obsdb, const eckit::Configuration & config
 
 // -----------------------------------------------------------------------------
 
+void QCmanager::preProcess() const {
+  oops::Log::trace() << "QCmanager preProcess" << std::endl;
+  // QCmanager is applied before all other filters, so this is where a new stage starts: the
+  // ObsSpace may have been modified since the columns cached so far were read.
+  chain_->columns().startStage();
+}
+
+// -----------------------------------------------------------------------------
+
+void QCmanager::priorFilter(const GeoVaLs &) const {
+  oops::Log::trace() << "QCmanager priorFilter" << std::endl;
+  chain_->columns().startStage();
+}
+
+// -----------------------------------------------------------------------------
+
 void QCmanager::postFilter(const ioda::ObsVector & hofx, const ObsDiagnostics &) const {
   oops::Log::trace() << "QCmanager postFilter" << std::endl;
+  chain_->columns().startStage();
 
   const double missing = util::missingValue(missing);
 
+  const ActiveObsIndex & activeObs = chain_->activeObs();
   for (size_t jv = 0; jv < observed_.size(); ++jv) {
-    for (size_t jobs = 0; jobs < obsdb_.nlocs(); ++jobs) {
+    for (size_t jobs : activeObs.activeLocations(jv)) {
       size_t iobs = observed_.size() * jobs + jv;
-      if ((*flags_)[jv][jobs] == 0 && hofx[iobs] == missing) {
-        (*flags_)[jv][jobs] = QCflags::Hfailed;
-      }
+      if (hofx[iobs] == missing) (*flags_)[jv][jobs] = QCflags::Hfailed;
     }
   }
   oops::Log::trace() << "QCmanager postFilter done" << std::endl;
@@ -87,6 +104,7 @@ void QCmanager::postFilter(const ioda::ObsVector & hofx, const ObsDiagnostics &)
 QCmanager::~QCmanager() {
   oops::Log::trace() << "QCmanager::~QCmanager starting" << std::endl;
   oops::Log::info() << *this;
+  PerformanceMonitor::instance().reportAndReset(obsdb_.comm(), obsdb_.obsname() + "/");
   oops::Log::trace() << "QCmanager::~QCmanager done" << std::endl;
 }
 
@@ -121,20 +139,14 @@ void QCmanager::print(std::ostream & os) const {
   };
   const size_t numSpecialCases = 3;
 
-  const size_t nlocs = obsdb_.nlocs();
-  const size_t gnlocs = obsdb_.globalNumLocs();
+  // Count the flags of all variables in a single pass and a single reduction.
+  const QCstatistics stats(obsdb_, *flags_);
+  const size_t gnlocs = stats.globalNumLocs();
 
   for (size_t jvar = 0; jvar < observed_.size(); ++jvar) {
-    std::unique_ptr<ioda::Accumulator<std::vector<size_t>>> accumulator =
-        obsdb_.distribution()->createAccumulator<size_t>(cases.size());
-
-    for (size_t jobs = 0; jobs < nlocs; ++jobs) {
-      const int actualFlag = (*flags_)[jvar][jobs];
-      for (size_t jcase = 0; jcase < cases.size(); ++jcase)
-        if (actualFlag == cases[jcase].first)
-          accumulator->addTerm(jobs, jcase, 1);
-    }
-    const std::vector<std::size_t> counts = accumulator->computeResult();
+    std::vector<std::size_t> counts(cases.size());
+    for (size_t jcase = 0; jcase < cases.size(); ++jcase)
+      counts[jcase] = stats.count(jvar, cases[jcase].first);
 
     if (obsdb_.comm().rank() == 0) {
       const std::string info = "QC " + flags_->obstype() + " " + observed_[jvar] + ": ";
@@ -16,6 +16,7 @@
 #include "ioda/ObsSpace.h"
 #include "oops/base/Variables.h"
 #include "oops/util/Printable.h"
+#include "ufo/filters/FilterChainState.h"
 
 namespace ioda {
   template <typename DATATYPE> class ObsDataVector;
@@ -33,8 +34,8 @@ class QCmanager : public util::Printable {
             std::shared_ptr<ioda::ObsDataVector<float> >);
   ~QCmanager();
 
-  void preProcess() const {}
-  void priorFilter(const GeoVaLs &) const {}
+  void preProcess() const;
+  void priorFilter(const GeoVaLs &) const;
   void postFilter(const ioda::ObsVector &, const ObsDiagnostics &) const;
 
   const oops::Variables & requiredVars() const {return nogeovals_;}
@@ -50,6 +51,8 @@ class QCmanager : public util::Printable {
   std::shared_ptr<ioda::ObsDataVector<int>> flags_;
   std::shared_ptr<ioda::ObsDataVector<float>> obserr_;
   const oops::Variables & observed_;
+  /// State shared by the filters applied to flags_, which this QCmanager keeps alive.
+  std::shared_ptr<FilterChainState> chain_;
 };
 
 }  // namespace ufo
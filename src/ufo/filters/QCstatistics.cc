@@ -0,0 +1,63 @@
+/*
+ * (C) Crown copyright 2021, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#include "ufo/filters/QCstatistics.h"
+
+#include <memory>
+
+#include "ioda/distribution/Accumulator.h"
+#include "ioda/ObsDataVector.h"
+#include "ioda/ObsSpace.h"
+#include "oops/util/assert.h"
+
+namespace ufo {
+
+// -----------------------------------------------------------------------------
+
+constexpr int QCstatistics::maxFlag;
+constexpr size_t QCstatistics::numBins_;
+
+// -----------------------------------------------------------------------------
+
+QCstatistics::QCstatistics(const ioda::ObsSpace & obsdb, const ioda::ObsDataVector<int> & flags)
+  : variables_(flags.varnames().variables()), gnlocs_(obsdb.globalNumLocs())
+{
+  const size_t nvars = flags.nvars();
+  const size_t nlocs = flags.nlocs();
+
+  std::unique_ptr<ioda::Accumulator<std::vector<size_t>>> accumulator =
+      obsdb.distribution()->createAccumulator<size_t>(nvars * numBins_);
+
+  for (size_t jvar = 0; jvar < nvars; ++jvar) {
+    const std::vector<int> & varFlags = flags[jvar];
+    const size_t offset = jvar * numBins_;
+    for (size_t jobs = 0; jobs < nlocs; ++jobs) {
+      const int flag = varFlags[jobs];
+      const size_t bin = (flag >= 0 && flag <= maxFlag) ? flag : numBins_ - 1;
+      accumulator->addTerm(jobs, offset + bin, 1);
+    }
+  }
+
+  counts_ = accumulator->computeResult();
+}
+
+// -----------------------------------------------------------------------------
+
+size_t QCstatistics::count(size_t jvar, int flag) const {
+  ASSERT(flag >= 0 && flag <= maxFlag);
+  return counts_[jvar * numBins_ + flag];
+}
+
+// -----------------------------------------------------------------------------
+
+size_t QCstatistics::countOutOfRange(size_t jvar) const {
+  return counts_[(jvar + 1) * numBins_ - 1];
+}
+
+// -----------------------------------------------------------------------------
+
+}  // namespace ufo
@@ -0,0 +1,77 @@
+/*
+ * (C) Crown copyright 2021, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef UFO_FILTERS_QCSTATISTICS_H_
+#define UFO_FILTERS_QCSTATISTICS_H_
+
+#include <cstddef>  // for size_t
+#include <string>
+#include <vector>
+
+namespace ioda {
+  template <typename DATATYPE> class ObsDataVector;
+  class ObsSpace;
+}
+
+namespace ufo {
+
+/// \brief Numbers of observations of each variable carrying each QC flag, summed over all
+/// processes.
+///
+/// The counts of all variables are collected in a single pass over the QC flags: each flag is
+/// mapped directly to a histogram bin (flags 0 to maxFlag have a bin each; all other values
+/// share a final bin), and the histograms of all variables are then summed over the processes
+/// sharing the ObsSpace in one reduction. Observations held by more than one process are
+/// counted once.
+///
+/// Used by QCmanager to report QC statistics at the end of a run, but also suitable for
+/// monitoring the effect of filters at any point. Example:
+///
+/// \code
+///   const QCstatistics stats(obsdb, *flags);
+///   for (size_t jvar = 0; jvar < stats.nvars(); ++jvar)
+///     oops::Log::info() << stats.variable(jvar) << ": "
+///                       << stats.count(jvar, QCflags::pass) << " passed" << std::endl;
+/// \endcode
+class QCstatistics {
+ public:
+  /// Count the observations of each variable of \p flags carrying each flag. This is a collective
+  /// operation: it must be called on all processes sharing \p obsdb.
+  QCstatistics(const ioda::ObsSpace & obsdb, const ioda::ObsDataVector<int> & flags);
+
+  /// Largest flag with a dedicated histogram bin.
+  static constexpr int maxFlag = 99;
+
+  /// Number of variables.
+  size_t nvars() const {return variables_.size();}
+
+  /// Name of variable \p jvar.
+  const std::string & variable(size_t jvar) const {return variables_[jvar];}
+
+  /// Total number of observation locations (across all processes).
+  size_t globalNumLocs() const {return gnlocs_;}
+
+  /// Number of locations at which variable \p jvar carries flag \p flag. \p flag must lie
+  /// between 0 and maxFlag.
+  size_t count(size_t jvar, int flag) const;
+
+  /// Number of locations at which variable \p jvar carries a flag outside the range
+  /// [0, maxFlag].
+  size_t countOutOfRange(size_t jvar) const;
+
+ private:
+  static constexpr size_t numBins_ = maxFlag + 2;
+
+  std::vector<std::string> variables_;
+  size_t gnlocs_;
+  /// Histogram of variable jvar, stored in elements [jvar * numBins_, (jvar + 1) * numBins_).
+  std::vector<size_t> counts_;
+};
+
+}  // namespace ufo
+
+#endif  // UFO_FILTERS_QCSTATISTICS_H_
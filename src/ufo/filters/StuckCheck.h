@@ -57,6 +57,8 @@ class StuckCheck: public FilterBase,
 
   ~StuckCheck() override;
 
+  bool modifiesObsSpace() const override {return false;}
+
  private:
   Parameters_ options_;
   // Instantiate object for accessing observations that may be held on multiple MPI ranks.
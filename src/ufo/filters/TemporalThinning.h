@@ -55,6 +55,8 @@ class TemporalThinning : public FilterBase,
 
   ~TemporalThinning() override;
 
+  bool modifiesObsSpace() const override {return false;}
+
  private:
   void print(std::ostream &) const override;
   void applyFilter(const std::vector<bool> &, const Variables &,
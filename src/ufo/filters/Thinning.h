@@ -66,6 +66,8 @@ class Thinning : public FilterBase,
            std::shared_ptr<ioda::ObsDataVector<float> >);
   ~Thinning();
 
+  bool modifiesObsSpace() const override {return false;}
+
  private:
   void print(std::ostream &) const override;
   void applyFilter(const std::vector<bool> &, const Variables &,
@@ -88,6 +88,8 @@ class TrackCheck : public FilterBase,
 
   ~TrackCheck() override;
 
+  bool modifiesObsSpace() const override {return false;}
+
  private:
   /// \brief Attributes of an observation belonging to a track.
   class TrackObservation {
@@ -120,6 +120,8 @@ class TrackCheckShip: public FilterBase,
     double meanSpeed_{};
   };
 
+  bool modifiesObsSpace() const override {return false;}
+
  private:
   class TrackObservation {
    public:
@@ -69,6 +69,11 @@ class VariableTransformsParameters : public oops::Parameters {
   /// By default \e UseValidDataOnly is set to \e true.
   /// See ReadTheDoc for more details
   oops::Parameter<bool> UseValidDataOnly{"UseValidDataOnly", true, this};
+
+  /// Should the saturation vapour pressure be interpolated from a table? [Optional]:
+  /// By default \e UseSatVaporPresTable is set to \e false and the formula is evaluated
+  /// at each location. See formulas::SatVaporPresTable for details.
+  oops::Parameter<bool> UseSatVaporPresTable{"UseSatVaporPresTable", false, this};
 };
 }  // namespace ufo
 
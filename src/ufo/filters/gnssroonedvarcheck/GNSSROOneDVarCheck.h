@@ -55,6 +55,9 @@ class GNSSROOneDVarCheck : public FilterBase,
                   std::shared_ptr<ioda::ObsDataVector<float> >);
   ~GNSSROOneDVarCheck();
 
+  /// The QC flags of all variables are read back from the ObsSpace after the Fortran code has run.
+  oops::Variables modifiedVars() const override {return flags_->varnames();}
+
  private:
   void print(std::ostream &) const override;
   void applyFilter(const std::vector<bool> &, const Variables &,
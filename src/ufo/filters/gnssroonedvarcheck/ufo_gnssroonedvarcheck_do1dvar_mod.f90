@@ -43,14 +43,16 @@ SUBROUTINE Ops_GPSRO_Do1DVar_BA (nlevp,                  &
                                  Tb,                     &
                                  Ts,                     &
                                  O_Bdiff,                &
-                                 DFS)
+                                 DFS,                    &
+                                 ws)
 
 use ufo_gnssroonedvarcheck_utils_mod, only: &
     singlebg_type,             &
     singleob_type
 
 use ufo_gnssroonedvarcheck_rootsolv_mod, only: &
-    Ops_GPSRO_rootsolv_BA
+    Ops_GPSRO_rootsolv_BA,     &
+    rootsolv_workspace
 
 use ufo_utils_refractivity_calculator, only: &
     ufo_calculate_refractivity
@@ -81,6 +83,7 @@ REAL(kind_real), INTENT(INOUT)      :: Tb(nlevq)
 REAL(kind_real), INTENT(INOUT)      :: Ts(nlevq)
 REAL(kind_real), INTENT(INOUT)      :: O_Bdiff  ! measure of O-B for whole profile
 REAL(kind_real), INTENT(INOUT)      :: DFS      ! measure of degrees of freedom of signal for whole profile
+TYPE(rootsolv_workspace), INTENT(INOUT) :: ws   ! work arrays used by the root solver
 
 ! Local parameters
 CHARACTER(len=*), PARAMETER         :: RoutineName = "Ops_GPSRO_Do1DVar_BA"
@@ -98,7 +101,7 @@ LOGICAL                             :: ran_iteration
 REAL(kind_real)                     :: J_pen
 REAL(kind_real)                     :: xb(nlevp+nlevq)                 ! background profile used in the 1D-Var
 REAL(kind_real)                     :: x(nlevp+nlevq)                  ! 1Dvar solution profile
-REAL(kind_real)                     :: Amat(nlevp+nlevq,nlevp+nlevq)        ! solultion error cov matrix
+REAL(kind_real), ALLOCATABLE        :: Amat(:,:)                       ! solultion error cov matrix
 REAL(kind_real), ALLOCATABLE        :: zobs(:)
 REAL(kind_real), ALLOCATABLE        :: yobs(:)
 REAL(kind_real), ALLOCATABLE        :: yb(:)
@@ -154,10 +157,12 @@ nobs = COUNT (Ob % BendingAngle(:) % value /= missing_value(Ob % BendingAngle(1)
               Ob % ImpactParam(:) % value /= missing_value(Ob % ImpactParam(1) % value)   .AND. & ! not missing impact parameter
               Ob % qc_flags(:) == 0)
 
+!$omp critical (fckit_log)
 WRITE (message, '(A,I0)') 'size of input obs vector ', SIZE (Ob % BendingAngle(:) % value)
 CALL fckit_log % info(message)
 WRITE (message, '(A,I0)') 'size of packed obs vector ', nobs
 CALL fckit_log % info(message)
+!$omp end critical (fckit_log)
 
 ! Only continue if we have some observations to process
 IF (nobs > 0) THEN
@@ -173,6 +178,7 @@ IF (nobs > 0) THEN
   ALLOCATE (zobs(nobs))
   ALLOCATE (yb(nobs))
   ALLOCATE (ycalc(nobs))
+  ALLOCATE (Amat(nlevp+nlevq,nlevp+nlevq))
 
   ! Pack observation arrays for valid values
   ! Note: This hard-codes the R-matrix to be diagonal, since that is all that
@@ -239,7 +245,8 @@ IF (nobs > 0) THEN
                                 temp_undulation,           &    ! geoid undulation
                                 Tb,                        &
                                 Ts,                        &
-                                DFS)
+                                DFS,                       &
+                                ws)                             ! work arrays
     ran_iteration = .TRUE.
   ELSE
 
@@ -349,13 +356,17 @@ IF (nobs > 0) THEN
 ELSE
   IF (nobs <= 10) THEN
     WRITE (message, '(A)') 'nobs is less than 10: exit Ops_GPSRO_Do1DVar_BA'
+!$omp critical (fckit_log)
     CALL fckit_log % info(message)
+!$omp end critical (fckit_log)
     Ob % BendingAngle(:) % PGEFinal = 0.55     ! flag lack of observation data
   END IF
 
   IF (BAerr) THEN
     WRITE (message, '(A)') 'Error in Ops_Refractivity: exit Ops_GPSRO_Do1DVar_BA'
+!$omp critical (fckit_log)
     CALL fckit_log % info(message)
+!$omp end critical (fckit_log)
     Ob % BendingAngle(:) % PGEFinal = 0.58     ! flag BAerr
   END IF
 END IF
@@ -24,12 +24,15 @@ use ufo_gnssroonedvarcheck_utils_mod, only: &
     singlebg_type, singleob_type
 use ufo_gnssroonedvarcheck_get_bmatrix_mod, only: Ops_GPSRO_GetBmatrix, bmatrix_type
 use ufo_gnssroonedvarcheck_do1dvar_mod, only: Ops_GPSRO_Do1DVar_BA
+use ufo_gnssroonedvarcheck_rootsolv_mod, only: rootsolv_workspace, &
+    rootsolv_workspace_setup, rootsolv_workspace_delete
 
 implicit none
 private
 public :: ufo_gnssroonedvarcheck_create
 public :: ufo_gnssroonedvarcheck_delete
 public :: ufo_gnssroonedvarcheck_apply
+public :: ufo_gnssroonedvarcheck_set_flags
 
 type, public :: ufo_gnssroonedvarcheck
   character(len=800)        :: qcname            !< name of the filter
@@ -115,6 +118,13 @@ end subroutine ufo_gnssroonedvarcheck_delete
 !! This routine is called from the c++ apply method.  The filter performs 
 !! a 1D-Var minimization
 !!
+!! Profiles are independent, so they are distributed among OpenMP threads.
+!! Each thread allocates its background structure and root-solver work arrays
+!! once and reuses them for all its profiles. Every profile reads a copy of the
+!! input QC flags and writes only the flags of its own observations, so the
+!! output doesn't depend on the number of threads or the order in which
+!! profiles are processed.
+!!
 !! \author Met Office
 !!
 !! \date 09/06/2020: Created
@@ -132,6 +142,8 @@ subroutine ufo_gnssroonedvarcheck_apply(self, geovals, apply)
   type(ufo_geoval), pointer          :: prs              ! Model background values of air pressure
   type(ufo_geoval), pointer          :: theta_heights    ! Model heights of levels containing specific humidity
   type(ufo_geoval), pointer          :: rho_heights      ! Model heights of levels containing air pressure
+  type(ufo_geoval), target           :: q_copy, prs_copy, theta_heights_copy, rho_heights_copy
+                                                         ! Double-precision copies of the above, if needed
   type(singlebg_type)                :: Back             ! Model background fields
   type(singleob_type)                :: Ob               ! The profile of observations
   type(bmatrix_type)                 :: b_matrix         ! Background-error covariance matrix
@@ -149,6 +161,9 @@ subroutine ufo_gnssroonedvarcheck_apply(self, geovals, apply)
   real(kind_real), allocatable       :: sort_key(:)           ! Key for the sorting (based on record number and impact parameter)
   integer, allocatable               :: index_vals(:)         ! Indices of sorted observation
   integer, allocatable               :: unique(:)             ! Set of unique profile numbers
+  integer, allocatable               :: profile_start(:)      ! Starting index of each profile (and one past the last)
+  integer, allocatable               :: qc_flags_in(:)        ! QC flags before the 1DVar check
+  type(rootsolv_workspace)           :: ws                    ! Work arrays used by the root solver
   integer                            :: start_point           ! Starting index of the current profile
   integer                            :: current_point         ! Ending index of the current profile
   integer                            :: iprofile              ! Loop variable, profile number
@@ -190,15 +205,13 @@ subroutine ufo_gnssroonedvarcheck_apply(self, geovals, apply)
   call obsspace_get_db(self % obsdb, "FortranERR", "bending_angle", obs_err)
 
   ! get variables from geovals
-  call ufo_geovals_get_var(geovals, var_q, q)               ! specific humidity
-  call ufo_geovals_get_var(geovals, var_prsi, prs)          ! pressure
-  call ufo_geovals_get_var(geovals, var_z, theta_heights)   ! Geopotential height of the normal model levels
-  call ufo_geovals_get_var(geovals, var_zi, rho_heights)    ! Geopotential height of the pressure levels
+  call ufo_geovals_get_var(geovals, var_q, q, q_copy)                              ! specific humidity
+  call ufo_geovals_get_var(geovals, var_prsi, prs, prs_copy)                       ! pressure
+  call ufo_geovals_get_var(geovals, var_z, theta_heights, theta_heights_copy)      ! Geopotential height of the normal model levels
+  call ufo_geovals_get_var(geovals, var_zi, rho_heights, rho_heights_copy)         ! Geopotential height of the pressure levels
 
-  ! Read in the B-matrix and background profiles
+  ! Read in the B-matrix
   call Ops_GPSRO_GetBmatrix(self % bmatrix_filename, prs % nval, q % nval, b_matrix)
-  call allocate_singlebg(Back, prs % nval, q % nval)
-  allocate(Tb(q % nval), Ts(q % nval))
 
   ! Read through the record numbers in order to find a profile of observations
   ! Each profile shares the same record number
@@ -207,10 +220,34 @@ subroutine ufo_gnssroonedvarcheck_apply(self, geovals, apply)
   call Ops_RealSortQuick(sort_key, index_vals)
   call find_unique(record_number, unique)
 
-  ! For every profile that we have found, perform a 1DVar minimisation
+  ! Work out which observations belong to each profile
+  allocate(profile_start(size(unique) + 1))
   current_point = 1
   do iprofile = 1, size(unique)
-    start_point = current_point
+    profile_start(iprofile) = current_point
+    do current_point = current_point, nobs
+      if (unique(iprofile) /= record_number(index_vals(current_point))) exit
+    end do
+  end do
+  profile_start(size(unique) + 1) = current_point
+
+  ! Profiles read the flags set by previous filters and write the updated ones
+  ! to a separate array, so that they can be processed in any order
+  qc_flags_in = qc_flags
+
+  ! For every profile that we have found, perform a 1DVar minimisation
+!$omp parallel default(shared) &
+!$omp private(iprofile, start_point, current_point, nobs_profile, ipoint, iband, iseason) &
+!$omp private(Back, Ob, ws, Tb, Ts, BAerr, O_Bdiff, dfs, Message)
+  call allocate_singlebg(Back, prs % nval, q % nval)
+  allocate(Tb(q % nval), Ts(q % nval))
+  call rootsolv_workspace_setup(ws, prs % nval, q % nval, self % pseudo_ops)
+
+!$omp do schedule(dynamic)
+  do iprofile = 1, size(unique)
+    start_point = profile_start(iprofile)
+    current_point = profile_start(iprofile + 1)
+!$omp critical (fckit_log)
     WRITE (Message, '(A,I0)') 'ObNumber ', iprofile
     call fckit_log % info(Message)
     WRITE (Message, '(A,F12.2)') 'Latitude ', obsLat(index_vals(start_point))
@@ -225,11 +262,7 @@ subroutine ufo_gnssroonedvarcheck_apply(self, geovals, apply)
     call fckit_log % info(Message)
     WRITE (Message, '(A,F12.2)') 'GPSRO_Zmax ', self % Zmax
     call fckit_log % info(Message)
-
-    ! Work out which observations belong to the current profile
-    do current_point = start_point, nobs
-      if (unique(iprofile) /= record_number(index_vals(current_point))) exit
-    end do
+!$omp end critical (fckit_log)
 
     ! Load the geovals into the background structure
     Back % za(:) = rho_heights % vals(:, index_vals(start_point))
@@ -250,7 +283,7 @@ subroutine ufo_gnssroonedvarcheck_apply(self, geovals, apply)
     Ob % bendingangle(:) % value = obs_bending_angle(index_vals(start_point:current_point-1))
     Ob % bendingangle(:) % oberr = obs_err(index_vals(start_point:current_point-1))
     Ob % impactparam(:) % value = impact_param(index_vals(start_point:current_point-1))
-    Ob % qc_flags(:) = qc_flags(index_vals(start_point:current_point-1))
+    Ob % qc_flags(:) = qc_flags_in(index_vals(start_point:current_point-1))
     Ob % ro_rad_curv % value = radius_curv(index_vals(start_point))
     Ob % ro_geoid_und % value = undulation(index_vals(start_point))
 
@@ -286,18 +319,15 @@ subroutine ufo_gnssroonedvarcheck_apply(self, geovals, apply)
                               Tb,                      &   ! Calculated background temperature
                               Ts,                      &   ! 1DVar solution temperature
                               O_Bdiff,                 &   ! Difference between observations and background for profile
-                              DFS)                         ! Estimated degrees of freedom for signal
+                              DFS,                     &   ! Estimated degrees of freedom for signal
+                              ws)                          ! Work arrays for the root solver
 
     ! Flag bad profiles
-    do ipoint = 0, nobs_profile-1
-      if (qc_flags(start_point + ipoint) > 0) then
-        ! Do nothing, since the data are already flagged
-      else if (Ob % bendingangle(ipoint+1) % PGEFinal > 0.5) then
-        qc_flags(start_point + ipoint) = self % onedvarflag
-        Ob % qc_flags(ipoint+1) = self % onedvarflag
-      end if
-    end do
+    call ufo_gnssroonedvarcheck_set_flags(index_vals, start_point, qc_flags_in, &
+                                          Ob % bendingangle(:) % PGEFinal, &
+                                          self % onedvarflag, qc_flags)
 
+!$omp critical (fckit_log)
     write(Message,'(A,2I5,2F10.3,I5,F16.6)') 'Profile stats: ', obsSatid(index_vals(start_point)), &
         obsOrigC(index_vals(start_point)), Ob % latitude, Ob % longitude, &
         Ob % niter, Ob % jcost
@@ -307,11 +337,58 @@ subroutine ufo_gnssroonedvarcheck_apply(self, geovals, apply)
                                                      min(start_point+ipoint+99, current_point-1)))
         call fckit_log % debug(Message)
     end do
+!$omp end critical (fckit_log)
 
     call deallocate_singleob(Ob)
   end do
+!$omp end do
+
+  call rootsolv_workspace_delete(ws)
+  call deallocate_singlebg(Back)
+  deallocate(Tb, Ts)
+!$omp end parallel
+
   call obsspace_put_db(self % obsdb, "FortranQC", "bending_angle", qc_flags)
 
 end subroutine ufo_gnssroonedvarcheck_apply
 
+! ------------------------------------------------------------------------------
+!> Flag the observations of a profile rejected by the 1D-Var
+!!
+!! \details The observations of the profile are index_vals(start_point) to
+!! index_vals(start_point + size(pge) - 1), where index_vals holds the indices
+!! of the observations sorted by record number and impact parameter. The QC
+!! flags are read and written at the index of each observation, which differs
+!! from its sorted position unless the input is stored in that order.
+!!
+!! \author Met Office
+!!
+!! \date 16/10/2026: Created
+!!
+subroutine ufo_gnssroonedvarcheck_set_flags(index_vals, start_point, qc_flags_in, &
+                                             pge, onedvarflag, qc_flags)
+
+implicit none
+
+integer, intent(in)         :: index_vals(:)   !< Indices of the sorted observations
+integer, intent(in)         :: start_point     !< Sorted position of the first observation of the profile
+integer, intent(in)         :: qc_flags_in(:)  !< QC flags before the 1DVar check
+real(kind_real), intent(in) :: pge(:)          !< Final probability of gross error of each observation of the profile
+integer, intent(in)         :: onedvarflag     !< Flag used by the qc manager for a 1D-var check
+integer, intent(inout)      :: qc_flags(:)     !< QC flags to be updated
+
+integer :: ipoint  ! Loop variable, observation point in the profile
+integer :: iobs    ! Index of the observation
+
+do ipoint = 1, size(pge)
+  iobs = index_vals(start_point + ipoint - 1)
+  if (qc_flags_in(iobs) > 0) then
+    ! Do nothing, since the data are already flagged
+  else if (pge(ipoint) > 0.5) then
+    qc_flags(iobs) = onedvarflag
+  end if
+end do
+
+end subroutine ufo_gnssroonedvarcheck_set_flags
+
 end module ufo_gnssroonedvarcheck_mod
@@ -15,9 +15,129 @@ use fckit_log_module, only: fckit_log
 
 private
 public :: Ops_GPSRO_rootsolv_BA
+public :: rootsolv_workspace_setup, rootsolv_workspace_delete
+
+!> Work arrays used by Ops_GPSRO_rootsolv_BA
+!!
+!! \details Holding these on the heap, and reusing them from one profile to the
+!! next, avoids reallocating them for every profile and keeps the large matrices
+!! off the (small) stacks of the threads processing profiles concurrently. Each
+!! thread must use its own workspace.
+type, public :: rootsolv_workspace
+  integer                      :: nobs = 0            !< size of the ob. vector the workspace is sized for
+  real(kind_real), allocatable :: nr(:)               !< index * radius product
+  real(kind_real), allocatable :: dref_dp(:,:)        !< gradient of refractivity wrt pressure
+  real(kind_real), allocatable :: dref_dq(:,:)        !< gradient of refractivity wrt humidity
+  real(kind_real), allocatable :: dnr_dref(:,:)       !< gradient of nr wrt refractivity
+  real(kind_real), allocatable :: d2J_dx2(:,:)        !< hessian of the cost function
+  real(kind_real), allocatable :: KOK(:,:)            !< KT *O^-1 *K
+  real(kind_real), allocatable :: AKOK(:,:)           !< Amat * KOK
+  real(kind_real), allocatable :: dalpha_dref(:,:)    !< gradient of bending angle wrt refractivity
+  real(kind_real), allocatable :: dalpha_dnr(:,:)     !< gradient of bending angle wrt nr
+  real(kind_real), allocatable :: m1(:,:)             !< dalpha_dnr * dnr_dref
+  real(kind_real), allocatable :: Kmat(:,:)           !< gradient of bending angle wrt state
+  real(kind_real), allocatable :: OK(:,:)             !< O^-1 * Kmat
+end type rootsolv_workspace
 
 contains
 
+!-------------------------------------------------------------------------------
+! Allocate the work arrays whose sizes don't depend on the number of observations
+!-------------------------------------------------------------------------------
+
+SUBROUTINE rootsolv_workspace_setup (ws,               &
+                                     nlevp,            &
+                                     nlevq,            &
+                                     GPSRO_pseudo_ops)
+
+IMPLICIT NONE
+
+TYPE(rootsolv_workspace), INTENT(INOUT) :: ws
+INTEGER, INTENT(IN)                     :: nlevp
+INTEGER, INTENT(IN)                     :: nlevq
+LOGICAL, INTENT(IN)                     :: GPSRO_pseudo_ops
+
+INTEGER                                 :: nstate
+INTEGER                                 :: nref
+
+CALL rootsolv_workspace_delete(ws)
+
+nstate = nlevp + nlevq
+IF (GPSRO_pseudo_ops) THEN
+  nref = 2 * nlevq - 1
+ELSE
+  nref = nlevq
+END IF
+
+ALLOCATE(ws % nr(nref))
+ALLOCATE(ws % dref_dp(nref,nlevp))
+ALLOCATE(ws % dref_dq(nref,nlevq))
+ALLOCATE(ws % dnr_dref(nref,nref))
+ALLOCATE(ws % d2J_dx2(nstate,nstate))
+ALLOCATE(ws % KOK(nstate,nstate))
+ALLOCATE(ws % AKOK(nstate,nstate))
+
+END SUBROUTINE rootsolv_workspace_setup
+
+!-------------------------------------------------------------------------------
+! Size the work arrays for an observation vector of length nobs
+!-------------------------------------------------------------------------------
+
+SUBROUTINE rootsolv_workspace_resize (ws,    &
+                                      nobs)
+
+IMPLICIT NONE
+
+TYPE(rootsolv_workspace), INTENT(INOUT) :: ws
+INTEGER, INTENT(IN)                     :: nobs
+
+INTEGER                                 :: nref
+INTEGER                                 :: nstate
+
+IF (nobs == ws % nobs) RETURN
+
+nref = SIZE(ws % nr)
+nstate = SIZE(ws % d2J_dx2, 1)
+IF (ALLOCATED (ws % dalpha_dref)) DEALLOCATE (ws % dalpha_dref)
+IF (ALLOCATED (ws % dalpha_dnr)) DEALLOCATE (ws % dalpha_dnr)
+IF (ALLOCATED (ws % m1)) DEALLOCATE (ws % m1)
+IF (ALLOCATED (ws % Kmat)) DEALLOCATE (ws % Kmat)
+IF (ALLOCATED (ws % OK)) DEALLOCATE (ws % OK)
+ALLOCATE(ws % dalpha_dref(nobs,nref))
+ALLOCATE(ws % dalpha_dnr(nobs,nref))
+ALLOCATE(ws % m1(nobs,nref))
+ALLOCATE(ws % Kmat(nobs,nstate))
+ALLOCATE(ws % OK(nobs,nstate))
+ws % nobs = nobs
+
+END SUBROUTINE rootsolv_workspace_resize
+
+!-------------------------------------------------------------------------------
+! Free the work arrays
+!-------------------------------------------------------------------------------
+
+SUBROUTINE rootsolv_workspace_delete (ws)
+
+IMPLICIT NONE
+
+TYPE(rootsolv_workspace), INTENT(INOUT) :: ws
+
+IF (ALLOCATED (ws % nr)) DEALLOCATE (ws % nr)
+IF (ALLOCATED (ws % dref_dp)) DEALLOCATE (ws % dref_dp)
+IF (ALLOCATED (ws % dref_dq)) DEALLOCATE (ws % dref_dq)
+IF (ALLOCATED (ws % dnr_dref)) DEALLOCATE (ws % dnr_dref)
+IF (ALLOCATED (ws % d2J_dx2)) DEALLOCATE (ws % d2J_dx2)
+IF (ALLOCATED (ws % KOK)) DEALLOCATE (ws % KOK)
+IF (ALLOCATED (ws % AKOK)) DEALLOCATE (ws % AKOK)
+IF (ALLOCATED (ws % dalpha_dref)) DEALLOCATE (ws % dalpha_dref)
+IF (ALLOCATED (ws % dalpha_dnr)) DEALLOCATE (ws % dalpha_dnr)
+IF (ALLOCATED (ws % m1)) DEALLOCATE (ws % m1)
+IF (ALLOCATED (ws % Kmat)) DEALLOCATE (ws % Kmat)
+IF (ALLOCATED (ws % OK)) DEALLOCATE (ws % OK)
+ws % nobs = 0
+
+END SUBROUTINE rootsolv_workspace_delete
+
 !-------------------------------------------------------------------------------
 ! Solve the 1dvar problem
 !-------------------------------------------------------------------------------
@@ -57,7 +177,8 @@ SUBROUTINE Ops_GPSRO_rootsolv_BA (nstate,        &   ! size of state vector
                                   RO_geoid_und,  &   ! geoid undulation
                                   Tb,            &
                                   Ts,            &
-                                  DFS)
+                                  DFS,           &
+                                  ws)            ! work arrays
 
 
 USE ufo_gnssro_ukmo1d_utils_mod, only: &
@@ -123,6 +244,7 @@ REAL(kind_real), INTENT(IN)    :: RO_geoid_und
 REAL(kind_real), INTENT(INOUT) :: Tb(nlevq)
 REAL(kind_real), INTENT(INOUT) :: Ts(nlevq)
 REAL(kind_real), INTENT(INOUT) :: DFS         ! Measure of degrees of freesom of signal for whole profile
+TYPE(rootsolv_workspace), INTENT(INOUT) :: ws ! Work arrays, sized by rootsolv_workspace_setup
 
 ! Local declarations:
 CHARACTER(len=*), PARAMETER  :: RoutineName = "Ops_GPSRO_rootsolv_BA"
@@ -142,26 +264,14 @@ REAL(kind_real)              :: xmin(nstate)
 REAL(kind_real)              :: ymin(nobs)
 REAL(kind_real)              :: lambda
 REAL(kind_real)              :: lamp1
-REAL(kind_real)              :: d2J_dx2(nstate,nstate)
 REAL(kind_real)              :: dJ_dx(nstate)
 REAL(kind_real)              :: diag_d2J(nstate)
-REAL(kind_real)              :: Kmat(Nobs,nstate)
 REAL(kind_real)              :: dx(nstate)
 REAL(kind_real)              :: Conv_Test
 REAL(kind_real)              :: ct2
 REAL(kind_real)              :: ct3
 REAL(kind_real)              :: d2                         ! measure of step taken
 REAL(kind_real)              :: sdx(nstate)
-REAL(kind_real)              :: OK(Nobs,nstate)            ! O^-1 * Kmat
-REAL(kind_real)              :: KOK(nstate,nstate)         ! KT *O^-1 *K
-REAL(kind_real)              :: AKOK(nstate,nstate)        ! Amat * above
-REAL(kind_real), ALLOCATABLE :: nr(:)
-REAL(kind_real), ALLOCATABLE :: dref_dp(:,:)
-REAL(kind_real), ALLOCATABLE :: dref_dq(:,:)
-REAL(kind_real), ALLOCATABLE :: dnr_dref(:,:)
-REAL(kind_real), ALLOCATABLE :: dalpha_dref(:,:)
-REAL(kind_real), ALLOCATABLE :: dalpha_dnr(:,:)
-REAL(kind_real), ALLOCATABLE :: m1(:,:)
 REAL(kind_real)              :: T(nlevq)
 REAL(kind_real)              :: pressure(1:nlevp)
 REAL(kind_real)              :: humidity(1:nlevq)
@@ -175,23 +285,18 @@ CHARACTER(LEN=max_string)    :: message
 ! 1. Initialise
 !--------------
 
-IF (GPSRO_pseudo_ops) THEN
-  ALLOCATE(nr(2 * nlevq - 1))
-  ALLOCATE(dref_dp(2 * nlevq - 1,nlevp))
-  ALLOCATE(dref_dq(2 * nlevq - 1,nlevq))
-  ALLOCATE(dnr_dref(2 * nlevq - 1,2 * nlevq - 1))
-  ALLOCATE(dalpha_dref(nobs,2 * nlevq - 1))
-  ALLOCATE(dalpha_dnr(nobs,2 * nlevq - 1))
-  ALLOCATE(m1(nobs,2 * nlevq - 1))
-ELSE
-  ALLOCATE(nr(nlevq))
-  ALLOCATE(dref_dp(nlevq,nlevp))
-  ALLOCATE(dref_dq(nlevq,nlevq))
-  ALLOCATE(dnr_dref(nlevq,nlevq))
-  ALLOCATE(dalpha_dref(nobs,nlevq))
-  ALLOCATE(dalpha_dnr(nobs,nlevq))
-  ALLOCATE(m1(nobs,nlevq))
-END IF
+CALL rootsolv_workspace_resize(ws, nobs)
+
+ASSOCIATE (nr => ws % nr,                   &
+           dnr_dref => ws % dnr_dref,       &
+           dalpha_dref => ws % dalpha_dref, &
+           dalpha_dnr => ws % dalpha_dnr,   &
+           m1 => ws % m1,                   &
+           Kmat => ws % Kmat,               &
+           d2J_dx2 => ws % d2J_dx2,         &
+           OK => ws % OK,                   &
+           KOK => ws % KOK,                 &
+           AKOK => ws % AKOK)
 
 x(:) = xb(:)   ! first guess = background
 xold(:) = xb(:)
@@ -236,7 +341,9 @@ ErrorCode = missing_value(ErrorCode)
 !-----------------------
 
 ! Data to stdout on convergence of iteration loop
+!$omp critical (fckit_log)
 CALL fckit_log % info('J_pen|Conv_test|ct2|lambda|d2|(dJ/dx)^2|')
+!$omp end critical (fckit_log)
 
 Iteration_loop: DO
 
@@ -355,12 +462,12 @@ Iteration_loop: DO
                                GPSRO_pseudo_ops,      &
                                GPSRO_vert_interp_ops, &
                                GPSRO_min_temp_grad,   &
-                               dref_dP,               &
-                               dref_dq)
+                               ws % dref_dp,          &
+                               ws % dref_dq)
 
     ! Change the units for the K-matrices
-    dref_dP(:,:) = 1.0E2 * dref_dP(:,:)   ! hPa
-    dref_dq(:,:) = 1.0E-3 * dref_dq(:,:)  ! g/kg
+    ws % dref_dp(:,:) = 1.0E2 * ws % dref_dp(:,:)   ! hPa
+    ws % dref_dq(:,:) = 1.0E-3 * ws % dref_dq(:,:)  ! g/kg
 
     !  2.  Calculate the gradient of nr wrt ref
     CALL Ops_GPSROcalc_nrK (model_heights, &           ! geopotential heights of pseudo levels
@@ -383,8 +490,8 @@ Iteration_loop: DO
     ! Calculate overall gradient of bending angle wrt p and q
 
     m1 = MATMUL (dalpha_dnr,dnr_dref)
-    Kmat(1:nobs,1:nlevp) = MATMUL (dalpha_dref,dref_dp) + MATMUL (m1,dref_dp)    !P part
-    Kmat(1:nobs,nlevp + 1:nstate) = MATMUL (dalpha_dref,dref_dq) + MATMUL (m1,dref_dq) !q part
+    Kmat(1:nobs,1:nlevp) = MATMUL (dalpha_dref,ws % dref_dp) + MATMUL (m1,ws % dref_dp)    !P part
+    Kmat(1:nobs,nlevp + 1:nstate) = MATMUL (dalpha_dref,ws % dref_dq) + MATMUL (m1,ws % dref_dq) !q part
 
     ! Store the state vector in xold
 
@@ -475,16 +582,20 @@ Iteration_loop: DO
   d2 = DOT_PRODUCT ((x(:) - xold(:)) , Sdx(:))    !d^2=dx(S^-1)dx, size of step normalized by error size
 
   WRITE (message,'(6E14.6)') J_pen, Conv_test, ct2, lambda, d2, ct3
+!$omp critical (fckit_log)
   CALL fckit_log % info(message)
+!$omp end critical (fckit_log)
 
 END DO Iteration_loop
 
 Ts(:) = T(:)                  !1DVAR solution temperature
 
+!$omp critical (fckit_log)
 WRITE (message, '(A,I0)') 'Number of iterations ', it   !write out number of iterations done
 CALL fckit_log % info(message)
 WRITE (message, '(A,F16.4)') 'O-B size ', O_Bdiff
 CALL fckit_log % info(message)
+!$omp end critical (fckit_log)
 
 ! Output the x(:) that gave the lowest cost function
 
@@ -522,20 +633,16 @@ IF (ErrorCode == 0 .AND. it <= iter_max) THEN
   END DO
 
   WRITE (message,'(A,F16.4)') 'DFS', DFS
+!$omp critical (fckit_log)
   CALL fckit_log % info(message)
+!$omp end critical (fckit_log)
 ELSE
 
    Do1DVar_Error = .TRUE.
 
 END IF
 
-IF (ALLOCATED (nr)) DEALLOCATE (nr)
-IF (ALLOCATED (dref_dp)) DEALLOCATE (dref_dp)
-IF (ALLOCATED (dref_dq)) DEALLOCATE (dref_dq)
-IF (ALLOCATED (dnr_dref)) DEALLOCATE (dnr_dref)
-IF (ALLOCATED (dalpha_dref)) DEALLOCATE (dalpha_dref)
-IF (ALLOCATED (dalpha_dnr)) DEALLOCATE (dalpha_dnr)
-IF (ALLOCATED (m1)) DEALLOCATE (m1)
+END ASSOCIATE
 
 END SUBROUTINE Ops_GPSRO_rootsolv_BA
 
@@ -61,15 +61,16 @@ void BennartzScatIndex::compute(const ObsFilterData & in,
     }
   }
 
-  // Compute Bennartz scattering index
-  float Offset;
+  // Compute Bennartz scattering index. Missing inputs are replaced by zeros, so that the loop
+  // needs no branches, and the results obtained at these locations are discarded.
+  const float coeff1 = options_.coeff1.value();
+  const float coeff2 = options_.coeff2.value();
+  std::vector<float> & scatIndex = out[0];
   for (size_t iloc = 0; iloc < nlocs; ++iloc) {
-    Offset = options_.coeff1.value() + options_.coeff2.value()*satzen[iloc];
-    if (bt89[iloc] == missing || bt150[iloc] == missing || satzen[iloc] == missing) {
-      out[0][iloc] = missing;
-    } else {
-      out[0][iloc] = bt89[iloc] - bt150[iloc] - Offset;
-    }
+    const bool valid = bt89[iloc] != missing && bt150[iloc] != missing && satzen[iloc] != missing;
+    const float Offset = coeff1 + coeff2*(valid ? satzen[iloc] : 0.0f);
+    const float value = (valid ? bt89[iloc] : 0.0f) - (valid ? bt150[iloc] : 0.0f) - Offset;
+    scatIndex[iloc] = valid ? value : missing;
   }
 }
 
@@ -47,7 +47,9 @@ void BgdDepartureAnomaly::compute(const ObsFilterData & in,
   const size_t nlocs = in.nlocs();
   const float missing = util::missingValue(missing);
 
-  // Get obs space
+  // Get obs space. The means computed below need all MPI tasks to take part, which they
+  // can't do safely from concurrently running filters.
+  in.ensureSerial("computing global means of background departures");
   auto & obsdb = in.obsspace();
 
   ASSERT(channels_.size() == 2);
@@ -279,19 +279,29 @@ void CLWRetMW::cloudLiquidWater(const std::vector<float> & szas,
   const float t0c = Constants::t0c;
   const float d1 = 0.754, d2 = -2.265;
   const float c1 = 8.240, c2 = 2.622, c3 = 1.846;
-  for (size_t iloc = 0; iloc < water_frac.size(); ++iloc) {
-    if (water_frac[iloc] >= 0.99) {
-      float cossza = cos(Constants::deg2rad * szas[iloc]);
-      float d0 = c1 - (c2 - c3 * cossza) * cossza;
-      if (tsavg[iloc] > t0c - 1.0 && bt238[iloc] <= 284.0 && bt314[iloc] <= 284.0
-                                  && bt238[iloc] > 0.0 && bt314[iloc] > 0.0) {
-        out[iloc] = cossza * (d0 + d1 * std::log(285.0 - bt238[iloc])
-                                 + d2 * std::log(285.0 - bt314[iloc]));
-        out[iloc] = std::max(0.f, out[iloc]);
-      } else {
-        out[iloc] = getBadValue();
-      }
-    }
+  const float bad = getBadValue();
+  const size_t nlocs = water_frac.size();
+
+  // Find the locations at which the retrieval is carried out and flag those where it fails.
+  std::vector<size_t> retrieved(nlocs);
+  size_t nretrieved = 0;
+  for (size_t iloc = 0; iloc < nlocs; ++iloc) {
+    const bool water = water_frac[iloc] >= 0.99;
+    const bool valid = tsavg[iloc] > t0c - 1.0 && bt238[iloc] <= 284.0 && bt314[iloc] <= 284.0
+                                             && bt238[iloc] > 0.0 && bt314[iloc] > 0.0;
+    out[iloc] = water && !valid ? bad : out[iloc];
+    retrieved[nretrieved] = iloc;
+    nretrieved += water && valid;
+  }
+
+  // Carry out the retrieval at these locations only.
+  for (size_t i = 0; i < nretrieved; ++i) {
+    const size_t iloc = retrieved[i];
+    const float cossza = cos(Constants::deg2rad * szas[iloc]);
+    const float d0 = c1 - (c2 - c3 * cossza) * cossza;
+    const float clw = cossza * (d0 + d1 * std::log(285.0 - bt238[iloc])
+                                   + d2 * std::log(285.0 - bt314[iloc]));
+    out[iloc] = std::max(0.f, clw);
   }
 }
 
@@ -334,30 +344,35 @@ void CLWRetMW::clw_retr_amsr2(const std::vector<float> & bt18v,
                                          const std::vector<float> & bt36v,
                                          const std::vector<float> & bt36h,
                                          std::vector<float> & out) {
-  float clw;
-  std::vector<float> pred_var_clw(2);
   // intercepts
   const float a0_clw = -0.65929;
   // regression coefficients
-  float regr_coeff_clw[3] = {-0.00013, 1.64692, -1.51916};
+  const float regr_coeff_clw[3] = {-0.00013, 1.64692, -1.51916};
+  const float bad = getBadValue();
+  const size_t nlocs = bt18v.size();
+
+  // Find the locations at which the retrieval is carried out and flag all others.
+  std::vector<size_t> retrieved(nlocs);
+  size_t nretrieved = 0;
+  for (size_t iloc = 0; iloc < nlocs; ++iloc) {
+    const bool valid = bt18v[iloc] > bt18h[iloc] && bt36v[iloc] > bt36h[iloc];
+    out[iloc] = bad;
+    retrieved[nretrieved] = iloc;
+    nretrieved += valid;
+  }
 
-  for (size_t iloc = 0; iloc < bt18v.size(); ++iloc) {
-    if (bt18v[iloc] <= bt18h[iloc]) {
-      out[iloc] = getBadValue();
-    } else if (bt36v[iloc] <= bt36h[iloc]) {
-      out[iloc] = getBadValue();
-    } else {
-      // Calculate predictors
-      pred_var_clw[0] = log(bt18v[iloc] - bt18h[iloc]);
-      pred_var_clw[1] = log(bt36v[iloc] - bt36h[iloc]);
-      clw = a0_clw + bt36h[iloc]*regr_coeff_clw[0];
-      for (size_t nvar_clw=0; nvar_clw < pred_var_clw.size(); ++nvar_clw) {
-        clw = clw + (pred_var_clw[nvar_clw] * regr_coeff_clw[nvar_clw+1]);
-      }
-      clw = std::max(0.0f, clw);
-      clw = std::min(6.0f, clw);
-      out[iloc] = clw;
-    }
+  // Carry out the retrieval at these locations only.
+  for (size_t i = 0; i < nretrieved; ++i) {
+    const size_t iloc = retrieved[i];
+    // Calculate predictors
+    const float pred_var_clw0 = log(bt18v[iloc] - bt18h[iloc]);
+    const float pred_var_clw1 = log(bt36v[iloc] - bt36h[iloc]);
+    float clw = a0_clw + bt36h[iloc]*regr_coeff_clw[0];
+    clw = clw + (pred_var_clw0 * regr_coeff_clw[1]);
+    clw = clw + (pred_var_clw1 * regr_coeff_clw[2]);
+    clw = std::max(0.0f, clw);
+    clw = std::min(6.0f, clw);
+    out[iloc] = clw;
   }
 }
 // -----------------------------------------------------------------------------
@@ -8,6 +8,7 @@
 #include "ufo/filters/obsfunctions/CLWRetMW_SSMIS.h"
 
 #include <algorithm>
+#include <array>
 #include <cmath>
 #include <iomanip>
 #include <iostream>
@@ -97,14 +98,9 @@ void CLWRetMW_SSMIS::cloudLiquidWater(const std::vector<float> & bt19h,
   ///          Issue on the DMSP SSMIS, 46, 984-995.
 
   const float missing = util::missingValue(missing);
-  const size_t nchannels = 7;
+  constexpr size_t nchannels = 7;
   const size_t nlocs = bt19h.size();
 
-  // Initialize output to missing.
-  for (size_t iloc = 0; iloc < nlocs; ++iloc) {
-    clw[iloc] = missing;
-  }
-
   // SSMIS information about channels and frequecies came from
   //  http://rain.atmos.colostate.edu/FCDR/ssmis.html
   //  Channels 12-18: 19.35h, 19.35v, 22.235, 37h, 37v, 91.655h, 91.655v GHz.
@@ -121,81 +117,89 @@ void CLWRetMW_SSMIS::cloudLiquidWater(const std::vector<float> & bt19h,
     dp[i] = cp[i]*dp0[i];
   }
 
-  // Setting the tax array to a relatively large number in the event that any missing data
-  // will fail the IF-tests of brightness temperatures less than 285K, ensures the output
-  // CLW is missing also.
+  const float det01 = cp[0]*cp[1] - dp[0]*dp[1];
+  const float det34 = cp[3]*cp[4] - dp[3]*dp[4];
+  const float det56 = cp[5]*cp[6] - dp[5]*dp[6];
 
-  std::vector<float> bt_test(nchannels);
-  std::vector<std::vector<float> > tax(nlocs, std::vector<float> (nchannels));
-  std::vector<std::vector<float> > tay(nlocs, std::vector<float> (nchannels));
+  // Find the locations over water, at which the retrieval is carried out.
+  std::vector<size_t> retrieved(nlocs);
+  size_t nretrieved = 0;
   for (size_t iloc = 0; iloc < nlocs; ++iloc) {
-    const std::vector<float> btest = {bt19h[iloc], bt19v[iloc], bt22v[iloc], bt37h[iloc],
-                                      bt37v[iloc], bt91v[iloc], bt91h[iloc]};
-    if (std::any_of(btest.begin(), btest.end(), [](float x){return (x <= 0.0f || x >= 300.0f);})) {
-      for (size_t ich = 0; ich < nchannels; ++ich) {
-        tax[iloc][ich] = 999.0f;
-      }
-    } else {
-      tax[iloc][0] = (bt19h[iloc]*cp[1] + bt19v[iloc]*dp[0])/(cp[0]*cp[1] - dp[0]*dp[1]);
-      tax[iloc][1] = (bt19h[iloc]*dp[1] + bt19v[iloc]*cp[0])/(cp[0]*cp[1] - dp[0]*dp[1]);
-      tax[iloc][2] = 1.0/cp[2]*(bt22v[iloc] + dp[2]*(0.653*tax[iloc][1] + 96.6));
-      tax[iloc][3] = (bt37h[iloc]*cp[4] + bt37v[iloc]*dp[3])/(cp[3]*cp[4] - dp[3]*dp[4]);
-      tax[iloc][4] = (bt37h[iloc]*dp[4] + bt37v[iloc]*cp[3])/(cp[3]*cp[4] - dp[3]*dp[4]);
-      tax[iloc][5] = (bt91v[iloc]*cp[6] + bt91h[iloc]*dp[5])/(cp[5]*cp[6] - dp[5]*dp[6]);
-      tax[iloc][6] = (bt91v[iloc]*dp[6] + bt91h[iloc]*cp[5])/(cp[5]*cp[6] - dp[5]*dp[6]);
-    }
+    clw[iloc] = missing;
+    retrieved[nretrieved] = iloc;
+    nretrieved += water_frac[iloc] >= 0.99;
+  }
 
+  // All three algorithms are evaluated at each of these locations and the result is selected
+  // afterwards, so that the loop has few branches. The arguments of the logarithms are replaced
+  // by 1 where the corresponding algorithm isn't applicable.
+  for (size_t i = 0; i < nretrieved; ++i) {
+    const size_t iloc = retrieved[i];
+    // Setting the tax array to a relatively large number in the event that any missing data
+    // will fail the IF-tests of brightness temperatures less than 285K, ensures the output
+    // CLW is missing also.
+    const bool valid = bt19h[iloc] > 0.0f && bt19h[iloc] < 300.0f &&
+                       bt19v[iloc] > 0.0f && bt19v[iloc] < 300.0f &&
+                       bt22v[iloc] > 0.0f && bt22v[iloc] < 300.0f &&
+                       bt37h[iloc] > 0.0f && bt37h[iloc] < 300.0f &&
+                       bt37v[iloc] > 0.0f && bt37v[iloc] < 300.0f &&
+                       bt91v[iloc] > 0.0f && bt91v[iloc] < 300.0f &&
+                       bt91h[iloc] > 0.0f && bt91h[iloc] < 300.0f;
+    // Replace invalid brightness temperatures by values that can't cause overflows.
+    const float tb19h = valid ? bt19h[iloc] : 0.0f;
+    const float tb19v = valid ? bt19v[iloc] : 0.0f;
+    const float tb22v = valid ? bt22v[iloc] : 0.0f;
+    const float tb37h = valid ? bt37h[iloc] : 0.0f;
+    const float tb37v = valid ? bt37v[iloc] : 0.0f;
+    const float tb91v = valid ? bt91v[iloc] : 0.0f;
+    const float tb91h = valid ? bt91h[iloc] : 0.0f;
+
+    std::array<float, nchannels> tax;
+    tax[0] = (tb19h*cp[1] + tb19v*dp[0])/det01;
+    tax[1] = (tb19h*dp[1] + tb19v*cp[0])/det01;
+    tax[2] = 1.0/cp[2]*(tb22v + dp[2]*(0.653*tax[1] + 96.6));
+    tax[3] = (tb37h*cp[4] + tb37v*dp[3])/det34;
+    tax[4] = (tb37h*dp[4] + tb37v*cp[3])/det34;
+    tax[5] = (tb91v*cp[6] + tb91h*dp[5])/det56;
+    tax[6] = (tb91v*dp[6] + tb91h*cp[5])/det56;
+
+    std::array<float, nchannels> tay;
     for (size_t ich = 0; ich < nchannels; ++ich) {
-      tay[iloc][ich] =  ap[ich] + bp[ich]*tax[iloc][ich];
+      tay[ich] = ap[ich] + bp[ich]*(valid ? tax[ich] : 999.0f);
     }
-  }
 
-  float alg1, alg2, alg3;
-  float tby1, tby3, tby4, tpwc;
-  for (size_t iloc = 0; iloc < nlocs; ++iloc) {
-    if (water_frac[iloc] >= 0.99) {
-      clw[iloc] = 0.0;
-      alg1 = 0.0, alg2 = 0.0, alg3 = 0.0;
-      tby1 = 0.0, tby3 = 0.0, tby4 = 0.0, tpwc = 0.0;
-      // Try the quickest answer related to channels 2 and 3.
-      alg1 = 0.0;
-      if (tay[iloc][1] < 285.0 && tay[iloc][2] < 285.0) {
-        alg1 = -3.20*(std::log(290.0f-tay[iloc][1]) - 2.80 - 0.42*std::log(290.0f-tay[iloc][2]));
-      }
-      if (alg1 > 0.70) {
-        clw[iloc] = alg1;
-        clw[iloc] = std::max(0.0f, std::min(alg1, 6.0f));
-      } else {
-        // Try the next quickest answer related to channels 3 and 5.
-        alg2 = 0.0;
-        if (tay[iloc][4] < 285.0 && tay[iloc][2] < 285.0) {
-          alg2 = -1.66*(std::log(290.0f-tay[iloc][4]) - 2.90 - 0.349*std::log(290.0f-tay[iloc][2]));
-        }
-        if (alg2 > 0.28) {
-          clw[iloc] = alg2;
-          clw[iloc] = std::max(0.0f, std::min(alg2, 6.0f));
-        } else {
-          // Final test using channels 3 and 7, but we first need total precipitable water.
-          tby1  =  cp[0]*tay[iloc][0] - dp[0]*tay[iloc][1];
-          tby3  =  cp[2]*tay[iloc][2] - dp[2]*(0.653*tay[iloc][1] + 96.6);
-          tby4  =  cp[3]*tay[iloc][3] - dp[3]*tay[iloc][4];
-          tpwc = 232.89 - 0.1486*tby1 - 0.3695*tby4 - (1.8291 - 0.006193*tby3)*tby3;
-
-          if (tpwc < 30.0) {
-            alg3 = 0;
-            if (tay[iloc][6] < 285.0 && tay[iloc][2] < 285.0) {
-              alg3 = -0.44*(std::log(290.f-tay[iloc][6]) + 1.60
-                     - 1.354*std::log(290.f-tay[iloc][2]));
-              clw[iloc] = alg3;
-              clw[iloc] = std::max(0.0f, std::min(alg3, 6.0f));
-            }
-          } else if (alg2 > 0.0) {
-            clw[iloc] = alg2;
-            clw[iloc] = std::max(0.0f, std::min(alg2, 6.0f));
-          }
-        }
-      }
+    // Try the quickest answer related to channels 2 and 3.
+    const bool use1 = tay[1] < 285.0 && tay[2] < 285.0;
+    // Try the next quickest answer related to channels 3 and 5.
+    const bool use2 = tay[4] < 285.0 && tay[2] < 285.0;
+    // Final test using channels 3 and 7, but we first need total precipitable water.
+    const bool use3 = tay[6] < 285.0 && tay[2] < 285.0;
+
+    const float log1 = std::log(use1 ? 290.0f-tay[1] : 1.0f);
+    const float log2 = std::log(use2 ? 290.0f-tay[4] : 1.0f);
+    const float log3 = std::log(use3 ? 290.f-tay[6] : 1.0f);
+    const float log22v = std::log(use1 || use2 || use3 ? 290.0f-tay[2] : 1.0f);
+
+    const float alg1 = use1 ? -3.20*(log1 - 2.80 - 0.42*log22v) : 0.0f;
+    const float alg2 = use2 ? -1.66*(log2 - 2.90 - 0.349*log22v) : 0.0f;
+    const float alg3 = use3 ? -0.44*(log3 + 1.60 - 1.354*log22v) : 0.0f;
+
+    const float tby1 = cp[0]*tay[0] - dp[0]*tay[1];
+    const float tby3 = cp[2]*tay[2] - dp[2]*(0.653*tay[1] + 96.6);
+    const float tby4 = cp[3]*tay[3] - dp[3]*tay[4];
+    const float tpwc = 232.89 - 0.1486*tby1 - 0.3695*tby4 - (1.8291 - 0.006193*tby3)*tby3;
+
+    float result = 0.0f;
+    if (alg1 > 0.70) {
+      result = std::max(0.0f, std::min(alg1, 6.0f));
+    } else if (alg2 > 0.28) {
+      result = std::max(0.0f, std::min(alg2, 6.0f));
+    } else if (tpwc < 30.0) {
+      result = use3 ? std::max(0.0f, std::min(alg3, 6.0f)) : 0.0f;
+    } else if (alg2 > 0.0) {
+      result = std::max(0.0f, std::min(alg2, 6.0f));
     }
+    clw[iloc] = result;
   }
 }
 
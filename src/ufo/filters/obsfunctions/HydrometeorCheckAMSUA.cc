@@ -159,149 +159,116 @@ void HydrometeorCheckAMSUA::compute(const ObsFilterData & in,
   float w1f6 = 1.0/10.0, w2f6 = 1.0/0.80;
   float w1f4 = 1.0/0.30, w2f4 = 1.0/1.80;
 
-  std::vector<std::vector<int>> affected_channels(nchans, std::vector<int>(nlocs));
+  // Sets of channels affected by the checks below. Each set contains the previous one.
+  enum AffectedChannels {
+    NONE = 0,
+    // Channels sensitive to the surface emissivity (1-5, 15)
+    SURFACE = 1,
+    // All window channels (1-6, 15)
+    WINDOW = 2
+  };
+
   // Loop over locations
   // Combined cloud-precipitation-surface checks
+  // Only the largest set of channels affected at each location is recorded; the channel loop
+  // writing the output is kept separate so that both loops access memory contiguously.
+  std::vector<int> affected(nlocs, NONE);
   for (size_t iloc = 0; iloc < nlocs; ++iloc) {
-    // Initialization
-    for (size_t ich = 0; ich < nchans; ++ich) {
-      affected_channels[ich][iloc] = 0;
-    }
+    const bool water = water_frac[iloc] > 0.99;
 
     // Calculate cloud effect
     float cldeff_obs536 = 0.0;
-    if (water_frac[iloc] > 0.99) {
+    if (water) {
       cldeff_obs536 = btobs[ich536][iloc] - hofxclr536[iloc] - bias[ich536][iloc];
     }
 
     // Calculate scattering effect
-    std::vector<float> factch4(nlocs);
-    std::vector<float> factch6(nlocs);
     float btobsbc238 = btobs[ich238][iloc] - bias_const238[iloc]
                                            - bias_scanang238[iloc];
     float clwx = 0.6;
     float dsval = 0.8;
-    if (water_frac[iloc] > 0.99) {
+    if (water) {
       clwx = 0.0;
       dsval = ((2.410 - 0.0098 * btobsbc238) * innov[ich238][iloc] +
                 0.454 * innov[ich314][iloc] - innov[ich890][iloc]) * w1f6;
       dsval = std::max(static_cast<float>(0.0), dsval);
     }
-    factch4[iloc] = pow(clwx, 2) + pow(innov[ich528][iloc] * w2f4, 2);
-    factch6[iloc] = pow(dsval, 2) + pow(innov[ich544][iloc] * w2f6, 2);
+    const float factch4 = pow(clwx, 2) + pow(innov[ich528][iloc] * w2f4, 2);
+    const float factch6 = pow(dsval, 2) + pow(innov[ich544][iloc] * w2f6, 2);
 
     // Window channel sanity check
     // If any of the window channels is bad, skip all window channels
     // List of surface sensitivity channels
-    std::vector<float> OmFs{std::abs(innov[ich238][iloc]), std::abs(innov[ich314][iloc]),
-                            std::abs(innov[ich503][iloc]), std::abs(innov[ich528][iloc]),
-                            std::abs(innov[ich536][iloc]), std::abs(innov[ich544][iloc]),
-                            std::abs(innov[ich890][iloc])};
-    bool result = false;
-    result = any_of(OmFs.begin(), OmFs.end(), [](float x){return x > 200.0;});
-
+    const bool result = std::abs(innov[ich238][iloc]) > 200.0 ||
+                        std::abs(innov[ich314][iloc]) > 200.0 ||
+                        std::abs(innov[ich503][iloc]) > 200.0 ||
+                        std::abs(innov[ich528][iloc]) > 200.0 ||
+                        std::abs(innov[ich536][iloc]) > 200.0 ||
+                        std::abs(innov[ich544][iloc]) > 200.0 ||
+                        std::abs(innov[ich890][iloc]) > 200.0;
+
+    int level = NONE;
     if (result) {
-      for (size_t ich = ich238; ich <= ich544; ++ich) {
-        affected_channels[ich][iloc] = 1;
+      level = WINDOW;
+    } else if (water) {
+      // Hydrometeor check over water surface
+      // Cloud water retrieval sanity check
+      if (clwobs[0][iloc] > 999.0) level = WINDOW;
+
+      // Precipitation check (factch6)
+      // Scattering check (ch5 cloud effect)
+      if (factch6 >= 1.0 || cldeff_obs536 < -0.5) {
+        level = WINDOW;
+      // Sensitivity of BT to the surface emissivity check
+      } else {
+        const double clwfactor = 1.0 - std::max(1.0, 10.0*clwobs[0][iloc]);
+        auto de = [&](int ich) -> float {
+          const float dbtdech = dbtde[ich][iloc];
+          return dbtdech != 0.0 ? std::abs(innov[ich][iloc]) / dbtdech *
+                                  (obserr0[ich] / obserr[ich][iloc]) * clwfactor : 0.0;
+        };
+        float thrd238 = 0.025, thrd314 = 0.015, thrd503 = 0.030, thrd890 = 0.030;
+        const bool qcemiss = de(ich238) > thrd238 || de(ich314) > thrd314 ||
+                             de(ich503) > thrd503 || de(ich890) > thrd890;
+        if (qcemiss) level = std::max(level, static_cast<int>(SURFACE));
       }
-      affected_channels[ich890][iloc] = 1;
     } else {
-      // Hydrometeor check over water surface
-      if (water_frac[iloc] > 0.99) {
-        // Cloud water retrieval sanity check
-        if (clwobs[0][iloc] > 999.0) {
-          for (size_t ich = ich238; ich <= ich544; ++ich) {
-            affected_channels[ich][iloc] = 1;
-          }
-          affected_channels[ich890][iloc] = 1;
-        }
-
-        // Precipitation check (factch6)
-        if (factch6[iloc] >= 1.0) {
-          for (size_t ich = ich238; ich <= ich544; ++ich) {
-            affected_channels[ich][iloc] = 1;
-          }
-          affected_channels[ich890][iloc] = 1;
-        // Scattering check (ch5 cloud effect)
-        } else if (cldeff_obs536 < -0.5) {
-          for (size_t ich = ich238; ich <= ich544; ++ich) {
-            affected_channels[ich][iloc] = 1;
-          }
-          affected_channels[ich890][iloc] = 1;
-        // Sensitivity of BT to the surface emissivity check
-        } else {
-          float thrd238 = 0.025, thrd314 = 0.015, thrd503 = 0.030, thrd890 = 0.030;
-          float de238 = 0.0, de314 = 0.0, de503 = 0.0, de890 = 0.0;
-          float dbtde238 = dbtde[ich238][iloc];
-          float dbtde314 = dbtde[ich314][iloc];
-          float dbtde503 = dbtde[ich503][iloc];
-          float dbtde890 = dbtde[ich890][iloc];
-          if (dbtde238 != 0.0) de238 = std::abs(innov[ich238][iloc]) / dbtde238 *
-                                       (obserr0[ich238] / obserr[ich238][iloc]) *
-                                       (1.0 - std::max(1.0, 10.0*clwobs[0][iloc]));
-          if (dbtde314 != 0.0) de314 = std::abs(innov[ich314][iloc]) / dbtde314 *
-                                       (obserr0[ich314] / obserr[ich314][iloc]) *
-                                       (1.0 - std::max(1.0, 10.0*clwobs[0][iloc]));
-          if (dbtde503 != 0.0) de503 = std::abs(innov[ich503][iloc]) / dbtde503 *
-                                       (obserr0[ich503] / obserr[ich503][iloc]) *
-                                       (1.0 - std::max(1.0, 10.0*clwobs[0][iloc]));
-          if (dbtde890 != 0.0) de890 = std::abs(innov[ich890][iloc]) / dbtde890 *
-                                       (obserr0[ich890] / obserr[ich890][iloc]) *
-                                       (1.0 - std::max(1.0, 10.0*clwobs[0][iloc]));
-          bool qcemiss = false;
-          qcemiss = de238 > thrd238 || de314 > thrd314 || de503 > thrd503 || de890 > thrd890;
-          if (qcemiss) {
-            for (size_t ich = ich238; ich <= ich536; ++ich) {
-              affected_channels[ich][iloc] = 1;
-            }
-            affected_channels[ich890][iloc] = 1;
-          }
-        }
+      // Hydrometeor check over non-water (land/sea ice/snow) surface
+      // Precipitation check (factch6)
+      if (factch6 >= 1.0) {
+        level = WINDOW;
+      // Thick cloud check (factch4)
+      } else if (factch4 > 0.5) {
+        level = SURFACE;
+      // Sensitivity of BT to the surface emissivity check
       } else {
-        // Hydrometeor check over non-water (land/sea ice/snow) surface
-        // Precipitation check (factch6)
-        if (factch6[iloc] >= 1.0) {
-          for (size_t ich = ich238; ich <= ich544; ++ich) {
-            affected_channels[ich][iloc] = 1;
-          }
-          affected_channels[ich890][iloc] = 1;
-        // Thick cloud check (factch4)
-        } else if (factch4[iloc] > 0.5) {
-          for (size_t ich = ich238; ich <= ich536; ++ich) {
-            affected_channels[ich][iloc] = 1;
-          }
-          affected_channels[ich890][iloc] = 1;
-        // Sensitivity of BT to the surface emissivity check
-        } else {
-          float thrd238 = 0.020, thrd314 = 0.015, thrd503 = 0.035, thrd890 = 0.015;
-          float de238 = 0.0, de314 = 0.0, de503 = 0.0, de890 = 0.0;
-          float dbtde238 = dbtde[ich238][iloc];
-          float dbtde314 = dbtde[ich314][iloc];
-          float dbtde503 = dbtde[ich503][iloc];
-          float dbtde890 = dbtde[ich890][iloc];
-          if (dbtde238 != 0.0) de238 = std::abs(innov[ich238][iloc]) / dbtde238;
-          if (dbtde314 != 0.0) de314 = std::abs(innov[ich314][iloc]) / dbtde314;
-          if (dbtde503 != 0.0) de503 = std::abs(innov[ich503][iloc]) / dbtde503;
-          if (dbtde890 != 0.0) de890 = std::abs(innov[ich890][iloc]) / dbtde890;
-          bool qcemiss = false;
-          qcemiss = de238 > thrd238 || de314 > thrd314 || de503 > thrd503 || de890 > thrd890;
-          if (qcemiss) {
-            for (size_t ich = ich238; ich <= ich536; ++ich) {
-              affected_channels[ich][iloc] = 1;
-            }
-            affected_channels[ich890][iloc] = 1;
-          }
-        }
-      // surface type
+        auto de = [&](int ich) -> float {
+          const float dbtdech = dbtde[ich][iloc];
+          return dbtdech != 0.0 ? std::abs(innov[ich][iloc]) / dbtdech : 0.0;
+        };
+        float thrd238 = 0.020, thrd314 = 0.015, thrd503 = 0.035, thrd890 = 0.015;
+        const bool qcemiss = de(ich238) > thrd238 || de(ich314) > thrd314 ||
+                             de(ich503) > thrd503 || de(ich890) > thrd890;
+        if (qcemiss) level = SURFACE;
       }
-    // window channel sanity check
     }
+    affected[iloc] = level;
   // loop over locations
   }
+
   // Output
   for (size_t ichan = 0; ichan < nchans; ++ichan) {
+    // Smallest set of channels containing this channel
+    const int jchan = ichan;
+    int minLevel = WINDOW + 1;
+    if ((jchan >= ich238 && jchan <= ich536) || jchan == ich890) {
+      minLevel = SURFACE;
+    } else if (jchan == ich544) {
+      minLevel = WINDOW;
+    }
+    std::vector<float> & flag = out[ichan];
     for (size_t iloc = 0; iloc < nlocs; ++iloc) {
-      out[ichan][iloc] = affected_channels[ichan][iloc];
+      flag[iloc] = affected[iloc] >= minLevel;
     }
   }
 }
@@ -77,9 +77,6 @@ void ObsErrorFactorConventional::compute(const ObsFilterData & data,
   const size_t nlocs = data.nlocs();
   const size_t nlevs = data.nlevs(Variable("air_pressure@GeoVaLs"));
 
-  // Get obs space
-  auto & obsdb = data.obsspace();
-
   // Get output variable size
   int varsize = obserr.nvars();
 
@@ -132,11 +129,8 @@ void ObsErrorFactorConventional::compute(const ObsFilterData & data,
     int icount = 0;
     int ireport = 0;
 
-    ioda::ObsSpace::RecIdxIter irec;   // Using obs grouping/sorting indices
-    for ( irec = obsdb.recidx_begin(); irec != obsdb.recidx_end(); ++irec ) {   // record loop
-      std:: size_t rNum = obsdb.recidx_recnum(irec);
-      std::vector<std::size_t> rSort = obsdb.recidx_vector(irec);
-
+    // Using obs grouping/sorting indices
+    for (const std::vector<std::size_t> & rSort : data.records()) {   // record loop
       ireport++;
       for (size_t iloc = 0; iloc < rSort.size(); ++iloc) {   // profile loop
         icount++;
@@ -204,7 +198,7 @@ void ObsErrorFactorConventional::compute(const ObsFilterData & data,
       std::string errString = "The data should be sorted or icount and nlocs are not consistent: ";
       oops::Log::error() << errString << icount << ", "<< nlocs << std::endl;
       throw eckit::BadValue(errString);
-    }  // irec loop
+    }  // record loop
     oops::Log::debug() << "ObsErrorFactorCon: inflate var, # of reports, total obs, filtered obs = "
                    << inflatevars[iv] << " " << ireport << " "<< nlocs << " " << ipass << std::endl;
   }  // iv loop
@@ -180,29 +180,43 @@ void ObsErrorFactorSituDependMW::compute(const ObsFilterData & in,
     ich544 = 7, ich549 = 8, ich890 = 16;
   }
 
-  // Calculate error factors (error_factors) for each channel
-  // Loop through locations
+  // Calculate the terms that depend on location only
+  // icol: product of CLW match indices of all channels
+  std::vector<float> icol(nlocs, 1.0);
+  for (size_t ichan = 0; ichan < nchans; ++ichan) {
+    for (size_t iloc = 0; iloc < nlocs; ++iloc) {
+      icol[iloc] = water_frac[iloc] >= 0.99 ? icol[iloc] * clwmatchidx[ichan][iloc] : icol[iloc];
+    }
+  }
+  std::vector<float> clwtmp(nlocs);
   for (size_t iloc = 0; iloc < nlocs; ++iloc) {
-    for (size_t ichan = 0; ichan < nchans; ++ichan) out[ichan][iloc] = 1.0;
-    if (water_frac[iloc] >= 0.99) {
-      float icol = 1.0;
-      for (size_t ichan = 0; ichan < nchans; ++ichan) icol = icol * clwmatchidx[ichan][iloc];
-      for (size_t ichan = 0; ichan < nchans; ++ichan) {
-        size_t channel = ichan + 1;
-        if (varinv[ichan][iloc] > 0.0 && (channel <= ich536 || channel >= ich890)) {
-          float term = (1.0 - icol) * std::abs(innov[ichan][iloc]);
-          term = term + std::min(0.002 * pow(surface_wind_speed[iloc], 2) * obserr0[ichan][iloc],
-                                 0.5 * obserr0[ichan][iloc]);
-          float clwtmp = std::min(std::abs((clwobs[0][iloc] - clwbkg[0][iloc])), 1.f);
-          term = term + std::min(13.0 * clwtmp * obserr0[ichan][iloc], 3.5 * obserr0[ichan][iloc]);
-          if (scatobs[0][iloc] > 9.0) {
-            term = term + std::min(1.5 * (scatobs[0][iloc] - 9.0) * obserr0[ichan][iloc],
-                                   2.5 * obserr0[ichan][iloc]);
-          }
-          term = pow(term, 2.0);
-          out[ichan][iloc] = 1.0 / (1.0 + varinv[ichan][iloc] * term);
-          out[ichan][iloc] = sqrt(1.0 / out[ichan][iloc]);
+    clwtmp[iloc] = std::min(std::abs((clwobs[0][iloc] - clwbkg[0][iloc])), 1.f);
+  }
+
+  // Calculate error factors (error_factors) for each channel
+  // Loop through channels, then locations, so that all arrays are accessed contiguously
+  for (size_t ichan = 0; ichan < nchans; ++ichan) {
+    std::vector<float> & factor = out[ichan];
+    const std::vector<float> & chan_varinv = varinv[ichan];
+    const std::vector<float> & chan_innov = innov[ichan];
+    const std::vector<float> & chan_obserr0 = obserr0[ichan];
+    const size_t channel = ichan + 1;
+    const bool affected = channel <= ich536 || channel >= ich890;
+    for (size_t iloc = 0; iloc < nlocs; ++iloc) {
+      factor[iloc] = 1.0;
+      if (affected && water_frac[iloc] >= 0.99 && chan_varinv[iloc] > 0.0) {
+        float term = (1.0 - icol[iloc]) * std::abs(chan_innov[iloc]);
+        term = term + std::min(0.002 * pow(surface_wind_speed[iloc], 2) * chan_obserr0[iloc],
+                               0.5 * chan_obserr0[iloc]);
+        term = term + std::min(13.0 * clwtmp[iloc] * chan_obserr0[iloc],
+                               3.5 * chan_obserr0[iloc]);
+        if (scatobs[0][iloc] > 9.0) {
+          term = term + std::min(1.5 * (scatobs[0][iloc] - 9.0) * chan_obserr0[iloc],
+                                 2.5 * chan_obserr0[iloc]);
         }
+        term = pow(term, 2.0);
+        factor[iloc] = 1.0 / (1.0 + chan_varinv[iloc] * term);
+        factor[iloc] = sqrt(1.0 / factor[iloc]);
       }
     }
   }
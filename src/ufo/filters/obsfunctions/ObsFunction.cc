@@ -7,15 +7,19 @@
 
 #include "ufo/filters/obsfunctions/ObsFunction.h"
 
+#include <string>
+
 #include "ioda/ObsDataVector.h"
 #include "ufo/filters/Variables.h"
+#include "ufo/utils/PerformanceMonitor.h"
 
 namespace ufo {
 
 // -----------------------------------------------------------------------------
 
 ObsFunction::ObsFunction(const Variable & var)
-  : obsfct_(ObsFunctionFactory::create(var))
+  : obsfct_(ObsFunctionFactory::create(var)),
+    monitorName_("/" + var.variable() + "@" + var.group() + "/compute")
 {}
 
 // -----------------------------------------------------------------------------
@@ -26,6 +30,7 @@ ObsFunction::~ObsFunction() {}
 
 void ObsFunction::compute(const ObsFilterData & in,
                           ioda::ObsDataVector<float> & out) const {
+  ScopedPerformanceMonitor monitor(in.obsspace().obsname(), monitorName_.c_str(), in.nlocs());
   obsfct_->compute(in, out);
 }
 
@@ -36,6 +36,9 @@ class ObsFunction : private boost::noncopyable {
   const ufo::Variables & requiredVariables() const;
  private:
   std::unique_ptr<ObsFunctionBase> obsfct_;
+  /// Key under which the cost of compute() is recorded in the PerformanceMonitor, without the
+  /// ObsSpace name.
+  std::string monitorName_;
 };
 
 // -----------------------------------------------------------------------------
@@ -95,14 +95,17 @@ void SCATRetMW::compute(const ObsFilterData & in,
       }
     }
     const float missing = util::missingValue(missing);
-    // Retrieve scattering index
+    // Retrieve scattering index. Missing brightness temperatures are replaced by zeros, so that
+    // the loop needs no branches, and the results obtained at these locations are discarded.
+    std::vector<float> & scat = out[igrp];
     for (size_t iloc = 0; iloc < nlocs; ++iloc) {
-      if (water_frac[iloc] >= 0.99 &&
-          bt238[iloc] != missing && bt314[iloc] != missing && bt890[iloc] != missing) {
-        out[igrp][iloc] = -113.2 + (2.41 - 0.0049 * bt238[iloc]) * bt238[iloc]
-                               + 0.454 * bt314[iloc] - bt890[iloc];
-        out[igrp][iloc] = std::max(0.f, out[igrp][iloc]);
-      }
+      const bool valid = water_frac[iloc] >= 0.99 &&
+          bt238[iloc] != missing && bt314[iloc] != missing && bt890[iloc] != missing;
+      const float tb238 = valid ? bt238[iloc] : 0.0f;
+      const float tb314 = valid ? bt314[iloc] : 0.0f;
+      const float tb890 = valid ? bt890[iloc] : 0.0f;
+      const float value = -113.2 + (2.41 - 0.0049 * tb238) * tb238 + 0.454 * tb314 - tb890;
+      scat[iloc] = valid ? std::max(0.f, value) : scat[iloc];
     }
   }
 }
@@ -105,29 +105,20 @@ void SIRetMW::compute(const ObsFilterData & in,
       } else {
         for (size_t iloc = 0; iloc < nlocs; ++iloc) {
           // Temporarily account for ZERO clear-sky BT output from CRTM
-          if (clr90[iloc] > -1.0f && clr90[iloc] < 1.0f) {
-            clr90[iloc] = bt90[iloc];
-          } else {
-            clr90[iloc] = clr90[iloc] + bias90[iloc];
-          }
-          if (clr150[iloc] > -1.0f && clr150[iloc] < 1.0f) {
-            clr150[iloc] = bt150[iloc];
-          } else {
-            clr150[iloc] = clr150[iloc] + bias150[iloc];
-          }
+          const bool zero90 = clr90[iloc] > -1.0f && clr90[iloc] < 1.0f;
+          const bool zero150 = clr150[iloc] > -1.0f && clr150[iloc] < 1.0f;
+          clr90[iloc] = zero90 ? bt90[iloc] : clr90[iloc] + bias90[iloc];
+          clr150[iloc] = zero150 ? bt150[iloc] : clr150[iloc] + bias150[iloc];
         }
       }
     }
 
-    // Retrieve scattering index
+    // Retrieve scattering index (over water, relative to its clear-sky value)
+    std::vector<float> & si = out[igrp];
     for (size_t iloc = 0; iloc < nlocs; ++iloc) {
-      if (water_frac[iloc] >= 0.99) {
-        float siclr = clr90[iloc] - clr150[iloc];
-        out[igrp][iloc] = bt90[iloc] - bt150[iloc] - siclr;
-      } else {
-        out[igrp][iloc] = bt90[iloc] - bt150[iloc];
-      }
-      }
+      const float siclr = water_frac[iloc] >= 0.99 ? clr90[iloc] - clr150[iloc] : 0.0f;
+      si[iloc] = bt90[iloc] - bt150[iloc] - siclr;
+    }
   }
 }
 
@@ -186,8 +186,8 @@ void applyMinMax(std::vector<bool> & where, WhereParameters const & parameters,
 
   // Apply mask min/max
   if (vmin != not_set_value || vmax != not_set_value) {
-    std::vector<T> data;
-    filterdata.get(varname, data);
+    std::vector<T> buffer;
+    const std::vector<T> & data = filterdata.getRef(varname, buffer);
     processWhereMinMax(data, vmin, vmax, where);
   }
 }
@@ -204,8 +204,8 @@ void applyMinMax<util::DateTime>(std::vector<bool> & where, WhereParameters cons
 
   // Apply mask min/max
   if (vmin != not_set_value || vmax != not_set_value) {
-    std::vector<util::DateTime> data;
-    filterdata.get(varname, data);
+    std::vector<util::DateTime> buffer;
+    const std::vector<util::DateTime> & data = filterdata.getRef(varname, buffer);
     processWhereMinMax(data, vmin, vmax, where);
   }
 }
@@ -342,34 +342,34 @@ void processWhereMatchesAnyWildcardPattern(const std::vector<int> & data,
 // -----------------------------------------------------------------------------
 void isInString(std::vector<bool> & where, std::vector<std::string> const & allowedValues,
                 ObsFilterData const & filterdata, Variable const & varname) {
-  std::vector<std::string> data;
+  std::vector<std::string> buffer;
   std::set<std::string> whitelist(allowedValues.begin(), allowedValues.end());
-  filterdata.get(varname, data);
+  const std::vector<std::string> & data = filterdata.getRef(varname, buffer);
   processWhereIsIn(data, whitelist, where);
 }
 
 // -----------------------------------------------------------------------------
 void isInInteger(std::vector<bool> & where, std::set<int> const & allowedValues,
                  ObsFilterData const & filterdata, Variable const & varname) {
-  std::vector<int> data;
-  filterdata.get(varname, data);
+  std::vector<int> buffer;
+  const std::vector<int> & data = filterdata.getRef(varname, buffer);
   processWhereIsIn(data, allowedValues, where);
 }
 
 // -----------------------------------------------------------------------------
 void isNotInString(std::vector<bool> & where, std::vector<std::string> const & forbiddenValues,
                    ObsFilterData const & filterdata, Variable const & varname) {
-  std::vector<std::string> data;
+  std::vector<std::string> buffer;
   std::set<std::string> blacklist(forbiddenValues.begin(), forbiddenValues.end());
-  filterdata.get(varname, data);
+  const std::vector<std::string> & data = filterdata.getRef(varname, buffer);
   processWhereIsNotIn(data, blacklist, where);
 }
 
 // -----------------------------------------------------------------------------
 void isNotInInteger(std::vector<bool> & where, std::set<int> const & forbiddenValues,
                     ObsFilterData const & filterdata, Variable const & varname) {
-  std::vector<int> data;
-  filterdata.get(varname, data);
+  std::vector<int> buffer;
+  const std::vector<int> & data = filterdata.getRef(varname, buffer);
   processWhereIsNotIn(data, forbiddenValues, where);
 }
 
@@ -399,8 +399,8 @@ std::vector<bool> processWhere(const std::vector<WhereParameters> & params,
 //      Apply mask is_defined
         if (currentParams.isDefined.value()) {
           if (filterdata.has(varname)) {
-            std::vector<float> data;
-            filterdata.get(varname, data);
+            std::vector<float> buffer;
+            const std::vector<float> & data = filterdata.getRef(varname, buffer);
             processWhereIsDefined(data, where);
           } else {
             std::fill(where.begin(), where.end(), false);
@@ -409,8 +409,8 @@ std::vector<bool> processWhere(const std::vector<WhereParameters> & params,
 
 //      Apply mask is_not_defined
         if (currentParams.isNotDefined.value()) {
-          std::vector<float> data;
-          filterdata.get(varname, data);
+          std::vector<float> buffer;
+          const std::vector<float> & data = filterdata.getRef(varname, buffer);
           processWhereIsNotDefined(data, where);
         }
 
@@ -432,8 +432,8 @@ std::vector<bool> processWhere(const std::vector<WhereParameters> & params,
 //      Apply mask is_close
         if (currentParams.isClose.value() != boost::none) {
           if (dtype == ioda::ObsDtype::Float) {
-            std::vector<float> data;
-            filterdata.get(varname, data);
+            std::vector<float> buffer;
+            const std::vector<float> & data = filterdata.getRef(varname, buffer);
             if (currentParams.relativetolerance.value() == boost::none &&
                 currentParams.absolutetolerance.value() != boost::none) {
               processWhereIsClose(data, currentParams.absolutetolerance.value().get(),
@@ -472,8 +472,8 @@ std::vector<bool> processWhere(const std::vector<WhereParameters> & params,
 //      Apply mask is_not_close
         if (currentParams.isNotClose.value() != boost::none) {
           if (dtype == ioda::ObsDtype::Float) {
-            std::vector<float> data;
-            filterdata.get(varname, data);
+            std::vector<float> buffer;
+            const std::vector<float> & data = filterdata.getRef(varname, buffer);
             if (currentParams.relativetolerance.value() == boost::none &&
                 currentParams.absolutetolerance.value() != boost::none) {
               processWhereIsNotClose(data, currentParams.absolutetolerance.value().get(),
@@ -497,9 +497,9 @@ std::vector<bool> processWhere(const std::vector<WhereParameters> & params,
 //      Apply mask any_bit_set_of
         if (currentParams.anyBitSetOf.value() != boost::none) {
           if (dtype == ioda::ObsDtype::Integer) {
-            std::vector<int> data;
+            std::vector<int> buffer;
             const std::set<int> &bitIndices = *currentParams.anyBitSetOf.value();
-            filterdata.get(varname, data);
+            const std::vector<int> & data = filterdata.getRef(varname, buffer);
             processWhereAnyBitSetOf(data, bitIndices, where);
           } else {
             throw eckit::UserError(
@@ -511,9 +511,9 @@ std::vector<bool> processWhere(const std::vector<WhereParameters> & params,
 //      Apply mask any_bit_unset_of
         if (currentParams.anyBitUnsetOf.value() != boost::none) {
           if (dtype == ioda::ObsDtype::Integer) {
-            std::vector<int> data;
+            std::vector<int> buffer;
             const std::set<int> &bitIndices = *currentParams.anyBitUnsetOf.value();
-            filterdata.get(varname, data);
+            const std::vector<int> & data = filterdata.getRef(varname, buffer);
             processWhereAnyBitUnsetOf(data, bitIndices, where);
           } else {
             throw eckit::UserError(
@@ -528,12 +528,12 @@ std::vector<bool> processWhere(const std::vector<WhereParameters> & params,
           // Select observations for which the variable 'varname' matches the regular expression
           // 'pattern'.
           if (dtype == ioda::ObsDtype::Integer) {
-            std::vector<int> data;
-            filterdata.get(varname, data);
+            std::vector<int> buffer;
+            const std::vector<int> & data = filterdata.getRef(varname, buffer);
             processWhereMatchesRegex(data, pattern, where);
           } else if (dtype == ioda::ObsDtype::String) {
-            std::vector<std::string> data;
-            filterdata.get(varname, data);
+            std::vector<std::string> buffer;
+            const std::vector<std::string> & data = filterdata.getRef(varname, buffer);
             processWhereMatchesRegex(data, pattern, where);
           } else {
             throw eckit::UserError(
@@ -548,12 +548,12 @@ std::vector<bool> processWhere(const std::vector<WhereParameters> & params,
           // Select observations for which the variable 'varname' matches the pattern
           // 'pattern', which may contain the * and ? wildcards.
           if (dtype == ioda::ObsDtype::Integer) {
-            std::vector<int> data;
-            filterdata.get(varname, data);
+            std::vector<int> buffer;
+            const std::vector<int> & data = filterdata.getRef(varname, buffer);
             processWhereMatchesAnyWildcardPattern(data, {pattern}, where);
           } else if (dtype == ioda::ObsDtype::String) {
-            std::vector<std::string> data;
-            filterdata.get(varname, data);
+            std::vector<std::string> buffer;
+            const std::vector<std::string> & data = filterdata.getRef(varname, buffer);
             processWhereMatchesAnyWildcardPattern(data, {pattern}, where);
           } else {
             throw eckit::UserError(
@@ -568,12 +568,12 @@ std::vector<bool> processWhere(const std::vector<WhereParameters> & params,
           // Select observations for which the variable 'varname' matches any of the patterns
           // 'patterns'; these may contain the * and ? wildcards.
           if (dtype == ioda::ObsDtype::Integer) {
-            std::vector<int> data;
-            filterdata.get(varname, data);
+            std::vector<int> buffer;
+            const std::vector<int> & data = filterdata.getRef(varname, buffer);
             processWhereMatchesAnyWildcardPattern(data, patterns, where);
           } else if (dtype == ioda::ObsDtype::String) {
-            std::vector<std::string> data;
-            filterdata.get(varname, data);
+            std::vector<std::string> buffer;
+            const std::vector<std::string> & data = filterdata.getRef(varname, buffer);
             processWhereMatchesAnyWildcardPattern(data, patterns, where);
           } else {
             throw eckit::UserError(
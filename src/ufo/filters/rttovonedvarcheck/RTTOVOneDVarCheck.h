@@ -58,6 +58,9 @@ class RTTOVOneDVarCheck : public FilterBase,
                   std::shared_ptr<ioda::ObsDataVector<float> >);
   ~RTTOVOneDVarCheck() override;
 
+  /// The QC flags of all variables are read back from the ObsSpace after the Fortran code has run.
+  oops::Variables modifiedVars() const override {return flags_->varnames();}
+
  private:
   void print(std::ostream &) const override;
   void applyFilter(const std::vector<bool> &, const Variables &,
@@ -295,7 +295,6 @@ Iterations: do iter = 1, self % max1DVarIterations
     call ufo_rttovonedvarcheck_NewtonManyChans (Ydiff,          &
                                      nchans,                    &
                                      H_matrix(:,:),             & ! in
-                                     transpose (H_matrix(:,:)), & ! in
                                      nprofelements,             &
                                      Diffprofile,               &
                                      b_inv,                     &
@@ -536,7 +535,7 @@ integer, intent(out)              :: Status          !< check if Cholesky decomp
 character(len=*), parameter :: RoutineName = "ufo_rttovonedvarcheck_NewtonFewChans"
 integer                     :: Element
 integer                     :: i
-real(kind_real)             :: HB(nChans,nprofelements) ! Scratch vector
+real(kind_real)             :: BHT(nprofelements,nChans) ! B.H^T = (H.B)^T
 real(kind_real)             :: Q(nChans)                ! Q = U^-1.V
 real(kind_real)             :: U(nChans,nChans)         ! U = H.B.H^T + R
 real(kind_real)             :: V(nChans)                ! V = (y-y(x_n))-H^T(xb-x_n)
@@ -547,8 +546,16 @@ Status = 0
 ! 1. Calculate the U and V vectors for the three forms of R matrix allowed
 !    for.
 !---------------------------------------------------------------------------
-HB = matmul(H_matrix, B_matrix)
-U = matmul(HB, H_matrix_T)
+! B is symmetric so B.H^T is the transpose of H.B; storing it this way round
+! keeps the columns used below contiguous and U is symmetric so only its
+! lower triangle needs computing.
+BHT = matmul(B_matrix, H_matrix_T)
+do i = 1, nChans
+  do Element = i, nChans
+    U(Element,i) = dot_product(H_matrix_T(:,Element), BHT(:,i))
+    U(i,Element) = U(Element,i)
+  end do
+end do
 
 ! Plus sign is not in error - it reverses sign of DeltaProfile to change
 ! from xn-xb to xb-xn
@@ -574,7 +581,7 @@ if (Status /= 0) goto 9999
 ! Delta profile is (HB)^T.Q
 !------
 
-DeltaProfile = matmul(transpose(HB), Q)
+DeltaProfile = matmul(BHT, Q)
 
 9999 continue
 end subroutine ufo_rttovonedvarcheck_NewtonFewChans
@@ -612,6 +619,10 @@ end subroutine ufo_rttovonedvarcheck_NewtonFewChans
 !!     -# The length of the observation vector is greater than the length
 !!        of the state vector
 !!
+!! H^T R^-1 H is computed as G^T.G, with G = R^(-1/2).H, so that only the lower
+!! triangle of this symmetric matrix needs computing. R^(-1/2) is stored in the
+!! r-matrix object and shared by all observations with the same channel selection.
+!!
 !! References:
 !!
 !!   Rodgers, Retrieval of atmospheric temperature and composition from
@@ -627,7 +638,6 @@ end subroutine ufo_rttovonedvarcheck_NewtonFewChans
 subroutine ufo_rttovonedvarcheck_NewtonManyChans (DeltaBT, &
                                        nChans,        &
                                        H_Matrix,      &
-                                       H_Matrix_T,    &
                                        nprofelements, &
                                        DeltaProfile,  &
                                        B_inverse,     &
@@ -640,7 +650,6 @@ implicit none
 real(kind_real), intent(in)       :: DeltaBT(:)      !< y-y(x)
 integer, intent(in)               :: nChans          !< number of channels
 real(kind_real), intent(in)       :: H_Matrix(:,:)   !< Jacobian
-real(kind_real), intent(in)       :: H_Matrix_T(:,:) !< (Jacobian)^T
 integer, intent(in)               :: nprofelements   !< number of elements in profile vector
 real(kind_real), intent(inout)    :: DeltaProfile(:) !< x-xb
 real(kind_real), intent(in)       :: B_inverse(:,:)  !< inverse state error covariance
@@ -649,26 +658,31 @@ integer, intent(out)              :: Status          !< check if Cholesky decomp
 
 ! Local declarations:
 character(len=*), parameter :: RoutineName = 'ufo_rttovonedvarcheck_NewtonManyChans'
-real(kind_real)             :: HTR(nprofelements, nChans)      ! Scratch vector
+integer                     :: i, j
+real(kind_real)             :: G(nChans, nprofelements)        ! G = R^(-1/2).H
+real(kind_real)             :: W(nChans)                       ! W = R^(-1/2).(y-y(x_n))
 real(kind_real)             :: U(nprofelements, nprofelements) ! U = H.B.H^T + R
 real(kind_real)             :: V(nprofelements)                ! V = (y-y(x_n))-H^T(xb-x_n)
 
 Status = 0
 
 !---------------------------------------------------------------------------
-! 1. Calculate HTR for the three allowed forms of R matrix. if required, the
-!    matrix is tested to determine whether it is stored as an inverse and
-!    inverted if not.
+! 1. Scale H and y-y(x_n) by R^(-1/2).
 !---------------------------------------------------------------------------
-!HTR = matmul(H_matrix_T, R_inverse)
-call r_matrix % multiply_inverse_matrix(H_matrix_T,HTR)
+call r_matrix % multiply_inverse_sqrt_matrix(H_matrix, G)
+call r_matrix % multiply_inverse_sqrt_vector(DeltaBT, W)
 
 !---------------------------------------------------------------------------
-! 2. Calculate U and V
+! 2. Calculate U = H^T.R^-1.H = G^T.G and V
 !---------------------------------------------------------------------------
 
-U = matmul(HTR, H_matrix)
-V = matmul(HTR, DeltaBT)
+do j = 1, nprofelements
+  do i = j, nprofelements
+    U(i,j) = dot_product(G(:,i), G(:,j))
+    U(j,i) = U(i,j)
+  end do
+end do
+V = matmul(W, G)
 V = V + matmul(U, DeltaProfile)
 
 !---------------------------------------------------------------------------
@@ -129,9 +129,9 @@ subroutine ufo_rttovonedvarcheck_apply(self, f_conf, vars, retrieval_vars, geova
   integer, allocatable               :: fields_in(:)
   real(kind_real)                    :: missing         ! missing value
   real(kind_real)                    :: t1, t2          ! timing
-  real(kind_real), allocatable       :: b_matrix(:,:)   ! 1d-var profile b matrix
-  real(kind_real), allocatable       :: b_inverse(:,:)  ! inverse for each 1d-var profile b matrix
-  real(kind_real), allocatable       :: b_sigma(:)      ! b_matrix diagonal error
+  real(kind_real), pointer           :: b_matrix(:,:)   ! 1d-var profile b matrix (view)
+  real(kind_real), pointer           :: b_inverse(:,:)  ! inverse for each 1d-var profile b matrix (view)
+  real(kind_real), pointer           :: b_sigma(:)      ! b_matrix diagonal error (view)
   logical                            :: file_exists     ! check if a file exists logical
   logical                            :: onedvar_success
   logical                            :: cloud_retrieval = .false.
@@ -175,11 +175,6 @@ subroutine ufo_rttovonedvarcheck_apply(self, f_conf, vars, retrieval_vars, geova
   ! Read in observation data from obsspace
   call obs % setup(self, prof_index % nprofelements, geovals, vars, IR_pcemis)
 
-  ! Initialize data arrays
-  allocate(b_matrix(prof_index % nprofelements,prof_index % nprofelements))
-  allocate(b_inverse(prof_index % nprofelements,prof_index % nprofelements))
-  allocate(b_sigma(prof_index % nprofelements))
-
   ! Decide on loop parameters - testing
   if (self % StartOb == 0) self % StartOb = 1
   if (self % FinishOb == 0) self % FinishOb = obs % iloc
@@ -207,9 +202,10 @@ subroutine ufo_rttovonedvarcheck_apply(self, f_conf, vars, retrieval_vars, geova
       call ufo_rttovonedvarcheck_check_geovals(self, local_geovals, &
               prof_index, obs % surface_type(jobs))
 
-      ! create b matrix arrays for this single observation location
-      call full_bmatrix % reset( obs % lat(jobs), & ! in
-                    b_matrix, b_inverse, b_sigma  ) ! out
+      ! point to the b matrix arrays of the latitude band of this observation;
+      ! these are shared by all observations in the band and must not be modified
+      call full_bmatrix % view( obs % lat(jobs), & ! in
+                    b_matrix, b_inverse, b_sigma ) ! out
 
       !---------------------------------------------------
       ! 2.2 Setup Jo terms
@@ -260,7 +256,12 @@ subroutine ufo_rttovonedvarcheck_apply(self, f_conf, vars, retrieval_vars, geova
           ob % emiss(jchans_used) = obs % emiss(jvar, jobs)
         end if
       end do
-      call r_submatrix % setup(nchans_used, ob % channels_used, full_rmatrix=full_rmatrix)
+      ! Consecutive observations often share a channel selection, in which case
+      ! the r-matrix (and its factorisation) from the previous one is reused
+      if (.not. r_submatrix % has_channels(ob % channels_used)) then
+        call r_submatrix % delete()
+        call r_submatrix % setup(nchans_used, ob % channels_used, full_rmatrix=full_rmatrix)
+      end if
 
       ! Setup hofxdiags for this retrieval
       call ufo_geovals_setup(hofxdiags, retrieval_vars, 1)
@@ -312,7 +313,6 @@ subroutine ufo_rttovonedvarcheck_apply(self, f_conf, vars, retrieval_vars, geova
       call ufo_geovals_delete(local_geovals)
       call ufo_geovals_delete(hofxdiags)
       call ob % delete()
-      call r_submatrix % delete()
 
     else
       call fckit_log % info("Final 1Dvar cost, apply = F")
@@ -335,11 +335,10 @@ subroutine ufo_rttovonedvarcheck_apply(self, f_conf, vars, retrieval_vars, geova
   ! Tidy up memory used for all observations
   call full_bmatrix % delete()
   call full_rmatrix % delete()
+  call r_submatrix % delete()
   call obs % delete()
   if (self % pcemiss) call IR_pcemis % delete()
-  if (allocated(b_matrix))  deallocate(b_matrix)
-  if (allocated(b_inverse)) deallocate(b_inverse)
-  if (allocated(b_sigma))   deallocate(b_sigma)
+  nullify(b_matrix, b_inverse, b_sigma)
   call rttov_simobs % delete()
 
 end subroutine ufo_rttovonedvarcheck_apply
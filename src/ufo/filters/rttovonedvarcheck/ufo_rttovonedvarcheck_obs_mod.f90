@@ -90,6 +90,7 @@ character(len=max_string)   :: varname
 logical                     :: variable_present = .false.
 logical                     :: model_surface_present = .false.
 type(ufo_geoval), pointer   :: geoval
+type(ufo_geoval), target    :: geovalcopy
 
 missing = missing_value(missing)
 self % iloc = obsspace_get_nlocs(config % obsdb)
@@ -197,14 +198,14 @@ else if (obsspace_has(config % obsdb, "MetaData", "surface_height")) then
 else if (obsspace_has(config % obsdb, "MetaData", "model_orography")) then
   call obsspace_get_db(config % obsdb, "MetaData", "model_orography", self % elevation(:))
 else if (ufo_vars_getindex(geovals % variables, 'surface_altitude') > 0) then
-  call ufo_geovals_get_var(geovals, 'surface_altitude', geoval)
+  call ufo_geovals_get_var(geovals, 'surface_altitude', geoval, geovalcopy)
   self % elevation(:) = geoval%vals(1, 1)
 else
   self % elevation(:) = zero
 endif
 
 ! Read in surface type from model data
-call ufo_geovals_get_var(geovals, "surface_type", geoval)
+call ufo_geovals_get_var(geovals, "surface_type", geoval, geovalcopy)
 self % surface_type(:) = geoval%vals(1, 1)
 
 ! Setup emissivity
@@ -17,9 +17,11 @@ private
 type, public :: ufo_rttovonedvarcheck_rsubmatrix
 
   integer :: nchans !< number of channels used in current r matrix
+  integer, allocatable :: channels(:) !< channels used in current r matrix
   real(kind_real), allocatable :: matrix(:,:) !< full matrix
   real(kind_real), allocatable :: inv_matrix(:,:) !< inverse full matrix
   real(kind_real), allocatable :: diagonal(:) !< diagonal matrix
+  real(kind_real), allocatable :: inv_sqrt_diagonal(:) !< diagonal of the inverse square root
   logical :: diagonal_flag !< flag to use diagonal r-matrix
   logical :: full_flag !< flag to use full r-matrix
 
@@ -31,7 +33,10 @@ contains
   procedure :: multiply_matrix => rsubmatrix_multiply_matrix
   procedure :: multiply_inverse_vector => rsubmatrix_inv_multiply
   procedure :: multiply_inverse_matrix => rsubmatrix_multiply_inv_matrix
+  procedure :: multiply_inverse_sqrt_vector => rsubmatrix_inv_sqrt_multiply
+  procedure :: multiply_inverse_sqrt_matrix => rsubmatrix_inv_sqrt_multiply_matrix
   procedure :: add_to_matrix => rsubmatrix_add_to_u
+  procedure :: has_channels => rsubmatrix_has_channels
 
 end type ufo_rttovonedvarcheck_rsubmatrix
 
@@ -59,6 +64,8 @@ integer                     :: ii, ff, ss
 character(len=max_string)   :: mat_type
 
 self % nchans = nchans
+allocate(self % channels(nchans))
+self % channels(:) = channels(1:nchans)
 self % full_flag = .false.
 self % diagonal_flag = .false.
 
@@ -99,6 +106,11 @@ select case (trim(mat_type))
           end if
         end do
       end do
+
+      ! Stored so that the factorisation isn't repeated for every observation
+      ! and iteration sharing this channel selection.
+      allocate(self % inv_sqrt_diagonal(nchans))
+      self % inv_sqrt_diagonal(:) = 1.0_kind_real / sqrt(self % diagonal(:))
    case default
       call abor1_ftn('Unknown r matrix type')
 end select
@@ -120,6 +132,9 @@ class(ufo_rttovonedvarcheck_rsubmatrix), intent(inout) :: self  !< R mtrix struc
 if (allocated(self % matrix))       deallocate(self % matrix)
 if (allocated(self % inv_matrix))   deallocate(self % inv_matrix)
 if (allocated(self % diagonal))     deallocate(self % diagonal)
+if (allocated(self % inv_sqrt_diagonal)) deallocate(self % inv_sqrt_diagonal)
+if (allocated(self % channels))     deallocate(self % channels)
+self % nchans = 0
 
 end subroutine rsubmatrix_delete
 
@@ -239,6 +254,70 @@ end if
 
 end subroutine rsubmatrix_multiply_inv_matrix
 
+! ------------------------------------------------------------------------------
+!> Multiply a vector by the inverse square root of the r-matrix
+!!
+!! \details For a diagonal r-matrix R^(-1/2) is the diagonal matrix
+!! with elements 1/sqrt(R(i,i)).
+!!
+!! \author Met Office
+!!
+!! \date 16/10/2026: Created
+!!
+subroutine rsubmatrix_inv_sqrt_multiply(self,xin,xout)
+
+implicit none
+class(ufo_rttovonedvarcheck_rsubmatrix), intent(in) :: self
+real(kind_real), intent(in)        :: xin(:)
+real(kind_real), intent(inout)     :: xout(:)
+
+if (size(xout) /= self % nchans) then
+  call abor1_ftn("rsubmatrix_inv_sqrt_multiply: arrays incompatible sizes")
+end if
+
+! Full R matrix
+if (self % full_flag) call abor1_ftn("rsubmatrix_inv_sqrt_multiply: only implemented for diagonal R")
+
+! Diagonal R matrix
+if (self % diagonal_flag) xout(:) = xin(:) * self % inv_sqrt_diagonal(:)
+
+end subroutine rsubmatrix_inv_sqrt_multiply
+
+! ------------------------------------------------------------------------------
+!> Multiply a matrix on the left by the inverse square root of the r-matrix
+!!
+!! \details Computes xout = R^(-1/2).xin, where xin has one row per channel.
+!!
+!! \author Met Office
+!!
+!! \date 16/10/2026: Created
+!!
+subroutine rsubmatrix_inv_sqrt_multiply_matrix(self,xin,xout)
+
+implicit none
+class(ufo_rttovonedvarcheck_rsubmatrix), intent(in) :: self
+real(kind_real), intent(in)        :: xin(:,:)
+real(kind_real), intent(out)       :: xout(:,:)
+
+integer :: jj
+
+if (size(xin, 1) /= self % nchans .or. size(xout, 1) /= self % nchans) then
+  call abor1_ftn("rsubmatrix_inv_sqrt_multiply_matrix: arrays incompatible sizes")
+end if
+
+! Full R matrix
+if (self % full_flag) &
+  call abor1_ftn("rsubmatrix_inv_sqrt_multiply_matrix: only implemented for diagonal R")
+
+! Diagonal R matrix
+if (self % diagonal_flag) then
+  do jj=1, size(xin, 2)
+    xout(:,jj) = xin(:,jj) * self % inv_sqrt_diagonal(:)
+  end do
+end if
+
+end subroutine rsubmatrix_inv_sqrt_multiply_matrix
+
 ! ------------------------------------------------------------------------------
 !> Add a matrix to the r-matrix
 !!
@@ -271,6 +350,29 @@ end if
 
 end subroutine rsubmatrix_add_to_u
 
+! ------------------------------------------------------------------------------
+!> Check if the r-matrix has been set up for a given channel selection
+!!
+!! \details Used to reuse the r-matrix for consecutive observations sharing the
+!! same channel selection.
+!!
+!! \author Met Office
+!!
+!! \date 16/10/2026: Created
+!!
+logical function rsubmatrix_has_channels(self, channels)
+
+implicit none
+class(ufo_rttovonedvarcheck_rsubmatrix), intent(in) :: self
+integer, intent(in)                                 :: channels(:)
+
+rsubmatrix_has_channels = .false.
+if (.not. allocated(self % channels)) return
+if (size(channels) /= self % nchans) return
+rsubmatrix_has_channels = all(self % channels(:) == channels(:))
+
+end function rsubmatrix_has_channels
+
 ! ------------------------------------------------------------------------------
 !> Print the contents of the r-matrix
 !!
@@ -60,6 +60,16 @@ ObsGnssroBndNBAM::~ObsGnssroBndNBAM() {
 
 // -----------------------------------------------------------------------------
 
+oops::Variables ObsGnssroBndNBAM::precisionSensitiveVars() const {
+  oops::Variables vars;
+  for (size_t jv = 0; jv < varin_->size(); ++jv)
+    if ((*varin_)[jv] != "air_temperature" && (*varin_)[jv] != "specific_humidity")
+      vars.push_back((*varin_)[jv]);
+  return vars;
+}
+
+// -----------------------------------------------------------------------------
+
 void ObsGnssroBndNBAM::simulateObs(const GeoVaLs & gom, ioda::ObsVector & ovec,
                                   ObsDiagnostics &) const {
   ufo_gnssro_bndnbam_simobs_f90(keyOperGnssroBndNBAM_, gom.toFortran(), odb_,
@@ -46,6 +46,9 @@ class ObsGnssroBndNBAM : public ObsOperatorBase,
 
 // Other
   const oops::Variables & requiredVars() const override {return *varin_;}
+  bool supportsSinglePrecisionGeoVaLs() const override {return true;}
+  /// Pressures and heights, from which the refractivity profile is integrated.
+  oops::Variables precisionSensitiveVars() const override;
 
   int & toFortran() {return keyOperGnssroBndNBAM_;}
   const int & toFortran() const {return keyOperGnssroBndNBAM_;}
@@ -16,6 +16,7 @@
 #include "ioda/ObsVector.h"
 
 #include "oops/base/Variables.h"
+#include "oops/util/assert.h"
 #include "oops/util/Logger.h"
 
 #include "ufo/GeoVaLs.h"
@@ -64,6 +65,12 @@ ObsGnssroBndNBAMTLAD::~ObsGnssroBndNBAMTLAD() {
 
 void ObsGnssroBndNBAMTLAD::setTrajectory(const GeoVaLs & geovals, const ObsBias & bias,
                                          ObsDiagnostics &) {
+  if (!activeObservations().empty()) {
+    // Bending angle is the only simulated variable.
+    const int nlocs = obsspace().nlocs();
+    ASSERT(activeObservations().size() == static_cast<size_t>(nlocs));
+    ufo_gnssro_bndnbam_tlad_set_active_f90(keyOperGnssroBndNBAM_, nlocs, activeObservations()[0]);
+  }
   ufo_gnssro_bndnbam_tlad_settraj_f90(keyOperGnssroBndNBAM_, geovals.toFortran(), obsspace());
 }
 
@@ -25,6 +25,7 @@ extern "C" {
 // -----------------------------------------------------------------------------
   void ufo_gnssro_bndnbam_tlad_setup_f90(F90hop &, const eckit::Configuration &);
   void ufo_gnssro_bndnbam_tlad_delete_f90(F90hop &);
+  void ufo_gnssro_bndnbam_tlad_set_active_f90(const F90hop &, const int &, const int &);
   void ufo_gnssro_bndnbam_tlad_settraj_f90(const F90hop &, const F90goms &,
                                              const ioda::ObsSpace &);
   void ufo_gnssro_bndnbam_simobs_tl_f90(const F90hop &, const F90goms &, const ioda::ObsSpace &,
@@ -42,6 +42,9 @@ class ROobserror : public FilterBase,
              std::shared_ptr<ioda::ObsDataVector<float> >);
   ~ROobserror();
 
+  /// The QC flags of all variables are read back from the ObsSpace after the Fortran code has run.
+  oops::Variables modifiedVars() const override {return flags_->varnames();}
+
  private:
   void print(std::ostream &) const override;
   void applyFilter(const std::vector<bool> &, const Variables &,
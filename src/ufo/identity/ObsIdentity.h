@@ -48,6 +48,8 @@ class ObsIdentity : public ObsOperatorBase,
 
   oops::Variables simulatedVars() const override { return operatorVars_; }
 
+  bool isThreadSafe() const override { return true; }
+
   int & toFortran() {return keyOperObsIdentity_;}
   const int & toFortran() const {return keyOperObsIdentity_;}
 
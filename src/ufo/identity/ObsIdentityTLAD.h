@@ -52,6 +52,8 @@ class ObsIdentityTLAD : public LinearObsOperatorBase,
 
   oops::Variables simulatedVars() const override {return operatorVars_;}
 
+  bool isThreadSafe() const override {return true;}
+
   int & toFortran() {return keyOperObsIdentity_;}
   const int & toFortran() const {return keyOperObsIdentity_;}
 
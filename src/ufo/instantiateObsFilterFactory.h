@@ -8,6 +8,8 @@
 #ifndef UFO_INSTANTIATEOBSFILTERFACTORY_H_
 #define UFO_INSTANTIATEOBSFILTERFACTORY_H_
 
+#include <string>
+
 #include "oops/base/instantiateObsFilterFactory.h"
 #include "oops/interface/ObsFilter.h"
 #include "ufo/filters/AcceptList.h"
@@ -15,7 +17,9 @@
 #include "ufo/filters/BayesianBackgroundCheck.h"
 #include "ufo/filters/BayesianBackgroundQCFlags.h"
 #include "ufo/filters/BlackList.h"
+#include "ufo/filters/ConcurrentFilters.h"
 #include "ufo/filters/DifferenceCheck.h"
+#include "ufo/filters/FusedChecks.h"
 #include "ufo/filters/Gaussian_Thinning.h"
 #include "ufo/filters/gnssroonedvarcheck/GNSSROOneDVarCheck.h"
 #include "ufo/filters/HistoryCheck.h"
@@ -28,6 +32,7 @@
 #include "ufo/filters/ObsDiagnosticsWriter.h"
 #include "ufo/filters/ObsDomainCheck.h"
 #include "ufo/filters/ObsDomainErrCheck.h"
+#include "ufo/filters/ObsProcessorBase.h"
 #include "ufo/filters/PerformAction.h"
 #include "ufo/filters/PoissonDiskThinning.h"
 #include "ufo/filters/PreQC.h"
@@ -51,91 +56,110 @@
 #endif
 
 namespace ufo {
+
+/// \brief Registers filter T under the same name in the oops filter factory and in
+/// ObsProcessorFactory, so that it can also be used as a member of ConcurrentFilters and
+/// FusedChecks.
+template <typename OBS, typename T>
+class FilterAndProcessorMaker {
+ public:
+  explicit FilterAndProcessorMaker(const std::string & name)
+    : filterMaker_(name), processorMaker_(name) {}
+
+ private:
+  oops::FilterMaker<OBS, oops::ObsFilter<OBS, T> > filterMaker_;
+  ObsProcessorMaker<T> processorMaker_;
+};
+
 template<typename OBS> void instantiateObsFilterFactory() {
   oops::instantiateObsFilterFactory<OBS>();
   static oops::FilterMaker<OBS, oops::ObsFilter<OBS, ufo::QCmanager> >
            qcManagerMaker("QCmanager");
   static oops::FilterMaker<OBS, oops::ObsFilter<OBS, ufo::PreQC> >
            preQCMaker("PreQC");
-  static oops::FilterMaker<OBS, oops::ObsFilter<OBS, ufo::ObsDomainCheck> >
+  static FilterAndProcessorMaker<OBS, ufo::ObsDomainCheck>
            domainCheckMaker("Domain Check");
-  static oops::FilterMaker<OBS, oops::ObsFilter<OBS, ufo::SatName> >
+  static FilterAndProcessorMaker<OBS, ufo::SatName>
            satnameCheckMaker("satname");
-  static oops::FilterMaker<OBS, oops::ObsFilter<OBS, ufo::ObsBoundsCheck> >
+  static FilterAndProcessorMaker<OBS, ufo::ObsBoundsCheck>
            boundsCheckMaker("Bounds Check");
-  static oops::FilterMaker<OBS, oops::ObsFilter<OBS, ufo::BlackList> >
+  static FilterAndProcessorMaker<OBS, ufo::BlackList>
            blackListMaker("BlackList");
-  static oops::FilterMaker<OBS, oops::ObsFilter<OBS, ufo::BlackList> >
+  static FilterAndProcessorMaker<OBS, ufo::BlackList>
            rejectListMaker("RejectList");  // alternative name
-  static oops::FilterMaker<OBS, oops::ObsFilter<OBS, ufo::BackgroundCheck> >
+  static FilterAndProcessorMaker<OBS, ufo::BackgroundCheck>
            backgroundCheckMaker("Background Check");
-  static oops::FilterMaker<OBS, oops::ObsFilter<OBS, ufo::BayesianBackgroundCheck> >
+  static FilterAndProcessorMaker<OBS, ufo::BayesianBackgroundCheck>
            BayesianBackgroundCheckMaker("Bayesian Background Check");
-  static oops::FilterMaker<OBS, oops::ObsFilter<OBS, ufo::DifferenceCheck> >
+  static FilterAndProcessorMaker<OBS, ufo::DifferenceCheck>
            differenceCheckMaker("Difference Check");
-  static oops::FilterMaker<OBS, oops::ObsFilter<OBS, ufo::HistoryCheck> >
+  static FilterAndProcessorMaker<OBS, ufo::HistoryCheck>
            historyCheckMaker("History Check");
-  static oops::FilterMaker<OBS, oops::ObsFilter<OBS, ufo::ModelObThreshold> >
+  static FilterAndProcessorMaker<OBS, ufo::ModelObThreshold>
            ModelObThresholdMaker("ModelOb Threshold");
-  static oops::FilterMaker<OBS, oops::ObsFilter<OBS, ufo::ROobserror> >
+  static FilterAndProcessorMaker<OBS, ufo::ROobserror>
            ROobserrorMaker("ROobserror");
-  static oops::FilterMaker<OBS, oops::ObsFilter<OBS, ufo::Thinning> >
+  static FilterAndProcessorMaker<OBS, ufo::Thinning>
            thinningMaker("Thinning");
-  static oops::FilterMaker<OBS, oops::ObsFilter<OBS, ufo::Gaussian_Thinning> >
+  static FilterAndProcessorMaker<OBS, ufo::Gaussian_Thinning>
            gaussianThinningMaker("Gaussian Thinning");
-  static oops::FilterMaker<OBS, oops::ObsFilter<OBS, ufo::MWCLWCheck> >
+  static FilterAndProcessorMaker<OBS, ufo::MWCLWCheck>
            MWCLWCheckMaker("MWCLW Check");
-  static oops::FilterMaker<OBS, oops::ObsFilter<OBS, ufo::ObsDomainErrCheck> >
+  static FilterAndProcessorMaker<OBS, ufo::ObsDomainErrCheck>
            domainErrCheckMaker("DomainErr Check");
-  static oops::FilterMaker<OBS, oops::ObsFilter<OBS, ufo::ProfileConsistencyChecks> >
+  static FilterAndProcessorMaker<OBS, ufo::ProfileConsistencyChecks>
            profileConsistencyChecksMaker("Profile Consistency Checks");
-  static oops::FilterMaker<OBS, oops::ObsFilter<OBS, ufo::BackgroundCheckRONBAM> >
+  static FilterAndProcessorMaker<OBS, ufo::BackgroundCheckRONBAM>
            backgroundCheckRONBAMMaker("Background Check RONBAM");
-  static oops::FilterMaker<OBS, oops::ObsFilter<OBS, ufo::TemporalThinning> >
+  static FilterAndProcessorMaker<OBS, ufo::TemporalThinning>
            temporalThinningMaker("Temporal Thinning");
-  static oops::FilterMaker<OBS, oops::ObsFilter<OBS, ufo::PoissonDiskThinning> >
+  static FilterAndProcessorMaker<OBS, ufo::PoissonDiskThinning>
            poissonDiskThinningMaker("Poisson Disk Thinning");
   static oops::FilterMaker<OBS, oops::ObsFilter<OBS, ufo::ObsDiagnosticsWriter> >
            YDIAGsaverMaker("YDIAGsaver");
-  static oops::FilterMaker<OBS, oops::ObsFilter<OBS, ufo::TrackCheck> >
+  static FilterAndProcessorMaker<OBS, ufo::TrackCheck>
            TrackCheckMaker("Track Check");
-  static oops::FilterMaker<OBS, oops::ObsFilter<OBS, ufo::MetOfficeBuddyCheck> >
+  static FilterAndProcessorMaker<OBS, ufo::MetOfficeBuddyCheck>
            MetOfficeBuddyCheckMaker("Met Office Buddy Check");
-  static oops::FilterMaker<OBS, oops::ObsFilter<OBS, ufo::ObsDerivativeCheck> >
+  static FilterAndProcessorMaker<OBS, ufo::ObsDerivativeCheck>
            DerivativeCheckMaker("Derivative Check");
-  static oops::FilterMaker<OBS, oops::ObsFilter<OBS, ufo::TrackCheckShip> >
+  static FilterAndProcessorMaker<OBS, ufo::TrackCheckShip>
            ShipTrackCheckMaker("Ship Track Check");
-  static oops::FilterMaker<OBS, oops::ObsFilter<OBS, ufo::StuckCheck> >
+  static FilterAndProcessorMaker<OBS, ufo::StuckCheck>
            StuckCheckMaker("Stuck Check");
-  static oops::FilterMaker<OBS, oops::ObsFilter<OBS, ufo::GNSSROOneDVarCheck> >
+  static FilterAndProcessorMaker<OBS, ufo::GNSSROOneDVarCheck>
            GNSSROOneDVarCheckMaker("GNSS-RO 1DVar Check");
-  static oops::FilterMaker<OBS, oops::ObsFilter<OBS, ufo::VariableAssignment> >
+  static FilterAndProcessorMaker<OBS, ufo::VariableAssignment>
            variableAssignmentMaker("Variable Assignment");
-  static oops::FilterMaker<OBS, oops::ObsFilter<OBS, ufo::VariableTransforms> >
+  static FilterAndProcessorMaker<OBS, ufo::VariableTransforms>
            VariableTransformsMaker("Variable Transforms");
-  static oops::FilterMaker<OBS, oops::ObsFilter<OBS, ufo::ProfileBackgroundCheck> >
+  static FilterAndProcessorMaker<OBS, ufo::ProfileBackgroundCheck>
            ProfileBackgroundCheckMaker("Profile Background Check");
-  static oops::FilterMaker<OBS, oops::ObsFilter<OBS, ufo::ProfileFewObsCheck> >
+  static FilterAndProcessorMaker<OBS, ufo::ProfileFewObsCheck>
            ProfileFewObsCheckMaker("Profile Few Observations Check");
-  static oops::FilterMaker<OBS, oops::ObsFilter<OBS, ufo::AcceptList> >
+  static FilterAndProcessorMaker<OBS, ufo::AcceptList>
            acceptListMaker("AcceptList");
-  static oops::FilterMaker<OBS, oops::ObsFilter<OBS, ufo::PerformAction> >
+  static FilterAndProcessorMaker<OBS, ufo::PerformAction>
            performActionMaker("Perform Action");
-  static oops::FilterMaker<OBS, oops::ObsFilter<OBS, ufo::BayesianBackgroundQCFlags> >
+  static FilterAndProcessorMaker<OBS, ufo::BayesianBackgroundQCFlags>
            BayesianBackgroundQCFlagsMaker("Bayesian Background QC Flags");
-  static oops::FilterMaker<OBS, oops::ObsFilter<OBS, ufo::ImpactHeightCheck> >
+  static FilterAndProcessorMaker<OBS, ufo::ImpactHeightCheck>
            ImpactHeightCheckMaker("GNSSRO Impact Height Check");
+  static oops::FilterMaker<OBS, oops::ObsFilter<OBS, ufo::ConcurrentFilters> >
+           ConcurrentFiltersMaker("Concurrent Filters");
+  static oops::FilterMaker<OBS, oops::ObsFilter<OBS, ufo::FusedChecks> >
+           FusedChecksMaker("Fused Checks");
 
   // Only include this filter if rttov is present
   #if defined(RTTOV_FOUND)
-    static oops::FilterMaker<OBS, oops::ObsFilter<OBS, ufo::RTTOVOneDVarCheck> >
+    static FilterAndProcessorMaker<OBS, ufo::RTTOVOneDVarCheck>
              RTTOVOneDVarCheckMaker("RTTOV OneDVar Check");
   #endif
 
   // For backward compatibility, register some filters under legacy names used in the past
-  static oops::FilterMaker<OBS, oops::ObsFilter<OBS, ufo::Gaussian_Thinning> >
+  static FilterAndProcessorMaker<OBS, ufo::Gaussian_Thinning>
            legacyGaussianThinningMaker("Gaussian_Thinning");
-  static oops::FilterMaker<OBS, oops::ObsFilter<OBS, ufo::TemporalThinning> >
+  static FilterAndProcessorMaker<OBS, ufo::TemporalThinning>
            legacyTemporalThinningMaker("TemporalThinning");
 }
 
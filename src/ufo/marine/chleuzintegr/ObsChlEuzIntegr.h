@@ -50,6 +50,8 @@ class ObsChlEuzIntegr : public ObsOperatorBase,
 
 // Other
   const oops::Variables & requiredVars() const override {return *varin_;}
+  /// Chlorophyll and cell thicknesses are read into doubles and may be stored in single precision.
+  bool supportsSinglePrecisionGeoVaLs() const override {return true;}
 
  private:
   void print(std::ostream &) const override;
@@ -46,6 +46,8 @@ class ObsSeaIceFraction : public ObsOperatorBase,
 
 // Other
   const oops::Variables & requiredVars() const override {return *varin_;}
+  /// Ice fractions are summed in double precision and may be stored in single precision.
+  bool supportsSinglePrecisionGeoVaLs() const override {return true;}
 
  private:
   void print(std::ostream &) const override;
@@ -6,6 +6,9 @@
  */
 
 #include <algorithm>
+#include <utility>
+
+#include "oops/util/assert.h"
 
 #include "ufo/profile/EntireSampleDataHandler.h"
 #include "ufo/profile/VariableNames.h"
@@ -17,6 +20,19 @@ namespace ufo {
       options_(options)
   {}
 
+  void EntireSampleDataHandler::setLocationOrder(std::vector <size_t> order)
+  {
+    ASSERT(entireSampleData_.empty());
+    ASSERT(order.size() == obsdb_.nlocs());
+    // Do not store the identity permutation.
+    bool identity = true;
+    for (size_t i = 0; i < order.size() && identity; ++i)
+      identity = order[i] == i;
+    if (identity)
+      order.clear();
+    locationOrder_ = std::move(order);
+  }
+
   void EntireSampleDataHandler::writeQuantitiesToObsdb()
   {
     // Write out all variables in particular groups.
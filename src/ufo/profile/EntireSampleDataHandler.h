@@ -27,6 +27,7 @@
 #include "oops/util/missingValues.h"
 
 #include "ufo/profile/DataHandlerParameters.h"
+#include "ufo/profile/ProfileDataHandle.h"
 
 #include "ufo/utils/metoffice/MetOfficeQCFlags.h"
 #include "ufo/utils/StringUtils.h"
@@ -54,29 +55,29 @@ namespace ufo {
     ///    -# If the variable is not present in the input data set, and 'optional' is false,
     ///       do not fill the vector.
     /// Also store the name of the variable, enabling it to be retrieved later.
+    /// Values of variables with one entry per location are stored in the order set by
+    /// setLocationOrder().
     template <typename T>
       std::vector<T>& get(const std::string &fullname)
       {
-        // Determine variable and group names, optional, and number of entries per profile.
-        std::string varname;
-        std::string groupname;
-        ufo::splitVarGroup(fullname, varname, groupname);
+        return get<T>(ProfileDataHandle(fullname));
+      }
+
+    /// \overload
+    template <typename T>
+      std::vector<T>& get(const ProfileDataHandle &handle)
+      {
+        // If the vector is already present, return it.
+        if (isStored(handle))
+          return getStored<T>(handle);
+
+        const std::string &varname = handle.varname();
+        const std::string &groupname = handle.groupname();
         const bool optional = options_.getOptional(groupname);
         const size_t entriesPerProfile = options_.getEntriesPerProfile(groupname);
 
         std::vector <T> vec_all;  // Vector storing data for entire sample.
-        auto it_entireSampleData = entireSampleData_.find(fullname);
-        if (it_entireSampleData != entireSampleData_.end()) {
-          // If the vector is already present, return it.
-          // If the type T is incorrect then boost::get will return an exception.
-          // Provide additional information if that occurs.
-          try {
-            return boost::get<std::vector<T>> (it_entireSampleData->second);
-          } catch (boost::bad_get) {
-            throw eckit::BadParameter("Template parameter passed to boost::get for " +
-                                      fullname + " probably has the wrong type", Here());
-          }
-        } else if (obsdb_.has(groupname, varname) || optional) {
+        if (obsdb_.has(groupname, varname) || optional) {
           // Initially fill the vector with the default value for the type T.
           if (entriesPerProfile == 0) {
             vec_all.assign(obsdb_.nlocs(), defaultValue(vec_all, groupname));
@@ -84,12 +85,35 @@ namespace ufo {
             vec_all.assign(entriesPerProfile * obsdb_.nrecs(), defaultValue(vec_all, groupname));
           }
           // Retrieve variable from the obsdb if present, overwriting the default value.
-          if (obsdb_.has(groupname, varname)) obsdb_.get_db(groupname, varname, vec_all);
+          if (obsdb_.has(groupname, varname)) {
+            obsdb_.get_db(groupname, varname, vec_all);
+            if (entriesPerProfile == 0) permuteToLocationOrder(vec_all);
+          }
         }
 
         // Add vector to map.
-        entireSampleData_.emplace(fullname, std::move(vec_all));
-        return boost::get<std::vector<T>> (entireSampleData_[fullname]);
+        store(handle, std::move(vec_all));
+        return getStored<T>(handle);
+      }
+
+    /// \brief Set the order in which values of variables with one entry per location are stored.
+    ///
+    /// The value at location \p order[i] of the ObsSpace is stored at position i.
+    /// \p order must be a permutation of the location indices. This function must be called
+    /// before any variable is retrieved.
+    void setLocationOrder(std::vector <size_t> order);
+
+    /// Reorder a vector holding one value per location (in the order used by the ObsSpace)
+    /// into the order set by setLocationOrder().
+    template <typename T>
+      void permuteToLocationOrder(std::vector<T> &vec) const
+      {
+        if (locationOrder_.empty() || vec.size() != locationOrder_.size()) return;
+        std::vector <T> permuted;
+        permuted.reserve(vec.size());
+        for (size_t jloc : locationOrder_)
+          permuted.push_back(std::move(vec[jloc]));
+        vec = std::move(permuted);
       }
 
     /// Write various quantities to the obsdb so they can be used in future QC checks.
@@ -100,15 +124,10 @@ namespace ufo {
     /// Initialise vector in the entire sample for a variable that is not currently
     /// stored. Fill the vector with the default value for the data type.
     template <typename T>
-      void initialiseVector(const std::string fullname)
+      void initialiseVector(const ProfileDataHandle &handle)
       {
-        auto it_entireSampleData = entireSampleData_.find(fullname);
-        if (it_entireSampleData == entireSampleData_.end() ||
-            (it_entireSampleData != entireSampleData_.end() &&
-             get<T>(fullname).size() == 0)) {
-          std::string varname;
-          std::string groupname;
-          ufo::splitVarGroup(fullname, varname, groupname);
+        if (!isStored(handle) || get<T>(handle).size() == 0) {
+          const std::string &groupname = handle.groupname();
           const size_t entriesPerProfile = options_.getEntriesPerProfile(groupname);
           std::vector <T> vec_all;  // Vector storing data for entire sample.
           if (entriesPerProfile == 0) {
@@ -117,11 +136,43 @@ namespace ufo {
             vec_all.assign(entriesPerProfile * obsdb_.nrecs(),
                            defaultValue(vec_all, groupname));
           }
-          entireSampleData_[fullname] = vec_all;
+          store(handle, std::move(vec_all));
         }
       }
 
    private:  // functions
+    /// Determine whether a vector is stored for a variable.
+    bool isStored(const ProfileDataHandle &handle) const
+    {
+      return handle.index() < entireSampleDataByHandle_.size() &&
+        entireSampleDataByHandle_[handle.index()] != nullptr;
+    }
+
+    /// Store the vector \p vec_all for a variable, replacing any vector stored previously.
+    template <typename T>
+      void store(const ProfileDataHandle &handle, std::vector <T> &&vec_all)
+      {
+        EntireSampleVector &stored = entireSampleData_[handle.fullname()];
+        stored = std::move(vec_all);
+        if (handle.index() >= entireSampleDataByHandle_.size())
+          entireSampleDataByHandle_.resize(handle.index() + 1, nullptr);
+        entireSampleDataByHandle_[handle.index()] = &stored;
+      }
+
+    /// Return a vector known to be stored.
+    template <typename T>
+      std::vector<T>& getStored(const ProfileDataHandle &handle)
+      {
+        // If the type T is incorrect then boost::get will return an exception.
+        // Provide additional information if that occurs.
+        try {
+          return boost::get<std::vector<T>> (*entireSampleDataByHandle_[handle.index()]);
+        } catch (boost::bad_get) {
+          throw eckit::BadParameter("Template parameter passed to boost::get for " +
+                                    handle.fullname() + " probably has the wrong type", Here());
+        }
+      }
+
     /// Put entire data vector on obsdb.
     template <typename T>
       void putDataVector(const std::string &fullname,
@@ -130,10 +181,17 @@ namespace ufo {
         // Do not store the vector if it is empty.
         if (datavec.empty()) return;
 
-        std::string varname;
-        std::string groupname;
-        ufo::splitVarGroup(fullname, varname, groupname);
-        obsdb_.put_db(groupname, varname, datavec);
+        const ProfileDataHandle handle(fullname);
+        if (!locationOrder_.empty() && datavec.size() == locationOrder_.size() &&
+            options_.getEntriesPerProfile(handle.groupname()) == 0) {
+          // Restore the order of locations used by the ObsSpace.
+          std::vector <T> unpermuted(datavec.size());
+          for (size_t i = 0; i < locationOrder_.size(); ++i)
+            unpermuted[locationOrder_[i]] = datavec[i];
+          obsdb_.put_db(handle.groupname(), handle.varname(), unpermuted);
+        } else {
+          obsdb_.put_db(handle.groupname(), handle.varname(), datavec);
+        }
       }
 
    private:  // variables
@@ -152,9 +210,19 @@ namespace ufo {
     /// Default value used to fill vector of strings.
     std::string defaultValue(const std::vector <std::string> &vec, const std::string &groupname);
 
+    typedef boost::variant
+      <std::vector <int>, std::vector <float>, std::vector <std::string>> EntireSampleVector;
+
     /// Container of each variable in the entire data set.
-    std::unordered_map <std::string, boost::variant
-      <std::vector <int>, std::vector <float>, std::vector <std::string>>> entireSampleData_;
+    std::unordered_map <std::string, EntireSampleVector> entireSampleData_;
+
+    /// Pointers to the elements of entireSampleData_ indexed by ProfileDataHandle::index()
+    /// (null for variables not retrieved yet).
+    std::vector <EntireSampleVector*> entireSampleDataByHandle_;
+
+    /// Positions in the ObsSpace of the values of per-location variables stored at each position
+    /// of the vectors of entireSampleData_ (empty if the ObsSpace order is used).
+    std::vector <size_t> locationOrder_;
 
     /// Missing value (int)
     const int missingValueInt = util::missingValue(missingValueInt);
@@ -7,6 +7,8 @@
 
 #include "ufo/profile/ProfileCheckBackgroundGeopotentialHeight.h"
 
+#include "ufo/profile/VariableHandles.h"
+
 namespace ufo {
 
   static ProfileCheckMaker<ProfileCheckBackgroundGeopotentialHeight>
@@ -24,29 +26,29 @@ namespace ufo {
     const size_t numProfileLevels = profileDataHandler.getNumProfileLevels();
     const bool ModelLevels = options_.modellevels.value();
     const std::vector <float> &Zstation =
-      profileDataHandler.get<float>(ufo::VariableNames::Zstation);
+      profileDataHandler.get<float>(VariableHandles::Zstation);
     const std::vector <float> &pressures =
-       profileDataHandler.get<float>(ufo::VariableNames::obs_air_pressure);
+       profileDataHandler.get<float>(VariableHandles::obs_air_pressure);
     const std::vector <float> &zObs =
-       profileDataHandler.get<float>(ufo::VariableNames::obs_geopotential_height);
+       profileDataHandler.get<float>(VariableHandles::obs_geopotential_height);
     const std::vector <float> &zObsErr =
-       profileDataHandler.get<float>(ufo::VariableNames::obserr_geopotential_height);
+       profileDataHandler.get<float>(VariableHandles::obserr_geopotential_height);
     const std::vector <float> &zBkg =
-      profileDataHandler.get<float>(ufo::VariableNames::hofx_geopotential_height);
+      profileDataHandler.get<float>(VariableHandles::hofx_geopotential_height);
     std::vector <float> &zBkgErr =
       profileDataHandler.getObsDiag(ufo::VariableNames::bkgerr_geopotential_height);
     std::vector <float> &zPGE =
-      profileDataHandler.get<float>(ufo::VariableNames::pge_geopotential_height);
+      profileDataHandler.get<float>(VariableHandles::pge_geopotential_height);
     std::vector <float> &zPGEBd =
-      profileDataHandler.get<float>(ufo::VariableNames::pgebd_geopotential_height);
+      profileDataHandler.get<float>(VariableHandles::pgebd_geopotential_height);
     std::vector <int> &zFlags =
-      profileDataHandler.get<int>(ufo::VariableNames::qcflags_geopotential_height);
+      profileDataHandler.get<int>(VariableHandles::qcflags_geopotential_height);
     const std::vector <int> &tFlags =
-      profileDataHandler.get<int>(ufo::VariableNames::qcflags_air_temperature);
+      profileDataHandler.get<int>(VariableHandles::qcflags_air_temperature);
     const std::vector <float> &zObsCorrection =
-       profileDataHandler.get<float>(ufo::VariableNames::obscorrection_geopotential_height);
+       profileDataHandler.get<float>(VariableHandles::obscorrection_geopotential_height);
     const std::vector <int> &timeFlags =
-      profileDataHandler.get<int>(ufo::VariableNames::qcflags_time);
+      profileDataHandler.get<int>(VariableHandles::qcflags_time);
 
     if (!oops::allVectorsSameNonZeroSize(Zstation, pressures,
                                          zObs, zObsErr, zBkg,
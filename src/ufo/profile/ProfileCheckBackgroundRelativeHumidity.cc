@@ -7,6 +7,8 @@
 
 #include "ufo/profile/ProfileCheckBackgroundRelativeHumidity.h"
 
+#include "ufo/profile/VariableHandles.h"
+
 namespace ufo {
 
   static ProfileCheckMaker<ProfileCheckBackgroundRelativeHumidity>
@@ -24,21 +26,21 @@ namespace ufo {
     const size_t numProfileLevels = profileDataHandler.getNumProfileLevels();
     const bool ModelLevels = options_.modellevels.value();
     const std::vector <float> &rhObs =
-       profileDataHandler.get<float>(ufo::VariableNames::obs_relative_humidity);
+       profileDataHandler.get<float>(VariableHandles::obs_relative_humidity);
     const std::vector <float> &rhObsErr =
-       profileDataHandler.get<float>(ufo::VariableNames::obserr_relative_humidity);
+       profileDataHandler.get<float>(VariableHandles::obserr_relative_humidity);
     const std::vector <float> &rhBkg =
-      profileDataHandler.get<float>(ufo::VariableNames::hofx_relative_humidity);
+      profileDataHandler.get<float>(VariableHandles::hofx_relative_humidity);
     const std::vector <float> &rhBkgErr =
       profileDataHandler.getObsDiag(ufo::VariableNames::bkgerr_relative_humidity);
     std::vector <float> &rhPGE =
-      profileDataHandler.get<float>(ufo::VariableNames::pge_relative_humidity);
+      profileDataHandler.get<float>(VariableHandles::pge_relative_humidity);
     std::vector <float> &rhPGEBd =
-      profileDataHandler.get<float>(ufo::VariableNames::pgebd_relative_humidity);
+      profileDataHandler.get<float>(VariableHandles::pgebd_relative_humidity);
     std::vector <int> &rhFlags =
-      profileDataHandler.get<int>(ufo::VariableNames::qcflags_relative_humidity);
+      profileDataHandler.get<int>(VariableHandles::qcflags_relative_humidity);
     const std::vector <int> &timeFlags =
-      profileDataHandler.get<int>(ufo::VariableNames::qcflags_time);
+      profileDataHandler.get<int>(VariableHandles::qcflags_time);
 
     if (!oops::allVectorsSameNonZeroSize(rhObs, rhObsErr, rhBkg, rhBkgErr,
                                          rhPGE, rhFlags, timeFlags)) {
@@ -7,6 +7,8 @@
 
 #include "ufo/profile/ProfileCheckBackgroundTemperature.h"
 
+#include "ufo/profile/VariableHandles.h"
+
 namespace ufo {
 
   static ProfileCheckMaker<ProfileCheckBackgroundTemperature>
@@ -24,27 +26,27 @@ namespace ufo {
     const size_t numProfileLevels = profileDataHandler.getNumProfileLevels();
     const bool ModelLevels = options_.modellevels.value();
     const std::vector <float> &Latitude =
-      profileDataHandler.get<float>(ufo::VariableNames::Latitude);
+      profileDataHandler.get<float>(VariableHandles::Latitude);
     const std::vector <float> &pressures =
-       profileDataHandler.get<float>(ufo::VariableNames::obs_air_pressure);
+       profileDataHandler.get<float>(VariableHandles::obs_air_pressure);
     const std::vector <float> &tObs =
-       profileDataHandler.get<float>(ufo::VariableNames::obs_air_temperature);
+       profileDataHandler.get<float>(VariableHandles::obs_air_temperature);
     const std::vector <float> &tObsErr =
-       profileDataHandler.get<float>(ufo::VariableNames::obserr_air_temperature);
+       profileDataHandler.get<float>(VariableHandles::obserr_air_temperature);
     const std::vector <float> &tBkg =
-      profileDataHandler.get<float>(ufo::VariableNames::hofx_air_temperature);
+      profileDataHandler.get<float>(VariableHandles::hofx_air_temperature);
     const std::vector <float> &tBkgErr =
       profileDataHandler.getObsDiag(ufo::VariableNames::bkgerr_air_temperature);
     std::vector <float> &tPGE =
-      profileDataHandler.get<float>(ufo::VariableNames::pge_air_temperature);
+      profileDataHandler.get<float>(VariableHandles::pge_air_temperature);
     std::vector <float> &tPGEBd =
-      profileDataHandler.get<float>(ufo::VariableNames::pgebd_air_temperature);
+      profileDataHandler.get<float>(VariableHandles::pgebd_air_temperature);
     std::vector <int> &tFlags =
-      profileDataHandler.get<int>(ufo::VariableNames::qcflags_air_temperature);
+      profileDataHandler.get<int>(VariableHandles::qcflags_air_temperature);
     const std::vector <int> &timeFlags =
-      profileDataHandler.get<int>(ufo::VariableNames::qcflags_time);
+      profileDataHandler.get<int>(VariableHandles::qcflags_time);
     const std::vector <float> &tObsCorrection =
-       profileDataHandler.get<float>(ufo::VariableNames::obscorrection_air_temperature);
+       profileDataHandler.get<float>(VariableHandles::obscorrection_air_temperature);
 
     if (!oops::allVectorsSameNonZeroSize(Latitude, pressures,
                                          tObs, tObsErr, tBkg, tBkgErr,
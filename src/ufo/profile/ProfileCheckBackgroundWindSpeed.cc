@@ -7,6 +7,8 @@
 
 #include "ufo/profile/ProfileCheckBackgroundWindSpeed.h"
 
+#include "ufo/profile/VariableHandles.h"
+
 namespace ufo {
 
   static ProfileCheckMaker<ProfileCheckBackgroundWindSpeed>
@@ -24,35 +26,35 @@ namespace ufo {
     const size_t numProfileLevels = profileDataHandler.getNumProfileLevels();
     const bool ModelLevels = options_.modellevels.value();
     const std::vector <float> &uObs =
-       profileDataHandler.get<float>(ufo::VariableNames::obs_eastward_wind);
+       profileDataHandler.get<float>(VariableHandles::obs_eastward_wind);
     const std::vector <float> &uObsErr =
-       profileDataHandler.get<float>(ufo::VariableNames::obserr_eastward_wind);
+       profileDataHandler.get<float>(VariableHandles::obserr_eastward_wind);
     const std::vector <float> &uBkg =
-      profileDataHandler.get<float>(ufo::VariableNames::hofx_eastward_wind);
+      profileDataHandler.get<float>(VariableHandles::hofx_eastward_wind);
     const std::vector <float> &uBkgErr =
       profileDataHandler.getObsDiag(ufo::VariableNames::bkgerr_eastward_wind);
     std::vector <float> &uPGE =
-      profileDataHandler.get<float>(ufo::VariableNames::pge_eastward_wind);
+      profileDataHandler.get<float>(VariableHandles::pge_eastward_wind);
     std::vector <float> &uPGEBd =
-      profileDataHandler.get<float>(ufo::VariableNames::pgebd_eastward_wind);
+      profileDataHandler.get<float>(VariableHandles::pgebd_eastward_wind);
     std::vector <int> &uFlags =
-      profileDataHandler.get<int>(ufo::VariableNames::qcflags_eastward_wind);
+      profileDataHandler.get<int>(VariableHandles::qcflags_eastward_wind);
     const std::vector <float> &vObs =
-       profileDataHandler.get<float>(ufo::VariableNames::obs_northward_wind);
+       profileDataHandler.get<float>(VariableHandles::obs_northward_wind);
     const std::vector <float> &vObsErr =
-       profileDataHandler.get<float>(ufo::VariableNames::obserr_northward_wind);
+       profileDataHandler.get<float>(VariableHandles::obserr_northward_wind);
     const std::vector <float> &vBkg =
-      profileDataHandler.get<float>(ufo::VariableNames::hofx_northward_wind);
+      profileDataHandler.get<float>(VariableHandles::hofx_northward_wind);
     const std::vector <float> &vBkgErr =
       profileDataHandler.getObsDiag(ufo::VariableNames::bkgerr_northward_wind);
     std::vector <float> &vPGE =
-      profileDataHandler.get<float>(ufo::VariableNames::pge_northward_wind);
+      profileDataHandler.get<float>(VariableHandles::pge_northward_wind);
     std::vector <float> &vPGEBd =
-      profileDataHandler.get<float>(ufo::VariableNames::pgebd_northward_wind);
+      profileDataHandler.get<float>(VariableHandles::pgebd_northward_wind);
     std::vector <int> &vFlags =
-      profileDataHandler.get<int>(ufo::VariableNames::qcflags_northward_wind);
+      profileDataHandler.get<int>(VariableHandles::qcflags_northward_wind);
     const std::vector <int> &timeFlags =
-      profileDataHandler.get<int>(ufo::VariableNames::qcflags_time);
+      profileDataHandler.get<int>(VariableHandles::qcflags_time);
 
     if (!oops::allVectorsSameNonZeroSize(uObs, uObsErr, uBkg, uBkgErr,
                                          uPGE, uFlags,
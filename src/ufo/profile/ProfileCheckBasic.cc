@@ -6,7 +6,7 @@
  */
 
 #include "ufo/profile/ProfileCheckBasic.h"
-#include "ufo/profile/VariableNames.h"
+#include "ufo/profile/VariableHandles.h"
 
 namespace ufo {
 
@@ -32,15 +32,15 @@ namespace ufo {
 
     const int numProfileLevels = profileDataHandler.getNumProfileLevels();
     const std::vector <float> &pressures =
-      profileDataHandler.get<float>(ufo::VariableNames::obs_air_pressure);
+      profileDataHandler.get<float>(VariableHandles::obs_air_pressure);
     // All QC flags are retrieved for the basic checks.
     // (Some might be empty; that is checked before they are used.)
     std::vector <int> &tFlags = profileDataHandler.get<int>
-      (ufo::VariableNames::qcflags_air_temperature);
+      (VariableHandles::qcflags_air_temperature);
     std::vector <int> &zFlags = profileDataHandler.get<int>
-      (ufo::VariableNames::qcflags_geopotential_height);
+      (VariableHandles::qcflags_geopotential_height);
     std::vector <int> &uFlags = profileDataHandler.get<int>
-      (ufo::VariableNames::qcflags_eastward_wind);
+      (VariableHandles::qcflags_eastward_wind);
 
     // Warn and exit if pressures vector is empty
     if (pressures.empty()) {
@@ -6,6 +6,7 @@
  */
 
 #include "ufo/profile/ProfileCheckHydrostatic.h"
+#include "ufo/profile/VariableHandles.h"
 #include "ufo/profile/VariableNames.h"
 
 namespace ufo {
@@ -24,35 +25,35 @@ namespace ufo {
     const int numProfileLevels = profileDataHandler.getNumProfileLevels();
 
     const std::vector <float> &pressures =
-       profileDataHandler.get<float>(ufo::VariableNames::obs_air_pressure);
+       profileDataHandler.get<float>(VariableHandles::obs_air_pressure);
     const std::vector <float> &tObs =
-       profileDataHandler.get<float>(ufo::VariableNames::obs_air_temperature);
+       profileDataHandler.get<float>(VariableHandles::obs_air_temperature);
     const std::vector <float> &tBkg =
-       profileDataHandler.get<float>(ufo::VariableNames::hofx_air_temperature);
+       profileDataHandler.get<float>(VariableHandles::hofx_air_temperature);
     const std::vector <float> &zObs =
-       profileDataHandler.get<float>(ufo::VariableNames::obs_geopotential_height);
+       profileDataHandler.get<float>(VariableHandles::obs_geopotential_height);
     const std::vector <float> &zBkg =
-       profileDataHandler.get<float>(ufo::VariableNames::hofx_geopotential_height);
+       profileDataHandler.get<float>(VariableHandles::hofx_geopotential_height);
     std::vector <int> &tFlags =
-       profileDataHandler.get<int>(ufo::VariableNames::qcflags_air_temperature);
+       profileDataHandler.get<int>(VariableHandles::qcflags_air_temperature);
     std::vector <int> &zFlags =
-       profileDataHandler.get<int>(ufo::VariableNames::qcflags_geopotential_height);
+       profileDataHandler.get<int>(VariableHandles::qcflags_geopotential_height);
     std::vector <int> &NumAnyErrors =
-       profileDataHandler.get<int>(ufo::VariableNames::counter_NumAnyErrors);
+       profileDataHandler.get<int>(VariableHandles::counter_NumAnyErrors);
     std::vector <int> &Num925Miss =
-       profileDataHandler.get<int>(ufo::VariableNames::counter_Num925Miss);
+       profileDataHandler.get<int>(VariableHandles::counter_Num925Miss);
     std::vector <int> &Num100Miss =
-       profileDataHandler.get<int>(ufo::VariableNames::counter_Num100Miss);
+       profileDataHandler.get<int>(VariableHandles::counter_Num100Miss);
     std::vector <int> &NumStdMiss =
-       profileDataHandler.get<int>(ufo::VariableNames::counter_NumStdMiss);
+       profileDataHandler.get<int>(VariableHandles::counter_NumStdMiss);
     std::vector <int> &NumHydErrObs =
-       profileDataHandler.get<int>(ufo::VariableNames::counter_NumHydErrObs);
+       profileDataHandler.get<int>(VariableHandles::counter_NumHydErrObs);
     std::vector <int> &NumIntHydErrors =
-       profileDataHandler.get<int>(ufo::VariableNames::counter_NumIntHydErrors);
+       profileDataHandler.get<int>(VariableHandles::counter_NumIntHydErrors);
     const std::vector <float> &tObsCorrection =
-       profileDataHandler.get<float>(ufo::VariableNames::obscorrection_air_temperature);
+       profileDataHandler.get<float>(VariableHandles::obscorrection_air_temperature);
     std::vector <float> &zObsCorrection =
-       profileDataHandler.get<float>(ufo::VariableNames::obscorrection_geopotential_height);
+       profileDataHandler.get<float>(VariableHandles::obscorrection_geopotential_height);
 
     if (!oops::allVectorsSameNonZeroSize(pressures, tObs, tBkg, zObs, zBkg, tFlags, zFlags,
                                          tObsCorrection, zObsCorrection)) {
@@ -6,6 +6,7 @@
  */
 
 #include "ufo/profile/ProfileCheckInterpolation.h"
+#include "ufo/profile/VariableHandles.h"
 #include "ufo/profile/VariableNames.h"
 
 namespace ufo {
@@ -26,21 +27,21 @@ namespace ufo {
     const int numProfileLevels = profileDataHandler.getNumProfileLevels();
 
     const std::vector <float> &pressures =
-       profileDataHandler.get<float>(ufo::VariableNames::obs_air_pressure);
+       profileDataHandler.get<float>(VariableHandles::obs_air_pressure);
     const std::vector <float> &tObs =
-       profileDataHandler.get<float>(ufo::VariableNames::obs_air_temperature);
+       profileDataHandler.get<float>(VariableHandles::obs_air_temperature);
     const std::vector <float> &tBkg =
-       profileDataHandler.get<float>(ufo::VariableNames::hofx_air_temperature);
+       profileDataHandler.get<float>(VariableHandles::hofx_air_temperature);
     std::vector <int> &tFlags =
-       profileDataHandler.get<int>(ufo::VariableNames::qcflags_air_temperature);
+       profileDataHandler.get<int>(VariableHandles::qcflags_air_temperature);
     std::vector <int> &NumAnyErrors =
-       profileDataHandler.get<int>(ufo::VariableNames::counter_NumAnyErrors);
+       profileDataHandler.get<int>(VariableHandles::counter_NumAnyErrors);
     std::vector <int> &NumInterpErrors =
-       profileDataHandler.get<int>(ufo::VariableNames::counter_NumInterpErrors);
+       profileDataHandler.get<int>(VariableHandles::counter_NumInterpErrors);
     std::vector <int> &NumInterpErrObs =
-       profileDataHandler.get<int>(ufo::VariableNames::counter_NumInterpErrObs);
+       profileDataHandler.get<int>(VariableHandles::counter_NumInterpErrObs);
     const std::vector <float> &tObsCorrection =
-       profileDataHandler.get<float>(ufo::VariableNames::obscorrection_air_temperature);
+       profileDataHandler.get<float>(VariableHandles::obscorrection_air_temperature);
 
     if (!oops::allVectorsSameNonZeroSize(pressures, tObs, tBkg, tFlags,
                                          tObsCorrection)) {
@@ -7,6 +7,8 @@
 
 #include "ufo/profile/ProfileCheckPermanentReject.h"
 
+#include "ufo/profile/VariableHandles.h"
+
 namespace ufo {
 
   static ProfileCheckMaker<ProfileCheckPermanentReject>
@@ -24,17 +26,17 @@ namespace ufo {
     const size_t numProfileLevels = profileDataHandler.getNumProfileLevels();
     const bool ModelLevels = options_.modellevels.value();
     std::vector <int> &tFlags =
-      profileDataHandler.get<int>(ufo::VariableNames::qcflags_air_temperature);
+      profileDataHandler.get<int>(VariableHandles::qcflags_air_temperature);
     std::vector <int> &rhFlags =
-      profileDataHandler.get<int>(ufo::VariableNames::qcflags_relative_humidity);
+      profileDataHandler.get<int>(VariableHandles::qcflags_relative_humidity);
     std::vector <int> &uFlags =
-      profileDataHandler.get<int>(ufo::VariableNames::qcflags_eastward_wind);
+      profileDataHandler.get<int>(VariableHandles::qcflags_eastward_wind);
     std::vector <int> &vFlags =
-      profileDataHandler.get<int>(ufo::VariableNames::qcflags_northward_wind);
+      profileDataHandler.get<int>(VariableHandles::qcflags_northward_wind);
     std::vector <int> &zFlags =
-      profileDataHandler.get<int>(ufo::VariableNames::qcflags_geopotential_height);
+      profileDataHandler.get<int>(VariableHandles::qcflags_geopotential_height);
     std::vector <int> &ReportFlags =
-      profileDataHandler.get<int>(ufo::VariableNames::qcflags_observation_report);
+      profileDataHandler.get<int>(VariableHandles::qcflags_observation_report);
 
     if (ReportFlags.empty()) {
       oops::Log::debug() << "ReportFlags vector is empty. "
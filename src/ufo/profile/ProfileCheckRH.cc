@@ -6,6 +6,7 @@
  */
 
 #include "ufo/profile/ProfileCheckRH.h"
+#include "ufo/profile/VariableHandles.h"
 #include "ufo/profile/VariableNames.h"
 
 namespace ufo {
@@ -23,34 +24,34 @@ namespace ufo {
 
     const int numProfileLevels = profileDataHandler.getNumProfileLevels();
     const std::vector <float> &pressures =
-       profileDataHandler.get<float>(ufo::VariableNames::obs_air_pressure);
+       profileDataHandler.get<float>(VariableHandles::obs_air_pressure);
     const std::vector <float> &tObs =
-       profileDataHandler.get<float>(ufo::VariableNames::obs_air_temperature);
+       profileDataHandler.get<float>(VariableHandles::obs_air_temperature);
     const std::vector <float> &tBkg =
-       profileDataHandler.get<float>(ufo::VariableNames::hofx_air_temperature);
+       profileDataHandler.get<float>(VariableHandles::hofx_air_temperature);
     const std::vector <float> &RHObs =
-       profileDataHandler.get<float>(ufo::VariableNames::obs_relative_humidity);
+       profileDataHandler.get<float>(VariableHandles::obs_relative_humidity);
     const std::vector <float> &RHBkg =
-       profileDataHandler.get<float>(ufo::VariableNames::hofx_relative_humidity);
+       profileDataHandler.get<float>(VariableHandles::hofx_relative_humidity);
     const std::vector <float> &tdObs =
-       profileDataHandler.get<float>(ufo::VariableNames::obs_dew_point_temperature);
+       profileDataHandler.get<float>(VariableHandles::obs_dew_point_temperature);
     const std::vector <int> &tFlags =
-       profileDataHandler.get<int>(ufo::VariableNames::qcflags_air_temperature);
+       profileDataHandler.get<int>(VariableHandles::qcflags_air_temperature);
     std::vector <int> &RHFlags =
-       profileDataHandler.get<int>(ufo::VariableNames::qcflags_relative_humidity);
+       profileDataHandler.get<int>(VariableHandles::qcflags_relative_humidity);
     const std::vector <float> &tObsCorrection =
-       profileDataHandler.get<float>(ufo::VariableNames::obscorrection_air_temperature);
+       profileDataHandler.get<float>(VariableHandles::obscorrection_air_temperature);
 
     std::vector <int> &TotCProfs =
-       profileDataHandler.get<int>(ufo::VariableNames::counter_TotCProfs);
+       profileDataHandler.get<int>(VariableHandles::counter_TotCProfs);
     std::vector <int> &TotHProfs =
-       profileDataHandler.get<int>(ufo::VariableNames::counter_TotHProfs);
+       profileDataHandler.get<int>(VariableHandles::counter_TotHProfs);
     std::vector <int> &TotCFlags =
-       profileDataHandler.get<int>(ufo::VariableNames::counter_TotCFlags);
+       profileDataHandler.get<int>(VariableHandles::counter_TotCFlags);
     std::vector <int> &TotHFlags =
-       profileDataHandler.get<int>(ufo::VariableNames::counter_TotHFlags);
+       profileDataHandler.get<int>(VariableHandles::counter_TotHFlags);
     std::vector <int> &TotLFlags =
-       profileDataHandler.get<int>(ufo::VariableNames::counter_TotLFlags);
+       profileDataHandler.get<int>(VariableHandles::counter_TotLFlags);
 
     if (!oops::allVectorsSameNonZeroSize(pressures, tObs, tBkg, RHObs, RHBkg,
                                          tdObs, tFlags, RHFlags, tObsCorrection)) {
@@ -6,7 +6,7 @@
  */
 
 #include "ufo/profile/ProfileCheckSamePDiffT.h"
-#include "ufo/profile/VariableNames.h"
+#include "ufo/profile/VariableHandles.h"
 
 namespace ufo {
 
@@ -25,19 +25,19 @@ namespace ufo {
     const int numProfileLevels = profileDataHandler.getNumProfileLevels();
 
     const std::vector <float> &pressures =
-      profileDataHandler.get<float>(ufo::VariableNames::obs_air_pressure);
+      profileDataHandler.get<float>(VariableHandles::obs_air_pressure);
     const std::vector <float> &tObs =
-      profileDataHandler.get<float>(ufo::VariableNames::obs_air_temperature);
+      profileDataHandler.get<float>(VariableHandles::obs_air_temperature);
     const std::vector <float> &tBkg =
-      profileDataHandler.get<float>(ufo::VariableNames::hofx_air_temperature);
+      profileDataHandler.get<float>(VariableHandles::hofx_air_temperature);
     std::vector <int> &tFlags =
-      profileDataHandler.get<int>(ufo::VariableNames::qcflags_air_temperature);
+      profileDataHandler.get<int>(VariableHandles::qcflags_air_temperature);
     std::vector <int> &NumAnyErrors =
-      profileDataHandler.get<int>(ufo::VariableNames::counter_NumAnyErrors);
+      profileDataHandler.get<int>(VariableHandles::counter_NumAnyErrors);
     std::vector <int> &NumSamePErrObs =
-      profileDataHandler.get<int>(ufo::VariableNames::counter_NumSamePErrObs);
+      profileDataHandler.get<int>(VariableHandles::counter_NumSamePErrObs);
     const std::vector <float> &tObsCorrection =
-      profileDataHandler.get<float>(ufo::VariableNames::obscorrection_air_temperature);
+      profileDataHandler.get<float>(VariableHandles::obscorrection_air_temperature);
 
     if (!oops::allVectorsSameNonZeroSize(pressures, tObs, tBkg, tFlags, tObsCorrection)) {
       oops::Log::warning() << "At least one vector is the wrong size. "
@@ -10,6 +10,8 @@
 
 #include "ufo/profile/ProfileCheckTime.h"
 
+#include "ufo/profile/VariableHandles.h"
+
 namespace ufo {
 
   static ProfileCheckMaker<ProfileCheckTime>
@@ -27,15 +29,15 @@ namespace ufo {
     const size_t numProfileLevels = profileDataHandler.getNumProfileLevels();
     const bool ModelLevels = options_.modellevels.value();
     const std::vector <int> &ObsType =
-      profileDataHandler.get<int>(ufo::VariableNames::ObsType);
+      profileDataHandler.get<int>(VariableHandles::ObsType);
     const std::vector <float> &level_time =
-       profileDataHandler.get<float>(ufo::VariableNames::obs_level_time);
+       profileDataHandler.get<float>(VariableHandles::obs_level_time);
     const std::vector <float> &pressures =
-       profileDataHandler.get<float>(ufo::VariableNames::obs_air_pressure);
+       profileDataHandler.get<float>(VariableHandles::obs_air_pressure);
     std::vector <int> &uFlags =
-      profileDataHandler.get<int>(ufo::VariableNames::qcflags_eastward_wind);
+      profileDataHandler.get<int>(VariableHandles::qcflags_eastward_wind);
     std::vector <int> &vFlags =
-      profileDataHandler.get<int>(ufo::VariableNames::qcflags_northward_wind);
+      profileDataHandler.get<int>(VariableHandles::qcflags_northward_wind);
 
     if (!oops::allVectorsSameNonZeroSize(ObsType, pressures, uFlags, vFlags)) {
       oops::Log::warning() << "At least one vector is the wrong size. "
@@ -99,6 +101,6 @@ namespace ufo {
     }
 
     // Store the time flags for use in later checks.
-    profileDataHandler.set<int>(ufo::VariableNames::qcflags_time, std::move(timeFlags));
+    profileDataHandler.set<int>(VariableHandles::qcflags_time, std::move(timeFlags));
   }
 }  // namespace ufo
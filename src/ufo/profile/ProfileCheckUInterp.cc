@@ -6,6 +6,7 @@
  */
 
 #include "ufo/profile/ProfileCheckUInterp.h"
+#include "ufo/profile/VariableHandles.h"
 #include "ufo/profile/VariableNames.h"
 
 namespace ufo {
@@ -24,17 +25,17 @@ namespace ufo {
 
     const int numProfileLevels = profileDataHandler.getNumProfileLevels();
     const std::vector <float> &pressures =
-      profileDataHandler.get<float>(ufo::VariableNames::obs_air_pressure);
+      profileDataHandler.get<float>(VariableHandles::obs_air_pressure);
     const std::vector <float> &uObs =
-      profileDataHandler.get<float>(ufo::VariableNames::obs_eastward_wind);
+      profileDataHandler.get<float>(VariableHandles::obs_eastward_wind);
     const std::vector <float> &vObs =
-      profileDataHandler.get<float>(ufo::VariableNames::obs_northward_wind);
+      profileDataHandler.get<float>(VariableHandles::obs_northward_wind);
     std::vector <int> &uFlags =
-      profileDataHandler.get<int>(ufo::VariableNames::qcflags_eastward_wind);
+      profileDataHandler.get<int>(VariableHandles::qcflags_eastward_wind);
     std::vector <int> &NumSamePErrObs =
-      profileDataHandler.get<int>(ufo::VariableNames::counter_NumSamePErrObs);
+      profileDataHandler.get<int>(VariableHandles::counter_NumSamePErrObs);
     std::vector <int> &NumInterpErrObs =
-      profileDataHandler.get<int>(ufo::VariableNames::counter_NumInterpErrObs);
+      profileDataHandler.get<int>(VariableHandles::counter_NumInterpErrObs);
 
     if (!oops::allVectorsSameNonZeroSize(pressures, uObs, vObs, uFlags)) {
       oops::Log::warning() << "At least one vector is the wrong size. "
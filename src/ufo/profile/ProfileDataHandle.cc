@@ -0,0 +1,42 @@
+/*
+ * (C) Crown copyright 2021, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#include <deque>
+#include <mutex>  // NOLINT(build/c++11)
+#include <unordered_map>
+#include <utility>
+
+#include "ufo/profile/ProfileDataHandle.h"
+#include "ufo/utils/StringUtils.h"
+
+namespace ufo {
+  ProfileDataHandle::ProfileDataHandle(const std::string &fullname)
+    : variable_(&registerVariable(fullname))
+  {}
+
+  const ProfileDataHandle::Variable &
+  ProfileDataHandle::registerVariable(const std::string &fullname)
+  {
+    static std::mutex mutex;
+    // Elements of a deque are not moved when new elements are appended to it.
+    static std::deque<Variable> variables;
+    static std::unordered_map<std::string, size_t> indices;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    const auto it_index = indices.find(fullname);
+    if (it_index != indices.end())
+      return variables[it_index->second];
+
+    Variable variable;
+    variable.index = variables.size();
+    variable.fullname = fullname;
+    ufo::splitVarGroup(fullname, variable.varname, variable.groupname);
+    variables.push_back(std::move(variable));
+    indices.emplace(fullname, variables.back().index);
+    return variables.back();
+  }
+}  // namespace ufo
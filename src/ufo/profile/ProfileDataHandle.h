@@ -0,0 +1,59 @@
+/*
+ * (C) Crown copyright 2021, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef UFO_PROFILE_PROFILEDATAHANDLE_H_
+#define UFO_PROFILE_PROFILEDATAHANDLE_H_
+
+#include <cstddef>
+#include <string>
+
+namespace ufo {
+
+  /// \brief Handle identifying a variable stored by the ProfileDataHandler and
+  /// EntireSampleDataHandler classes.
+  ///
+  /// Each distinct variable name (of the form var@group) is registered once per program and
+  /// assigned a small integer index, which the data handlers use to find the variable without
+  /// parsing or hashing its name. Handles of variables retrieved for every profile should
+  /// therefore be created only once; those of the variables in VariableNames are declared in
+  /// VariableHandles.
+  class ProfileDataHandle {
+   public:
+    /// Return the handle of the variable \p fullname, registering it if necessary.
+    /// This function is thread-safe.
+    explicit ProfileDataHandle(const std::string &fullname);
+
+    /// Index of the variable among all registered variables.
+    size_t index() const {return variable_->index;}
+
+    /// Full name of the variable (var@group).
+    const std::string &fullname() const {return variable_->fullname;}
+
+    /// Name of the variable without the group.
+    const std::string &varname() const {return variable_->varname;}
+
+    /// Group of the variable.
+    const std::string &groupname() const {return variable_->groupname;}
+
+   private:
+    /// Properties of a registered variable.
+    struct Variable {
+      size_t index;
+      std::string fullname;
+      std::string varname;
+      std::string groupname;
+    };
+
+    /// Return the registered variable called \p fullname, registering it if necessary.
+    static const Variable &registerVariable(const std::string &fullname);
+
+    /// Registered variables are never destroyed before the end of the program.
+    const Variable *variable_;
+  };
+}  // namespace ufo
+
+#endif  // UFO_PROFILE_PROFILEDATAHANDLE_H_
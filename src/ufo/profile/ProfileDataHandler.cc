@@ -5,6 +5,9 @@
  * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
  */
 
+#include <numeric>
+#include <utility>
+
 #include "oops/util/missingValues.h"
 
 #include "ufo/GeoVaLs.h"
@@ -30,11 +33,45 @@ namespace ufo {
   {
     profileIndices_.reset(new ProfileIndices(obsdb_, options, apply));
     entireSampleDataHandler_.reset(new EntireSampleDataHandler(obsdb_, options));
+    setRecordContiguousOrder();
+  }
+
+  void ProfileDataHandler::setRecordContiguousOrder()
+  {
+    const size_t nlocs = obsdb_.nlocs();
+    // Locations in the order in which they are visited.
+    std::vector <size_t> order;
+    order.reserve(nlocs);
+    std::vector <bool> visited(nlocs, false);
+    profileOffsets_.assign(1, 0);
+    for (size_t jprof = 0; jprof < obsdb_.nrecs(); ++jprof) {
+      profileIndices_->updateNextProfileIndices();
+      for (const size_t jloc : profileIndices_->getProfileIndices()) {
+        if (jloc >= nlocs || visited[jloc]) {
+          // Profiles sharing locations cannot all be stored contiguously.
+          profileOffsets_.clear();
+          profileIndices_->reset();
+          return;
+        }
+        visited[jloc] = true;
+        order.push_back(jloc);
+      }
+      profileOffsets_.push_back(order.size());
+    }
+    profileIndices_->reset();
+
+    // Locations that do not belong to any profile are stored after all profiles.
+    for (size_t jloc = 0; jloc < nlocs; ++jloc)
+      if (!visited[jloc]) order.push_back(jloc);
+    entireSampleDataHandler_->setLocationOrder(std::move(order));
   }
 
   void ProfileDataHandler::resetProfileInformation()
   {
-    profileData_.clear();
+    // Keep the vectors, so that their memory can be reused by the next profile.
+    for (const ProfileDataHandle &handle : loadedVariables_)
+      profileData_[handle.index()].loaded = false;
+    loadedVariables_.clear();
     GeoVaLData_.clear();
     obsDiagData_.clear();
   }
@@ -43,6 +80,7 @@ namespace ufo {
   {
     resetProfileInformation();
     profileIndices_->updateNextProfileIndices();
+    profilePosition_ = nextProfilePosition_++;
   }
 
   void ProfileDataHandler::updateProfileInformation()
@@ -81,27 +119,41 @@ namespace ufo {
     }
   }
 
+  bool ProfileDataHandler::getProfileRangeInEntireSample(const std::string& groupname,
+                                                         size_t &begin, size_t &size) const
+  {
+    const size_t entriesPerProfile = options_.getEntriesPerProfile(groupname);
+    if (entriesPerProfile != 0) {
+      begin = profileIndices_->getProfileNumCurrent() * entriesPerProfile;
+      size = entriesPerProfile;
+      return true;
+    }
+    if (profileOffsets_.empty())
+      return false;
+    if (profilePosition_ + 1 < profileOffsets_.size()) {
+      begin = profileOffsets_[profilePosition_];
+      size = profileOffsets_[profilePosition_ + 1] - begin;
+    } else {
+      begin = 0;
+      size = 0;
+    }
+    return true;
+  }
+
   void ProfileDataHandler::updateEntireSampleData()
   {
-    for (const auto &it_profile : profileData_) {
-      std::string fullname = it_profile.first;
-      std::string varname;
-      std::string groupname;
-      ufo::splitVarGroup(fullname, varname, groupname);
+    for (const ProfileDataHandle &handle : loadedVariables_) {
+      const std::string &fullname = handle.fullname();
+      const std::string &groupname = handle.groupname();
 
       if (groupname == "QCFlags" ||
           groupname == "ModelLevelsFlags" ||
           groupname == "ModelLevelsQCFlags" ||
           groupname == "ModelRhoLevelsFlags" ||
           groupname == "Counters") {
-        const std::vector <int>& profileData = get<int>(fullname);
-        getProfileIndicesInEntireSample(groupname);
-        std::vector <int>& entireSampleData = entireSampleDataHandler_->get<int>(fullname);
-        size_t idx = 0;
-        for (const auto& profileIndex : profileIndicesInEntireSample_) {
-          updateValueIfPresent(profileData, idx, entireSampleData, profileIndex);
-          idx++;
-        }
+        const std::vector <int>& profileData = get<int>(handle);
+        std::vector <int>& entireSampleData = entireSampleDataHandler_->get<int>(handle);
+        insertProfile(groupname, profileData, entireSampleData);
       } else if (groupname == "Corrections" ||
                  groupname == "DerivedValue" ||
                  groupname == "GrossErrorProbability" ||
@@ -109,14 +161,9 @@ namespace ufo {
                  groupname == "ModelLevelsDerivedValue" ||
                  groupname == "ModelRhoLevelsDerivedValue" ||
                  fullname == ufo::VariableNames::obs_air_pressure) {
-        const std::vector <float>& profileData = get<float>(fullname);
-        getProfileIndicesInEntireSample(groupname);
-        std::vector <float>& entireSampleData = entireSampleDataHandler_->get<float>(fullname);
-        size_t idx = 0;
-        for (const auto& profileIndex : profileIndicesInEntireSample_) {
-          updateValueIfPresent(profileData, idx, entireSampleData, profileIndex);
-          idx++;
-        }
+        const std::vector <float>& profileData = get<float>(handle);
+        std::vector <float>& entireSampleData = entireSampleDataHandler_->get<float>(handle);
+        insertProfile(groupname, profileData, entireSampleData);
       }
     }
   }
@@ -138,17 +185,15 @@ namespace ufo {
   {
     oops::Log::debug() << "Flagging observations" << std::endl;
 
-    for (const auto& it_profile : profileData_) {
-      std::string fullname = it_profile.first;
-      std::string varname;
-      std::string groupname;
-      ufo::splitVarGroup(fullname, varname, groupname);
+    for (const ProfileDataHandle &handle : loadedVariables_) {
+      const std::string &varname = handle.varname();
+      const std::string &groupname = handle.groupname();
 
       if (groupname == "QCFlags") {
-        oops::Log::debug() << " " << fullname << std::endl;
+        oops::Log::debug() << " " << handle.fullname() << std::endl;
 
         // Obtain QC flags
-        const std::vector <int> &Flags = get<int>(fullname);
+        const std::vector <int> &Flags = get<int>(handle);
         if (Flags.empty()) continue;
         getProfileIndicesInEntireSample(groupname);
 
@@ -244,14 +289,12 @@ namespace ufo {
           obsdiags_->has(varname)) {
         vec_all.assign(obsdb_.nlocs(), util::missingValue(1.0f));
         obsdiags_->get(vec_all, varname);
+        entireSampleDataHandler_->permuteToLocationOrder(vec_all);
       }
       // If the ObsDiags vector for the entire sample is not empty,
       // fill the values for this profile.
-      if (!vec_all.empty()) {
-        getProfileIndicesInEntireSample(groupname);
-        for (const auto& profileIndex : profileIndicesInEntireSample_)
-          vec_ObsDiag.emplace_back(vec_all[profileIndex]);
-      }
+      if (!vec_all.empty())
+        extractProfile(groupname, vec_all, vec_ObsDiag);
       // Add ObsDiag vector to map (even if it is empty).
       obsDiagData_.emplace(fullname, std::move(vec_ObsDiag));
       return obsDiagData_[fullname];
@@ -265,7 +308,7 @@ namespace ufo {
    const std::vector <std::string> &variableNamesGeoVaLs,
    const std::vector <std::string> &variableNamesObsDiags)
   {
-    profileIndices_->reset();
+    resetProfileIndices();
     std::vector <ProfileDataHolder> profiles;
     oops::Log::debug() << "Filling vector of profiles" << std::endl;
     for (size_t jprof = 0; jprof < obsdb_.nrecs(); ++jprof) {
@@ -8,6 +8,8 @@
 #ifndef UFO_PROFILE_PROFILEDATAHANDLER_H_
 #define UFO_PROFILE_PROFILEDATAHANDLER_H_
 
+#include <algorithm>
+#include <deque>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -27,6 +29,7 @@
 
 #include "ufo/profile/DataHandlerParameters.h"
 #include "ufo/profile/EntireSampleDataHandler.h"
+#include "ufo/profile/ProfileDataHandle.h"
 #include "ufo/profile/ProfileIndices.h"
 
 #include "ufo/utils/metoffice/MetOfficeQCFlags.h"
@@ -47,6 +50,11 @@ namespace ufo {
   /// \brief Retrieve and store data for individual profiles.
   /// To do this, first the vector of values in the entire data sample is retrieved
   /// then the relevant data corresponding to this profile are extracted.
+  ///
+  /// Unless some locations belong to several profiles, the entire sample is stored with the
+  /// locations of each profile in a contiguous range, in the order in which profiles are visited,
+  /// so that the data of a profile are extracted and written back with a single copy.
+  /// Variables can be identified either by their names or (faster) by ProfileDataHandles.
   class ProfileDataHandler {
    public:
     ProfileDataHandler(const ObsFilterData &data,
@@ -63,36 +71,41 @@ namespace ufo {
     template <typename T>
       std::vector<T>& get(const std::string &fullname)
       {
-        // Determine variable and group names
-        std::string varname;
-        std::string groupname;
-        ufo::splitVarGroup(fullname, varname, groupname);
+        return get<T>(ProfileDataHandle(fullname));
+      }
 
-        auto it_profileData = profileData_.find(fullname);
-        if (it_profileData != profileData_.end()) {
+    /// \overload
+    template <typename T>
+      std::vector<T>& get(const ProfileDataHandle &handle)
+      {
+        ProfileVector &profileVector = getProfileVector(handle);
+        if (profileVector.loaded) {
           // If the vector is already present, return it.
           // If the type T is incorrect then boost::get will return an exception;
           // provide additional information if that occurs.
           try {
-            return boost::get<std::vector<T>> (it_profileData->second);
+            return boost::get<std::vector<T>> (profileVector.values);
           } catch (boost::bad_get) {
             throw eckit::BadParameter("Template parameter passed to boost::get for " +
-                                      fullname + " probably has the wrong type", Here());
-          }
-        } else {
-          std::vector <T> vec_prof;  // Vector storing data for current profile.
-          // Retrieve variable vector from entire sample.
-          const std::vector <T> &vec_all = entireSampleDataHandler_->get<T>(fullname);
-          // Only proceed if the vector is not empty.
-          if (!vec_all.empty()) {
-            getProfileIndicesInEntireSample(groupname);
-            for (const auto& profileIndex : profileIndicesInEntireSample_)
-              vec_prof.emplace_back(vec_all[profileIndex]);
+                                      handle.fullname() + " probably has the wrong type",
+                                      Here());
           }
-          // Add vector to map (even if it is empty).
-          profileData_.emplace(fullname, std::move(vec_prof));
-          return boost::get<std::vector<T>> (profileData_[fullname]);
         }
+        // Reuse the memory allocated for previous profiles if possible.
+        std::vector <T> *vec_prof = boost::get<std::vector<T>> (&profileVector.values);
+        if (vec_prof == nullptr) {
+          profileVector.values = std::vector <T>();
+          vec_prof = boost::get<std::vector<T>> (&profileVector.values);
+        }
+        vec_prof->clear();
+        // Retrieve variable vector from entire sample.
+        const std::vector <T> &vec_all = entireSampleDataHandler_->get<T>(handle);
+        // Only proceed if the vector is not empty.
+        if (!vec_all.empty())
+          extractProfile(handle.groupname(), vec_all, *vec_prof);
+        // Mark the vector as present (even if it is empty).
+        setLoaded(profileVector, handle);
+        return *vec_prof;
       }
 
     /// Directly set a vector for the current profile.
@@ -103,29 +116,22 @@ namespace ufo {
     template <typename T>
       void set(const std::string &fullname, std::vector<T> &&vec_in)
       {
-        // Determine variable and group names
-        std::string varname;
-        std::string groupname;
-        ufo::splitVarGroup(fullname, varname, groupname);
-        // Check whether vector is already in map.
-        auto it_profileData = profileData_.find(fullname);
-        if (it_profileData != profileData_.end()) {
-          // Replace vector in map.
-          it_profileData->second = std::move(vec_in);
-        } else {
-          // Add vector to map.
-          profileData_.emplace(fullname, std::move(vec_in));
-        }
-        entireSampleDataHandler_->initialiseVector<T>(fullname);
+        set(ProfileDataHandle(fullname), std::move(vec_in));
+      }
+
+    /// \overload
+    template <typename T>
+      void set(const ProfileDataHandle &handle, std::vector<T> &&vec_in)
+      {
+        ProfileVector &profileVector = getProfileVector(handle);
+        // Replace any vector already present.
+        profileVector.values = std::move(vec_in);
+        setLoaded(profileVector, handle);
+        entireSampleDataHandler_->initialiseVector<T>(handle);
         // Transfer this profile's data into the entire sample.
-        getProfileIndicesInEntireSample(groupname);
-        std::vector <T>& entireSampleData = entireSampleDataHandler_->get<T>(fullname);
-        const std::vector <T>& profileData = this->get<T>(fullname);
-        size_t idx = 0;
-        for (const auto& profileIndex : profileIndicesInEntireSample_) {
-          updateValueIfPresent(profileData, idx, entireSampleData, profileIndex);
-          idx++;
-        }
+        std::vector <T>& entireSampleData = entireSampleDataHandler_->get<T>(handle);
+        const std::vector <T>& profileData = this->get<T>(handle);
+        insertProfile(handle.groupname(), profileData, entireSampleData);
       }
 
     /// Initialise the next profile prior to applying checks.
@@ -158,7 +164,11 @@ namespace ufo {
 
     /// Reset profile indices (required if it is desired to loop through
     /// the entire sample again).
-    void resetProfileIndices() {profileIndices_->reset();}
+    void resetProfileIndices()
+    {
+      profileIndices_->reset();
+      nextProfilePosition_ = 0;
+    }
 
     /// Produce a vector of all profiles, loading the requested variables into each one.
     std::vector <ProfileDataHolder> produceProfileVector
@@ -190,23 +200,91 @@ namespace ufo {
     /// a configurable value if required.
     void setFlagged();
 
-    /// Transfer values from one vector to another (as long as neither is empty).
+    /// Get indices in entire sample corresponding to current profile,
+    /// in the order of locations used by the ObsSpace.
+    void getProfileIndicesInEntireSample(const std::string& groupname);
+
+    /// \brief Determine the range of elements of the vectors of the entire sample in which
+    /// variables of group \p groupname are stored for the current profile.
+    ///
+    /// Return false if these elements do not form a contiguous range.
+    bool getProfileRangeInEntireSample(const std::string& groupname,
+                                       size_t &begin, size_t &size) const;
+
+    /// Copy the values of the current profile from a vector of the entire sample.
+    template <typename T>
+      void extractProfile(const std::string &groupname,
+                          const std::vector <T> &vec_all,
+                          std::vector <T> &vec_prof)
+      {
+        size_t begin, size;
+        if (getProfileRangeInEntireSample(groupname, begin, size)) {
+          vec_prof.assign(vec_all.begin() + begin, vec_all.begin() + begin + size);
+        } else {
+          getProfileIndicesInEntireSample(groupname);
+          vec_prof.clear();
+          for (const auto& profileIndex : profileIndicesInEntireSample_)
+            vec_prof.emplace_back(vec_all[profileIndex]);
+        }
+      }
+
+    /// Copy the values of the current profile into a vector of the entire sample
+    /// (as long as neither vector is empty).
     template <typename T>
-      void updateValueIfPresent(const std::vector <T> &vecIn, const size_t &idxIn,
-                                std::vector <T> &vecOut, const size_t &idxOut)
+      void insertProfile(const std::string &groupname,
+                         const std::vector <T> &vec_prof,
+                         std::vector <T> &vec_all)
       {
         // Ensure neither vector is empty.
-        if (oops::anyVectorEmpty(vecIn, vecOut)) return;
-        vecOut[idxOut] = vecIn[idxIn];
+        if (oops::anyVectorEmpty(vec_prof, vec_all)) return;
+        size_t begin, size;
+        if (getProfileRangeInEntireSample(groupname, begin, size)) {
+          std::copy_n(vec_prof.begin(), std::min(size, vec_prof.size()), vec_all.begin() + begin);
+        } else {
+          getProfileIndicesInEntireSample(groupname);
+          const size_t size = std::min(profileIndicesInEntireSample_.size(), vec_prof.size());
+          for (size_t idx = 0; idx < size; ++idx)
+            vec_all[profileIndicesInEntireSample_[idx]] = vec_prof[idx];
+        }
       }
 
-    /// Get indices in entire sample corresponding to current profile.
-    void getProfileIndicesInEntireSample(const std::string& groupname);
+    /// Store the locations of each profile contiguously in the entire sample.
+    void setRecordContiguousOrder();
+
+   private:  // types
+    /// Values of a variable in the current profile.
+    struct ProfileVector {
+      /// True if \p values hold the data of the current profile.
+      /// If false, \p values may hold the data of a previous profile.
+      bool loaded = false;
+      boost::variant <std::vector <int>, std::vector <float>, std::vector <std::string>> values;
+    };
+
+    /// Return the container of the values of the variable with handle \p handle.
+    ProfileVector &getProfileVector(const ProfileDataHandle &handle)
+    {
+      // Elements are appended, which leaves references to existing elements valid.
+      if (handle.index() >= profileData_.size())
+        profileData_.resize(handle.index() + 1);
+      return profileData_[handle.index()];
+    }
+
+    /// Mark a variable as present in the current profile.
+    void setLoaded(ProfileVector &profileVector, const ProfileDataHandle &handle)
+    {
+      if (!profileVector.loaded) {
+        profileVector.loaded = true;
+        loadedVariables_.push_back(handle);
+      }
+    }
 
    private:  // members
-    /// Container of each variable in the current profile.
-    std::unordered_map <std::string, boost::variant
-      <std::vector <int>, std::vector <float>, std::vector <std::string>>> profileData_;
+    /// Container of each variable, indexed by ProfileDataHandle::index().
+    /// A deque is used so that references to the vectors remain valid when variables are added.
+    std::deque <ProfileVector> profileData_;
+
+    /// Variables present in the current profile.
+    std::vector <ProfileDataHandle> loadedVariables_;
 
     /// Container of GeoVaLs in the current profile.
     std::unordered_map <std::string, std::vector <float>> GeoVaLData_;
@@ -240,6 +318,18 @@ namespace ufo {
 
     /// Indices in the entire data sample that correspond to the current profile.
     std::vector <size_t> profileIndicesInEntireSample_;
+
+    /// Start of the range of elements of per-location vectors of the entire sample holding the
+    /// data of each profile, followed by the total number of such elements
+    /// (empty if the data of each profile are not stored contiguously).
+    std::vector <size_t> profileOffsets_;
+
+    /// Position of the current profile in the sequence of profiles visited since the profile
+    /// indices were last reset.
+    size_t profilePosition_ = 0;
+
+    /// Position of the next profile to be visited.
+    size_t nextProfilePosition_ = 0;
   };
 }  // namespace ufo
 
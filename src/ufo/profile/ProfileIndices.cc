@@ -22,7 +22,10 @@ namespace ufo {
     this->reset();
 
     // Determine unique profile numbers.
-    uniqueProfileNums_.insert(profileNums_.begin(), profileNums_.end());
+    uniqueProfileNums_ = profileNums_;
+    std::sort(uniqueProfileNums_.begin(), uniqueProfileNums_.end());
+    uniqueProfileNums_.erase(std::unique(uniqueProfileNums_.begin(), uniqueProfileNums_.end()),
+                             uniqueProfileNums_.end());
 
     // If not sorting observations, ensure number of profiles is consistent
     // with quantity reported by obsdb.
@@ -124,7 +127,8 @@ namespace ufo {
 
   size_t ProfileIndices::getProfileNumCurrent() const
   {
-    const auto &it = uniqueProfileNums_.find(profileNumCurrent_);
+    const auto it = std::lower_bound(uniqueProfileNums_.begin(), uniqueProfileNums_.end(),
+                                     profileNumCurrent_);
     return std::distance(uniqueProfileNums_.begin(), it);
   }
 
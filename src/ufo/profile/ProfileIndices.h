@@ -11,7 +11,6 @@
 #include <map>
 #include <memory>
 #include <ostream>
-#include <set>
 #include <string>
 #include <utility>
 #include <vector>
@@ -75,8 +74,8 @@ namespace ufo {
     /// Profile numbers for the entire sample.
     const std::vector <size_t> profileNums_;
 
-    /// Unique profile numbers for the entire sample.
-    std::set <size_t> uniqueProfileNums_;
+    /// Unique profile numbers for the entire sample (in ascending order).
+    std::vector <size_t> uniqueProfileNums_;
 
     /// Profile index map.
     typedef std::map<std::size_t, std::vector<std::size_t>> ProfIdxMap;
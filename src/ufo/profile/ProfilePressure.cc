@@ -7,6 +7,8 @@
 
 #include "ufo/profile/ProfilePressure.h"
 
+#include "ufo/profile/VariableHandles.h"
+
 namespace ufo {
 
   static ProfileCheckMaker<ProfilePressure>
@@ -25,11 +27,11 @@ namespace ufo {
 
     // Retrieve the observed geopotential height and associated metadata.
     std::vector <float> &zObs =
-      profileDataHandler.get<float>(ufo::VariableNames::obs_geopotential_height);
+      profileDataHandler.get<float>(VariableHandles::obs_geopotential_height);
     const std::vector <int> &ObsType =
-      profileDataHandler.get<int>(ufo::VariableNames::ObsType);
+      profileDataHandler.get<int>(VariableHandles::ObsType);
     std::vector <int> &ReportFlags =
-      profileDataHandler.get<int>(ufo::VariableNames::qcflags_observation_report);
+      profileDataHandler.get<int>(VariableHandles::qcflags_observation_report);
 
     if (!oops::allVectorsSameNonZeroSize(zObs, ObsType, ReportFlags)) {
       oops::Log::warning() << "At least one vector is the wrong size. "
@@ -57,7 +59,7 @@ namespace ufo {
 
     // Retrive the vector of observed pressures.
     std::vector <float> &pressures =
-      profileDataHandler.get<float>(ufo::VariableNames::obs_air_pressure);
+      profileDataHandler.get<float>(VariableHandles::obs_air_pressure);
     // If pressures have not been recorded, initialise the vector with missing values.
     if (pressures.empty())
       pressures.assign(numProfileLevels, missingValueFloat);
@@ -7,6 +7,8 @@
 
 #include "ufo/profile/ProfileSondeFlags.h"
 
+#include "ufo/profile/VariableHandles.h"
+
 namespace ufo {
 
   static ProfileCheckMaker<ProfileSondeFlags>
@@ -24,17 +26,17 @@ namespace ufo {
     const int numProfileLevels = profileDataHandler.getNumProfileLevels();
 
     std::vector <int> &tFlags =
-      profileDataHandler.get<int>(ufo::VariableNames::qcflags_air_temperature);
+      profileDataHandler.get<int>(VariableHandles::qcflags_air_temperature);
     std::vector <int> &rhFlags =
-      profileDataHandler.get<int>(ufo::VariableNames::qcflags_relative_humidity);
+      profileDataHandler.get<int>(VariableHandles::qcflags_relative_humidity);
     std::vector <int> &uFlags =
-      profileDataHandler.get<int>(ufo::VariableNames::qcflags_eastward_wind);
+      profileDataHandler.get<int>(VariableHandles::qcflags_eastward_wind);
     std::vector <int> &vFlags =
-      profileDataHandler.get<int>(ufo::VariableNames::qcflags_northward_wind);
+      profileDataHandler.get<int>(VariableHandles::qcflags_northward_wind);
     const std::vector <int> &ObsType =
-      profileDataHandler.get<int>(ufo::VariableNames::ObsType);
+      profileDataHandler.get<int>(VariableHandles::ObsType);
     const std::vector <int> &LevelType =
-      profileDataHandler.get<int>(ufo::VariableNames::LevelType);
+      profileDataHandler.get<int>(VariableHandles::LevelType);
 
     if (!oops::allVectorsSameNonZeroSize(tFlags, rhFlags, uFlags, vFlags,
                                          ObsType, LevelType)) {
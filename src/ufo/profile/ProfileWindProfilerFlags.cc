@@ -6,7 +6,7 @@
  */
 
 #include "ufo/profile/ProfileWindProfilerFlags.h"
-#include "ufo/profile/VariableNames.h"
+#include "ufo/profile/VariableHandles.h"
 
 namespace ufo {
 
@@ -24,13 +24,13 @@ namespace ufo {
     const int numProfileLevels = profileDataHandler.getNumProfileLevels();
 
     std::vector <int> &uFlags =
-      profileDataHandler.get<int>(ufo::VariableNames::qcflags_eastward_wind);
+      profileDataHandler.get<int>(VariableHandles::qcflags_eastward_wind);
     std::vector <int> &vFlags =
-      profileDataHandler.get<int>(ufo::VariableNames::qcflags_northward_wind);
+      profileDataHandler.get<int>(VariableHandles::qcflags_northward_wind);
     const std::vector <int> &WinProQCFlags =
-      profileDataHandler.get<int>(ufo::VariableNames::qcflags_wind_profiler);
+      profileDataHandler.get<int>(VariableHandles::qcflags_wind_profiler);
     const std::vector <int> &ObsType =
-      profileDataHandler.get<int>(ufo::VariableNames::ObsType);
+      profileDataHandler.get<int>(VariableHandles::ObsType);
 
     if (!oops::allVectorsSameNonZeroSize(uFlags, vFlags, WinProQCFlags, ObsType)) {
       oops::Log::warning() << "At least one vector is the wrong size. "
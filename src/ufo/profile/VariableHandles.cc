@@ -0,0 +1,120 @@
+/*
+ * (C) Crown copyright 2021, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#include "ufo/profile/VariableHandles.h"
+
+#include "ufo/profile/VariableNames.h"
+
+namespace ufo
+{
+
+// Observation values
+const ProfileDataHandle VariableHandles::obs_air_pressure(VariableNames::obs_air_pressure);
+const ProfileDataHandle VariableHandles::obs_air_temperature(VariableNames::obs_air_temperature);
+const ProfileDataHandle VariableHandles::obs_relative_humidity(
+  VariableNames::obs_relative_humidity);
+const ProfileDataHandle VariableHandles::obs_eastward_wind(VariableNames::obs_eastward_wind);
+const ProfileDataHandle VariableHandles::obs_northward_wind(VariableNames::obs_northward_wind);
+const ProfileDataHandle VariableHandles::obs_geopotential_height(
+  VariableNames::obs_geopotential_height);
+const ProfileDataHandle VariableHandles::obs_dew_point_temperature(
+  VariableNames::obs_dew_point_temperature);
+
+// Observation errors
+const ProfileDataHandle VariableHandles::obserr_air_temperature(
+  VariableNames::obserr_air_temperature);
+const ProfileDataHandle VariableHandles::obserr_relative_humidity(
+  VariableNames::obserr_relative_humidity);
+const ProfileDataHandle VariableHandles::obserr_eastward_wind(VariableNames::obserr_eastward_wind);
+const ProfileDataHandle VariableHandles::obserr_northward_wind(
+  VariableNames::obserr_northward_wind);
+const ProfileDataHandle VariableHandles::obserr_geopotential_height(
+  VariableNames::obserr_geopotential_height);
+
+// HofX
+const ProfileDataHandle VariableHandles::hofx_air_temperature(VariableNames::hofx_air_temperature);
+const ProfileDataHandle VariableHandles::hofx_geopotential_height(
+  VariableNames::hofx_geopotential_height);
+const ProfileDataHandle VariableHandles::hofx_relative_humidity(
+  VariableNames::hofx_relative_humidity);
+const ProfileDataHandle VariableHandles::hofx_eastward_wind(VariableNames::hofx_eastward_wind);
+const ProfileDataHandle VariableHandles::hofx_northward_wind(VariableNames::hofx_northward_wind);
+
+// Probability of gross error
+const ProfileDataHandle VariableHandles::pge_air_temperature(VariableNames::pge_air_temperature);
+const ProfileDataHandle VariableHandles::pge_relative_humidity(
+  VariableNames::pge_relative_humidity);
+const ProfileDataHandle VariableHandles::pge_eastward_wind(VariableNames::pge_eastward_wind);
+const ProfileDataHandle VariableHandles::pge_northward_wind(VariableNames::pge_northward_wind);
+const ProfileDataHandle VariableHandles::pge_geopotential_height(
+  VariableNames::pge_geopotential_height);
+
+// Probability of gross error used in buddy check
+const ProfileDataHandle VariableHandles::pgebd_air_temperature(
+  VariableNames::pgebd_air_temperature);
+const ProfileDataHandle VariableHandles::pgebd_relative_humidity(
+  VariableNames::pgebd_relative_humidity);
+const ProfileDataHandle VariableHandles::pgebd_eastward_wind(VariableNames::pgebd_eastward_wind);
+const ProfileDataHandle VariableHandles::pgebd_northward_wind(VariableNames::pgebd_northward_wind);
+const ProfileDataHandle VariableHandles::pgebd_geopotential_height(
+  VariableNames::pgebd_geopotential_height);
+
+// MetaData
+const ProfileDataHandle VariableHandles::obs_level_time(VariableNames::obs_level_time);
+const ProfileDataHandle VariableHandles::ObsType(VariableNames::ObsType);
+const ProfileDataHandle VariableHandles::Latitude(VariableNames::Latitude);
+const ProfileDataHandle VariableHandles::Zstation(VariableNames::Zstation);
+const ProfileDataHandle VariableHandles::LevelType(VariableNames::LevelType);
+
+// QC flags
+const ProfileDataHandle VariableHandles::qcflags_observation_report(
+  VariableNames::qcflags_observation_report);
+const ProfileDataHandle VariableHandles::qcflags_air_temperature(
+  VariableNames::qcflags_air_temperature);
+const ProfileDataHandle VariableHandles::qcflags_relative_humidity(
+  VariableNames::qcflags_relative_humidity);
+const ProfileDataHandle VariableHandles::qcflags_geopotential_height(
+  VariableNames::qcflags_geopotential_height);
+const ProfileDataHandle VariableHandles::qcflags_eastward_wind(
+  VariableNames::qcflags_eastward_wind);
+const ProfileDataHandle VariableHandles::qcflags_northward_wind(
+  VariableNames::qcflags_northward_wind);
+const ProfileDataHandle VariableHandles::qcflags_time(VariableNames::qcflags_time);
+const ProfileDataHandle VariableHandles::qcflags_wind_profiler(
+  VariableNames::qcflags_wind_profiler);
+
+// Counters
+const ProfileDataHandle VariableHandles::counter_NumAnyErrors(VariableNames::counter_NumAnyErrors);
+const ProfileDataHandle VariableHandles::counter_NumSamePErrObs(
+  VariableNames::counter_NumSamePErrObs);
+const ProfileDataHandle VariableHandles::counter_NumSuperadiabat(
+  VariableNames::counter_NumSuperadiabat);
+const ProfileDataHandle VariableHandles::counter_Num925Miss(VariableNames::counter_Num925Miss);
+const ProfileDataHandle VariableHandles::counter_Num100Miss(VariableNames::counter_Num100Miss);
+const ProfileDataHandle VariableHandles::counter_NumStdMiss(VariableNames::counter_NumStdMiss);
+const ProfileDataHandle VariableHandles::counter_NumHydErrObs(VariableNames::counter_NumHydErrObs);
+const ProfileDataHandle VariableHandles::counter_NumIntHydErrors(
+  VariableNames::counter_NumIntHydErrors);
+const ProfileDataHandle VariableHandles::counter_NumInterpErrors(
+  VariableNames::counter_NumInterpErrors);
+const ProfileDataHandle VariableHandles::counter_NumInterpErrObs(
+  VariableNames::counter_NumInterpErrObs);
+const ProfileDataHandle VariableHandles::counter_NumSignChange(
+  VariableNames::counter_NumSignChange);
+const ProfileDataHandle VariableHandles::counter_TotCProfs(VariableNames::counter_TotCProfs);
+const ProfileDataHandle VariableHandles::counter_TotHProfs(VariableNames::counter_TotHProfs);
+const ProfileDataHandle VariableHandles::counter_TotCFlags(VariableNames::counter_TotCFlags);
+const ProfileDataHandle VariableHandles::counter_TotHFlags(VariableNames::counter_TotHFlags);
+const ProfileDataHandle VariableHandles::counter_TotLFlags(VariableNames::counter_TotLFlags);
+
+// Corrections
+const ProfileDataHandle VariableHandles::obscorrection_air_temperature(
+  VariableNames::obscorrection_air_temperature);
+const ProfileDataHandle VariableHandles::obscorrection_geopotential_height(
+  VariableNames::obscorrection_geopotential_height);
+
+}  // namespace ufo
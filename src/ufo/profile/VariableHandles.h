@@ -0,0 +1,108 @@
+/*
+ * (C) Crown copyright 2021, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef UFO_PROFILE_VARIABLEHANDLES_H_
+#define UFO_PROFILE_VARIABLEHANDLES_H_
+
+#include "ufo/profile/ProfileDataHandle.h"
+
+namespace ufo
+{
+
+/// Handles of the variables in VariableNames retrieved by the profile checks, created once
+/// per program.
+struct VariableHandles
+{
+  // Observation values
+
+  static const ProfileDataHandle obs_air_pressure;
+  static const ProfileDataHandle obs_air_temperature;
+  static const ProfileDataHandle obs_relative_humidity;
+  static const ProfileDataHandle obs_eastward_wind;
+  static const ProfileDataHandle obs_northward_wind;
+  static const ProfileDataHandle obs_geopotential_height;
+  static const ProfileDataHandle obs_dew_point_temperature;
+
+  // Observation errors
+
+  static const ProfileDataHandle obserr_air_temperature;
+  static const ProfileDataHandle obserr_relative_humidity;
+  static const ProfileDataHandle obserr_eastward_wind;
+  static const ProfileDataHandle obserr_northward_wind;
+  static const ProfileDataHandle obserr_geopotential_height;
+
+  // HofX
+
+  static const ProfileDataHandle hofx_air_temperature;
+  static const ProfileDataHandle hofx_geopotential_height;
+  static const ProfileDataHandle hofx_relative_humidity;
+  static const ProfileDataHandle hofx_eastward_wind;
+  static const ProfileDataHandle hofx_northward_wind;
+
+  // Probability of gross error
+
+  static const ProfileDataHandle pge_air_temperature;
+  static const ProfileDataHandle pge_relative_humidity;
+  static const ProfileDataHandle pge_eastward_wind;
+  static const ProfileDataHandle pge_northward_wind;
+  static const ProfileDataHandle pge_geopotential_height;
+
+  // Probability of gross error used in buddy check
+
+  static const ProfileDataHandle pgebd_air_temperature;
+  static const ProfileDataHandle pgebd_relative_humidity;
+  static const ProfileDataHandle pgebd_eastward_wind;
+  static const ProfileDataHandle pgebd_northward_wind;
+  static const ProfileDataHandle pgebd_geopotential_height;
+
+  // MetaData
+
+  static const ProfileDataHandle obs_level_time;
+  static const ProfileDataHandle ObsType;
+  static const ProfileDataHandle Latitude;
+  static const ProfileDataHandle Zstation;
+  static const ProfileDataHandle LevelType;
+
+  // QC flags
+
+  static const ProfileDataHandle qcflags_observation_report;
+  static const ProfileDataHandle qcflags_air_temperature;
+  static const ProfileDataHandle qcflags_relative_humidity;
+  static const ProfileDataHandle qcflags_geopotential_height;
+  static const ProfileDataHandle qcflags_eastward_wind;
+  static const ProfileDataHandle qcflags_northward_wind;
+  static const ProfileDataHandle qcflags_time;
+  static const ProfileDataHandle qcflags_wind_profiler;
+
+  // Counters
+
+  static const ProfileDataHandle counter_NumAnyErrors;
+  static const ProfileDataHandle counter_NumSamePErrObs;
+  static const ProfileDataHandle counter_NumSuperadiabat;
+  static const ProfileDataHandle counter_Num925Miss;
+  static const ProfileDataHandle counter_Num100Miss;
+  static const ProfileDataHandle counter_NumStdMiss;
+  static const ProfileDataHandle counter_NumHydErrObs;
+  static const ProfileDataHandle counter_NumIntHydErrors;
+  static const ProfileDataHandle counter_NumInterpErrors;
+  static const ProfileDataHandle counter_NumInterpErrObs;
+  static const ProfileDataHandle counter_NumSignChange;
+  static const ProfileDataHandle counter_TotCProfs;
+  static const ProfileDataHandle counter_TotHProfs;
+  static const ProfileDataHandle counter_TotCFlags;
+  static const ProfileDataHandle counter_TotHFlags;
+  static const ProfileDataHandle counter_TotLFlags;
+
+  // Corrections
+
+  static const ProfileDataHandle obscorrection_air_temperature;
+  static const ProfileDataHandle obscorrection_geopotential_height;
+};
+
+}  // namespace ufo
+
+#endif  // UFO_PROFILE_VARIABLEHANDLES_H_
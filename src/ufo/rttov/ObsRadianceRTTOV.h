@@ -47,6 +47,8 @@ class ObsRadianceRTTOV : public ObsOperatorBase,
 
 // Other
   const oops::Variables & requiredVars() const override {return varin_;}
+  /// RTTOV profiles are filled from double-precision copies of the GeoVaLs.
+  bool supportsSinglePrecisionGeoVaLs() const override {return true;}
 
   int & toFortran() {return keyOperRadianceRTTOV_;}
   const int & toFortran() const {return keyOperRadianceRTTOV_;}
@@ -32,6 +32,11 @@ extern "C" {
   void ufo_radiancerttov_simobs_f90(const F90hop &, const F90goms &, const ioda::ObsSpace &,
                                const int &, const int &, double &, const F90goms &);
 // -----------------------------------------------------------------------------
+//  Coefficients shared by all RTTOV operators
+// -----------------------------------------------------------------------------
+  /// Return the number of times coefficients have been read in this process.
+  int ufo_rttov_coefs_read_count_f90();
+// -----------------------------------------------------------------------------
 
 }  // extern C
 
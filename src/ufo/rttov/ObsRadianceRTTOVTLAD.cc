@@ -55,6 +55,12 @@ void ObsRadianceRTTOVTLAD::setTrajectory(const GeoVaLs & geovals, const ObsBias
                                         ObsDiagnostics & ydiags) {
   ufo_radiancerttov_tlad_settraj_f90(keyOperRadianceRTTOV_, geovals.toFortran(), obsspace(),
                                     ydiags.toFortran());
+  if (!activeObservations().empty()) {
+    const int nvars = obsspace().obsvariables().size();
+    const int nlocs = obsspace().nlocs();
+    ufo_radiancerttov_tlad_compact_f90(keyOperRadianceRTTOV_, nvars, nlocs,
+                                       activeObservations()[0]);
+  }
   oops::Log::trace() << "ObsRadianceRTTOVTLAD::setTrajectory done" << std::endl;
 }
 
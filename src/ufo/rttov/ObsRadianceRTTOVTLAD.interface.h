@@ -32,6 +32,7 @@ extern "C" {
   void ufo_radiancerttov_tlad_delete_f90(F90hop &);
   void ufo_radiancerttov_tlad_settraj_f90(const F90hop &, const F90goms &, const ioda::ObsSpace &,
                                          const F90goms &);
+  void ufo_radiancerttov_tlad_compact_f90(const F90hop &, const int &, const int &, const int &);
   void ufo_radiancerttov_simobs_tl_f90(const F90hop &, const F90goms &, const ioda::ObsSpace &,
                                   const int &, const int &, double &);
   void ufo_radiancerttov_simobs_ad_f90(const F90hop &, const F90goms &, const ioda::ObsSpace &,
@@ -0,0 +1,205 @@
+/*
+ * (C) Crown copyright 2021, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#include "ufo/utils/NodeSharedVector.h"
+
+#include <mpi.h>
+
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <utility>
+
+#include "eckit/mpi/Comm.h"
+#include "oops/util/assert.h"
+
+namespace ufo {
+
+// -----------------------------------------------------------------------------
+
+struct NodeSharedLayout::Impl {
+  /// A range of elements of the gathered array.
+  struct Slice {
+    size_t offset;
+    size_t size;
+  };
+
+  MPI_Comm nodeComm = MPI_COMM_NULL;
+  /// Communicator grouping the node leaders; MPI_COMM_NULL on all other processes.
+  MPI_Comm leaderComm = MPI_COMM_NULL;
+  /// Node leaders only: slices held by the processes on each node (ordered by the rank of
+  /// the node leader in leaderComm).
+  std::vector<std::vector<Slice>> nodeSlices;
+  /// Node leaders only: true if the slices held by the processes on each node form a single
+  /// range of elements and nodes are ordered like these ranges.
+  bool nodeSlicesContiguous = true;
+};
+
+// -----------------------------------------------------------------------------
+
+struct NodeSharedBuffer::Impl {
+  MPI_Win window = MPI_WIN_NULL;
+};
+
+// -----------------------------------------------------------------------------
+
+NodeSharedLayout::NodeSharedLayout(const eckit::mpi::Comm & comm, size_t localSize,
+                                   size_t fakeNodes)
+  : localSize_(localSize), impl_(new Impl)
+{
+  MPI_Comm & nodeComm = impl_->nodeComm;
+  MPI_Comm & leaderComm = impl_->leaderComm;
+  const MPI_Comm mpiComm = MPI_Comm_f2c(comm.communicator());
+  const int rank = comm.rank();
+  const int size = comm.size();
+
+  // Offsets of the slices held by all processes.
+  const uint64_t localSize64 = localSize;
+  std::vector<uint64_t> sizes(size);
+  MPI_Allgather(&localSize64, 1, MPI_UINT64_T, sizes.data(), 1, MPI_UINT64_T, mpiComm);
+  std::vector<size_t> offsets(size + 1, 0);
+  for (int r = 0; r < size; ++r)
+    offsets[r + 1] = offsets[r] + sizes[r];
+  localOffset_ = offsets[rank];
+  globalSize_ = offsets[size];
+
+  MPI_Comm_split_type(mpiComm, MPI_COMM_TYPE_SHARED, rank, MPI_INFO_NULL, &nodeComm);
+  if (fakeNodes > 0) {
+    MPI_Comm sharedComm = nodeComm;
+    MPI_Comm_split(sharedComm, static_cast<int>(rank % fakeNodes), rank, &nodeComm);
+    MPI_Comm_free(&sharedComm);
+  }
+  int nodeRank;
+  MPI_Comm_rank(nodeComm, &nodeRank);
+  MPI_Comm_split(mpiComm, nodeRank == 0 ? 0 : MPI_UNDEFINED, rank, &leaderComm);
+
+  // Rank of the leader of the node of each process.
+  int leader = rank;
+  MPI_Bcast(&leader, 1, MPI_INT, 0, nodeComm);
+  std::vector<int> leaders(size);
+  MPI_Allgather(&leader, 1, MPI_INT, leaders.data(), 1, MPI_INT, mpiComm);
+
+  // Leaders are ranked in leaderComm in the same order as in comm, so iterating over a map keyed
+  // by their ranks in comm visits nodes in the right order.
+  std::map<int, std::vector<int>> nodeProcesses;
+  for (int r = 0; r < size; ++r)
+    nodeProcesses[leaders[r]].push_back(r);
+  numNodes_ = nodeProcesses.size();
+
+  if (leaderComm == MPI_COMM_NULL)
+    return;
+
+  size_t nextOffset = 0;
+  for (const auto & leaderAndProcesses : nodeProcesses) {
+    std::vector<Impl::Slice> slices;
+    for (int r : leaderAndProcesses.second) {
+      if (offsets[r] != nextOffset)
+        impl_->nodeSlicesContiguous = false;
+      nextOffset = offsets[r + 1];
+      slices.push_back(Impl::Slice{offsets[r], sizes[r]});
+    }
+    impl_->nodeSlices.push_back(std::move(slices));
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+NodeSharedLayout::~NodeSharedLayout() {
+  if (impl_->leaderComm != MPI_COMM_NULL)
+    MPI_Comm_free(&impl_->leaderComm);
+  MPI_Comm_free(&impl_->nodeComm);
+}
+
+// -----------------------------------------------------------------------------
+
+NodeSharedBuffer::NodeSharedBuffer(std::shared_ptr<const NodeSharedLayout> layout,
+                                   const void * localData, size_t elementSize)
+  : layout_(std::move(layout)), impl_(new Impl)
+{
+  const NodeSharedLayout & l = *layout_;
+  const NodeSharedLayout::Impl & li = *l.impl_;
+  MPI_Win & window = impl_->window;
+
+  // The whole array is allocated by the node leader; other processes only map it.
+  int nodeRank;
+  MPI_Comm_rank(li.nodeComm, &nodeRank);
+  const MPI_Aint windowSize = nodeRank == 0 ? l.globalSize_ * elementSize : 0;
+  void * localBase;
+  MPI_Win_allocate_shared(windowSize, 1, MPI_INFO_NULL, li.nodeComm, &localBase, &window);
+  MPI_Aint leaderWindowSize;
+  int leaderDispUnit;
+  MPI_Win_shared_query(window, 0, &leaderWindowSize, &leaderDispUnit, &data_);
+
+  char * global = static_cast<char *>(data_);
+  MPI_Win_lock_all(MPI_MODE_NOCHECK, window);
+
+  // Each process copies its own slice; then leaders exchange the slices held on their nodes.
+  if (l.localSize_ > 0)
+    std::memcpy(global + l.localOffset_ * elementSize, localData, l.localSize_ * elementSize);
+  MPI_Win_sync(window);
+  MPI_Barrier(li.nodeComm);
+
+  if (li.leaderComm != MPI_COMM_NULL && li.nodeSlices.size() > 1) {
+    ASSERT(l.globalSize_ <= static_cast<size_t>(INT_MAX));
+    MPI_Datatype elementType;
+    MPI_Type_contiguous(static_cast<int>(elementSize), MPI_BYTE, &elementType);
+    MPI_Type_commit(&elementType);
+
+    int leaderRank;
+    MPI_Comm_rank(li.leaderComm, &leaderRank);
+    const size_t numNodes = li.nodeSlices.size();
+    std::vector<int> counts(numNodes, 0), displs(numNodes, 0);
+    for (size_t node = 0; node < numNodes; ++node) {
+      for (const NodeSharedLayout::Impl::Slice & slice : li.nodeSlices[node])
+        counts[node] += slice.size;
+      if (node > 0)
+        displs[node] = displs[node - 1] + counts[node - 1];
+    }
+
+    if (li.nodeSlicesContiguous) {
+      // Each node's slices already sit at the position at which allgatherv will put them.
+      MPI_Allgatherv(MPI_IN_PLACE, 0, elementType, global, counts.data(), displs.data(),
+                     elementType, li.leaderComm);
+    } else {
+      // Pack the slices of this node, exchange and unpack them.
+      std::vector<char> send(counts[leaderRank] * elementSize);
+      char * next = send.data();
+      for (const NodeSharedLayout::Impl::Slice & slice : li.nodeSlices[leaderRank]) {
+        std::memcpy(next, global + slice.offset * elementSize, slice.size * elementSize);
+        next += slice.size * elementSize;
+      }
+      std::vector<char> received(l.globalSize_ * elementSize);
+      MPI_Allgatherv(send.data(), counts[leaderRank], elementType, received.data(),
+                     counts.data(), displs.data(), elementType, li.leaderComm);
+      next = received.data();
+      for (const std::vector<NodeSharedLayout::Impl::Slice> & slices : li.nodeSlices) {
+        for (const NodeSharedLayout::Impl::Slice & slice : slices) {
+          std::memcpy(global + slice.offset * elementSize, next, slice.size * elementSize);
+          next += slice.size * elementSize;
+        }
+      }
+    }
+
+    MPI_Type_free(&elementType);
+  }
+
+  MPI_Win_sync(window);
+  MPI_Barrier(li.nodeComm);
+  MPI_Win_sync(window);
+  MPI_Win_unlock_all(window);
+}
+
+// -----------------------------------------------------------------------------
+
+NodeSharedBuffer::~NodeSharedBuffer() {
+  MPI_Win_free(&impl_->window);
+}
+
+// -----------------------------------------------------------------------------
+
+}  // namespace ufo
@@ -0,0 +1,150 @@
+/*
+ * (C) Crown copyright 2021, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef UFO_UTILS_NODESHAREDVECTOR_H_
+#define UFO_UTILS_NODESHAREDVECTOR_H_
+
+#include <cstddef>  // for size_t
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+
+namespace eckit {
+  namespace mpi {
+    class Comm;
+  }
+}
+
+namespace ufo {
+
+/// \brief Communicators used to gather arrays distributed over the processes of a communicator
+/// into memory shared by all processes running on the same (shared-memory) node.
+///
+/// The processes of the communicator are split into nodes with MPI_Comm_split_type. The process
+/// with the lowest rank on each node is its leader; only leaders take part in the exchange of
+/// data between nodes.
+///
+/// The constructor and destructor are collective operations over the communicator.
+class NodeSharedLayout : private boost::noncopyable {
+ public:
+  /// \brief Create the layout of arrays whose slice held by the calling process has
+  /// \p localSize elements.
+  ///
+  /// In gathered arrays, the slice held by process 0 comes first, followed by that held by
+  /// process 1 and so on.
+  ///
+  /// If \p fakeNodes is positive, each node is split further into fake nodes: the process with
+  /// rank r goes to fake node r % \p fakeNodes. This makes it possible to test the exchange
+  /// between node leaders on a single machine. \p fakeNodes at least equal to the number of
+  /// processes puts each process on its own node; smaller values interleave the processes of
+  /// different nodes.
+  NodeSharedLayout(const eckit::mpi::Comm & comm, size_t localSize, size_t fakeNodes = 0);
+  ~NodeSharedLayout();
+
+  /// Return the number of elements held by the calling process.
+  size_t localSize() const {return localSize_;}
+
+  /// Return the total number of elements held by all processes.
+  size_t globalSize() const {return globalSize_;}
+
+  /// Return the number of nodes the processes of the communicator are split into.
+  size_t numNodes() const {return numNodes_;}
+
+ private:
+  friend class NodeSharedBuffer;
+
+  /// MPI communicators and the slices exchanged by node leaders.
+  struct Impl;
+
+  size_t localSize_;
+  size_t localOffset_;
+  size_t globalSize_;
+  size_t numNodes_;
+  std::unique_ptr<Impl> impl_;
+};
+
+/// \brief Array gathered from all processes of a communicator into an MPI-3 shared-memory
+/// window allocated once per node.
+///
+/// The constructor and destructor are collective operations over the processes of each node,
+/// so buffers must be created and destroyed in the same order on all processes.
+class NodeSharedBuffer : private boost::noncopyable {
+ public:
+  /// \brief Gather the arrays of layout->localSize() elements of \p elementSize bytes each
+  /// pointed to by \p localData on all processes.
+  NodeSharedBuffer(std::shared_ptr<const NodeSharedLayout> layout, const void * localData,
+                   size_t elementSize);
+  ~NodeSharedBuffer();
+
+  /// Return a pointer to the first element of the gathered array.
+  const void * data() const {return data_;}
+
+ private:
+  /// The shared-memory window.
+  struct Impl;
+
+  std::shared_ptr<const NodeSharedLayout> layout_;
+  std::unique_ptr<Impl> impl_;
+  void * data_ = nullptr;
+};
+
+/// \brief Read-only array of values that may be stored in memory shared by all processes
+/// running on the same node.
+///
+/// Objects of this type either own an ordinary vector or refer to a NodeSharedBuffer. Copies
+/// share the same storage, which is released when the last copy is destroyed.
+template <typename T>
+class NodeSharedVector {
+  static_assert(std::is_trivially_copyable<T>::value,
+                "NodeSharedVector can only hold trivially copyable values");
+
+ public:
+  typedef T value_type;
+  typedef const T * const_iterator;
+
+  /// Create an empty vector.
+  NodeSharedVector() : data_(nullptr), size_(0) {}
+
+  /// Take ownership of \p values.
+  explicit NodeSharedVector(std::vector<T> values) {
+    auto storage = std::make_shared<const std::vector<T>>(std::move(values));
+    data_ = storage->data();
+    size_ = storage->size();
+    storage_ = std::move(storage);
+  }
+
+  /// \brief Gather the values \p localValues held by all processes into node-shared memory.
+  ///
+  /// This is a collective operation; \p localValues must have layout->localSize() elements.
+  NodeSharedVector(std::shared_ptr<const NodeSharedLayout> layout,
+                   const std::vector<T> & localValues) {
+    size_ = layout->globalSize();
+    auto storage = std::make_shared<const NodeSharedBuffer>(std::move(layout),
+                                                            localValues.data(), sizeof(T));
+    data_ = static_cast<const T *>(storage->data());
+    storage_ = std::move(storage);
+  }
+
+  size_t size() const {return size_;}
+  bool empty() const {return size_ == 0;}
+  const T & operator[](size_t i) const {return data_[i];}
+  const T * data() const {return data_;}
+  const_iterator begin() const {return data_;}
+  const_iterator end() const {return data_ + size_;}
+
+ private:
+  std::shared_ptr<const void> storage_;
+  const T * data_;
+  size_t size_;
+};
+
+}  // namespace ufo
+
+#endif  // UFO_UTILS_NODESHAREDVECTOR_H_
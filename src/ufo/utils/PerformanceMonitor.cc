@@ -0,0 +1,247 @@
+/*
+ * (C) Crown copyright 2021, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#include "ufo/utils/PerformanceMonitor.h"
+
+#include <sys/resource.h>
+
+#include <cstdlib>
+#include <fstream>
+#include <set>
+#include <sstream>
+#include <vector>
+
+#include "eckit/exception/Exceptions.h"
+#include "eckit/log/JSON.h"
+#include "eckit/mpi/Comm.h"
+#include "oops/util/Logger.h"
+
+namespace ufo {
+
+namespace {
+
+/// Return the peak resident set size of the current process (in bytes).
+int64_t peakMemory() {
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  // On Linux ru_maxrss is expressed in kilobytes.
+  return static_cast<int64_t>(usage.ru_maxrss) * 1024;
+}
+
+/// Return the result of reducing \p values element-wise over all ranks of \p comm with \p op.
+template <typename T>
+std::vector<T> reduce(const eckit::mpi::Comm & comm, const std::vector<T> & values,
+                      eckit::mpi::Operation::Code op) {
+  std::vector<T> result = values;
+  comm.allReduceInPlace(result.begin(), result.end(), op);
+  return result;
+}
+
+/// Write the minimum, maximum and mean over ranks of the \p index'th statistic as a JSON object.
+template <typename T>
+void writeStatistics(eckit::JSON & json, const char * name,
+                     const std::vector<T> & mins, const std::vector<T> & maxs,
+                     const std::vector<T> & sums, size_t index, size_t nranks) {
+  json << name;
+  json.startObject();
+  json << "min" << mins[index];
+  json << "max" << maxs[index];
+  json << "mean" << static_cast<double>(sums[index]) / nranks;
+  json.endObject();
+}
+
+}  // namespace
+
+// -----------------------------------------------------------------------------
+
+PerformanceMonitor & PerformanceMonitor::instance() {
+  static PerformanceMonitor monitor;
+  return monitor;
+}
+
+// -----------------------------------------------------------------------------
+
+PerformanceMonitor::PerformanceMonitor() {
+  const char * env = std::getenv("UFO_PERFORMANCE_MONITOR");
+  enabled_ = env != nullptr && *env != '\0' && std::string(env) != "0";
+  automaticReports_ = true;
+}
+
+// -----------------------------------------------------------------------------
+
+void PerformanceMonitor::record(const std::string & name, double wallTime, size_t nlocs,
+                                int64_t memoryGrowth) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  PerformanceRecord & record = records_[name];
+  ++record.calls;
+  record.wallTime += wallTime;
+  record.nlocs += nlocs;
+  record.memoryGrowth += memoryGrowth;
+}
+
+// -----------------------------------------------------------------------------
+
+std::map<std::string, PerformanceRecord> PerformanceMonitor::records() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return records_;
+}
+
+// -----------------------------------------------------------------------------
+
+void PerformanceMonitor::reset() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  records_.clear();
+}
+
+// -----------------------------------------------------------------------------
+
+void PerformanceMonitor::reset(const std::string & prefix) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = records_.lower_bound(prefix);
+  while (it != records_.end() && it->first.compare(0, prefix.size(), prefix) == 0)
+    it = records_.erase(it);
+}
+
+// -----------------------------------------------------------------------------
+
+void PerformanceMonitor::report(const eckit::mpi::Comm & comm, std::ostream & os,
+                                const std::string & prefix) const {
+  const std::map<std::string, PerformanceRecord> localRecords = records();
+
+  // Different ranks may have entered different scopes, so first form the union of all names.
+  std::string localNames;
+  for (const auto & nameAndRecord : localRecords)
+    if (nameAndRecord.first.compare(0, prefix.size(), prefix) == 0)
+      localNames += nameAndRecord.first + '\n';
+  eckit::mpi::Buffer<char> buffer(comm.size());
+  comm.allGatherv(localNames.begin(), localNames.end(), buffer);
+  std::set<std::string> names;
+  {
+    std::istringstream allNames(std::string(buffer.buffer.begin(), buffer.buffer.end()));
+    std::string name;
+    while (std::getline(allNames, name))
+      names.insert(name);
+  }
+
+  const size_t nnames = names.size();
+  std::vector<int64_t> calls(nnames, 0), nlocs(nnames, 0), memory(nnames, 0);
+  std::vector<double> wallTime(nnames, 0.0);
+  size_t i = 0;
+  for (const std::string & name : names) {
+    const auto it = localRecords.find(name);
+    if (it != localRecords.end()) {
+      calls[i] = it->second.calls;
+      wallTime[i] = it->second.wallTime;
+      nlocs[i] = it->second.nlocs;
+      memory[i] = it->second.memoryGrowth;
+    }
+    ++i;
+  }
+
+  const std::vector<int64_t> minCalls = reduce(comm, calls, eckit::mpi::min()),
+                             maxCalls = reduce(comm, calls, eckit::mpi::max()),
+                             sumCalls = reduce(comm, calls, eckit::mpi::sum()),
+                             minNlocs = reduce(comm, nlocs, eckit::mpi::min()),
+                             maxNlocs = reduce(comm, nlocs, eckit::mpi::max()),
+                             sumNlocs = reduce(comm, nlocs, eckit::mpi::sum()),
+                             minMemory = reduce(comm, memory, eckit::mpi::min()),
+                             maxMemory = reduce(comm, memory, eckit::mpi::max()),
+                             sumMemory = reduce(comm, memory, eckit::mpi::sum());
+  const std::vector<double> minWallTime = reduce(comm, wallTime, eckit::mpi::min()),
+                            maxWallTime = reduce(comm, wallTime, eckit::mpi::max()),
+                            sumWallTime = reduce(comm, wallTime, eckit::mpi::sum());
+
+  if (comm.rank() != 0)
+    return;
+
+  const size_t nranks = comm.size();
+  eckit::JSON json(os);
+  json.startObject();
+  json << "ranks" << nranks;
+  json << "scopes";
+  json.startObject();
+  i = 0;
+  for (const std::string & name : names) {
+    json << name;
+    json.startObject();
+    writeStatistics(json, "calls", minCalls, maxCalls, sumCalls, i, nranks);
+    writeStatistics(json, "wall time (s)", minWallTime, maxWallTime, sumWallTime, i, nranks);
+    writeStatistics(json, "nlocs", minNlocs, maxNlocs, sumNlocs, i, nranks);
+    writeStatistics(json, "memory growth (bytes)", minMemory, maxMemory, sumMemory, i, nranks);
+    json << "total nlocs" << sumNlocs[i];
+    json.endObject();
+    ++i;
+  }
+  json.endObject();
+  json.endObject();
+  os << std::endl;
+}
+
+// -----------------------------------------------------------------------------
+
+void PerformanceMonitor::reportAndReset(const eckit::mpi::Comm & comm,
+                                        const std::string & prefix) {
+  if (!enabled_ || !automaticReports_)
+    return;
+
+  std::stringstream os;
+  report(comm, os, prefix);
+  reset(prefix);
+  if (comm.rank() != 0)
+    return;
+
+  const char * filename = std::getenv("UFO_PERFORMANCE_REPORT");
+  if (filename == nullptr || *filename == '\0') {
+    oops::Log::info() << "PerformanceMonitor: " << os.str();
+    return;
+  }
+  std::ofstream file(filename, std::ios::app);
+  if (!file)
+    throw eckit::CantOpenFile(filename, Here());
+  file << os.str();
+}
+
+// -----------------------------------------------------------------------------
+
+ScopedPerformanceMonitor::ScopedPerformanceMonitor(const std::string & name, size_t nlocs)
+  : active_(PerformanceMonitor::instance().enabled())
+{
+  if (!active_)
+    return;
+  name_ = name;
+  nlocs_ = nlocs;
+  startPeakMemory_ = peakMemory();
+  start_ = std::chrono::steady_clock::now();
+}
+
+// -----------------------------------------------------------------------------
+
+ScopedPerformanceMonitor::ScopedPerformanceMonitor(const std::string & prefix, const char * name,
+                                                   size_t nlocs)
+  : active_(PerformanceMonitor::instance().enabled())
+{
+  if (!active_)
+    return;
+  name_ = prefix + name;
+  nlocs_ = nlocs;
+  startPeakMemory_ = peakMemory();
+  start_ = std::chrono::steady_clock::now();
+}
+
+// -----------------------------------------------------------------------------
+
+ScopedPerformanceMonitor::~ScopedPerformanceMonitor() {
+  if (!active_)
+    return;
+  const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start_;
+  PerformanceMonitor::instance().record(name_, elapsed.count(), nlocs_,
+                                        peakMemory() - startPeakMemory_);
+}
+
+// -----------------------------------------------------------------------------
+
+}  // namespace ufo
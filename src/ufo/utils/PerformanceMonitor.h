@@ -0,0 +1,147 @@
+/*
+ * (C) Crown copyright 2021, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef UFO_UTILS_PERFORMANCEMONITOR_H_
+#define UFO_UTILS_PERFORMANCEMONITOR_H_
+
+#include <atomic>
+#include <chrono>  // NOLINT(build/c++11)
+#include <cstddef>  // for size_t
+#include <cstdint>
+#include <map>
+#include <mutex>  // NOLINT(build/c++11)
+#include <ostream>
+#include <string>
+
+#include <boost/noncopyable.hpp>
+
+namespace eckit {
+  namespace mpi {
+    class Comm;
+  }
+}
+
+namespace ufo {
+
+/// \brief Cost of all calls to an instrumented scope made on the current process.
+struct PerformanceRecord {
+  /// Number of times the scope has been entered.
+  size_t calls = 0;
+  /// Total wall-clock time spent in the scope (in seconds).
+  double wallTime = 0.0;
+  /// Total number of locations processed by the scope.
+  size_t nlocs = 0;
+  /// Total growth of the peak resident set size of the process during calls to the scope
+  /// (in bytes). This is an upper bound of the memory allocated and still in use at the point
+  /// where the peak was reached.
+  int64_t memoryGrowth = 0;
+};
+
+/// \brief Process-wide registry of the costs of instrumented scopes (observation operators,
+/// filters, ObsFunctions etc.).
+///
+/// Scopes are instrumented by creating a ScopedPerformanceMonitor object at their start.
+/// Instrumentation is disabled by default and can be switched on either by setting the
+/// `UFO_PERFORMANCE_MONITOR` environment variable to a non-empty value other than 0 or by calling
+/// setEnabled(true). While disabled, instrumented scopes only pay the cost of one branch (and of
+/// building the key, unless it is passed to ScopedPerformanceMonitor in two parts).
+///
+/// Records are keyed by strings of the form `<obs space>/<component>/<phase>`, e.g.
+/// `Radiosonde/VertInterp/simulateObs` or `AMSUA/Bounds Check/applyFilter`. Call report() to
+/// aggregate the records over all ranks of an MPI communicator and write them out in JSON format.
+///
+/// In applications such as HofX and Variational the records are reported automatically: when the
+/// filter chain (QCmanager) of an observation space is destroyed, the records of that
+/// observation space are reported and discarded, and so are the records of a linear observation
+/// operator when it is destroyed (linear operators typically outlive the filters). Reports are
+/// written to the info log or, if the `UFO_PERFORMANCE_REPORT` environment variable is set,
+/// appended to the file it names, one JSON object per line. Applications calling report()
+/// themselves (such as ufo_benchmark.x) switch automatic reports off with
+/// setAutomaticReports(false).
+///
+/// All member functions are thread-safe.
+class PerformanceMonitor : private boost::noncopyable {
+ public:
+  static PerformanceMonitor & instance();
+
+  bool enabled() const { return enabled_; }
+  void setEnabled(bool enabled) { enabled_ = enabled; }
+
+  /// Add the cost of a single call to the scope \p name.
+  void record(const std::string & name, double wallTime, size_t nlocs, int64_t memoryGrowth);
+
+  /// Return a copy of the records collected on the current process.
+  std::map<std::string, PerformanceRecord> records() const;
+
+  /// Discard all records.
+  void reset();
+  /// Discard the records of the scopes whose names start with \p prefix.
+  void reset(const std::string & prefix);
+
+  /// \brief Write the records of all ranks of \p comm to \p os in JSON format.
+  ///
+  /// This is a collective operation; only rank 0 writes to \p os. For each scope recorded on any
+  /// rank whose name starts with \p prefix, the minimum, maximum and mean over ranks of the number
+  /// of calls, wall-clock time, number of locations and memory growth are reported. Ranks that
+  /// haven't entered a scope contribute zeros.
+  void report(const eckit::mpi::Comm & comm, std::ostream & os,
+              const std::string & prefix = "") const;
+
+  bool automaticReports() const { return automaticReports_; }
+  void setAutomaticReports(bool automaticReports) { automaticReports_ = automaticReports; }
+
+  /// \brief Report and discard the records of the scopes whose names start with \p prefix, if
+  /// the monitor is enabled and automatic reports are on.
+  ///
+  /// This is a collective operation on \p comm, meant to be called when the component owning
+  /// these scopes is destroyed. The report is written to the info log or appended to the file
+  /// named by the `UFO_PERFORMANCE_REPORT` environment variable.
+  void reportAndReset(const eckit::mpi::Comm & comm, const std::string & prefix);
+
+ private:
+  PerformanceMonitor();
+
+  std::atomic<bool> enabled_;
+  std::atomic<bool> automaticReports_;
+  mutable std::mutex mutex_;
+  std::map<std::string, PerformanceRecord> records_;
+};
+
+/// \brief Records the wall-clock time and memory growth between its construction and destruction
+/// in the PerformanceMonitor.
+///
+/// Example:
+/// \code
+/// void MyFilter::applyFilter(...) const {
+///   ScopedPerformanceMonitor monitor(obsdb_.obsname() + "/MyFilter/applyFilter", obsdb_.nlocs());
+///   ...
+/// }
+/// \endcode
+///
+/// Does nothing if the PerformanceMonitor is disabled. In code run often, prefer the constructor
+/// taking the key in two parts, which are only concatenated if the PerformanceMonitor is enabled.
+class ScopedPerformanceMonitor : private boost::noncopyable {
+ public:
+  /// \param name Key under which the cost will be recorded.
+  /// \param nlocs Number of locations processed in this call.
+  ScopedPerformanceMonitor(const std::string & name, size_t nlocs);
+  /// \param prefix, name The cost will be recorded under the key \p prefix + \p name.
+  /// \param nlocs Number of locations processed in this call.
+  ScopedPerformanceMonitor(const std::string & prefix, const char * name, size_t nlocs);
+  ~ScopedPerformanceMonitor();
+
+ private:
+  bool active_;
+  std::string name_;
+  size_t nlocs_ = 0;
+  std::chrono::steady_clock::time_point start_;
+  int64_t startPeakMemory_ = 0;
+};
+
+}  // namespace ufo
+
+#endif  // UFO_UTILS_PERFORMANCEMONITOR_H_
@@ -8,13 +8,149 @@
 #include "ufo/utils/RecursiveSplitter.h"
 
 #include <algorithm>
+#include <cstdint>
+#include <future>  // NOLINT(build/c++11)
 #include <numeric>
+#include <thread>  // NOLINT(build/c++11)
+#include <unordered_map>
+#include <utility>
 
 #include "oops/util/Random.h"
 
 namespace ufo
 {
 
+namespace {
+
+/// Groups with at least this many elements are sorted by tasks run concurrently.
+const size_t minParallelGroupSize = 1 << 15;
+/// Groups with at most this many elements are sorted by insertion.
+const size_t maxInsertionSortSize = 32;
+
+/// Scratch arrays used to sort groups.
+struct SortWorkspace {
+  std::vector<size_t> ids;
+  std::vector<size_t> keys;
+  std::vector<size_t> counts;
+};
+
+/// \brief Set \p codes[i] to the rank of \p categories[i] among the distinct elements of
+/// \p categories.
+///
+/// Categories are first numbered in the order of their first occurrence using a hash table,
+/// so that only the distinct categories need to be sorted.
+template <typename T>
+void encodeByHashing(const std::vector<T> &categories, std::vector<size_t> &codes) {
+  std::unordered_map<T, size_t> provisionalCodes;
+  for (size_t id = 0; id < categories.size(); ++id)
+    codes[id] = provisionalCodes.emplace(categories[id], provisionalCodes.size()).first->second;
+
+  std::vector<const T*> distinctCategories(provisionalCodes.size());
+  for (const auto &categoryAndCode : provisionalCodes)
+    distinctCategories[categoryAndCode.second] = &categoryAndCode.first;
+  std::vector<size_t> order(distinctCategories.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(), [&distinctCategories](size_t a, size_t b)
+            { return *distinctCategories[a] < *distinctCategories[b]; });
+  std::vector<size_t> rank(order.size());
+  for (size_t r = 0; r < order.size(); ++r)
+    rank[order[r]] = r;
+
+  for (size_t &code : codes)
+    code = rank[code];
+}
+
+/// \brief Set \p codes[i] to a number increasing with \p categories[i], equal for equal
+/// categories and no larger than a small multiple of the size of \p categories.
+template <typename T>
+void encodeIntegers(const std::vector<T> &categories, std::vector<size_t> &codes) {
+  if (categories.empty())
+    return;
+  const auto minmax = std::minmax_element(categories.begin(), categories.end());
+  const T min = *minmax.first;
+  // Unsigned arithmetic gives the right range even if max - min overflows T.
+  const uint64_t range = static_cast<uint64_t>(*minmax.second) - static_cast<uint64_t>(min);
+  if (range < 2 * categories.size() + 256) {
+    // The categories are dense enough to be used directly.
+    for (size_t id = 0; id < categories.size(); ++id)
+      codes[id] = static_cast<uint64_t>(categories[id]) - static_cast<uint64_t>(min);
+  } else {
+    encodeByHashing(categories, codes);
+  }
+}
+
+void encode(const std::vector<int> &categories, std::vector<size_t> &codes) {
+  encodeIntegers(categories, codes);
+}
+
+void encode(const std::vector<size_t> &categories, std::vector<size_t> &codes) {
+  encodeIntegers(categories, codes);
+}
+
+void encode(const std::vector<std::string> &categories, std::vector<size_t> &codes) {
+  encodeByHashing(categories, codes);
+}
+
+/// \brief Stably sort the \p n elements of \p ids in ascending order of the elements of \p keys
+/// stored at the same positions, reordering \p keys in the same way.
+void stableSortByKey(size_t *ids, size_t *keys, size_t n, SortWorkspace &workspace) {
+  if (n <= maxInsertionSortSize) {
+    for (size_t i = 1; i < n; ++i) {
+      const size_t id = ids[i], key = keys[i];
+      size_t j = i;
+      for (; j > 0 && keys[j - 1] > key; --j) {
+        ids[j] = ids[j - 1];
+        keys[j] = keys[j - 1];
+      }
+      ids[j] = id;
+      keys[j] = key;
+    }
+    return;
+  }
+
+  const auto minmax = std::minmax_element(keys, keys + n);
+  const size_t minKey = *minmax.first;
+  const size_t range = *minmax.second - minKey;
+  if (range == 0)
+    return;
+
+  workspace.ids.resize(n);
+  workspace.keys.resize(n);
+  size_t *srcIds = ids, *srcKeys = keys;
+  size_t *dstIds = workspace.ids.data(), *dstKeys = workspace.keys.data();
+  std::vector<size_t> &counts = workspace.counts;
+
+  // A single counting sort pass if there are no more distinct keys than elements, otherwise
+  // a least-significant-digit radix sort on bytes of the key offsets.
+  const bool singlePass = range < n;
+  const size_t numBuckets = singlePass ? range + 1 : 256;
+  const size_t digitMask = singlePass ? ~size_t(0) : 255;
+  const int digitBits = singlePass ? 0 : 8;
+  int shift = 0;
+  do {
+    counts.assign(numBuckets + 1, 0);
+    for (size_t i = 0; i < n; ++i)
+      ++counts[(((srcKeys[i] - minKey) >> shift) & digitMask) + 1];
+    std::partial_sum(counts.begin(), counts.end(), counts.begin());
+    for (size_t i = 0; i < n; ++i) {
+      const size_t pos = counts[((srcKeys[i] - minKey) >> shift) & digitMask]++;
+      dstIds[pos] = srcIds[i];
+      dstKeys[pos] = srcKeys[i];
+    }
+    std::swap(srcIds, dstIds);
+    std::swap(srcKeys, dstKeys);
+    shift += digitBits;
+  } while (!singlePass && shift < 64 && (range >> shift) != 0);
+
+  if (srcIds != ids) {
+    std::copy(srcIds, srcIds + n, ids);
+    std::copy(srcKeys, srcKeys + n, keys);
+  }
+}
+
+}  // namespace
+
+
 RecursiveSplitter::RecursiveSplitter(size_t numIds) {
   orderedIds_.resize(numIds);
   std::iota(orderedIds_.begin(), orderedIds_.end(), 0);
@@ -35,29 +171,66 @@ void RecursiveSplitter::initializeEncodedGroups() {
 
 template <typename T>
 void RecursiveSplitter::groupByImpl(const std::vector<T> &categories) {
-  auto orderedCategory = [&](size_t index) { return categories[orderedIds_[index]]; };
+  std::vector<size_t> codes(categories.size());
+  encode(categories, codes);
+  groupByCodes(codes);
+}
+
+void RecursiveSplitter::groupByCodes(const std::vector<size_t> &codes) {
+  const size_t numIds = orderedIds_.size();
+
+  // Find the existing multi-element groups (as ranges [first, last] of indices).
+  std::vector<std::pair<size_t, size_t>> groups;
+  for (size_t index = encodedGroups_.empty() ? 0 : encodedGroups_[0];
+       index + 1 < numIds; ) {
+    const size_t lastIndexInGroup = encodedGroups_[index + 1];
+    groups.emplace_back(index, lastIndexInGroup);
+    index = lastIndexInGroup + 1 < numIds ? encodedGroups_[lastIndexInGroup + 1] : numIds;
+  }
+
+  // Codes of the categories of the elements in the order in which they're stored in orderedIds_.
+  std::vector<size_t> orderedCodes(numIds);
+  for (const std::pair<size_t, size_t> &group : groups)
+    for (size_t index = group.first; index <= group.second; ++index)
+      orderedCodes[index] = codes[orderedIds_[index]];
+
+  auto sortGroup = [this, &orderedCodes](const std::pair<size_t, size_t> &group,
+                                         SortWorkspace &workspace) {
+    stableSortByKey(&orderedIds_[group.first], &orderedCodes[group.first],
+                    group.second - group.first + 1, workspace);
+  };
+
+  // Large groups are shared among concurrent tasks; the others are sorted by this thread.
+  std::vector<const std::pair<size_t, size_t>*> largeGroups;
+  for (const std::pair<size_t, size_t> &group : groups)
+    if (group.second - group.first + 1 >= minParallelGroupSize)
+      largeGroups.push_back(&group);
+  const size_t numTasks = largeGroups.size() < 2 ? 0 :
+      std::min<size_t>(largeGroups.size(), std::max(1u, std::thread::hardware_concurrency()));
+  std::vector<std::future<void>> tasks;
+  for (size_t task = 0; task < numTasks; ++task)
+    tasks.push_back(std::async(std::launch::async, [&, task] {
+      SortWorkspace workspace;
+      for (size_t i = task; i < largeGroups.size(); i += numTasks)
+        sortGroup(*largeGroups[i], workspace);
+    }));
+  SortWorkspace workspace;
+  for (const std::pair<size_t, size_t> &group : groups)
+    if (numTasks == 0 || group.second - group.first + 1 < minParallelGroupSize)
+      sortGroup(group, workspace);
+  for (std::future<void> &task : tasks)
+    task.get();
 
-  const auto numIds = orderedIds_.size();
-  ptrdiff_t lastIndexInGroup = -1;
+  // Now update the groups
   ptrdiff_t lastIndexInLastGroup = -1;
-  while (lastIndexInGroup + 1 < numIds) {
-    const size_t firstIndexInGroup = encodedGroups_[lastIndexInGroup + 1];
-    if (firstIndexInGroup + 1 >= numIds)
-      break;
-    lastIndexInGroup = encodedGroups_[firstIndexInGroup + 1];
-
-    std::stable_sort(orderedIds_.begin() + firstIndexInGroup,
-                     orderedIds_.begin() + lastIndexInGroup + 1,
-                     [&categories](size_t idA, size_t idB)
-                     { return categories[idA] < categories[idB];});
-
-    // Now update the group
+  for (const std::pair<size_t, size_t> &group : groups) {
+    const size_t firstIndexInGroup = group.first, lastIndexInGroup = group.second;
     size_t newFirstIndex = firstIndexInGroup;
     for (size_t newLastIndex = firstIndexInGroup;
          newLastIndex <= lastIndexInGroup;
          ++newLastIndex) {
       if (newLastIndex != lastIndexInGroup &&
-          orderedCategory(newLastIndex) == orderedCategory(newLastIndex + 1))
+          orderedCodes[newLastIndex] == orderedCodes[newLastIndex + 1])
           continue;
 
       if (newLastIndex > newFirstIndex) {
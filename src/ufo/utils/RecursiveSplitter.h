@@ -59,6 +59,11 @@ namespace ufo {
 ///
 /// \internal In the implementation, indices into the partitioned array are referred to as _ids_.
 /// The term _index_ denotes an index into the vector \c orderedIds_.
+///
+/// Before splitting the equivalence classes, groupBy() replaces each category by an integer code
+/// (its rank among distinct categories, or its offset from the smallest category if the integer
+/// categories are densely packed). Hence strings are compared only while the distinct categories
+/// are sorted.
 class RecursiveSplitter
 {
  public:
@@ -318,6 +323,13 @@ class RecursiveSplitter
   template <typename T>
   void groupByImpl(const std::vector<T> &categories);
 
+  /// \brief Split existing equivalence classes according to the categories \p codes, which
+  /// must increase with the original categories.
+  ///
+  /// Each multi-element class is sorted by a stable counting or radix sort; large classes are
+  /// sorted concurrently.
+  void groupByCodes(const std::vector<size_t> &codes);
+
   /// Indices of elements of the partitioned array ordered by equivalence class.
   std::vector<size_t> orderedIds_;
   /// Encoded locations of multi-element equivalence classes in orderedIds_.
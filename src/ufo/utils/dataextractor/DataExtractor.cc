@@ -61,6 +61,69 @@ class SortVisitor : public boost::static_visitor<void> {
 
 namespace ufo {
 
+/// \brief Boost visitor marking the indices at which the value of a coordinate changes.
+class ValueChangeVisitor : public boost::static_visitor<void> {
+ public:
+  explicit ValueChangeVisitor(std::vector<bool> &changes) : changes(changes) {}
+
+  template <typename T>
+  void operator()(const std::vector<T> &coord) {
+    for (size_t i = 1; i < coord.size(); ++i)
+      if (coord[i] != coord[i - 1])
+        changes[i] = true;
+  }
+
+  std::vector<bool> &changes;
+};
+
+
+/// \brief Boost visitor finding the ranges over which a coordinate is increasing and equispaced
+/// among ranges starting at the indices flagged in rangeStarts.
+class EquispacedRangesVisitor : public boost::static_visitor<void> {
+ public:
+  EquispacedRangesVisitor(const std::vector<bool> &rangeStarts,
+                          DataExtractor::EquispacedRanges &ranges)
+    : rangeStarts(rangeStarts), ranges(ranges) {}
+
+  template <typename T>
+  void operator()(const std::vector<T> &coord) {
+    size_t begin = 0;
+    while (begin < coord.size()) {
+      size_t end = begin + 1;
+      while (end < coord.size() && !rangeStarts[end])
+        ++end;
+      addIfEquispaced(coord, begin, end);
+      begin = end;
+    }
+  }
+
+  void operator()(const std::vector<std::string> &) {}
+
+ private:
+  template <typename T>
+  void addIfEquispaced(const std::vector<T> &coord, size_t begin, size_t end) {
+    // Ranges of one or two values are searched quickly enough.
+    if (end - begin < 3)
+      return;
+    const double first = coord[begin];
+    const double step = (static_cast<double>(coord[end - 1]) - first) / (end - 1 - begin);
+    if (!(step > 0))
+      return;
+    for (size_t i = begin + 1; i < end; ++i) {
+      // The spacing needs to be regular only up to a small fraction of the step: DataExtractor
+      // corrects the index computed from it. The values must be strictly increasing, though.
+      if (!(coord[i] > coord[i - 1]) ||
+          std::abs(coord[i] - (first + (i - begin) * step)) > 0.01 * step)
+        return;
+    }
+    ranges[static_cast<int>(begin)] = DataExtractor::EquispacedRange{static_cast<int>(end), step};
+  }
+
+  const std::vector<bool> &rangeStarts;
+  DataExtractor::EquispacedRanges &ranges;
+};
+
+
 DataExtractor::DataExtractor(const std::string &filepath, const std::string &group) {
   // Read the data from the file
   load(filepath, group);
@@ -141,6 +204,36 @@ void DataExtractor::sort() {
                                "it has more than 2 dimensions.", Here());
     }
   }
+
+  findEquispacedRanges();
+}
+
+
+void DataExtractor::findEquispacedRanges() {
+  for (auto coord = coordsToExtractBy_.begin(); coord != coordsToExtractBy_.end(); ++coord) {
+    coord->equispacedRanges.clear();
+    if (coord->method == InterpMethod::EXACT)
+      continue;
+
+    // Find the ranges within which the preceding coordinates indexing the same dimension are
+    // constant.
+    const size_t size = coord->payloadDim == 0 ? interpolatedArray2D_.rows() :
+                                                 interpolatedArray2D_.cols();
+    std::vector<bool> rangeStarts(size, false);
+    if (size > 0)
+      rangeStarts[0] = true;
+    for (auto prevCoord = coordsToExtractBy_.begin(); prevCoord != coord; ++prevCoord) {
+      if (prevCoord->payloadDim == coord->payloadDim) {
+        ValueChangeVisitor visitor(rangeStarts);
+        boost::apply_visitor(visitor, prevCoord->values);
+      }
+    }
+
+    EquispacedRangesVisitor visitor(rangeStarts, coord->equispacedRanges);
+    boost::apply_visitor(visitor, coord->values);
+    oops::Log::debug() << "Coordinate " << coord->name << " is equispaced over "
+                       << coord->equispacedRanges.size() << " range(s)" << std::endl;
+  }
 }
 
 
@@ -155,7 +248,7 @@ void DataExtractor::scheduleSort(const std::string &varName, const InterpMethod
   boost::apply_visitor(visitor, coordVal);
 
   // Update our map between coordinate (variable) and interpolation/extract method
-  coordsToExtractBy_.emplace_back(Coordinate{varName, coordVal, method, dimIndex});
+  coordsToExtractBy_.emplace_back(Coordinate{varName, coordVal, method, dimIndex, {}});
 }
 
 
@@ -9,6 +9,7 @@
 #define UFO_UTILS_DATAEXTRACTOR_DATAEXTRACTOR_H_
 
 #include <algorithm>           // sort
+#include <cmath>               // ceil
 #include <functional>          // greater
 #include <limits>              // std::numeric_limits
 #include <list>                // list
@@ -227,9 +228,7 @@ class DataExtractor
                              Here());
     }
     // Find first index of varValues >= obVal
-    int nnIndex = std::lower_bound(varValues.begin() + range.begin,
-                                     varValues.begin() + range.end,
-                                     obVal) - varValues.begin();
+    int nnIndex = lowerBound(varValues, range, obVal);
 
     // Determine upper or lower indices from this
     if (varValues[nnIndex] == obVal) {
@@ -302,9 +301,7 @@ class DataExtractor
     Range &range = constrainedRanges_[static_cast<size_t>(dimIndex)];
 
     // Find first index of varValues >= obVal
-    int nnIndex = std::lower_bound(varValues.begin() + range.begin,
-                                   varValues.begin() + range.end,
-                                   obVal) - varValues.begin();
+    int nnIndex = lowerBound(varValues, range, obVal);
     if (nnIndex >= range.end) {
       nnIndex = range.end - 1;
     }
@@ -317,11 +314,7 @@ class DataExtractor
       nnIndex--;
 
     // Now find **same value** equidistant neighbours
-    auto bounds = std::equal_range(varValues.begin() + range.begin,
-                                   varValues.begin() + range.end,
-                                   varValues[nnIndex]);
-    range = {static_cast<int>(bounds.first - varValues.begin()),
-             static_cast<int>(bounds.second - varValues.begin())};
+    range = sameValueRange(varValues, range, nnIndex);
     oops::Log::debug() << "Nearest match; name: " << varName << " range: " <<
       range.begin << "," << range.end << std::endl;
   }
@@ -384,12 +377,8 @@ class DataExtractor
     Range &range = constrainedRanges_[static_cast<size_t>(dimIndex)];
 
     // Find index of the first varValues >= obVal
-    typedef typename std::vector<T>::const_iterator It;
-    const It rangeBegin(varValues.begin() + range.begin);
-    const It rangeEnd(varValues.begin() + range.end);
-
-    const It leastUpperBoundIt = std::lower_bound(rangeBegin, rangeEnd, obVal);
-    if (leastUpperBoundIt == rangeEnd) {
+    const int leastUpperBoundIndex = lowerBound(varValues, range, obVal);
+    if (leastUpperBoundIndex == range.end) {
       std::stringstream msg;
       msg << "No match found for 'least upper bound' extraction of value '" << obVal
           << "' of the variable '" << varName << "'";
@@ -397,9 +386,7 @@ class DataExtractor
     }
 
     // Find the range of items with the same value of this coordinate
-    const auto bounds = std::equal_range(rangeBegin, rangeEnd, *leastUpperBoundIt);
-    range = {static_cast<int>(bounds.first - varValues.begin()),
-             static_cast<int>(bounds.second - varValues.begin())};
+    range = sameValueRange(varValues, range, leastUpperBoundIndex);
     oops::Log::debug() << "Least upper bound match; name: " << varName << " range: "
                        << range.begin << "," << range.end << std::endl;
   }
@@ -424,15 +411,10 @@ class DataExtractor
     Range &range = constrainedRanges_[static_cast<size_t>(dimIndex)];
 
     // Find index of the last varValues <= obVal
-
-    typedef typename std::vector<T>::const_reverse_iterator ReverseIt;
-    typedef std::greater<T> Compare;
-    const ReverseIt reverseRangeBegin(varValues.begin() + range.end);
-    const ReverseIt reverseRangeEnd(varValues.begin() + range.begin);
-
-    const ReverseIt greatestLowerBoundIt =
-        std::lower_bound(reverseRangeBegin, reverseRangeEnd, obVal, Compare());
-    if (greatestLowerBoundIt == reverseRangeEnd) {
+    int greatestLowerBoundIndex = lowerBound(varValues, range, obVal);
+    if (greatestLowerBoundIndex == range.end || varValues[greatestLowerBoundIndex] != obVal)
+      --greatestLowerBoundIndex;
+    if (greatestLowerBoundIndex < range.begin) {
       std::stringstream msg;
       msg << "No match found for 'greatest lower bound' extraction of value '" << obVal
           << "' of the variable '" << varName << "'";
@@ -440,11 +422,7 @@ class DataExtractor
     }
 
     // Find the range of items with the same value of this coordinate
-    const auto bounds = std::equal_range(varValues.begin() + range.begin,
-                                         varValues.begin() + range.end,
-                                         *greatestLowerBoundIt);
-    range = {static_cast<int>(bounds.first - varValues.begin()),
-             static_cast<int>(bounds.second - varValues.begin())};
+    range = sameValueRange(varValues, range, greatestLowerBoundIndex);
     oops::Log::debug() << "Greatest lower bound match; name: " << varName << " range: "
                        << range.begin << "," << range.end << std::endl;
   }
@@ -477,6 +455,14 @@ class DataExtractor
     }
   }
 
+  /// \brief Find the index ranges over which the coordinates used for extraction are increasing
+  /// and equispaced.
+  /// \details Called by sort(). Such ranges are searched within each range over which the
+  /// coordinates preceding a coordinate in the extraction order and indexing the same dimension of
+  /// the payload array are constant, since these are the ranges within which that coordinate is
+  /// searched by extract().
+  void findEquispacedRanges();
+
   /// \brief Load all data from the input file.
   void load(const std::string &filepath, const std::string &interpolatedArrayGroup);
 
@@ -487,6 +473,16 @@ class DataExtractor
   struct Range {int begin, end;};
   std::array<Range, 2> constrainedRanges_;
 
+  /// Range of indices of a coordinate array over which its values are increasing and equispaced.
+  /// The first index of the range is the key under which it is stored.
+  struct EquispacedRange {
+    /// Index following the last index of the range
+    int end;
+    /// Difference between consecutive values
+    double step;
+  };
+  typedef std::unordered_map<int, EquispacedRange> EquispacedRanges;
+
   // Container holding coordinate arrays (of all supported types) loaded from the input file.
   typedef boost::variant<std::vector<int>,
                          std::vector<float>,
@@ -514,11 +510,71 @@ class DataExtractor
     InterpMethod method;
     /// Axis of the payload array indexed by the coordinate (0 or 1)
     int payloadDim;
+    /// Ranges of indices over which the coordinate values are increasing and equispaced, keyed
+    /// by their first index. Filled by sort().
+    EquispacedRanges equispacedRanges;
   };
 
   /// Coordinates to use in successive calls to extract().
   std::vector<Coordinate> coordsToExtractBy_;
   std::vector<Coordinate>::const_iterator nextCoordToExtractBy_;
+
+  /// \brief Return the equispaced range of the coordinate currently used for extraction that
+  /// matches \p range, or nullptr if there is none.
+  const EquispacedRange *findEquispacedRange(const Range &range) const {
+    const EquispacedRanges &ranges = nextCoordToExtractBy_->equispacedRanges;
+    const auto it = ranges.find(range.begin);
+    if (it == ranges.end() || it->second.end != range.end)
+      return nullptr;
+    return &it->second;
+  }
+
+  /// \brief Return the index of the first element of \p varValues in \p range that is not less
+  /// than \p obVal, as std::lower_bound would.
+  /// \details If the values of the coordinate currently used for extraction are equispaced over
+  /// \p range, the index is computed directly instead of being searched for.
+  template<typename T>
+  int lowerBound(const std::vector<T> &varValues, const Range &range, const T &obVal) const {
+    const EquispacedRange *equispaced = findEquispacedRange(range);
+    if (equispaced == nullptr)
+      return std::lower_bound(varValues.begin() + range.begin,
+                              varValues.begin() + range.end,
+                              obVal) - varValues.begin();
+
+    if (!(obVal > varValues[range.begin]))
+      return range.begin;
+    if (obVal > varValues[range.end - 1])
+      return range.end;
+    // varValues[range.begin] < obVal <= varValues[range.end - 1]: estimate the offset of the
+    // result from range.begin and correct it for rounding errors and deviations from equal spacing.
+    const double offset = std::ceil((static_cast<double>(obVal) -
+                                     static_cast<double>(varValues[range.begin])) /
+                                    equispaced->step);
+    int index = range.begin + static_cast<int>(std::min(std::max(offset, 1.0),
+                                                        static_cast<double>(range.end - 1 -
+                                                                            range.begin)));
+    while (!(varValues[index - 1] < obVal))
+      --index;
+    while (varValues[index] < obVal)
+      ++index;
+    return index;
+  }
+
+  /// \brief Return the range of indices within \p range of the elements of \p varValues equal
+  /// to varValues[index].
+  template<typename T>
+  Range sameValueRange(const std::vector<T> &varValues, const Range &range, int index) const {
+    // Equispaced values are strictly increasing.
+    if (findEquispacedRange(range) != nullptr)
+      return {index, index + 1};
+    const auto bounds = std::equal_range(varValues.begin() + range.begin,
+                                         varValues.begin() + range.end,
+                                         varValues[index]);
+    return {static_cast<int>(bounds.first - varValues.begin()),
+            static_cast<int>(bounds.second - varValues.begin())};
+  }
+
+  friend class EquispacedRangesVisitor;
 };
 
 }  // namespace ufo
@@ -34,6 +34,8 @@ contains
   procedure :: setup  => ufo_metoffice_bmatrixstatic_setup
   procedure :: delete => ufo_metoffice_bmatrixstatic_delete
   procedure :: reset  => ufo_metoffice_bmatrixstatic_reset
+  procedure :: band   => ufo_metoffice_bmatrixstatic_band
+  procedure :: view   => ufo_metoffice_bmatrixstatic_view
 end type ufo_metoffice_bmatrixstatic
 
 character(len=200)     :: message
@@ -588,12 +590,7 @@ real(kind_real), intent(out) :: b_sigma(:)
 integer :: band, i
 
 ! select appropriate b matrix for latitude of observation
-b_matrix(:,:) = zero
-b_inverse(:,:) = zero
-b_sigma(:) = zero
-do band = 1, self % nbands
-  if (latitude < self % north(band)) exit
-end do
+band = self % band(latitude)
 b_matrix(:,:) = self % store(:,:,band)
 b_inverse(:,:) = self % inverse(:,:,band)
 b_sigma(:) = self % sigma(:,band)
@@ -636,6 +633,63 @@ b_sigma(:) = self % sigma(:,band)
 
 end subroutine ufo_metoffice_bmatrixstatic_reset
 
+! ------------------------------------------------------------------------------------------------
+!> Return the latitude band containing a latitude
+!!
+!! \details Latitudes north of the last band are assigned to the last band.
+!!
+!! \author Met Office
+!!
+!! \date 16/10/2026: Created
+!!
+function ufo_metoffice_bmatrixstatic_band(self, latitude) result(band)
+
+implicit none
+
+class(ufo_metoffice_bmatrixstatic), intent(in) :: self !< B-matrix covariance
+real(kind_real), intent(in) :: latitude                 !< latitude of the observation
+integer                     :: band                     !< latitude band index
+
+do band = 1, self % nbands - 1
+  if (latitude < self % north(band)) exit
+end do
+
+end function ufo_metoffice_bmatrixstatic_band
+
+! ------------------------------------------------------------------------------------------------
+!> Point to the error covariances for a single observation without copying them
+!!
+!! \details Unlike reset, this returns views of the matrices held for the latitude
+!! band of the observation, so all observations in a band share the same storage.
+!! The views are read-only and remain valid until the object is deleted.
+!!
+!! \author Met Office
+!!
+!! \date 16/10/2026: Created
+!!
+subroutine ufo_metoffice_bmatrixstatic_view(self, latitude, &      ! in
+                                            b_matrix, b_inverse, & ! out
+                                            b_sigma)               ! out
+
+implicit none
+
+! Subroutine arguments
+class(ufo_metoffice_bmatrixstatic), intent(in) :: self !< B-matrix covariance
+real(kind_real), intent(in)              :: latitude      !< latitude of the observation
+real(kind_real), pointer, intent(out)    :: b_matrix(:,:)  !< b-matrix for the band
+real(kind_real), pointer, intent(out)    :: b_inverse(:,:) !< inverse b-matrix for the band
+real(kind_real), pointer, intent(out)    :: b_sigma(:)     !< b-matrix diagonal errors for the band
+
+! Local Variables
+integer :: band
+
+band = self % band(latitude)
+b_matrix => self % store(:,:,band)
+b_inverse => self % inverse(:,:,band)
+b_sigma => self % sigma(:,band)
+
+end subroutine ufo_metoffice_bmatrixstatic_view
+
 ! ------------------------------------------------------------------------------------------------
 !> Create a subset of the b-matrix.  Used for testing.
 !!
@@ -48,8 +48,9 @@ void Cal_RelativeHumidity::runTransform() {
 void Cal_RelativeHumidity::methodDEFAULT() {
   const size_t nlocs = obsdb_.nlocs();
 
-  float esat, qvs, qv, satVaporPres;
+  float esat, qvs, qv;
 
+  std::vector<float> satVaporPres;
   std::vector<float> specificHumidity;
   std::vector<float> airTemperature;
   std::vector<float> pressure;
@@ -78,14 +79,17 @@ void Cal_RelativeHumidity::methodDEFAULT() {
   // Initialise this vector with missing value
   relativeHumidity.assign(nlocs, missingValueFloat);
 
+  // Calculate saturation vapor pressure from temperature according to requested formulation
+  // (at all locations at once)
+  formulas::SatVaporPres_fromTemp(airTemperature, satVaporPres, formulation(),
+                                  UseSatVaporPresTable());
+
   // Loop over all obs
   for (size_t jobs = 0; jobs < nlocs; ++jobs) {
     if (specificHumidity[jobs] != missingValueFloat &&
         airTemperature[jobs] != missingValueFloat && pressure[jobs] != missingValueFloat) {
-      // Calculate saturation vapor pressure from temperature according to requested formulation
       // Double-check result is always lower than 15% of incoming pressure.
-      satVaporPres = formulas::SatVaporPres_fromTemp(airTemperature[jobs], formulation());
-      esat = std::min(pressure[jobs]*0.15f, satVaporPres);
+      esat = std::min(pressure[jobs]*0.15f, satVaporPres[jobs]);
 
       // Convert sat. vapor pressure to sat water vapor mixing ratio
       qvs = 0.622 * esat/(pressure[jobs]-esat);
@@ -135,7 +139,8 @@ void Cal_SpecificHumidity::runTransform() {
 
 void Cal_SpecificHumidity::methodDEFAULT() {
   const size_t nlocs = obsdb_.nlocs();
-  float esat, qvs, qv, satVaporPres;
+  float esat, qvs, qv;
+  std::vector<float> satVaporPres;
   std::vector<float> relativeHumidity;
   std::vector<float> airTemperature;
   std::vector<float> pressure;
@@ -164,14 +169,17 @@ void Cal_SpecificHumidity::methodDEFAULT() {
   // Initialise this vector with missing value
   specificHumidity.assign(nlocs, missingValueFloat);
 
+  // Calculate saturation vapor pressure from temperature according to requested formulation
+  // (at all locations at once)
+  formulas::SatVaporPres_fromTemp(airTemperature, satVaporPres, formulation(),
+                                  UseSatVaporPresTable());
+
   // Loop over all obs
   for (size_t jobs = 0; jobs < nlocs; ++jobs) {
     if (relativeHumidity[jobs] != missingValueFloat &&
         airTemperature[jobs] != missingValueFloat && pressure[jobs] != missingValueFloat) {
-      // Calculate saturation vapor pressure from temperature according to requested formulation
       // Double-check result is always lower than 15% of incoming pressure.
-      satVaporPres = formulas::SatVaporPres_fromTemp(airTemperature[jobs], formulation());
-      esat = std::min(pressure[jobs]*0.15f, satVaporPres);
+      esat = std::min(pressure[jobs]*0.15f, satVaporPres[jobs]);
 
       // Convert sat. vapor pressure to sat water vapor mixing ratio
       qvs = 0.622 * esat/(pressure[jobs]-esat);
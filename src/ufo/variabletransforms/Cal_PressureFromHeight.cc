@@ -297,19 +297,23 @@ void Cal_PressureFromHeightForICAO::methodUKMO() {
     throw eckit::BadValue("GeopotentialHeight vector is the wrong size or empty ", Here());
   }
 
-  // 3. Loop over each record
+  // 3. Calculate the pressure at all locations at once
+  // -------------------------------------------------------------------------------------
+  std::vector<float> icaoPressure;
+  formulas::Height_To_Pressure_ICAO_atmos(geopotentialHeight, icaoPressure, formulation());
+
+  // 4. Loop over each record
   // -------------------------------------------------------------------------------------
   for (irec = obsdb_.recidx_begin(); irec != obsdb_.recidx_end(); ++irec) {
     const std::vector<std::size_t> &rSort = obsdb_.recidx_vector(irec);
     size_t ilocs = 0;
 
-    // 3.1 Loop over each record
+    // 4.1 Loop over each record
     for (ilocs = 0; ilocs < rSort.size(); ++ilocs) {
       // Cycle if airPressure is valid
       if (airPressure[rSort[ilocs]] != missingValueFloat) continue;
 
-      airPressure[rSort[ilocs]] = formulas::Height_To_Pressure_ICAO_atmos(
-          geopotentialHeight[rSort[ilocs]], formulation());
+      airPressure[rSort[ilocs]] = icaoPressure[rSort[ilocs]];
 
       hasBeenUpdated = true;
     }
@@ -7,12 +7,16 @@
 
 #include <algorithm>
 #include <cmath>
+#include <map>
+#include <memory>
+#include <mutex>  // NOLINT(build/c++11)
 #include <string>
 #include <vector>
 #include "eckit/exception/Exceptions.h"
 #include "oops/util/Logger.h"
 #include "ufo/utils/Constants.h"
 #include "ufo/variabletransforms/Formulas.h"
+#include "ufo/variabletransforms/Formulas.interface.h"
 
 namespace ufo {
 
@@ -43,8 +47,6 @@ MethodFormulation resolveFormulations(const std::string& input, const std::strin
 /* -------------------------------------------------------------------------------------*/
 float SatVaporPres_fromTemp(float temp_K, MethodFormulation formulation) {
   const float missingValueFloat = util::missingValue(1.0f);
-  const float t0c = static_cast<float>(ufo::Constants::t0c);
-  float e_sub_s = missingValueFloat;  // Saturation vapour pressure (Pa)
 
   switch (formulation) {
     case formulas::MethodFormulation::UKMO:
@@ -55,49 +57,30 @@ float SatVaporPres_fromTemp(float temp_K, MethodFormulation formulation) {
        *     or Sonntag formulations, which are all very similar (Holger Vomel,
        *     pers. comm., 2011)
       */
-      if (temp_K != missingValueFloat) {
-        e_sub_s = std::exp(-6096.9385f / temp_K + 21.2409642f - 2.711193E-2f * temp_K +
-                        1.673952E-5f * temp_K * temp_K + 2.433502f * std::log(temp_K));
-      } else {
-        e_sub_s = 0.0f;
-      }
-      break;
+      if (temp_K != missingValueFloat)
+        return kernels::SatVaporPres_fromTemp<Sonntag>(temp_K);
+      return 0.0f;
     }
     case formulas::MethodFormulation::Walko: {
-          // Polynomial fit of Goff-Gratch (1946) formulation. (Walko, 1991)
-          float x = std::max(-80.0f, temp_K-t0c);
-          const std::vector<float> c{610.5851f, 44.40316f, 1.430341f, 0.2641412e-1f,
-            0.2995057e-3f, 0.2031998e-5f, 0.6936113e-8f, 0.2564861e-11f, -0.3704404e-13f};
-          e_sub_s = c[0]+x*(c[1]+x*(c[2]+x*(c[3]+x*(c[4]+x*(c[5]+x*(c[6]+x*(c[7]+x*c[8])))))));
-          break;
+      // Polynomial fit of Goff-Gratch (1946) formulation. (Walko, 1991)
+      return kernels::SatVaporPres_fromTemp<Walko>(temp_K);
     }
     case formulas::MethodFormulation::Murphy: {
       // ALTERNATIVE (costs more CPU, more accurate than Walko, 1991)
-      // Source: Murphy and Koop, Review of the vapour pressure of ice and
-      //       supercooled water for atmospheric applications, Q. J. R.
-      //       Meteorol. Soc (2005), 131, pp. 1539-1565.
-      e_sub_s = std::exp(54.842763f - 6763.22f / temp_K - 4.210f * std::log(temp_K)
-                     + 0.000367f * temp_K + std::tanh(0.0415f * (temp_K - 218.8f))
-                     * (53.878f - 1331.22f / temp_K - 9.44523f * std::log(temp_K)
-                     + 0.014025f * temp_K));
-      break;
+      return kernels::SatVaporPres_fromTemp<Murphy>(temp_K);
     }
     case formulas::MethodFormulation::NCAR:
     case formulas::MethodFormulation::NOAA:
     case formulas::MethodFormulation::Rogers:
     default: {
       // Classical formula from Rogers and Yau (1989; Eq2.17)
-      e_sub_s = 1000. * 0.6112 * std::exp(17.67f * (temp_K - t0c) / (temp_K - 29.65f));
-      break;
+      return kernels::SatVaporPres_fromTemp<DEFAULT>(temp_K);
     }
   }
-  return e_sub_s;
 }
 
 /* -------------------------------------------------------------------------------------*/
 float SatVaporPres_correction(float e_sub_s, float temp_K, MethodFormulation formulation) {
-  const float t0c = static_cast<float>(ufo::Constants::t0c);
-
   switch (formulation) {
     case formulas::MethodFormulation::NCAR:
     case formulas::MethodFormulation::NOAA:
@@ -108,11 +91,7 @@ float SatVaporPres_correction(float e_sub_s, float temp_K, MethodFormulation for
           air (eg eqns 20, 22 of Sonntag, but for consistency with QSAT the formula
           below is from eqn A4.6 of Adrian Gill's book)
       */
-      float FsubW;  // Enhancement factor
-      FsubW = 1.0f - 1.0E-8f *
-          (4.5f + 6.0E-4f * (temp_K - t0c) *(temp_K - t0c));
-      e_sub_s = e_sub_s * FsubW;
-      break;
+      return kernels::SatVaporPres_correction(e_sub_s, temp_K);
     }
     default: {
       std::string errString = "Aborting, no method matches enum formulas::MethodFormulation";
@@ -120,114 +99,242 @@ float SatVaporPres_correction(float e_sub_s, float temp_K, MethodFormulation for
       throw eckit::BadValue(errString);
     }
   }
-  return e_sub_s;
 }
 /* -------------------------------------------------------------------------------------*/
 
 float Qsat_From_Psat(float Psat, float P, MethodFormulation formulation) {
-  float QSat = util::missingValue(1.0f);  // Saturated specific humidity or
-                                          // saturated vapour pressure (if P<0)
-
-  switch (formulation) {
-    case formulas::MethodFormulation::NCAR:
-    case formulas::MethodFormulation::NOAA:
-    case formulas::MethodFormulation::UKMO:
-    default: {
-      // Calculation using the Sonntag (1994) formula. (With fix at low
-      // pressure)
-      QSat = (Constants::epsilon * Psat) /
-             (std::max(P, Psat) - (1.0f - Constants::epsilon) * Psat);
-      break;
-    }
-  }
-  return QSat;
+  // Calculation using the Sonntag (1994) formula. (With fix at low pressure)
+  // All methods use the same formulation.
+  return kernels::Qsat_From_Psat(Psat, P);
 }
 
 /* -------------------------------------------------------------------------------------*/
 
 // VirtualTemperature()
 float VirtualTemp_From_Psat_P_T(float Psat, float P, float T, MethodFormulation formulation) {
-  float Tv = util::missingValue(1.0f);  // virtual temperature
-
-  switch (formulation) {
-    case formulas::MethodFormulation::NCAR:
-    case formulas::MethodFormulation::NOAA:
-    case formulas::MethodFormulation::UKMO:
-    default: {
-      Tv = T * ((P + Psat / Constants::epsilon) / (P + Psat));
-      break;
-    }
-  }
-  return Tv;
+  // All methods use the same formulation.
+  return kernels::VirtualTemp_From_Psat_P_T(Psat, P, T);
 }
 
 /* -------------------------------------------------------------------------------------*/
 
 float VirtualTemp_From_Rh_Psat_P_T(float Rh, float Psat, float P, float T,
                                    MethodFormulation formulation) {
-  float Tv = util::missingValue(1.0f);  // virtual temperature
+  // All methods use the same formulation.
+  return kernels::VirtualTemp_From_Rh_Psat_P_T(Rh, Psat, P, T);
+}
+
+/* -------------------------------------------------------------------------------------*/
+
+float Height_To_Pressure_ICAO_atmos(float height, MethodFormulation formulation) {
+  const float missingValueFloat = util::missingValue(1.0f);
+  // All methods use the ICAO standard.
+  if (height <= missingValueFloat)
+    return missingValueFloat;
+  return kernels::Height_To_Pressure_ICAO_atmos(height, missingValueFloat);
+}
+
+/* -------------------------------------------------------------------------------------*/
+
+namespace {
+
+/// Apply \p op to the values at each location, setting the output to \p missing wherever an
+/// input is missing. Missing inputs are replaced by \p valid before \p op is applied, so that
+/// the loop has no branches and never evaluates formulas outside their domain.
+template <typename T, typename Op>
+void applyToValid(size_t n, const T *in, T *out, T missing, T valid, const Op &op) {
+  for (size_t i = 0; i < n; ++i) {
+    const bool isMissing = in[i] == missing;
+    const T result = op(isMissing ? valid : in[i]);
+    out[i] = isMissing ? missing : result;
+  }
+}
+
+template <typename T, typename Op>
+void applyToValid(size_t n, const T *in1, const T *in2, T *out, T missing,
+                  T valid1, T valid2, const Op &op) {
+  for (size_t i = 0; i < n; ++i) {
+    const bool isMissing = in1[i] == missing || in2[i] == missing;
+    const T result = op(isMissing ? valid1 : in1[i], isMissing ? valid2 : in2[i]);
+    out[i] = isMissing ? missing : result;
+  }
+}
+
+template <typename T, typename Op>
+void applyToValid(size_t n, const T *in1, const T *in2, const T *in3, T *out, T missing,
+                  T valid1, T valid2, T valid3, const Op &op) {
+  for (size_t i = 0; i < n; ++i) {
+    const bool isMissing = in1[i] == missing || in2[i] == missing || in3[i] == missing;
+    const T result = op(isMissing ? valid1 : in1[i], isMissing ? valid2 : in2[i],
+                        isMissing ? valid3 : in3[i]);
+    out[i] = isMissing ? missing : result;
+  }
+}
+
+// Values substituted for missing inputs.
+const double validTemp = ufo::Constants::t0c;
+const double validPressure = 1.0e5;
+const double validVaporPres = 1.0e3;
+
+template <MethodFormulation formulation, typename T>
+void satVaporPresFromTemp(size_t n, const T *temp_K, T *e_sub_s, T missing) {
+  applyToValid(n, temp_K, e_sub_s, missing, static_cast<T>(validTemp),
+               [](T t) {return kernels::SatVaporPres_fromTemp<formulation>(t);});
+}
+
+template <typename T>
+void satVaporPresFromTemp(size_t n, const T *temp_K, T *e_sub_s,
+                          MethodFormulation formulation, T missing) {
+  switch (formulation) {
+    case formulas::MethodFormulation::UKMO:
+    case formulas::MethodFormulation::Sonntag:
+      satVaporPresFromTemp<Sonntag>(n, temp_K, e_sub_s, missing);
+      break;
+    case formulas::MethodFormulation::Walko:
+      satVaporPresFromTemp<Walko>(n, temp_K, e_sub_s, missing);
+      break;
+    case formulas::MethodFormulation::Murphy:
+      satVaporPresFromTemp<Murphy>(n, temp_K, e_sub_s, missing);
+      break;
+    default:
+      satVaporPresFromTemp<DEFAULT>(n, temp_K, e_sub_s, missing);
+      break;
+  }
+}
 
+template <typename T>
+void satVaporPresCorrection(size_t n, T *e_sub_s, const T *temp_K,
+                            MethodFormulation formulation, T missing) {
   switch (formulation) {
     case formulas::MethodFormulation::NCAR:
     case formulas::MethodFormulation::NOAA:
     case formulas::MethodFormulation::UKMO:
-    default: {
-      float PsatRh  = Psat * Rh * 0.01f;
-      Tv = VirtualTemp_From_Psat_P_T(PsatRh , P, T, formulation);
+    case formulas::MethodFormulation::Sonntag:
+      applyToValid(n, e_sub_s, temp_K, e_sub_s, missing,
+                   static_cast<T>(validVaporPres), static_cast<T>(validTemp),
+                   [](T e, T t) {return kernels::SatVaporPres_correction(e, t);});
       break;
+    default: {
+      std::string errString = "Aborting, no method matches enum formulas::MethodFormulation";
+      oops::Log::error() << errString;
+      throw eckit::BadValue(errString);
     }
   }
+}
 
-  return Tv;
+void checkSizes(size_t size1, size_t size2) {
+  if (size1 != size2)
+    throw eckit::BadValue("Vectors passed to a formula have different sizes", Here());
 }
 
+}  // namespace
+
 /* -------------------------------------------------------------------------------------*/
 
-float Height_To_Pressure_ICAO_atmos(float height, MethodFormulation formulation) {
-  const float missingValueFloat = util::missingValue(1.0f);
-  float Pressure = missingValueFloat;
+const SatVaporPresTable & SatVaporPresTable::get(MethodFormulation formulation) {
+  static std::mutex mutex;
+  static std::map<MethodFormulation, std::unique_ptr<SatVaporPresTable>> tables;
+  std::lock_guard<std::mutex> lock(mutex);
+  std::unique_ptr<SatVaporPresTable> &table = tables[formulation];
+  if (!table)
+    table.reset(new SatVaporPresTable(formulation));
+  return *table;
+}
 
-  switch (formulation) {
-    case formulas::MethodFormulation::NCAR:
-    case formulas::MethodFormulation::NOAA:
-    case formulas::MethodFormulation::UKMO:
-    default: {
-      float RepT_Bot, RepT_Top, ZP1, ZP2;
-
-      RepT_Bot = 1.0 / Constants::icao_temp_surface;
-      RepT_Top = 1.0 / Constants::icao_temp_isothermal_layer;
-      ZP1 = Constants::g_over_rd / Constants::icao_lapse_rate_l;
-      ZP2 = Constants::g_over_rd / Constants::icao_lapse_rate_u;
-
-      if (height <= missingValueFloat) {
-        Pressure = missingValueFloat;
-      } else if (height < -5000.0) {
-        // TODO(david simonin): The original code has this test.
-        // Not sure why! Are we expecting very negative height value??
-        Pressure = missingValueFloat;
-      } else if (height < Constants::icao_height_l) {
-        // Heights up to 11,000 geopotential heigh in meter [gpm]
-        Pressure = Constants::icao_lapse_rate_l * height * RepT_Bot;
-        Pressure = std::pow((1.0 - Pressure), ZP1);
-        Pressure = 100.0 * Pressure * Constants::icao_pressure_surface;
-      } else if (height < Constants::icao_height_u) {
-        // Heights between 11,000 and 20,000 geopotential heigh in meter [gpm]
-        Pressure = Constants::g_over_rd * (height - Constants::icao_height_l) * RepT_Top;
-        Pressure = std::log(Constants::icao_pressure_l) - Pressure;
-        Pressure = 100.0 * std::exp(Pressure);
-      } else {
-        // Heights above 20,000 geopotential heigh in meter [gpm]
-        Pressure = Constants::icao_lapse_rate_u * RepT_Top *
-                   (height - Constants::icao_height_u);
-        Pressure = 100.0 * Constants::icao_pressure_u *
-                   std::pow((1.0 - Pressure), ZP2);
-      }
-      break;
-    }
+SatVaporPresTable::SatVaporPresTable(MethodFormulation formulation)
+  : formulation_(formulation) {
+  const size_t n = static_cast<size_t>(std::lround((maxTemp_ - minTemp_) / tempStep_)) + 1;
+  std::vector<double> temps(n);
+  for (size_t i = 0; i < n; ++i)
+    temps[i] = minTemp_ + i * tempStep_;
+  std::vector<double> values(n);
+  satVaporPresFromTemp(n, temps.data(), values.data(), formulation,
+                       util::missingValue(1.0));
+  values_.assign(values.begin(), values.end());
+}
+
+void SatVaporPresTable::lookup(const std::vector<float> &temp_K,
+                               std::vector<float> &e_sub_s) const {
+  const float missing = util::missingValue(1.0f);
+  const size_t n = temp_K.size();
+  e_sub_s.resize(n);
+  // Positions are calculated in double precision, since single precision would limit the
+  // accuracy of the interpolation weights.
+  const double invStep = 1.0 / tempStep_;
+  const double last = values_.size() - 1;
+  bool outOfRange = false;
+  for (size_t i = 0; i < n; ++i) {
+    const double x = (temp_K[i] - minTemp_) * invStep;
+    const bool inRange = x >= 0.0 && x < last;
+    outOfRange |= !inRange && temp_K[i] != missing;
+    const double xc = inRange ? x : 0.0;
+    const size_t j = static_cast<size_t>(xc);
+    const double w = xc - j;
+    const float e = (1.0 - w) * values_[j] + w * values_[j + 1];
+    e_sub_s[i] = inRange ? e : missing;
+  }
+  if (outOfRange) {
+    // Use the formula at temperatures outside the table.
+    for (size_t i = 0; i < n; ++i)
+      if (e_sub_s[i] == missing && temp_K[i] != missing)
+        satVaporPresFromTemp(1, &temp_K[i], &e_sub_s[i], formulation_, missing);
   }
-  return Pressure;
 }
 
+/* -------------------------------------------------------------------------------------*/
+
+void SatVaporPres_fromTemp(const std::vector<float> &temp_K, std::vector<float> &e_sub_s,
+                           MethodFormulation formulation, bool tabulated) {
+  if (tabulated) {
+    SatVaporPresTable::get(formulation).lookup(temp_K, e_sub_s);
+  } else {
+    e_sub_s.resize(temp_K.size());
+    satVaporPresFromTemp(temp_K.size(), temp_K.data(), e_sub_s.data(), formulation,
+                         util::missingValue(1.0f));
+  }
+}
+
+void SatVaporPres_correction(std::vector<float> &e_sub_s, const std::vector<float> &temp_K,
+                             MethodFormulation formulation) {
+  checkSizes(e_sub_s.size(), temp_K.size());
+  satVaporPresCorrection(e_sub_s.size(), e_sub_s.data(), temp_K.data(), formulation,
+                         util::missingValue(1.0f));
+}
+
+void Qsat_From_Psat(const std::vector<float> &Psat, const std::vector<float> &P,
+                    std::vector<float> &QSat, MethodFormulation formulation) {
+  checkSizes(Psat.size(), P.size());
+  QSat.resize(Psat.size());
+  applyToValid(Psat.size(), Psat.data(), P.data(), QSat.data(), util::missingValue(1.0f),
+               static_cast<float>(validVaporPres), static_cast<float>(validPressure),
+               [](float psat, float p) {return kernels::Qsat_From_Psat(psat, p);});
+}
+
+void VirtualTemp_From_Psat_P_T(const std::vector<float> &Psat, const std::vector<float> &P,
+                               const std::vector<float> &T, std::vector<float> &Tv,
+                               MethodFormulation formulation) {
+  checkSizes(Psat.size(), P.size());
+  checkSizes(Psat.size(), T.size());
+  Tv.resize(Psat.size());
+  applyToValid(Psat.size(), Psat.data(), P.data(), T.data(), Tv.data(),
+               util::missingValue(1.0f), static_cast<float>(validVaporPres),
+               static_cast<float>(validPressure), static_cast<float>(validTemp),
+               [](float psat, float p, float t)
+               {return kernels::VirtualTemp_From_Psat_P_T(psat, p, t);});
+}
+
+void Height_To_Pressure_ICAO_atmos(const std::vector<float> &Height,
+                                   std::vector<float> &Pressure,
+                                   MethodFormulation formulation) {
+  const float missing = util::missingValue(1.0f);
+  Pressure.resize(Height.size());
+  for (size_t i = 0; i < Height.size(); ++i)
+    Pressure[i] = Height[i] <= missing ? missing :
+      kernels::Height_To_Pressure_ICAO_atmos(Height[i], missing);
+}
+
+/* -------------------------------------------------------------------------------------*/
+
 float GetWindDirection(float u, float v) {
   const float missing = util::missingValue(1.0f);
   float windDirection = missing;  // wind direction
@@ -276,5 +383,19 @@ float GetWind_V(float windSpeed, float windFromDirection) {
 }
 
 
+/* -------------------------------------------------------------------------------------*/
+
+void ufo_formulas_satvaporpres_fromtemp(const int &nvals, const double *temp_K,
+                                        double *e_sub_s, const int &formulation) {
+  satVaporPresFromTemp(nvals, temp_K, e_sub_s, static_cast<MethodFormulation>(formulation),
+                       util::missingValue(1.0));
+}
+
+void ufo_formulas_satvaporpres_correction(const int &nvals, double *e_sub_s,
+                                          const double *temp_K, const int &formulation) {
+  satVaporPresCorrection(nvals, e_sub_s, temp_K, static_cast<MethodFormulation>(formulation),
+                         util::missingValue(1.0));
+}
+
 }  // namespace formulas
 }  // namespace ufo
@@ -39,6 +39,144 @@ MethodFormulation resolveMethods(const std::string& input);
 
 MethodFormulation resolveFormulations(const std::string& input, const std::string& method);
 
+// -------------------------------------------------------------------------------------
+/*!
+* \brief Formulas resolved at compile time.
+*
+* The functions in this namespace hold the physics used by the functions of the same name in
+* the formulas namespace. Formulations are template parameters, so that callers processing
+* many locations can select a formulation once and then run a loop without branches. All
+* functions are templated on the floating-point type, so that the same code serves both the
+* transforms (float) and the Fortran operators (double) through the interface declared in
+* Formulas.interface.h. They do not check for missing values.
+*/
+namespace kernels {
+
+/// Saturation vapour pressure over water; the primary template implements the classical
+/// formula from Rogers and Yau (1989; Eq2.17) used by the DEFAULT, NCAR, NOAA and Rogers
+/// formulations.
+template <MethodFormulation formulation>
+struct SatVaporPresFormula {
+  template <typename T>
+  static T fromTemp(T temp_K) {
+    const T t0c = static_cast<T>(ufo::Constants::t0c);
+    return 1000. * 0.6112 * std::exp(static_cast<T>(17.67) * (temp_K - t0c) /
+                                     (temp_K - static_cast<T>(29.65)));
+  }
+};
+
+/// Eqn 7, Sonntag, D., Advancements in the field of hygrometry,
+/// Meteorol. Zeitschrift, N. F., 3, 51-66, 1994.
+template <>
+struct SatVaporPresFormula<Sonntag> {
+  template <typename T>
+  static T fromTemp(T temp_K) {
+    return std::exp(static_cast<T>(-6096.9385) / temp_K + static_cast<T>(21.2409642) -
+                    static_cast<T>(2.711193E-2) * temp_K +
+                    static_cast<T>(1.673952E-5) * temp_K * temp_K +
+                    static_cast<T>(2.433502) * std::log(temp_K));
+  }
+};
+
+/// UKMO uses the Sonntag (1994) formulation.
+template <>
+struct SatVaporPresFormula<UKMO> : SatVaporPresFormula<Sonntag> {};
+
+/// Polynomial fit of Goff-Gratch (1946) formulation. (Walko, 1991)
+template <>
+struct SatVaporPresFormula<Walko> {
+  template <typename T>
+  static T fromTemp(T temp_K) {
+    const T t0c = static_cast<T>(ufo::Constants::t0c);
+    const T x = std::max(static_cast<T>(-80.0), temp_K - t0c);
+    const T c[] = {static_cast<T>(610.5851), static_cast<T>(44.40316),
+                   static_cast<T>(1.430341), static_cast<T>(0.2641412e-1),
+                   static_cast<T>(0.2995057e-3), static_cast<T>(0.2031998e-5),
+                   static_cast<T>(0.6936113e-8), static_cast<T>(0.2564861e-11),
+                   static_cast<T>(-0.3704404e-13)};
+    return c[0]+x*(c[1]+x*(c[2]+x*(c[3]+x*(c[4]+x*(c[5]+x*(c[6]+x*(c[7]+x*c[8])))))));
+  }
+};
+
+/// Murphy and Koop, Review of the vapour pressure of ice and supercooled water for
+/// atmospheric applications, Q. J. R. Meteorol. Soc (2005), 131, pp. 1539-1565.
+template <>
+struct SatVaporPresFormula<Murphy> {
+  template <typename T>
+  static T fromTemp(T temp_K) {
+    return std::exp(static_cast<T>(54.842763) - static_cast<T>(6763.22) / temp_K -
+                    static_cast<T>(4.210) * std::log(temp_K) + static_cast<T>(0.000367) * temp_K +
+                    std::tanh(static_cast<T>(0.0415) * (temp_K - static_cast<T>(218.8))) *
+                    (static_cast<T>(53.878) - static_cast<T>(1331.22) / temp_K -
+                     static_cast<T>(9.44523) * std::log(temp_K) +
+                     static_cast<T>(0.014025) * temp_K));
+  }
+};
+
+template <MethodFormulation formulation, typename T>
+inline T SatVaporPres_fromTemp(T temp_K) {
+  return SatVaporPresFormula<formulation>::fromTemp(temp_K);
+}
+
+/// Enhancement factor for moist air (eqn A4.6 of Adrian Gill's book); used by the NCAR, NOAA,
+/// UKMO and Sonntag formulations.
+template <typename T>
+inline T SatVaporPres_correction(T e_sub_s, T temp_K) {
+  const T t0c = static_cast<T>(ufo::Constants::t0c);
+  const T FsubW = static_cast<T>(1.0) - static_cast<T>(1.0E-8) *
+      (static_cast<T>(4.5) + static_cast<T>(6.0E-4) * (temp_K - t0c) * (temp_K - t0c));
+  return e_sub_s * FsubW;
+}
+
+/// Sonntag (1994) formula (with fix at low pressure).
+template <typename T>
+inline T Qsat_From_Psat(T Psat, T P) {
+  return (Constants::epsilon * Psat) / (std::max(P, Psat) - (1.0f - Constants::epsilon) * Psat);
+}
+
+template <typename T>
+inline T VirtualTemp_From_Psat_P_T(T Psat, T P, T temp_K) {
+  return temp_K * ((P + Psat / Constants::epsilon) / (P + Psat));
+}
+
+template <typename T>
+inline T VirtualTemp_From_Rh_Psat_P_T(T Rh, T Psat, T P, T temp_K) {
+  const T PsatRh = Psat * Rh * static_cast<T>(0.01);
+  return VirtualTemp_From_Psat_P_T(PsatRh, P, temp_K);
+}
+
+/// ICAO standard atmosphere; \p missing is returned for heights below -5000 m.
+template <typename T>
+inline T Height_To_Pressure_ICAO_atmos(T height, T missing) {
+  const T RepT_Bot = 1.0 / Constants::icao_temp_surface;
+  const T RepT_Top = 1.0 / Constants::icao_temp_isothermal_layer;
+  const T ZP1 = Constants::g_over_rd / Constants::icao_lapse_rate_l;
+  const T ZP2 = Constants::g_over_rd / Constants::icao_lapse_rate_u;
+  T Pressure;
+  if (height < -5000.0) {
+    Pressure = missing;
+  } else if (height < Constants::icao_height_l) {
+    // Heights up to 11,000 geopotential heigh in meter [gpm]
+    Pressure = Constants::icao_lapse_rate_l * height * RepT_Bot;
+    Pressure = std::pow((1.0 - Pressure), ZP1);
+    Pressure = 100.0 * Pressure * Constants::icao_pressure_surface;
+  } else if (height < Constants::icao_height_u) {
+    // Heights between 11,000 and 20,000 geopotential heigh in meter [gpm]
+    Pressure = Constants::g_over_rd * (height - Constants::icao_height_l) * RepT_Top;
+    Pressure = std::log(Constants::icao_pressure_l) - Pressure;
+    Pressure = 100.0 * std::exp(Pressure);
+  } else {
+    // Heights above 20,000 geopotential heigh in meter [gpm]
+    Pressure = Constants::icao_lapse_rate_u * RepT_Top *
+               (height - Constants::icao_height_u);
+    Pressure = 100.0 * Constants::icao_pressure_u *
+               std::pow((1.0 - Pressure), ZP2);
+  }
+  return Pressure;
+}
+
+}  // namespace kernels
+
 // -------------------------------------------------------------------------------------
 /*!
 * \brief Calculates saturated vapour pressure from temperature
@@ -179,6 +317,69 @@ float VirtualTemp_From_Rh_Psat_P_T(float Rh, float Psat, float P, float T,
 float Height_To_Pressure_ICAO_atmos(float Height,
                             MethodFormulation formulation = formulas::MethodFormulation::DEFAULT);
 
+// -------------------------------------------------------------------------------------
+/*!
+* \brief Saturation vapour pressure tabulated at regular intervals of temperature.
+*
+* Values are interpolated linearly between nodes spaced 0.01 K apart from 150 K to 350 K. The
+* relative difference from the formula evaluated in double precision is below 2e-6, which at low
+* temperatures is less than the rounding error of the formula evaluated in single precision.
+* The formula is used for temperatures outside this range.
+*/
+class SatVaporPresTable {
+ public:
+  /// Return the table of formulation \p formulation, creating it on first use.
+  static const SatVaporPresTable & get(MethodFormulation formulation);
+
+  explicit SatVaporPresTable(MethodFormulation formulation);
+
+  /// Fill \p e_sub_s with the saturation vapour pressures at temperatures \p temp_K
+  /// (missing where \p temp_K is missing).
+  void lookup(const std::vector<float> &temp_K, std::vector<float> &e_sub_s) const;
+
+ private:
+  static constexpr double minTemp_ = 150.0;
+  static constexpr double maxTemp_ = 350.0;
+  static constexpr double tempStep_ = 0.01;
+
+  MethodFormulation formulation_;
+  std::vector<float> values_;
+};
+
+// -------------------------------------------------------------------------------------
+/*!
+* \brief Array versions of the formulas above.
+*
+* The formulation is resolved once per call and the values at all locations are then computed
+* in a single loop. The output vectors are resized to the size of the inputs, which must all
+* have the same size. Outputs are set to the missing value wherever any input is missing.
+*
+* \param tabulated
+*     If true, the saturation vapour pressure is interpolated from a SatVaporPresTable.
+*/
+void SatVaporPres_fromTemp(const std::vector<float> &temp_K, std::vector<float> &e_sub_s,
+                           MethodFormulation formulation = formulas::MethodFormulation::DEFAULT,
+                           bool tabulated = false);
+
+/// \overload
+void SatVaporPres_correction(std::vector<float> &e_sub_s, const std::vector<float> &temp_K,
+                        const MethodFormulation formulation = formulas::MethodFormulation::DEFAULT);
+
+/// \overload
+void Qsat_From_Psat(const std::vector<float> &Psat, const std::vector<float> &P,
+                    std::vector<float> &QSat,
+                    MethodFormulation formulation = formulas::MethodFormulation::DEFAULT);
+
+/// \overload
+void VirtualTemp_From_Psat_P_T(const std::vector<float> &Psat, const std::vector<float> &P,
+                               const std::vector<float> &T, std::vector<float> &Tv,
+                          MethodFormulation formulation = formulas::MethodFormulation::DEFAULT);
+
+/// \overload
+void Height_To_Pressure_ICAO_atmos(const std::vector<float> &Height,
+                                   std::vector<float> &Pressure,
+                            MethodFormulation formulation = formulas::MethodFormulation::DEFAULT);
+
 // -------------------------------------------------------------------------------------
 /*!
 * \brief Converts u and v wind component into wind direction.
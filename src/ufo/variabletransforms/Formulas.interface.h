@@ -0,0 +1,29 @@
+/*
+ * (C) Crown copyright 2021, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef UFO_VARIABLETRANSFORMS_FORMULAS_INTERFACE_H_
+#define UFO_VARIABLETRANSFORMS_FORMULAS_INTERFACE_H_
+
+namespace ufo {
+namespace formulas {
+
+/// Interface allowing Fortran code to use the formulas of Formulas.h (see ufo_formulas_mod).
+///
+/// Formulations are passed as values of MethodFormulation. Outputs are set to the missing
+/// value wherever an input is missing.
+
+extern "C" {
+void ufo_formulas_satvaporpres_fromtemp(const int &nvals, const double *temp_K,
+                                        double *e_sub_s, const int &formulation);
+
+void ufo_formulas_satvaporpres_correction(const int &nvals, double *e_sub_s,
+                                          const double *temp_K, const int &formulation);
+}  // extern C
+
+}  // namespace formulas
+}  // namespace ufo
+#endif  // UFO_VARIABLETRANSFORMS_FORMULAS_INTERFACE_H_
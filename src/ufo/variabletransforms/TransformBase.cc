@@ -20,6 +20,7 @@ TransformBase::TransformBase(const VariableTransformsParameters& options,
   formulation_  = formulas::resolveFormulations(options.Formulation.value(),
                                                 options.Method.value());
   UseValidDataOnly_ = options.UseValidDataOnly.value();
+  UseSatVaporPresTable_ = options.UseSatVaporPresTable.value();
   obsName_ = os.obsname();
 }
 
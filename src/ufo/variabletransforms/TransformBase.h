@@ -62,6 +62,7 @@ class TransformBase {
   formulas::MethodFormulation method_;
   formulas::MethodFormulation formulation_;
   bool UseValidDataOnly_;
+  bool UseSatVaporPresTable_;
   /// The observation name
   std::string obsName_;
 
@@ -73,6 +74,7 @@ class TransformBase {
   formulas::MethodFormulation formulation() const { return formulation_; }
   bool UseValidDataOnly() const { return UseValidDataOnly_; }
   void SetUseValidDataOnly(bool t) {UseValidDataOnly_ = t; }
+  bool UseSatVaporPresTable() const { return UseSatVaporPresTable_; }
   /// subclasses to access the observation name
   std::string obsName() const { return obsName_; }
   /// Configurable parameters
@@ -0,0 +1,16 @@
+/*
+ * (C) Crown copyright 2021, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#include "../ufo/CoefficientSharing.h"
+#include "oops/runs/Run.h"
+#include "ufo/rttov/ObsRadianceRTTOV.interface.h"
+
+int main(int argc,  char ** argv) {
+  oops::Run run(argc, argv);
+  ufo::test::CoefficientSharing tests(ufo::ufo_rttov_coefs_read_count_f90);
+  return run.execute(tests);
+}
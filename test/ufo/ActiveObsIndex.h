@@ -0,0 +1,189 @@
+/*
+ * (C) Crown copyright 2021, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef TEST_UFO_ACTIVEOBSINDEX_H_
+#define TEST_UFO_ACTIVEOBSINDEX_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#define ECKIT_TESTING_SELF_REGISTER_CASES 0
+
+#include "eckit/config/LocalConfiguration.h"
+#include "eckit/testing/Test.h"
+#include "ioda/ObsDataVector.h"
+#include "ioda/ObsSpace.h"
+#include "oops/mpi/mpi.h"
+#include "oops/runs/Test.h"
+#include "oops/util/DateTime.h"
+#include "oops/util/Expect.h"
+#include "test/TestEnvironment.h"
+#include "ufo/filters/ActiveObsIndex.h"
+#include "ufo/filters/FilterChainState.h"
+#include "ufo/filters/QCflags.h"
+
+namespace ufo {
+namespace test {
+
+typedef ioda::ObsDataVector<int> QCFlags_t;
+
+// -----------------------------------------------------------------------------
+
+/// Return the locations at which \p apply is true and variable \p ivar of \p flags passes QC,
+/// found by scanning all locations.
+std::vector<size_t> expectedActiveLocations(const QCFlags_t & flags, size_t ivar,
+                                            const std::vector<bool> & apply) {
+  std::vector<size_t> result;
+  for (size_t jobs = 0; jobs < flags.nlocs(); ++jobs)
+    if (apply[jobs] && flags[ivar][jobs] == QCflags::pass)
+      result.push_back(jobs);
+  return result;
+}
+
+/// Create QC flags rejecting every (ivar + 2)th location of each variable ivar.
+std::shared_ptr<QCFlags_t> makeFlags(ioda::ObsSpace & obsspace) {
+  std::shared_ptr<QCFlags_t> flags =
+      std::make_shared<QCFlags_t>(obsspace, obsspace.obsvariables());
+  for (size_t ivar = 0; ivar < flags->nvars(); ++ivar)
+    for (size_t jobs = 0; jobs < flags->nlocs(); ++jobs)
+      (*flags)[ivar][jobs] = (jobs % (ivar + 2) == 0) ? QCflags::domain : QCflags::pass;
+  return flags;
+}
+
+std::unique_ptr<ioda::ObsSpace> makeObsSpace() {
+  const eckit::LocalConfiguration conf(::test::TestEnvironment::config());
+  const util::DateTime bgn(conf.getString("window begin"));
+  const util::DateTime end(conf.getString("window end"));
+  const eckit::LocalConfiguration obsSpaceConf(conf, "obs space");
+  return std::unique_ptr<ioda::ObsSpace>(
+        new ioda::ObsSpace(obsSpaceConf, oops::mpi::world(), bgn, end, oops::mpi::myself()));
+}
+
+// -----------------------------------------------------------------------------
+
+void testActiveLocations() {
+  std::unique_ptr<ioda::ObsSpace> obsspace = makeObsSpace();
+  std::shared_ptr<QCFlags_t> flags = makeFlags(*obsspace);
+  std::shared_ptr<ufo::ActiveObsIndex> index = std::make_shared<ufo::ActiveObsIndex>(flags);
+
+  const std::vector<bool> all(flags->nlocs(), true);
+  std::vector<bool> apply(flags->nlocs());
+  for (size_t jobs = 0; jobs < apply.size(); ++jobs)
+    apply[jobs] = (jobs % 7 != 3);
+
+  for (size_t ivar = 0; ivar < flags->nvars(); ++ivar) {
+    EXPECT_EQUAL(index->activeLocations(ivar), expectedActiveLocations(*flags, ivar, all));
+    EXPECT_EQUAL(index->activeLocations(ivar, apply),
+                 expectedActiveLocations(*flags, ivar, apply));
+    EXPECT_EQUAL(index->numActive(ivar), expectedActiveLocations(*flags, ivar, all).size());
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+void testIncrementalUpdates() {
+  std::unique_ptr<ioda::ObsSpace> obsspace = makeObsSpace();
+  std::shared_ptr<QCFlags_t> flags = makeFlags(*obsspace);
+  std::shared_ptr<ufo::ActiveObsIndex> index = std::make_shared<ufo::ActiveObsIndex>(flags);
+  const std::vector<bool> all(flags->nlocs(), true);
+  const size_t ivar = 0;
+  const std::vector<size_t> & active = index->activeLocations(ivar);
+
+  // Rejected locations are removed without the index being notified.
+  for (size_t jobs = 1; jobs < flags->nlocs(); jobs += 3)
+    (*flags)[ivar][jobs] = QCflags::buddy;
+  EXPECT_EQUAL(index->activeLocations(ivar), expectedActiveLocations(*flags, ivar, all));
+  // The list is updated in place.
+  EXPECT(&index->activeLocations(ivar) == &active);
+
+  // Locations set back to pass are picked up once the list has been invalidated.
+  for (size_t jobs = 0; jobs < flags->nlocs(); jobs += 4)
+    (*flags)[ivar][jobs] = QCflags::pass;
+  index->invalidate(ivar);
+  EXPECT_EQUAL(index->activeLocations(ivar), expectedActiveLocations(*flags, ivar, all));
+
+  // Replace all flags.
+  for (size_t jvar = 0; jvar < flags->nvars(); ++jvar)
+    for (size_t jobs = 0; jobs < flags->nlocs(); ++jobs)
+      (*flags)[jvar][jobs] = (jobs % 2 == 0) ? QCflags::pass : QCflags::thinned;
+  index->invalidate();
+  for (size_t jvar = 0; jvar < flags->nvars(); ++jvar)
+    EXPECT_EQUAL(index->activeLocations(jvar), expectedActiveLocations(*flags, jvar, all));
+}
+
+// -----------------------------------------------------------------------------
+
+/// The index of a filter chain can be found through the chain's QC flags while the chain's
+/// state (owned by QCmanager) exists. Chains applied to the same ObsSpace don't share their
+/// ObsColumnStores.
+void testFilterChainState() {
+  std::unique_ptr<ioda::ObsSpace> obsspace = makeObsSpace();
+  std::shared_ptr<QCFlags_t> flags = makeFlags(*obsspace);
+  std::shared_ptr<QCFlags_t> otherFlags = makeFlags(*obsspace);
+  const std::vector<bool> all(flags->nlocs(), true);
+
+  EXPECT(ufo::FilterChainState::find(*flags) == nullptr);
+
+  std::shared_ptr<ufo::FilterChainState> chain = ufo::FilterChainState::create(*obsspace, flags);
+  EXPECT(ufo::FilterChainState::find(*flags) == chain);
+  EXPECT(ufo::FilterChainState::find(*otherFlags) == nullptr);
+  EXPECT_EQUAL(chain->activeObs().activeLocations(0), expectedActiveLocations(*flags, 0, all));
+
+  std::shared_ptr<ufo::FilterChainState> otherChain =
+      ufo::FilterChainState::create(*obsspace, otherFlags);
+  EXPECT(ufo::FilterChainState::find(*otherFlags) == otherChain);
+  EXPECT(&otherChain->columns() != &chain->columns());
+
+  chain.reset();
+  EXPECT(ufo::FilterChainState::find(*flags) == nullptr);
+  EXPECT(ufo::FilterChainState::find(*otherFlags) == otherChain);
+}
+
+// -----------------------------------------------------------------------------
+
+void testGatherScatter() {
+  const std::vector<float> values{1.0f, 2.0f, 3.0f, 4.0f, 5.0f};
+  const std::vector<size_t> locs{0, 2, 3};
+  std::vector<float> compact = gather(values, locs);
+  EXPECT_EQUAL(compact, std::vector<float>({1.0f, 3.0f, 4.0f}));
+
+  for (float & value : compact)
+    value *= 10.0f;
+  std::vector<float> result = values;
+  scatter(compact, locs, result);
+  EXPECT_EQUAL(result, std::vector<float>({10.0f, 2.0f, 30.0f, 40.0f, 5.0f}));
+}
+
+// -----------------------------------------------------------------------------
+
+class ActiveObsIndex : public oops::Test {
+ private:
+  std::string testid() const override {return "ufo::test::ActiveObsIndex";}
+
+  void register_tests() const override {
+    std::vector<eckit::testing::Test>& ts = eckit::testing::specification();
+
+    ts.emplace_back(CASE("ufo/ActiveObsIndex/activeLocations")
+                    { testActiveLocations(); });
+    ts.emplace_back(CASE("ufo/ActiveObsIndex/incrementalUpdates")
+                    { testIncrementalUpdates(); });
+    ts.emplace_back(CASE("ufo/ActiveObsIndex/filterChainState")
+                    { testFilterChainState(); });
+    ts.emplace_back(CASE("ufo/ActiveObsIndex/gatherScatter")
+                    { testGatherScatter(); });
+  }
+
+  void clear() const override {}
+};
+
+// -----------------------------------------------------------------------------
+
+}  // namespace test
+}  // namespace ufo
+
+#endif  // TEST_UFO_ACTIVEOBSINDEX_H_
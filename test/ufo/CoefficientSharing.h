@@ -0,0 +1,117 @@
+/*
+ * (C) Crown copyright 2021, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef TEST_UFO_COEFFICIENTSHARING_H_
+#define TEST_UFO_COEFFICIENTSHARING_H_
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#define ECKIT_TESTING_SELF_REGISTER_CASES 0
+
+#include "eckit/config/LocalConfiguration.h"
+#include "eckit/testing/Test.h"
+#include "ioda/ObsSpace.h"
+#include "ioda/ObsVector.h"
+#include "oops/base/Variables.h"
+#include "oops/mpi/mpi.h"
+#include "oops/runs/Test.h"
+#include "oops/util/Logger.h"
+#include "test/TestEnvironment.h"
+#include "ufo/GeoVaLs.h"
+#include "ufo/LinearObsOperator.h"
+#include "ufo/Locations.h"
+#include "ufo/ObsBias.h"
+#include "ufo/ObsDiagnostics.h"
+#include "ufo/ObsOperator.h"
+
+namespace ufo {
+namespace test {
+
+// -----------------------------------------------------------------------------
+
+/// Create the operators listed in `observations`, in order, and compute H(x) and set the
+/// trajectory of the linear operator of each. The operators of all entries stay alive until
+/// the end of the test. The number of coefficient loads reported by \p loadCount while doing
+/// so for each entry must be equal to its `expected coefficient loads`: 0 if the coefficients
+/// it needs have been loaded by a previous entry, 1 otherwise.
+void testCoefficientSharing(const std::function<int()> & loadCount) {
+  const eckit::LocalConfiguration conf(::test::TestEnvironment::config());
+  util::DateTime bgn(conf.getString("window begin"));
+  util::DateTime end(conf.getString("window end"));
+
+  std::vector<std::unique_ptr<ioda::ObsSpace>> obsspaces;
+  std::vector<std::unique_ptr<ObsOperator>> hops;
+  std::vector<std::unique_ptr<LinearObsOperator>> hoptls;
+
+  std::vector<eckit::LocalConfiguration> typeconfs;
+  conf.get("observations", typeconfs);
+  for (const eckit::LocalConfiguration & typeconf : typeconfs) {
+    const int loadsBefore = loadCount();
+
+    const eckit::LocalConfiguration obsconf(typeconf, "obs space");
+    obsspaces.emplace_back(new ioda::ObsSpace(obsconf, oops::mpi::world(), bgn, end,
+                                              oops::mpi::myself()));
+    ioda::ObsSpace & ospace = *obsspaces.back();
+
+    const eckit::LocalConfiguration obsopconf(typeconf, "obs operator");
+    hops.emplace_back(new ObsOperator(ospace, obsopconf));
+    hoptls.emplace_back(new LinearObsOperator(ospace, obsopconf));
+    const ObsOperator & hop = *hops.back();
+    LinearObsOperator & hoptl = *hoptls.back();
+
+    const eckit::LocalConfiguration gconf(typeconf, "geovals");
+    const GeoVaLs gval(gconf, ospace, hop.requiredVars());
+
+    eckit::LocalConfiguration biasconf = typeconf.getSubConfiguration("obs bias");
+    ObsBiasParameters biasparams;
+    biasparams.validateAndDeserialize(biasconf);
+    const ObsBias ybias(ospace, biasparams);
+
+    std::unique_ptr<Locations> locs(hop.locations());
+    ObsDiagnostics diags(ospace, *locs, oops::Variables());
+    ioda::ObsVector hofx(ospace);
+    hop.simulateObs(gval, hofx, ybias, diags);
+    hoptl.setTrajectory(gval, ybias);
+
+    const int loads = loadCount() - loadsBefore;
+    oops::Log::test() << ospace.obsname() << ": " << loads << " coefficient loads" << std::endl;
+    EXPECT_EQUAL(loads, typeconf.getInt("expected coefficient loads"));
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+class CoefficientSharing : public oops::Test {
+ public:
+  /// \p loadCount must return the number of times coefficients have been loaded so far.
+  explicit CoefficientSharing(std::function<int()> loadCount) : loadCount_(loadCount) {}
+  virtual ~CoefficientSharing() = default;
+ private:
+  std::string testid() const override {return "ufo::test::CoefficientSharing";}
+
+  void register_tests() const override {
+    std::vector<eckit::testing::Test>& ts = eckit::testing::specification();
+
+    const std::function<int()> loadCount = loadCount_;
+    ts.emplace_back(CASE("ufo/CoefficientSharing/testCoefficientSharing", loadCount)
+      { testCoefficientSharing(loadCount); });
+  }
+
+  void clear() const override {}
+
+  std::function<int()> loadCount_;
+};
+
+// -----------------------------------------------------------------------------
+
+}  // namespace test
+}  // namespace ufo
+
+#endif  // TEST_UFO_COEFFICIENTSHARING_H_
@@ -0,0 +1,262 @@
+/*
+ * (C) Crown copyright 2021, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef TEST_UFO_DATAEXTRACTOR_H_
+#define TEST_UFO_DATAEXTRACTOR_H_
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+#define ECKIT_TESTING_SELF_REGISTER_CASES 0
+
+#include "eckit/testing/Test.h"
+#include "oops/runs/Test.h"
+#include "oops/util/Expect.h"
+#include "oops/util/FloatCompare.h"
+#include "ufo/utils/dataextractor/DataExtractor.h"
+
+namespace ufo {
+namespace test {
+
+/// A row of the table from which values are extracted.
+struct Row {
+  int station;
+  float pressure;
+  int height;
+  float payload;
+};
+
+/// Return the rows of station \p station, sorted by pressure.
+std::vector<Row> stationRows(const std::vector<Row> & rows, int station) {
+  std::vector<Row> result;
+  for (const Row & row : rows)
+    if (row.station == station)
+      result.push_back(row);
+  std::stable_sort(result.begin(), result.end(),
+                   [](const Row & a, const Row & b) { return a.pressure < b.pressure; });
+  return result;
+}
+
+/// Table with three stations:
+/// * station 1: 41 pressures equispaced by 0.1 hPa; the values read from the file deviate from
+///   exact equal spacing because of rounding;
+/// * station 2: 12 irregularly spaced pressures;
+/// * station 3: pressures with repeated values, distinguished by height.
+/// The rows are written in a scrambled order, so that DataExtractor needs to sort them.
+std::vector<Row> makeRows(bool withRepeatedValues) {
+  std::vector<Row> rows;
+  char text[32];
+  for (int k = 0; k <= 40; ++k) {
+    std::snprintf(text, sizeof(text), "%.1f", 1000.0 + 0.1 * k);
+    rows.push_back(Row{1, std::stof(text), 1, 1000.0f + k});
+  }
+  for (int k = 0; k < 12; ++k)
+    rows.push_back(Row{2, 500.0f + 3.0f * k * k + (k % 3), 1, 2000.0f + k});
+  if (withRepeatedValues) {
+    const std::vector<float> pressures{200.0f, 210.0f, 210.0f, 210.0f, 220.0f, 240.0f, 240.0f};
+    std::vector<int> heights{1, 1, 2, 3, 1, 1, 2};
+    for (size_t k = 0; k < pressures.size(); ++k)
+      rows.push_back(Row{3, pressures[k], heights[k], 3000.0f + k});
+  }
+  // Scramble the rows.
+  std::vector<Row> scrambled;
+  const size_t stride = 7;
+  for (size_t start = 0; start < stride; ++start)
+    for (size_t k = start; k < rows.size(); k += stride)
+      scrambled.push_back(rows[rows.size() - 1 - k]);
+  return scrambled;
+}
+
+void writeCsv(const std::string & filename, const std::vector<Row> & rows, bool withHeight) {
+  std::ofstream out(filename);
+  out.precision(std::numeric_limits<float>::max_digits10);
+  out << "station_id@MetaData,air_pressure@MetaData";
+  if (withHeight) out << ",height@MetaData";
+  out << ",air_temperature@ObsBias\n";
+  out << "int,float";
+  if (withHeight) out << ",int";
+  out << ",float\n";
+  for (const Row & row : rows) {
+    out << row.station << "," << row.pressure;
+    if (withHeight) out << "," << row.height;
+    out << "," << row.payload << "\n";
+  }
+}
+
+/// Values at which the pressure coordinate of the rows \p rows is probed: all its values, their
+/// floating-point neighbours, midpoints between consecutive values and values out of range.
+std::vector<float> probes(const std::vector<Row> & rows) {
+  std::vector<float> result;
+  const float inf = std::numeric_limits<float>::infinity();
+  for (size_t i = 0; i < rows.size(); ++i) {
+    const float p = rows[i].pressure;
+    result.push_back(p);
+    result.push_back(std::nextafter(p, -inf));
+    result.push_back(std::nextafter(p, inf));
+    if (i > 0) {
+      const float prev = rows[i - 1].pressure;
+      result.push_back(prev + (p - prev) / 2);
+      result.push_back(prev + (p - prev) / 4);
+      result.push_back(prev + 3 * (p - prev) / 4);
+    }
+  }
+  result.push_back(rows.front().pressure - 1.0f);
+  result.push_back(rows.back().pressure + 1.0f);
+  return result;
+}
+
+/// Index of the first element of \p rows with pressure not less than \p p (found by a linear
+/// search, independent of the DataExtractor's).
+int lowerBoundRef(const std::vector<Row> & rows, float p) {
+  int i = 0;
+  while (i < static_cast<int>(rows.size()) && rows[i].pressure < p)
+    ++i;
+  return i;
+}
+
+/// Index of the row selected by \p method for pressure \p p, or -1 if there is none.
+int selectedRowRef(const std::vector<Row> & rows, InterpMethod method, float p) {
+  const int size = rows.size();
+  int i = lowerBoundRef(rows, p);
+  switch (method) {
+  case InterpMethod::NEAREST:
+    if (i == size) i = size - 1;
+    if (rows[i].pressure > p && i > 0 &&
+        std::abs(rows[i - 1].pressure - p) <= std::abs(rows[i].pressure - p))
+      --i;
+    return i;
+  case InterpMethod::LEAST_UPPER_BOUND:
+    return i < size ? i : -1;
+  case InterpMethod::GREATEST_LOWER_BOUND:
+    if (i == size || rows[i].pressure != p) --i;
+    return i;
+  default:
+    return -1;
+  }
+}
+
+/// Payload of the row of \p rows whose pressure equals that of rows[index] and whose height is
+/// \p height, or NaN if there is none.
+float payloadRef(const std::vector<Row> & rows, int index, int height) {
+  for (const Row & row : rows)
+    if (row.pressure == rows[index].pressure && row.height == height)
+      return row.payload;
+  return std::numeric_limits<float>::quiet_NaN();
+}
+
+/// Create a DataExtractor reading \p filename and extracting values by station, by pressure
+/// (using \p pressureMethod) and optionally by height.
+std::unique_ptr<ufo::DataExtractor> makeExtractor(const std::string & filename,
+                                                  InterpMethod pressureMethod, bool withHeight) {
+  std::unique_ptr<ufo::DataExtractor> extractor(new ufo::DataExtractor(filename, "ObsBias"));
+  extractor->scheduleSort("station_id@MetaData", InterpMethod::EXACT);
+  extractor->scheduleSort("air_pressure@MetaData", pressureMethod);
+  if (withHeight)
+    extractor->scheduleSort("height@MetaData", InterpMethod::EXACT);
+  extractor->sort();
+  return extractor;
+}
+
+void testMatch(InterpMethod method) {
+  const std::vector<Row> rows = makeRows(true);
+  const std::string filename = "dataextractor_match.csv";
+  writeCsv(filename, rows, true);
+
+  // A DataExtractor can't be used any more once an extraction has failed.
+  std::unique_ptr<ufo::DataExtractor> extractor = makeExtractor(filename, method, true);
+  for (int station : {1, 2, 3}) {
+    const std::vector<Row> sorted = stationRows(rows, station);
+    for (float p : probes(sorted)) {
+      const int index = selectedRowRef(sorted, method, p);
+      for (int height : {1, 2, 3}) {
+        extractor->extract(station);
+        if (index < 0) {
+          EXPECT_THROWS(extractor->extract(p));
+          extractor = makeExtractor(filename, method, true);
+          continue;
+        }
+        extractor->extract(p);
+        const float expected = payloadRef(sorted, index, height);
+        if (std::isnan(expected)) {
+          EXPECT_THROWS(extractor->extract(height));
+          extractor = makeExtractor(filename, method, true);
+        } else {
+          extractor->extract(height);
+          EXPECT_EQUAL(extractor->getResult(), expected);
+        }
+      }
+    }
+  }
+  std::remove(filename.c_str());
+}
+
+void testLinear() {
+  const std::vector<Row> rows = makeRows(false);
+  const std::string filename = "dataextractor_linear.csv";
+  writeCsv(filename, rows, false);
+
+  std::unique_ptr<ufo::DataExtractor> extractor =
+      makeExtractor(filename, InterpMethod::LINEAR, false);
+  for (int station : {1, 2}) {
+    const std::vector<Row> sorted = stationRows(rows, station);
+    for (float p : probes(sorted)) {
+      extractor->extract(station);
+      if (p < sorted.front().pressure || p > sorted.back().pressure) {
+        EXPECT_THROWS(extractor->extract(p));
+        extractor = makeExtractor(filename, InterpMethod::LINEAR, false);
+        continue;
+      }
+      extractor->extract(p);
+      const float result = extractor->getResult();
+
+      const int i = lowerBoundRef(sorted, p);
+      float expected;
+      if (sorted[i].pressure == p) {
+        expected = sorted[i].payload;
+      } else {
+        const Row & lower = sorted[i - 1];
+        const Row & upper = sorted[i];
+        expected = ((static_cast<float>(p - lower.pressure) /
+                     static_cast<float>(upper.pressure - lower.pressure)) *
+                    (upper.payload - lower.payload)) + lower.payload;
+      }
+      EXPECT(oops::is_close_relative(result, expected, 1.0e-6f));
+    }
+  }
+  std::remove(filename.c_str());
+}
+
+class DataExtractor : public oops::Test {
+ private:
+  std::string testid() const override {return "ufo::test::DataExtractor";}
+
+  void register_tests() const override {
+    std::vector<eckit::testing::Test>& ts = eckit::testing::specification();
+
+    ts.emplace_back(CASE("ufo/DataExtractor/nearest")
+                    { testMatch(InterpMethod::NEAREST); });
+    ts.emplace_back(CASE("ufo/DataExtractor/leastUpperBound")
+                    { testMatch(InterpMethod::LEAST_UPPER_BOUND); });
+    ts.emplace_back(CASE("ufo/DataExtractor/greatestLowerBound")
+                    { testMatch(InterpMethod::GREATEST_LOWER_BOUND); });
+    ts.emplace_back(CASE("ufo/DataExtractor/linear")
+                    { testLinear(); });
+  }
+
+  void clear() const override {}
+};
+
+}  // namespace test
+}  // namespace ufo
+
+#endif  // TEST_UFO_DATAEXTRACTOR_H_
@@ -0,0 +1,178 @@
+/*
+ * (C) Crown copyright 2021, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef TEST_UFO_FORMULAS_H_
+#define TEST_UFO_FORMULAS_H_
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include "eckit/testing/Test.h"
+#include "oops/runs/Test.h"
+#include "oops/util/Expect.h"
+#include "oops/util/missingValues.h"
+#include "ufo/utils/Constants.h"
+#include "ufo/variabletransforms/Formulas.h"
+#include "ufo/variabletransforms/Formulas.interface.h"
+
+namespace ufo {
+namespace test {
+
+const std::vector<formulas::MethodFormulation> allFormulations{
+  formulas::UKMO, formulas::NCAR, formulas::NOAA, formulas::DEFAULT,
+  formulas::Murphy, formulas::Sonntag, formulas::Walko, formulas::Rogers};
+
+const std::vector<formulas::MethodFormulation> correctedFormulations{
+  formulas::UKMO, formulas::NCAR, formulas::NOAA, formulas::Sonntag};
+
+/// Temperatures from 100 K to 400 K (beyond the range of the tables) and a missing value.
+std::vector<float> temperatures() {
+  std::vector<float> temps;
+  for (float t = 100.0f; t <= 400.0f; t += 0.37f)
+    temps.push_back(t);
+  temps.push_back(util::missingValue(1.0f));
+  return temps;
+}
+
+CASE("ufo/Formulas/SatVaporPres_fromTemp") {
+  const float missing = util::missingValue(1.0f);
+  const std::vector<float> temps = temperatures();
+  for (formulas::MethodFormulation formulation : allFormulations) {
+    std::vector<float> e_sub_s;
+    formulas::SatVaporPres_fromTemp(temps, e_sub_s, formulation);
+    EXPECT_EQUAL(e_sub_s.size(), temps.size());
+    for (size_t i = 0; i < temps.size(); ++i) {
+      if (temps[i] == missing)
+        EXPECT_EQUAL(e_sub_s[i], missing);
+      else
+        EXPECT_EQUAL(e_sub_s[i], formulas::SatVaporPres_fromTemp(temps[i], formulation));
+    }
+  }
+}
+
+CASE("ufo/Formulas/SatVaporPres_correction") {
+  const float missing = util::missingValue(1.0f);
+  const std::vector<float> temps = temperatures();
+  for (formulas::MethodFormulation formulation : correctedFormulations) {
+    std::vector<float> e_sub_s;
+    formulas::SatVaporPres_fromTemp(temps, e_sub_s, formulation);
+    const std::vector<float> uncorrected = e_sub_s;
+    formulas::SatVaporPres_correction(e_sub_s, temps, formulation);
+    for (size_t i = 0; i < temps.size(); ++i) {
+      if (temps[i] == missing)
+        EXPECT_EQUAL(e_sub_s[i], missing);
+      else
+        EXPECT_EQUAL(e_sub_s[i], formulas::SatVaporPres_correction(uncorrected[i], temps[i],
+                                                                   formulation));
+    }
+  }
+
+  std::vector<float> e_sub_s(temps.size(), 1000.0f);
+  EXPECT_THROWS(formulas::SatVaporPres_correction(e_sub_s, temps, formulas::Walko));
+  e_sub_s.pop_back();
+  EXPECT_THROWS(formulas::SatVaporPres_correction(e_sub_s, temps, formulas::UKMO));
+}
+
+CASE("ufo/Formulas/Humidity") {
+  const float missing = util::missingValue(1.0f);
+  const std::vector<float> Psat{1000.0f, 3000.0f, 60000.0f, missing, 2000.0f};
+  const std::vector<float> P{100000.0f, 50000.0f, 50000.0f, 80000.0f, missing};
+  const std::vector<float> T{290.0f, 300.0f, 310.0f, 280.0f, 270.0f};
+
+  std::vector<float> QSat, Tv;
+  formulas::Qsat_From_Psat(Psat, P, QSat);
+  formulas::VirtualTemp_From_Psat_P_T(Psat, P, T, Tv);
+  for (size_t i = 0; i < Psat.size(); ++i) {
+    if (Psat[i] == missing || P[i] == missing) {
+      EXPECT_EQUAL(QSat[i], missing);
+      EXPECT_EQUAL(Tv[i], missing);
+    } else {
+      EXPECT_EQUAL(QSat[i], formulas::Qsat_From_Psat(Psat[i], P[i]));
+      EXPECT_EQUAL(Tv[i], formulas::VirtualTemp_From_Psat_P_T(Psat[i], P[i], T[i]));
+    }
+  }
+}
+
+CASE("ufo/Formulas/Height_To_Pressure_ICAO_atmos") {
+  const float missing = util::missingValue(1.0f);
+  const std::vector<float> heights{missing, -6000.0f, -100.0f, 0.0f, 5000.0f, 11000.0f,
+                                   15000.0f, 20000.0f, 30000.0f};
+  std::vector<float> pressures;
+  formulas::Height_To_Pressure_ICAO_atmos(heights, pressures);
+  EXPECT_EQUAL(pressures.size(), heights.size());
+  for (size_t i = 0; i < heights.size(); ++i)
+    EXPECT_EQUAL(pressures[i], formulas::Height_To_Pressure_ICAO_atmos(heights[i]));
+  EXPECT_EQUAL(pressures[0], missing);
+  EXPECT_EQUAL(pressures[1], missing);
+}
+
+CASE("ufo/Formulas/SatVaporPresTable") {
+  const float missing = util::missingValue(1.0f);
+  const std::vector<float> temps = temperatures();
+  std::vector<double> tempsDouble(temps.begin(), temps.end());
+  tempsDouble.back() = util::missingValue(1.0);
+  for (formulas::MethodFormulation formulation : allFormulations) {
+    std::vector<float> exact, tabulated;
+    formulas::SatVaporPres_fromTemp(temps, exact, formulation);
+    formulas::SatVaporPres_fromTemp(temps, tabulated, formulation, true);
+    // The formula evaluated in double precision.
+    std::vector<double> exactDouble(temps.size());
+    const int nvals = temps.size();
+    const int formulationInt = formulation;
+    formulas::ufo_formulas_satvaporpres_fromtemp(nvals, tempsDouble.data(), exactDouble.data(),
+                                                 formulationInt);
+    EXPECT_EQUAL(tabulated.size(), temps.size());
+    for (size_t i = 0; i < temps.size(); ++i) {
+      if (temps[i] == missing) {
+        EXPECT_EQUAL(tabulated[i], missing);
+      } else if (temps[i] < 150.0f || temps[i] > 350.0f) {
+        EXPECT_EQUAL(tabulated[i], exact[i]);
+      } else {
+        EXPECT(std::abs(tabulated[i] - exactDouble[i]) <= 2e-6 * exactDouble[i]);
+      }
+    }
+  }
+  // Tables are created only once.
+  EXPECT(&formulas::SatVaporPresTable::get(formulas::Sonntag) ==
+         &formulas::SatVaporPresTable::get(formulas::Sonntag));
+}
+
+CASE("ufo/Formulas/FortranInterface") {
+  // The saturation vapour pressure used by the GSI-based Fortran operators.
+  const std::vector<double> temps{200.0, 250.0, 273.15, 300.0};
+  std::vector<double> e_sub_s(temps.size());
+  const int nvals = temps.size();
+  const int formulation = formulas::Rogers;
+  formulas::ufo_formulas_satvaporpres_fromtemp(nvals, temps.data(), e_sub_s.data(),
+                                               formulation);
+  for (size_t i = 0; i < temps.size(); ++i) {
+    const double t_c = temps[i] - ufo::Constants::t0c;
+    const double expected = ufo::Constants::es_w_0 * std::exp(17.67 * t_c / (t_c + 243.5));
+    EXPECT(std::abs(e_sub_s[i] - expected) <= 1e-12 * expected);
+  }
+
+  const std::vector<double> uncorrected = e_sub_s;
+  const int ukmo = formulas::UKMO;
+  formulas::ufo_formulas_satvaporpres_correction(nvals, e_sub_s.data(), temps.data(), ukmo);
+  for (size_t i = 0; i < temps.size(); ++i)
+    EXPECT(e_sub_s[i] < uncorrected[i] && e_sub_s[i] > 0.999 * uncorrected[i]);
+}
+
+class Formulas : public oops::Test {
+ private:
+  std::string testid() const override {return "ufo::test::Formulas";}
+
+  void register_tests() const override {}
+
+  void clear() const override {}
+};
+
+}  // namespace test
+}  // namespace ufo
+
+#endif  // TEST_UFO_FORMULAS_H_
@@ -0,0 +1,62 @@
+/*
+ * (C) Crown copyright 2021, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef TEST_UFO_GNSSROONEDVARCHECK_H_
+#define TEST_UFO_GNSSROONEDVARCHECK_H_
+
+#include <string>
+#include <vector>
+
+#include "eckit/config/LocalConfiguration.h"
+#include "eckit/testing/Test.h"
+#include "oops/runs/Test.h"
+#include "oops/util/Expect.h"
+#include "test/TestEnvironment.h"
+
+namespace ufo {
+namespace test {
+
+// -----------------------------------------------------------------------------
+extern "C" {
+  /// Applies the flag update of the GNSS-RO 1D-Var check to each profile listed in the
+  /// configuration. Returns 1 if the test passes, 0 if the test fails
+  int test_gnssroonedvarcheck_set_flags_f90(const eckit::Configuration &);
+}
+
+/// Tests that the 1D-Var check writes the flags of the observations of a profile at their
+/// indices rather than at their positions in the sorted order
+void testSetFlags() {
+  const eckit::LocalConfiguration conf(::test::TestEnvironment::config());
+  EXPECT(test_gnssroonedvarcheck_set_flags_f90(conf));
+}
+
+// -----------------------------------------------------------------------------
+
+class GNSSROOneDVarCheck : public oops::Test {
+ public:
+  GNSSROOneDVarCheck() {}
+  virtual ~GNSSROOneDVarCheck() {}
+
+ private:
+  std::string testid() const override {return "ufo::test::GNSSROOneDVarCheck";}
+
+  void register_tests() const override {
+    std::vector<eckit::testing::Test>& ts = eckit::testing::specification();
+
+    ts.emplace_back(CASE("ufo/GNSSROOneDVarCheck/testSetFlags")
+      { testSetFlags(); });
+  }
+
+  void clear() const override {}
+};
+
+// -----------------------------------------------------------------------------
+
+}  // namespace test
+}  // namespace ufo
+
+#endif  // TEST_UFO_GNSSROONEDVARCHECK_H_
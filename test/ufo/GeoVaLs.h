@@ -355,6 +355,73 @@ void testGeoVaLsAllocatePutGet() {
 
 // -----------------------------------------------------------------------------
 
+void testGeoVaLsSinglePrecision() {
+  const eckit::LocalConfiguration conf(::test::TestEnvironment::config());
+  const eckit::LocalConfiguration testconf(conf, "geovals get test");
+
+  const std::string var1 = "variable1";
+  const std::string var2 = "variable2";
+  const Locations locs(testconf, oops::mpi::world());
+  GeoVaLs gval(locs, oops::Variables({var1, var2}));
+
+  /// Store the first variable in single precision before allocating it
+  gval.setSinglePrecision(oops::Variables({var1}));
+  const int nlevs = 3;
+  gval.allocate(nlevs, oops::Variables({var1, var2}));
+  EXPECT_EQUAL(gval.nlevs(var1), nlevs);
+  EXPECT_EQUAL(gval.nlevs(var2), nlevs);
+
+  /// Doubles put in the first variable are rounded to single precision, floats are exact
+  const double value = 3.01234567890123;
+  const double rounded = static_cast<float>(value);
+  EXPECT(rounded != value);
+  for (int jlev = 1; jlev <= nlevs; ++jlev) {
+    gval.put(std::vector<double>(gval.nlocs(), jlev * value), var1, jlev);
+    gval.put(std::vector<double>(gval.nlocs(), jlev * value), var2, jlev);
+  }
+  std::vector<double> testvalues_double(gval.nlocs());
+  gval.get(testvalues_double, var1, 1);
+  EXPECT_EQUAL(testvalues_double, std::vector<double>(gval.nlocs(), rounded));
+  gval.get(testvalues_double, var2, 1);
+  EXPECT_EQUAL(testvalues_double, std::vector<double>(gval.nlocs(), value));
+  std::vector<float> testvalues_float(gval.nlocs());
+  gval.get(testvalues_float, var1, 1);
+  EXPECT_EQUAL(testvalues_float, std::vector<float>(gval.nlocs(), value));
+  for (size_t jloc = 0; jloc < gval.nlocs(); ++jloc) {
+    std::vector<float> refvalues_loc(nlevs);
+    for (int jlev = 0; jlev < nlevs; ++jlev)
+      refvalues_loc[jlev] = static_cast<float>((jlev + 1) * value);
+    std::vector<float> testvalues_loc(nlevs);
+    gval.getAtLocation(testvalues_loc, var1, jloc);
+    EXPECT_EQUAL(testvalues_loc, refvalues_loc);
+    gval.putAtLocation(refvalues_loc, var1, jloc);
+  }
+
+  /// Copies keep the storage precision
+  const GeoVaLs gvalcopy(gval);
+  gvalcopy.get(testvalues_double, var1, 1);
+  EXPECT_EQUAL(testvalues_double, std::vector<double>(gval.nlocs(), rounded));
+  gvalcopy.put(std::vector<double>(gval.nlocs(), value), var1, 1);
+  gvalcopy.get(testvalues_double, var1, 1);
+  EXPECT_EQUAL(testvalues_double, std::vector<double>(gval.nlocs(), rounded));
+
+  /// Arithmetic converts to double precision without changing values
+  gval *= 2.0;
+  gval.get(testvalues_double, var1, 1);
+  EXPECT_EQUAL(testvalues_double, std::vector<double>(gval.nlocs(), 2.0 * rounded));
+  gval.put(std::vector<double>(gval.nlocs(), value), var1, 1);
+  gval.get(testvalues_double, var1, 1);
+  EXPECT_EQUAL(testvalues_double, std::vector<double>(gval.nlocs(), value));
+
+  /// Values already allocated are rounded when stored in single precision
+  gval.setSinglePrecision(oops::Variables({var2}));
+  gval.get(testvalues_double, var2, 1);
+  EXPECT_EQUAL(testvalues_double, std::vector<double>(gval.nlocs(), 2.0 * rounded));
+  EXPECT_EQUAL(gval.nlevs(var2), nlevs);
+}
+
+// -----------------------------------------------------------------------------
+
 class GeoVaLs : public oops::Test {
  public:
   GeoVaLs() = default;
@@ -369,6 +436,8 @@ class GeoVaLs : public oops::Test {
       { testGeoVaLs(); });
     ts.emplace_back(CASE("ufo/GeoVaLs/testGeoVaLsAllocatePutGet")
       { testGeoVaLsAllocatePutGet(); });
+    ts.emplace_back(CASE("ufo/GeoVaLs/testGeoVaLsSinglePrecision")
+      { testGeoVaLsSinglePrecision(); });
   }
 
   void clear() const override {}
@@ -74,7 +74,6 @@ void testMetOfficeBuddyCheck(const eckit::LocalConfiguration &conf) {
   for (const std::string &name : diagConf.keys())
     diagVars.push_back(name);
   ufo::ObsDiagnostics obsDiags(obsSpace, locations, diagVars);
-  obsDiags.allocate(1, diagVars);
   for (const std::string &name : diagConf.keys()) {
     const std::vector<double> diag = diagConf.getDoubleVector(name);
     obsDiags.save(diag, name, 1);
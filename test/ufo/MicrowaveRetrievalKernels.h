@@ -0,0 +1,234 @@
+/*
+ * (C) Crown copyright 2021, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef TEST_UFO_MICROWAVERETRIEVALKERNELS_H_
+#define TEST_UFO_MICROWAVERETRIEVALKERNELS_H_
+
+#include <algorithm>
+#include <chrono>  // NOLINT(build/c++11)
+#include <cmath>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "eckit/testing/Test.h"
+#include "oops/runs/Test.h"
+#include "oops/util/Expect.h"
+#include "oops/util/FloatCompare.h"
+#include "oops/util/Logger.h"
+#include "oops/util/missingValues.h"
+#include "test/TestEnvironment.h"
+#include "ufo/filters/obsfunctions/CLWRetMW.h"
+#include "ufo/filters/obsfunctions/CLWRetMW_SSMIS.h"
+#include "ufo/utils/Constants.h"
+
+namespace ufo {
+namespace test {
+
+/// Scalar implementations of the retrievals, with a branch per location, against which the
+/// batched kernels are checked and timed.
+namespace reference {
+
+void cloudLiquidWater(const std::vector<float> & szas, const std::vector<float> & tsavg,
+                      const std::vector<float> & water_frac, const std::vector<float> & bt238,
+                      const std::vector<float> & bt314, std::vector<float> & out) {
+  const float t0c = Constants::t0c;
+  const float d1 = 0.754, d2 = -2.265;
+  const float c1 = 8.240, c2 = 2.622, c3 = 1.846;
+  for (size_t iloc = 0; iloc < water_frac.size(); ++iloc) {
+    if (water_frac[iloc] >= 0.99) {
+      float cossza = cos(Constants::deg2rad * szas[iloc]);
+      float d0 = c1 - (c2 - c3 * cossza) * cossza;
+      if (tsavg[iloc] > t0c - 1.0 && bt238[iloc] <= 284.0 && bt314[iloc] <= 284.0
+                                  && bt238[iloc] > 0.0 && bt314[iloc] > 0.0) {
+        out[iloc] = cossza * (d0 + d1 * std::log(285.0 - bt238[iloc])
+                                 + d2 * std::log(285.0 - bt314[iloc]));
+        out[iloc] = std::max(0.f, out[iloc]);
+      } else {
+        out[iloc] = CLWRetMW::getBadValue();
+      }
+    }
+  }
+}
+
+void clw_retr_amsr2(const std::vector<float> & bt18v, const std::vector<float> & bt18h,
+                    const std::vector<float> & bt36v, const std::vector<float> & bt36h,
+                    std::vector<float> & out) {
+  const float a0_clw = -0.65929;
+  const float regr_coeff_clw[3] = {-0.00013, 1.64692, -1.51916};
+  for (size_t iloc = 0; iloc < bt18v.size(); ++iloc) {
+    if (bt18v[iloc] <= bt18h[iloc] || bt36v[iloc] <= bt36h[iloc]) {
+      out[iloc] = CLWRetMW::getBadValue();
+    } else {
+      const float pred0 = log(bt18v[iloc] - bt18h[iloc]);
+      const float pred1 = log(bt36v[iloc] - bt36h[iloc]);
+      float clw = a0_clw + bt36h[iloc]*regr_coeff_clw[0];
+      clw = clw + pred0 * regr_coeff_clw[1];
+      clw = clw + pred1 * regr_coeff_clw[2];
+      out[iloc] = std::min(6.0f, std::max(0.0f, clw));
+    }
+  }
+}
+
+void cloudLiquidWaterSSMIS(const std::vector<std::vector<float>> & bt,
+                           const std::vector<float> & water_frac, std::vector<float> & clw) {
+  const float missing = util::missingValue(missing);
+  const size_t nchannels = 7;
+  const std::vector<float> ap = {0.00424, -2.03627, -2.52875, 0.80170, -3.86053, -7.43913, 1.53650};
+  const std::vector<float> bp = {1.00027, 1.00623, 0.99642, 0.99139,  1.00550, 1.03121, 0.99317};
+  const std::vector<float> cp0 = {0.969, 0.969, 0.974, 0.986, 0.986, 0.988, 0.988};
+  const std::vector<float> dp0 = {0.00415, 0.00473, 0.0107, 0.02612, 0.0217, 0.01383, 0.01947};
+  std::vector<float> cp(nchannels), dp(nchannels);
+  for (size_t i = 0; i < nchannels; ++i) {
+    cp[i] = 1.0 / (cp0[i]*(1.0-dp0[i]));
+    dp[i] = cp[i]*dp0[i];
+  }
+
+  for (size_t iloc = 0; iloc < water_frac.size(); ++iloc) {
+    clw[iloc] = missing;
+    if (water_frac[iloc] < 0.99)
+      continue;
+    std::vector<float> tax(nchannels, 999.0f), tay(nchannels);
+    bool valid = true;
+    for (size_t ich = 0; ich < nchannels; ++ich)
+      valid = valid && bt[ich][iloc] > 0.0f && bt[ich][iloc] < 300.0f;
+    if (valid) {
+      tax[0] = (bt[0][iloc]*cp[1] + bt[1][iloc]*dp[0])/(cp[0]*cp[1] - dp[0]*dp[1]);
+      tax[1] = (bt[0][iloc]*dp[1] + bt[1][iloc]*cp[0])/(cp[0]*cp[1] - dp[0]*dp[1]);
+      tax[2] = 1.0/cp[2]*(bt[2][iloc] + dp[2]*(0.653*tax[1] + 96.6));
+      tax[3] = (bt[3][iloc]*cp[4] + bt[4][iloc]*dp[3])/(cp[3]*cp[4] - dp[3]*dp[4]);
+      tax[4] = (bt[3][iloc]*dp[4] + bt[4][iloc]*cp[3])/(cp[3]*cp[4] - dp[3]*dp[4]);
+      tax[5] = (bt[5][iloc]*cp[6] + bt[6][iloc]*dp[5])/(cp[5]*cp[6] - dp[5]*dp[6]);
+      tax[6] = (bt[5][iloc]*dp[6] + bt[6][iloc]*cp[5])/(cp[5]*cp[6] - dp[5]*dp[6]);
+    }
+    for (size_t ich = 0; ich < nchannels; ++ich)
+      tay[ich] = ap[ich] + bp[ich]*tax[ich];
+
+    clw[iloc] = 0.0;
+    float alg1 = 0.0;
+    if (tay[1] < 285.0 && tay[2] < 285.0)
+      alg1 = -3.20*(std::log(290.0f-tay[1]) - 2.80 - 0.42*std::log(290.0f-tay[2]));
+    if (alg1 > 0.70) {
+      clw[iloc] = std::max(0.0f, std::min(alg1, 6.0f));
+      continue;
+    }
+    float alg2 = 0.0;
+    if (tay[4] < 285.0 && tay[2] < 285.0)
+      alg2 = -1.66*(std::log(290.0f-tay[4]) - 2.90 - 0.349*std::log(290.0f-tay[2]));
+    if (alg2 > 0.28) {
+      clw[iloc] = std::max(0.0f, std::min(alg2, 6.0f));
+      continue;
+    }
+    const float tby1 = cp[0]*tay[0] - dp[0]*tay[1];
+    const float tby3 = cp[2]*tay[2] - dp[2]*(0.653*tay[1] + 96.6);
+    const float tby4 = cp[3]*tay[3] - dp[3]*tay[4];
+    const float tpwc = 232.89 - 0.1486*tby1 - 0.3695*tby4 - (1.8291 - 0.006193*tby3)*tby3;
+    if (tpwc < 30.0) {
+      if (tay[6] < 285.0 && tay[2] < 285.0) {
+        const float alg3 = -0.44*(std::log(290.f-tay[6]) + 1.60
+                                  - 1.354*std::log(290.f-tay[2]));
+        clw[iloc] = std::max(0.0f, std::min(alg3, 6.0f));
+      }
+    } else if (alg2 > 0.0) {
+      clw[iloc] = std::max(0.0f, std::min(alg2, 6.0f));
+    }
+  }
+}
+
+}  // namespace reference
+
+/// Number of locations at which the kernels are evaluated.
+const size_t numLocations = 200000;
+
+/// Return \p n values drawn uniformly from [min, max), about 1% of which are missing.
+std::vector<float> randomValues(std::mt19937 & generator, size_t n, float min, float max) {
+  const float missing = util::missingValue(missing);
+  std::uniform_real_distribution<float> values(min, max);
+  std::uniform_real_distribution<float> uniform(0.0f, 1.0f);
+  std::vector<float> result(n);
+  for (float & x : result)
+    x = uniform(generator) < 0.01f ? missing : values(generator);
+  return result;
+}
+
+/// Return the wall-clock time (in seconds) taken by the fastest of several calls to \p f.
+double fastestRun(const std::function<void()> & f) {
+  double fastest = 0.0;
+  for (int run = 0; run < 5; ++run) {
+    const auto start = std::chrono::steady_clock::now();
+    f();
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    fastest = run == 0 ? elapsed.count() : std::min(fastest, elapsed.count());
+  }
+  return fastest;
+}
+
+/// Check that \p kernel and \p referenceKernel produce the same results and log their costs.
+void compareKernels(const std::string & name, std::vector<float> & out,
+                    std::vector<float> & referenceOut, const std::function<void()> & kernel,
+                    const std::function<void()> & referenceKernel) {
+  const double time = fastestRun(kernel);
+  const double referenceTime = fastestRun(referenceKernel);
+  oops::Log::info() << name << ": " << numLocations << " locations, batched kernel "
+                    << time << " s, scalar reference " << referenceTime << " s" << std::endl;
+  for (size_t iloc = 0; iloc < out.size(); ++iloc)
+    EXPECT(oops::is_close_relative(out[iloc], referenceOut[iloc], 1e-5f));
+}
+
+CASE("ufo/MicrowaveRetrievalKernels/CLWRetMW") {
+  std::mt19937 generator(1);
+  const std::vector<float> szas = randomValues(generator, numLocations, 0.0f, 60.0f);
+  const std::vector<float> tsavg = randomValues(generator, numLocations, 265.0f, 305.0f);
+  const std::vector<float> waterFrac = randomValues(generator, numLocations, 0.97f, 1.0f);
+  const std::vector<float> bt238 = randomValues(generator, numLocations, 150.0f, 290.0f);
+  const std::vector<float> bt314 = randomValues(generator, numLocations, 150.0f, 290.0f);
+  std::vector<float> out(numLocations, 0.0f), referenceOut(numLocations, 0.0f);
+  compareKernels("CLWRetMW::cloudLiquidWater", out, referenceOut,
+                 [&] { CLWRetMW::cloudLiquidWater(szas, tsavg, waterFrac, bt238, bt314, out); },
+                 [&] { reference::cloudLiquidWater(szas, tsavg, waterFrac, bt238, bt314,
+                                                   referenceOut); });
+}
+
+CASE("ufo/MicrowaveRetrievalKernels/CLWRetMW_AMSR2") {
+  std::mt19937 generator(2);
+  const std::vector<float> bt18v = randomValues(generator, numLocations, 180.0f, 280.0f);
+  const std::vector<float> bt18h = randomValues(generator, numLocations, 100.0f, 200.0f);
+  const std::vector<float> bt36v = randomValues(generator, numLocations, 190.0f, 280.0f);
+  const std::vector<float> bt36h = randomValues(generator, numLocations, 120.0f, 210.0f);
+  std::vector<float> out(numLocations, 0.0f), referenceOut(numLocations, 0.0f);
+  compareKernels("CLWRetMW::clw_retr_amsr2", out, referenceOut,
+                 [&] { CLWRetMW::clw_retr_amsr2(bt18v, bt18h, bt36v, bt36h, out); },
+                 [&] { reference::clw_retr_amsr2(bt18v, bt18h, bt36v, bt36h, referenceOut); });
+}
+
+CASE("ufo/MicrowaveRetrievalKernels/CLWRetMW_SSMIS") {
+  std::mt19937 generator(3);
+  std::vector<std::vector<float>> bt;
+  for (size_t ich = 0; ich < 7; ++ich)
+    bt.push_back(randomValues(generator, numLocations, 150.0f, 295.0f));
+  std::vector<float> waterFrac = randomValues(generator, numLocations, 0.97f, 1.0f);
+  std::vector<float> out(numLocations, 0.0f), referenceOut(numLocations, 0.0f);
+  compareKernels("CLWRetMW_SSMIS::cloudLiquidWater", out, referenceOut,
+                 [&] { CLWRetMW_SSMIS::cloudLiquidWater(bt[0], bt[1], bt[2], bt[3], bt[4],
+                                                        bt[5], bt[6], waterFrac, out); },
+                 [&] { reference::cloudLiquidWaterSSMIS(bt, waterFrac, referenceOut); });
+}
+
+class MicrowaveRetrievalKernels : public oops::Test {
+ private:
+  std::string testid() const override {return "ufo::test::MicrowaveRetrievalKernels";}
+
+  void register_tests() const override {}
+
+  void clear() const override {}
+};
+
+}  // namespace test
+}  // namespace ufo
+
+#endif  // TEST_UFO_MICROWAVERETRIEVALKERNELS_H_
@@ -0,0 +1,106 @@
+/*
+ * (C) Crown copyright 2021, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef TEST_UFO_NODESHAREDVECTOR_H_
+#define TEST_UFO_NODESHAREDVECTOR_H_
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#define ECKIT_TESTING_SELF_REGISTER_CASES 0
+
+#include "eckit/mpi/Comm.h"
+#include "eckit/testing/Test.h"
+#include "oops/mpi/mpi.h"
+#include "oops/runs/Test.h"
+#include "oops/util/Logger.h"
+#include "ufo/utils/NodeSharedVector.h"
+
+namespace ufo {
+namespace test {
+
+/// Number of elements held by the process with rank \p rank: process 1 holds none, so that
+/// empty slices are exercised too.
+size_t localSize(size_t rank) {
+  return rank == 1 ? 0 : 2 * rank + 3;
+}
+
+/// Value of the element with global index \p i.
+template <typename T>
+T expectedValue(size_t i) {
+  return static_cast<T>(3 * i + 1);
+}
+
+/// Gather values of type T held by all processes into node-shared memory and check that each
+/// process sees the values held by all processes, in the order of their ranks.
+template <typename T>
+void checkGather(const std::shared_ptr<const NodeSharedLayout> & layout,
+                 const eckit::mpi::Comm & comm) {
+  size_t offset = 0;
+  for (size_t rank = 0; rank < comm.rank(); ++rank)
+    offset += localSize(rank);
+  std::vector<T> localValues(layout->localSize());
+  for (size_t i = 0; i < localValues.size(); ++i)
+    localValues[i] = expectedValue<T>(offset + i);
+
+  const ufo::NodeSharedVector<T> gathered(layout, localValues);
+  EXPECT_EQUAL(gathered.size(), layout->globalSize());
+  size_t ndiff = 0;
+  for (size_t i = 0; i < gathered.size(); ++i)
+    ndiff += gathered[i] != expectedValue<T>(i);
+  EXPECT(ndiff == 0);
+}
+
+/// Gather arrays of several element types with a single layout whose processes are split into
+/// \p fakeNodes fake nodes (or into real nodes if \p fakeNodes is 0). Fake nodes make the node
+/// leaders exchange their slices even if all processes run on the same machine.
+void testGather(size_t fakeNodes) {
+  const eckit::mpi::Comm & comm = oops::mpi::world();
+  size_t globalSize = 0;
+  for (size_t rank = 0; rank < comm.size(); ++rank)
+    globalSize += localSize(rank);
+
+  auto layout = std::make_shared<const NodeSharedLayout>(comm, localSize(comm.rank()),
+                                                         fakeNodes);
+  EXPECT_EQUAL(layout->localSize(), localSize(comm.rank()));
+  EXPECT_EQUAL(layout->globalSize(), globalSize);
+
+  oops::Log::test() << "Processes: " << comm.size() << ", fake nodes requested: " << fakeNodes
+                    << ", nodes: " << layout->numNodes() << std::endl;
+  if (fakeNodes > 0)
+    EXPECT_EQUAL(layout->numNodes(), std::min<size_t>(fakeNodes, comm.size()));
+
+  checkGather<int>(layout, comm);
+  checkGather<double>(layout, comm);
+  checkGather<unsigned char>(layout, comm);
+  checkGather<size_t>(layout, comm);
+}
+
+class NodeSharedVector : public oops::Test {
+ private:
+  std::string testid() const override {return "ufo::test::NodeSharedVector";}
+
+  void register_tests() const override {
+    std::vector<eckit::testing::Test>& ts = eckit::testing::specification();
+
+    ts.emplace_back(CASE("ufo/NodeSharedVector/gather")
+                    { testGather(0); });
+    ts.emplace_back(CASE("ufo/NodeSharedVector/gatherFakeNodePerProcess")
+                    { testGather(oops::mpi::world().size()); });
+    ts.emplace_back(CASE("ufo/NodeSharedVector/gatherInterleavedFakeNodes")
+                    { testGather(2); });
+  }
+
+  void clear() const override {}
+};
+
+}  // namespace test
+}  // namespace ufo
+
+#endif  // TEST_UFO_NODESHAREDVECTOR_H_
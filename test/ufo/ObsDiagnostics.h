@@ -10,6 +10,7 @@
 
 #include <memory>
 #include <string>
+#include <thread>  // NOLINT(build/c++11)
 #include <vector>
 
 #define ECKIT_TESTING_SELF_REGISTER_CASES 0
@@ -110,6 +111,66 @@ void testObsDiagnostics() {
 
 // -----------------------------------------------------------------------------
 
+/// Write diagnostics from several threads, each writing different levels.
+void testConcurrentSave() {
+  const eckit::LocalConfiguration conf(::test::TestEnvironment::config());
+
+  util::DateTime bgn(conf.getString("window begin"));
+  util::DateTime end(conf.getString("window end"));
+  const eckit::LocalConfiguration obsconf(conf, "obs space");
+  ioda::ObsSpace ospace(obsconf, oops::mpi::world(), bgn, end, oops::mpi::myself());
+  const size_t nlocs = ospace.nlocs();
+
+  eckit::LocalConfiguration obsopconf(conf, "obs operator");
+  ObsOperator hop(ospace, obsopconf);
+  eckit::LocalConfiguration diagconf(conf, "obs diagnostics");
+  oops::Variables diagvars(diagconf, "variables");
+  std::unique_ptr<Locations> locs(hop.locations());
+  const int nlevs = 3;
+  ufo::ObsDiagnostics diags(ospace, *(locs.get()), diagvars,
+                            std::vector<int>(diagvars.size(), nlevs));
+
+  const int nthreads = 4;
+  auto value = [](size_t jvar, int jlev, size_t jloc) {return 1000.0 * jvar + 100.0 * jlev + jloc;};
+
+  // Each thread writes every nthreads-th level of every variable, either through save() or
+  // through a level view.
+  std::vector<std::thread> threads;
+  for (int jthread = 0; jthread < nthreads; ++jthread) {
+    threads.emplace_back([&, jthread]() {
+      for (size_t jvar = 0; jvar < diagvars.size(); ++jvar) {
+        for (int jlev = 1 + jthread; jlev <= nlevs; jlev += nthreads) {
+          if (jvar % 2 == 0) {
+            std::vector<double> vals(nlocs);
+            for (size_t jloc = 0; jloc < nlocs; ++jloc)
+              vals[jloc] = value(jvar, jlev, jloc);
+            diags.save(vals, diagvars[jvar], jlev);
+          } else {
+            const ufo::ObsDiagnostics::LevelView view = diags.level(diagvars[jvar], jlev);
+            for (size_t jloc = 0; jloc < view.size(); ++jloc)
+              view[jloc] = value(jvar, jlev, jloc);
+          }
+        }
+      }
+    });
+  }
+  for (std::thread & thread : threads)
+    thread.join();
+
+  for (size_t jvar = 0; jvar < diagvars.size(); ++jvar) {
+    EXPECT_EQUAL(diags.nlevs(diagvars[jvar]), static_cast<size_t>(nlevs));
+    for (int jlev = 1; jlev <= nlevs; ++jlev) {
+      std::vector<float> vals;
+      diags.get(vals, diagvars[jvar], jlev);
+      EXPECT_EQUAL(vals.size(), nlocs);
+      for (size_t jloc = 0; jloc < nlocs; ++jloc)
+        EXPECT_EQUAL(vals[jloc], static_cast<float>(value(jvar, jlev, jloc)));
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+
 class ObsDiagnostics : public oops::Test {
  public:
   ObsDiagnostics() {}
@@ -122,6 +183,8 @@ class ObsDiagnostics : public oops::Test {
 
     ts.emplace_back(CASE("ufo/ObsDiagnostics/testObsDiagnostics")
       { testObsDiagnostics(); });
+    ts.emplace_back(CASE("ufo/ObsDiagnostics/testConcurrentSave")
+      { testConcurrentSave(); });
   }
 
   void clear() const override {}
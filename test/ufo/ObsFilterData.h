@@ -8,6 +8,7 @@
 #ifndef TEST_UFO_OBSFILTERDATA_H_
 #define TEST_UFO_OBSFILTERDATA_H_
 
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -20,6 +21,7 @@
 #include "oops/mpi/mpi.h"
 #include "oops/runs/Test.h"
 #include "test/TestEnvironment.h"
+#include "ufo/filters/ObsColumnStore.h"
 #include "ufo/filters/ObsFilterData.h"
 #include "ufo/filters/Variables.h"
 #include "ufo/GeoVaLs.h"
@@ -210,6 +212,93 @@ void testObsFilterData() {
 
 // -----------------------------------------------------------------------------
 
+void testObsColumnStore() {
+  const eckit::LocalConfiguration conf(::test::TestEnvironment::config());
+  util::DateTime bgn(conf.getString("window begin"));
+  util::DateTime end(conf.getString("window end"));
+
+  std::vector<eckit::LocalConfiguration> confs;
+  conf.get("obs filter data", confs);
+  for (size_t jconf = 0; jconf < confs.size(); ++jconf) {
+    const eckit::LocalConfiguration obsconf(confs[jconf], "obs space");
+    ioda::ObsSpace ospace(obsconf, oops::mpi::world(), bgn, end, oops::mpi::myself());
+
+    const eckit::LocalConfiguration dataconf(confs[jconf], "test data");
+    std::vector<eckit::LocalConfiguration> varconfs;
+    dataconf.get("float variables", varconfs);
+    const ufo::Variables obsvars(varconfs);
+
+///  data and otherData belong to the same filter chain; directData doesn't belong to any
+    std::shared_ptr<ObsColumnStore> store = std::make_shared<ObsColumnStore>(ospace);
+    ObsFilterData data(ospace);
+    ObsFilterData otherData(ospace);
+    ObsFilterData directData(ospace);
+    data.useColumnStore(store);
+    otherData.useColumnStore(store);
+    data.require(obsvars);
+    data.prefetch();
+
+///  Check that getRef() returns the cached columns (shared by all ObsFilterData objects
+///  using the same store) without using the buffer
+    for (size_t jvar = 0; jvar < obsvars.nvars(); ++jvar) {
+      const Variable var = obsvars.variable(jvar);
+      std::vector<float> buffer, otherBuffer;
+      const std::vector<float> & vec = data.getRef(var, buffer);
+      EXPECT(buffer.empty());
+      EXPECT(&otherData.getRef(var, otherBuffer) == &vec);
+      std::vector<float> ref(ospace.nlocs());
+      ospace.get_db(var.group(), var.variable(), ref);
+      EXPECT(vec == ref);
+    }
+
+///  Check that changes made to the ObsSpace are seen once the store has been invalidated
+    const Variable var = obsvars.variable(0);
+    std::vector<float> buffer;
+    std::vector<float> modified = data.getRef(var, buffer);
+    for (float & value : modified)
+      value += 1.0f;
+    ospace.put_db(var.group(), var.variable(), modified);
+    std::vector<float> vec;
+    directData.get(var, vec);
+    EXPECT(vec == modified);
+    data.invalidateColumnStore();
+    otherData.get(var, vec);
+    EXPECT(vec == modified);
+
+///  Check that starting a new filter stage also discards the cached columns
+    const size_t stage = store->stage();
+    for (float & value : modified)
+      value += 1.0f;
+    ospace.put_db(var.group(), var.variable(), modified);
+    store->startStage();
+    EXPECT(store->stage() == stage + 1);
+    otherData.get(var, vec);
+    EXPECT(vec == modified);
+
+///  Check that the record indices cover all locations
+    size_t nrecordlocs = 0;
+    for (const std::vector<size_t> & record : data.records())
+      nrecordlocs += record.size();
+    EXPECT(nrecordlocs == ospace.nlocs());
+    EXPECT(directData.records() == data.records());
+
+///  Check that while filters run concurrently, required columns are served from the store
+///  and reading the ObsSpace directly fails
+    {
+      ObsColumnStore::ConcurrentAccess concurrentAccess(*store);
+      std::vector<float> concurrentBuffer;
+      EXPECT(data.getRef(var, concurrentBuffer) == modified);
+      EXPECT(concurrentBuffer.empty());
+      EXPECT_THROWS(data.ensureSerial("test"));
+      EXPECT_THROWS(otherData.ensureSerial("test"));
+      directData.ensureSerial("test");
+    }
+    data.ensureSerial("test");
+  }
+}
+
+// -----------------------------------------------------------------------------
+
 class ObsFilterData : public oops::Test {
  public:
   ObsFilterData() {}
@@ -222,6 +311,8 @@ class ObsFilterData : public oops::Test {
 
     ts.emplace_back(CASE("ufo/ObsFilterData/testObsFilterData")
       { testObsFilterData(); });
+    ts.emplace_back(CASE("ufo/ObsFilterData/testObsColumnStore")
+      { testObsColumnStore(); });
   }
 
   void clear() const override {}
@@ -0,0 +1,120 @@
+/*
+ * (C) Crown copyright 2021, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef TEST_UFO_PERFORMANCEMONITOR_H_
+#define TEST_UFO_PERFORMANCEMONITOR_H_
+
+#include <map>
+#include <sstream>
+#include <string>
+
+#include "eckit/testing/Test.h"
+#include "oops/mpi/mpi.h"
+#include "oops/runs/Test.h"
+#include "oops/util/Expect.h"
+#include "ufo/utils/PerformanceMonitor.h"
+
+namespace ufo {
+namespace test {
+
+CASE("ufo/PerformanceMonitor/disabled") {
+  ufo::PerformanceMonitor &monitor = ufo::PerformanceMonitor::instance();
+  monitor.reset();
+  monitor.setEnabled(false);
+  {
+    ScopedPerformanceMonitor scope("Test/Disabled/phase", 10);
+  }
+  EXPECT(monitor.records().empty());
+}
+
+CASE("ufo/PerformanceMonitor/enabled") {
+  ufo::PerformanceMonitor &monitor = ufo::PerformanceMonitor::instance();
+  monitor.reset();
+  monitor.setEnabled(true);
+  for (size_t i = 0; i < 3; ++i) {
+    ScopedPerformanceMonitor scope("Test/Enabled/phase", 10);
+  }
+  {
+    ScopedPerformanceMonitor scope("Test/Enabled/otherPhase", 7);
+  }
+  monitor.setEnabled(false);
+
+  const std::map<std::string, PerformanceRecord> records = monitor.records();
+  EXPECT_EQUAL(records.size(), 2);
+  const PerformanceRecord &record = records.at("Test/Enabled/phase");
+  EXPECT_EQUAL(record.calls, 3);
+  EXPECT_EQUAL(record.nlocs, 30);
+  EXPECT(record.wallTime >= 0.0);
+  EXPECT(record.memoryGrowth >= 0);
+  EXPECT_EQUAL(records.at("Test/Enabled/otherPhase").calls, 1);
+  EXPECT_EQUAL(records.at("Test/Enabled/otherPhase").nlocs, 7);
+
+  monitor.reset();
+  EXPECT(monitor.records().empty());
+}
+
+CASE("ufo/PerformanceMonitor/report") {
+  ufo::PerformanceMonitor &monitor = ufo::PerformanceMonitor::instance();
+  monitor.reset();
+  monitor.record("Test/Report/phase", 1.5, 100, 0);
+
+  const eckit::mpi::Comm &comm = oops::mpi::world();
+  std::stringstream report;
+  monitor.report(comm, report);
+  if (comm.rank() == 0) {
+    EXPECT(report.str().find("\"Test/Report/phase\"") != std::string::npos);
+    EXPECT(report.str().find("\"wall time (s)\"") != std::string::npos);
+  } else {
+    EXPECT(report.str().empty());
+  }
+  monitor.reset();
+}
+
+CASE("ufo/PerformanceMonitor/reportAndReset") {
+  ufo::PerformanceMonitor &monitor = ufo::PerformanceMonitor::instance();
+  monitor.reset();
+  monitor.setEnabled(true);
+  monitor.record("Test/Reported/phase", 1.5, 100, 0);
+  monitor.record("Test/Kept/phase", 2.5, 100, 0);
+  monitor.record("Other/Reported/phase", 0.5, 10, 0);
+
+  const eckit::mpi::Comm &comm = oops::mpi::world();
+  std::stringstream report;
+  monitor.report(comm, report, "Test/Reported/");
+  if (comm.rank() == 0) {
+    EXPECT(report.str().find("\"Test/Reported/phase\"") != std::string::npos);
+    EXPECT(report.str().find("\"Test/Kept/phase\"") == std::string::npos);
+  }
+
+  monitor.setAutomaticReports(false);
+  monitor.reportAndReset(comm, "Test/Reported/");
+  EXPECT_EQUAL(monitor.records().size(), 3);
+
+  monitor.setAutomaticReports(true);
+  monitor.reportAndReset(comm, "Test/Reported/");
+  const std::map<std::string, PerformanceRecord> records = monitor.records();
+  EXPECT_EQUAL(records.size(), 2);
+  EXPECT(records.count("Test/Kept/phase") == 1);
+  EXPECT(records.count("Other/Reported/phase") == 1);
+
+  monitor.setEnabled(false);
+  monitor.reset();
+}
+
+class PerformanceMonitor : public oops::Test {
+ private:
+  std::string testid() const override {return "ufo::test::PerformanceMonitor";}
+
+  void register_tests() const override {}
+
+  void clear() const override {}
+};
+
+}  // namespace test
+}  // namespace ufo
+
+#endif  // TEST_UFO_PERFORMANCEMONITOR_H_
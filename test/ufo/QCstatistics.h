@@ -0,0 +1,94 @@
+/*
+ * (C) Crown copyright 2021, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef TEST_UFO_QCSTATISTICS_H_
+#define TEST_UFO_QCSTATISTICS_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#define ECKIT_TESTING_SELF_REGISTER_CASES 0
+
+#include "eckit/config/LocalConfiguration.h"
+#include "eckit/mpi/Comm.h"
+#include "eckit/testing/Test.h"
+#include "ioda/ObsDataVector.h"
+#include "ioda/ObsSpace.h"
+#include "oops/mpi/mpi.h"
+#include "oops/runs/Test.h"
+#include "oops/util/DateTime.h"
+#include "oops/util/Expect.h"
+#include "test/TestEnvironment.h"
+#include "ufo/filters/QCflags.h"
+#include "ufo/filters/QCstatistics.h"
+
+namespace ufo {
+namespace test {
+
+// -----------------------------------------------------------------------------
+
+void testQCstatistics() {
+  const eckit::LocalConfiguration conf(::test::TestEnvironment::config());
+  const util::DateTime bgn(conf.getString("window begin"));
+  const util::DateTime end(conf.getString("window end"));
+  const eckit::LocalConfiguration obsSpaceConf(conf, "obs space");
+  ioda::ObsSpace obsspace(obsSpaceConf, oops::mpi::world(), bgn, end, oops::mpi::myself());
+
+  // Give each variable a different mix of flags, including some outside the histogram range.
+  const std::vector<int> someFlags{QCflags::pass, QCflags::missing, QCflags::bounds,
+                                   QCflags::thinned, 76, 77, -1, 1000};
+  ioda::ObsDataVector<int> flags(obsspace, obsspace.obsvariables());
+  for (size_t jvar = 0; jvar < flags.nvars(); ++jvar)
+    for (size_t jobs = 0; jobs < flags.nlocs(); ++jobs)
+      flags[jvar][jobs] = someFlags[(jobs + jvar) % (someFlags.size() - jvar % someFlags.size())];
+
+  const ufo::QCstatistics stats(obsspace, flags);
+
+  EXPECT_EQUAL(stats.nvars(), flags.nvars());
+  EXPECT_EQUAL(stats.globalNumLocs(), obsspace.globalNumLocs());
+  for (size_t jvar = 0; jvar < flags.nvars(); ++jvar) {
+    EXPECT_EQUAL(stats.variable(jvar), flags.varnames()[jvar]);
+
+    // The generated observations are not duplicated across processes, so the expected counts
+    // are the sums of the local counts.
+    size_t total = 0;
+    for (int flag = 0; flag <= ufo::QCstatistics::maxFlag; ++flag) {
+      size_t expected = 0;
+      for (size_t jobs = 0; jobs < flags.nlocs(); ++jobs)
+        if (flags[jvar][jobs] == flag)
+          ++expected;
+      obsspace.comm().allReduceInPlace(expected, eckit::mpi::sum());
+      EXPECT_EQUAL(stats.count(jvar, flag), expected);
+      total += expected;
+    }
+    EXPECT_EQUAL(stats.countOutOfRange(jvar), obsspace.globalNumLocs() - total);
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+class QCstatistics : public oops::Test {
+ private:
+  std::string testid() const override {return "ufo::test::QCstatistics";}
+
+  void register_tests() const override {
+    std::vector<eckit::testing::Test>& ts = eckit::testing::specification();
+
+    ts.emplace_back(CASE("ufo/QCstatistics/counts")
+                    { testQCstatistics(); });
+  }
+
+  void clear() const override {}
+};
+
+// -----------------------------------------------------------------------------
+
+}  // namespace test
+}  // namespace ufo
+
+#endif  // TEST_UFO_QCSTATISTICS_H_
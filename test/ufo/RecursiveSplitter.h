@@ -10,8 +10,12 @@
 
 #include "ufo/utils/RecursiveSplitter.h"
 
+#include <algorithm>
+#include <chrono>  // NOLINT(build/c++11)
 #include <iomanip>
 #include <memory>
+#include <numeric>
+#include <random>
 #include <set>
 #include <string>
 #include <vector>
@@ -19,6 +23,7 @@
 #include "eckit/testing/Test.h"
 #include "oops/runs/Test.h"
 #include "oops/util/Expect.h"
+#include "oops/util/Logger.h"
 
 namespace ufo {
 namespace test {
@@ -235,6 +240,125 @@ CASE("ufo/RecursiveSplitter/Recurse") {
   orderedComparison(splitter, expected);
 }
 
+/// \brief Splits groups by stable-sorting each of them with a comparator looking up categories,
+/// like earlier versions of RecursiveSplitter.
+class ReferenceSplitter {
+ public:
+  explicit ReferenceSplitter(size_t numIds) : orderedIds_(numIds), groupEnds_{numIds} {
+    std::iota(orderedIds_.begin(), orderedIds_.end(), 0);
+    if (numIds == 0) groupEnds_.clear();
+  }
+
+  template <typename T>
+  void groupBy(const std::vector<T> &categories) {
+    std::vector<size_t> newGroupEnds;
+    size_t begin = 0;
+    for (size_t end : groupEnds_) {
+      std::stable_sort(orderedIds_.begin() + begin, orderedIds_.begin() + end,
+                       [&categories](size_t idA, size_t idB)
+                       { return categories[idA] < categories[idB]; });
+      for (size_t index = begin + 1; index <= end; ++index)
+        if (index == end || categories[orderedIds_[index]] != categories[orderedIds_[index - 1]])
+          newGroupEnds.push_back(index);
+      begin = end;
+    }
+    groupEnds_ = newGroupEnds;
+  }
+
+  std::vector<std::vector<size_t>> groups() const {
+    std::vector<std::vector<size_t>> result;
+    size_t begin = 0;
+    for (size_t end : groupEnds_) {
+      result.emplace_back(orderedIds_.begin() + begin, orderedIds_.begin() + end);
+      begin = end;
+    }
+    return result;
+  }
+
+ private:
+  std::vector<size_t> orderedIds_;
+  std::vector<size_t> groupEnds_;
+};
+
+std::vector<std::vector<size_t>> getOrderedGroups(const RecursiveSplitter &splitter) {
+  std::vector<std::vector<size_t>> groups;
+  for (const auto &g : splitter.groups())
+    groups.emplace_back(g.begin(), g.end());
+  return groups;
+}
+
+/// Return \p n station IDs drawn from \p numStations distinct values.
+std::vector<std::string> randomStationIds(std::mt19937 &generator, size_t n, int numStations) {
+  std::uniform_int_distribution<int> distribution(0, numStations - 1);
+  std::vector<std::string> ids(n);
+  for (std::string &id : ids)
+    id = "STN" + std::to_string(distribution(generator));
+  return ids;
+}
+
+/// Return \p n integers drawn from [min, max].
+std::vector<int> randomInts(std::mt19937 &generator, size_t n, int min, int max) {
+  std::uniform_int_distribution<int> distribution(min, max);
+  std::vector<int> values(n);
+  for (int &value : values)
+    value = distribution(generator);
+  return values;
+}
+
+CASE("ufo/RecursiveSplitter/MatchesReference") {
+  std::mt19937 generator(4);
+  // Large sizes exercise the radix sort and the concurrent sorting of large groups; sparse
+  // integer categories are encoded with a hash table.
+  for (size_t numIds : {0, 1, 2, 37, 1000, 200000}) {
+    const std::vector<std::string> stations = randomStationIds(generator, numIds, 5);
+    const std::vector<int> sparse = randomInts(generator, numIds, -2000000000, 2000000000);
+    const std::vector<int> dense = randomInts(generator, numIds, -3, 3);
+    std::vector<size_t> levels(numIds);
+    for (size_t &level : levels)
+      level = generator() % 1000;
+
+    RecursiveSplitter splitter(numIds);
+    ReferenceSplitter reference(numIds);
+    splitter.groupBy(stations);
+    reference.groupBy(stations);
+    EXPECT(getOrderedGroups(splitter) == reference.groups());
+    splitter.groupBy(dense);
+    reference.groupBy(dense);
+    EXPECT(getOrderedGroups(splitter) == reference.groups());
+    splitter.groupBy(levels);
+    reference.groupBy(levels);
+    EXPECT(getOrderedGroups(splitter) == reference.groups());
+    splitter.groupBy(sparse);
+    reference.groupBy(sparse);
+    EXPECT(getOrderedGroups(splitter) == reference.groups());
+  }
+}
+
+CASE("ufo/RecursiveSplitter/Scaling") {
+  // Group observations by station ID and then by a time slot, as done by TrackCheck and
+  // StuckCheck, and log the time taken as a function of the number of observations.
+  std::mt19937 generator(5);
+  for (size_t numIds : {10000, 100000, 1000000}) {
+    const std::vector<std::string> stations = randomStationIds(generator, numIds, numIds / 50);
+    const std::vector<int> slots = randomInts(generator, numIds, 0, 1000);
+
+    auto start = std::chrono::steady_clock::now();
+    RecursiveSplitter splitter(numIds);
+    splitter.groupBy(stations);
+    splitter.groupBy(slots);
+    const std::chrono::duration<double> time = std::chrono::steady_clock::now() - start;
+
+    start = std::chrono::steady_clock::now();
+    ReferenceSplitter reference(numIds);
+    reference.groupBy(stations);
+    reference.groupBy(slots);
+    const std::chrono::duration<double> referenceTime = std::chrono::steady_clock::now() - start;
+
+    oops::Log::info() << "RecursiveSplitter: " << numIds << " ids: " << time.count()
+                      << " s (comparison sort: " << referenceTime.count() << " s)" << std::endl;
+    EXPECT(getOrderedGroups(splitter) == reference.groups());
+  }
+}
 
 class RecursiveSplitter : public oops::Test {
  public:
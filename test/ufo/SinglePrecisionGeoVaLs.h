@@ -0,0 +1,264 @@
+/*
+ * (C) Crown copyright 2021, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef TEST_UFO_SINGLEPRECISIONGEOVALS_H_
+#define TEST_UFO_SINGLEPRECISIONGEOVALS_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#define ECKIT_TESTING_SELF_REGISTER_CASES 0
+
+#include "eckit/config/LocalConfiguration.h"
+#include "eckit/testing/Test.h"
+#include "ioda/ObsDataVector.h"
+#include "ioda/ObsSpace.h"
+#include "ioda/ObsVector.h"
+#include "oops/base/ObsFilters.h"
+#include "oops/base/Variables.h"
+#include "oops/interface/GeoVaLs.h"
+#include "oops/interface/ObsAuxControl.h"
+#include "oops/interface/ObsDataVector.h"
+#include "oops/interface/ObsDiagnostics.h"
+#include "oops/interface/ObsOperator.h"
+#include "oops/interface/ObsSpace.h"
+#include "oops/interface/ObsVector.h"
+#include "oops/mpi/mpi.h"
+#include "oops/runs/Test.h"
+#include "oops/util/Logger.h"
+#include "oops/util/parameters/Parameter.h"
+#include "oops/util/parameters/Parameters.h"
+#include "test/TestEnvironment.h"
+#include "ufo/filters/QCflags.h"
+#include "ufo/GeoVaLs.h"
+#include "ufo/Locations.h"
+#include "ufo/ObsBias.h"
+#include "ufo/ObsBiasParameters.h"
+#include "ufo/ObsDiagnostics.h"
+#include "ufo/ObsOperator.h"
+#include "ufo/ObsTraits.h"
+
+namespace ufo {
+namespace test {
+
+// -----------------------------------------------------------------------------
+
+/// Copy the values of variables \p vars of \p from into \p to.
+void copyGeoVaLs(const GeoVaLs & from, GeoVaLs & to, const oops::Variables & vars) {
+  EXPECT(to.nlocs() == from.nlocs());
+  std::vector<double> values(from.nlocs());
+  for (size_t jv = 0; jv < vars.size(); ++jv) {
+    const size_t nlevs = from.nlevs(vars[jv]);
+    to.allocate(nlevs, oops::Variables({vars[jv]}));
+    for (size_t jlev = 1; jlev <= nlevs; ++jlev) {
+      from.get(values, vars[jv], jlev);
+      to.put(values, vars[jv], jlev);
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+/// Compare H(x) computed from GeoVaLs read in double precision with H(x) computed from the same
+/// values in GeoVaLs constructed from the operator locations, as they are in an application run
+/// with UFO_GEOVALS_SINGLE_PRECISION set. The variables these GeoVaLs store in single precision
+/// must be those listed in `single precision variables` (all required variables by default),
+/// and must still be stored in single precision after H(x) is computed. The rms of the
+/// difference between the two H(x) must not exceed `single precision tolerance` times the rms of
+/// H(x).
+void testSinglePrecisionHofX() {
+  const eckit::LocalConfiguration conf(::test::TestEnvironment::config());
+  util::DateTime bgn(conf.getString("window begin"));
+  util::DateTime end(conf.getString("window end"));
+
+  // The test must run in single-precision GeoVaLs mode.
+  EXPECT(GeoVaLs::singlePrecisionMode());
+
+  std::vector<eckit::LocalConfiguration> typeconfs;
+  conf.get("observations", typeconfs);
+  for (const eckit::LocalConfiguration & typeconf : typeconfs) {
+    const eckit::LocalConfiguration obsconf(typeconf, "obs space");
+    ioda::ObsSpace ospace(obsconf, oops::mpi::world(), bgn, end, oops::mpi::myself());
+
+    const eckit::LocalConfiguration obsopconf(typeconf, "obs operator");
+    ObsOperator hop(ospace, obsopconf);
+    const oops::Variables & vars = hop.requiredVars();
+
+    const eckit::LocalConfiguration gconf(typeconf, "geovals");
+    const GeoVaLs gval(gconf, ospace, vars);
+
+    // Copy the GeoVaLs read from file into GeoVaLs constructed from the operator locations.
+    std::unique_ptr<Locations> locs(hop.locations());
+    GeoVaLs gvalSingle(*locs, vars);
+    copyGeoVaLs(gval, gvalSingle, vars);
+
+    const oops::Variables expectedSingleVars = typeconf.has("single precision variables") ?
+          oops::Variables(typeconf.getStringVector("single precision variables")) : vars;
+    const oops::Variables & singleVars = locs->singlePrecisionVars();
+    EXPECT(singleVars.size() == expectedSingleVars.size());
+    for (size_t jv = 0; jv < expectedSingleVars.size(); ++jv)
+      EXPECT(singleVars.has(expectedSingleVars[jv]));
+
+    eckit::LocalConfiguration biasconf = typeconf.getSubConfiguration("obs bias");
+    ObsBiasParameters biasparams;
+    biasparams.validateAndDeserialize(biasconf);
+    const ObsBias ybias(ospace, biasparams);
+
+    ObsDiagnostics diags(ospace, *(locs.get()), oops::Variables());
+    ioda::ObsVector hofx(ospace);
+    ioda::ObsVector hofxSingle(ospace);
+    hop.simulateObs(gval, hofx, ybias, diags);
+    hop.simulateObs(gvalSingle, hofxSingle, ybias, diags);
+
+    // Computing H(x) must not have converted the GeoVaLs to double precision.
+    for (size_t jv = 0; jv < vars.size(); ++jv)
+      EXPECT(gvalSingle.isSinglePrecision(vars[jv]) == singleVars.has(vars[jv]));
+
+    const double tol = typeconf.getDouble("single precision tolerance");
+    const double rms = hofx.rms();
+    hofxSingle -= hofx;
+    oops::Log::test() << ospace.obsname() << ": variables in single precision: " << singleVars
+                      << ", rms of H(x) differences: " << hofxSingle.rms()
+                      << ", rms of H(x): " << rms << std::endl;
+    EXPECT(hofxSingle.rms() <= tol * rms);
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+/// Options of the filters applied by applyFilters().
+class FiltersParameters : public oops::Parameters {
+  OOPS_CONCRETE_PARAMETERS(FiltersParameters, Parameters)
+ public:
+  oops::Parameter<std::vector<oops::ObsFilterParametersWrapper<ObsTraits>>> obsFilters{
+    "obs filters", {}, this};
+};
+
+/// Apply the `obs filters` of \p typeconf to the H(x) computed by its `obs operator`, as an
+/// application does, and return the number of observations passing QC. The filters and the
+/// operator read the GeoVaLs from file if \p singlePrecision is false, and a copy of these in
+/// GeoVaLs constructed from the operator locations otherwise.
+size_t applyFilters(const eckit::LocalConfiguration & typeconf, const util::DateTime & bgn,
+                    const util::DateTime & end, bool singlePrecision) {
+  typedef oops::GeoVaLs<ObsTraits>            GeoVaLs_;
+  typedef oops::ObsAuxControl<ObsTraits>      ObsAuxCtrl_;
+  typedef oops::ObsDataVector<ObsTraits, int> ObsDataVector_;
+  typedef oops::ObsDiagnostics<ObsTraits>     ObsDiags_;
+  typedef oops::ObsFilters<ObsTraits>         ObsFilters_;
+  typedef oops::ObsOperator<ObsTraits>        ObsOperator_;
+  typedef oops::ObsSpace<ObsTraits>           ObsSpace_;
+  typedef oops::ObsVector<ObsTraits>          ObsVector_;
+
+  const eckit::LocalConfiguration obsconf(typeconf, "obs space");
+  ObsSpace_ obspace(obsconf, oops::mpi::world(), bgn, end, oops::mpi::myself());
+
+  FiltersParameters params;
+  params.deserialize(typeconf);
+  ObsVector_ obserr(obspace, "ObsError");
+  std::shared_ptr<ObsDataVector_> qcflags(new ObsDataVector_(obspace, obspace.obsvariables()));
+  ObsFilters_ filters(obspace, params.obsFilters, qcflags, obserr);
+  filters.preProcess();
+
+  ObsOperator_ hop(obspace, eckit::LocalConfiguration(typeconf, "obs operator"));
+  ObsBiasParameters biasparams;
+  biasparams.validateAndDeserialize(typeconf.getSubConfiguration("obs bias"));
+  const ObsAuxCtrl_ ybias(obspace, biasparams);
+
+  oops::Variables vars;
+  vars += hop.requiredVars();
+  vars += filters.requiredVars();
+  vars += ybias.requiredVars();
+  const GeoVaLs_ gvalFile(eckit::LocalConfiguration(typeconf, "geovals"), obspace, vars);
+  std::unique_ptr<GeoVaLs_> gvalSingle;
+  if (singlePrecision) {
+    gvalSingle.reset(new GeoVaLs_(hop.locations(), vars));
+    copyGeoVaLs(gvalFile.geovals(), gvalSingle->geovals(), vars);
+    // The test is only meaningful if the filters see some GeoVaLs stored in single precision.
+    bool anySingle = false;
+    for (size_t jv = 0; jv < vars.size(); ++jv)
+      anySingle = anySingle || gvalSingle->geovals().isSinglePrecision(vars[jv]);
+    EXPECT(anySingle);
+  }
+  const GeoVaLs_ & gval = singlePrecision ? *gvalSingle : gvalFile;
+
+  oops::Variables diagvars;
+  diagvars += filters.requiredHdiagnostics();
+  diagvars += ybias.requiredHdiagnostics();
+  ObsDiags_ diags(obspace, hop.locations(), diagvars);
+  ObsVector_ hofx(obspace);
+  filters.priorFilter(gval);
+  hop.simulateObs(gval, hofx, ybias, diags);
+  filters.postFilter(hofx, diags);
+
+  const ioda::ObsDataVector<int> & flags = qcflags->obsdatavector();
+  auto accumulator = obspace.obsspace().distribution()->createAccumulator<size_t>();
+  for (size_t jobs = 0; jobs < flags.nlocs(); ++jobs) {
+    size_t passed = 0;
+    for (size_t jv = 0; jv < flags.nvars(); ++jv)
+      if (flags[jv][jobs] == QCflags::pass) ++passed;
+    accumulator->addTerm(jobs, passed);
+  }
+  return accumulator->computeResult();
+}
+
+// -----------------------------------------------------------------------------
+
+/// Apply the `obs filters` of each element of `observations` that has some, together with its
+/// operator, with GeoVaLs read in double precision and with GeoVaLs constructed from the operator
+/// locations, as they are in an application run with UFO_GEOVALS_SINGLE_PRECISION set. Filters
+/// reading the GeoVaLs themselves, such as the 1D-Var checks, must cope with the variables the
+/// operator stores in single precision. In both cases, `passedBenchmark` observations must pass QC.
+void testSinglePrecisionFilters() {
+  const eckit::LocalConfiguration conf(::test::TestEnvironment::config());
+  util::DateTime bgn(conf.getString("window begin"));
+  util::DateTime end(conf.getString("window end"));
+
+  EXPECT(GeoVaLs::singlePrecisionMode());
+
+  std::vector<eckit::LocalConfiguration> typeconfs;
+  conf.get("observations", typeconfs);
+  for (const eckit::LocalConfiguration & typeconf : typeconfs) {
+    if (!typeconf.has("obs filters")) continue;
+    const size_t passedBenchmark = typeconf.getUnsigned("passedBenchmark");
+    const size_t passed = applyFilters(typeconf, bgn, end, false);
+    const size_t passedSingle = applyFilters(typeconf, bgn, end, true);
+    oops::Log::test() << "Observations passing QC: " << passed << " with double-precision "
+                      << "GeoVaLs, " << passedSingle << " with single-precision GeoVaLs"
+                      << std::endl;
+    EXPECT_EQUAL(passed, passedBenchmark);
+    EXPECT_EQUAL(passedSingle, passedBenchmark);
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+class SinglePrecisionGeoVaLs : public oops::Test {
+ public:
+  SinglePrecisionGeoVaLs() = default;
+  virtual ~SinglePrecisionGeoVaLs() = default;
+ private:
+  std::string testid() const override {return "ufo::test::SinglePrecisionGeoVaLs";}
+
+  void register_tests() const override {
+    std::vector<eckit::testing::Test>& ts = eckit::testing::specification();
+
+    ts.emplace_back(CASE("ufo/SinglePrecisionGeoVaLs/testSinglePrecisionHofX")
+      { testSinglePrecisionHofX(); });
+    ts.emplace_back(CASE("ufo/SinglePrecisionGeoVaLs/testSinglePrecisionFilters")
+      { testSinglePrecisionFilters(); });
+  }
+
+  void clear() const override {}
+};
+
+// -----------------------------------------------------------------------------
+
+}  // namespace test
+}  // namespace ufo
+
+#endif  // TEST_UFO_SINGLEPRECISIONGEOVALS_H_
@@ -0,0 +1,167 @@
+/*
+ * (C) Crown copyright 2021, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef TEST_UFO_SKIPREJECTEDOBSERVATIONS_H_
+#define TEST_UFO_SKIPREJECTEDOBSERVATIONS_H_
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+#define ECKIT_TESTING_SELF_REGISTER_CASES 0
+
+#include "eckit/config/LocalConfiguration.h"
+#include "eckit/testing/Test.h"
+#include "ioda/ObsDataVector.h"
+#include "ioda/ObsSpace.h"
+#include "ioda/ObsVector.h"
+#include "oops/mpi/mpi.h"
+#include "oops/runs/Test.h"
+#include "oops/util/Logger.h"
+#include "test/TestEnvironment.h"
+#include "ufo/filters/QCflags.h"
+#include "ufo/GeoVaLs.h"
+#include "ufo/LinearObsOperator.h"
+#include "ufo/ObsBias.h"
+#include "ufo/ObsBiasIncrement.h"
+#include "ufo/ObsOperator.h"
+
+namespace ufo {
+namespace test {
+
+// -----------------------------------------------------------------------------
+
+/// Linearize the operator twice about the same trajectory, with and without the
+/// `skip rejected observations` option, after rejecting all variables at every
+/// `reject every`-th location and, at other locations, variables jv > 0 at every
+/// `reject every`-th location shifted by jv (e.g. some channels of kept profiles).
+/// With the option set:
+/// * the TL output must be zero for rejected observations and match the output of the operator
+///   linearized about all observations elsewhere (to `tolerance TL` relative to its rms);
+/// * the TL and AD must remain adjoint (to `tolerance AD`);
+/// * the TL output must be the same whether the QC flags are passed to the operator or read
+///   from the ObsSpace.
+void testSkipRejectedObservations() {
+  const eckit::LocalConfiguration conf(::test::TestEnvironment::config());
+  util::DateTime bgn(conf.getString("window begin"));
+  util::DateTime end(conf.getString("window end"));
+
+  std::vector<eckit::LocalConfiguration> typeconfs;
+  conf.get("observations", typeconfs);
+  for (const eckit::LocalConfiguration & typeconf : typeconfs) {
+    const eckit::LocalConfiguration obsconf(typeconf, "obs space");
+    ioda::ObsSpace ospace(obsconf, oops::mpi::world(), bgn, end, oops::mpi::myself());
+    const oops::Variables & simulated = ospace.obsvariables();
+
+    // Reject some observations.
+    const size_t rejectEvery = typeconf.getUnsigned("reject every");
+    auto rejected = [rejectEvery](size_t jloc, size_t jv) {
+      return jloc % rejectEvery == 0 || (jv > 0 && (jloc + jv) % rejectEvery == 0);
+    };
+    ioda::ObsDataVector<int> qcflags(ospace, simulated);
+    size_t nrejected = 0;
+    for (size_t jv = 0; jv < simulated.size(); ++jv) {
+      for (size_t jloc = 0; jloc < ospace.nlocs(); ++jloc) {
+        qcflags[jv][jloc] = rejected(jloc, jv) ? QCflags::bounds : QCflags::pass;
+        nrejected += rejected(jloc, jv);
+      }
+    }
+    EXPECT(nrejected > 0);
+
+    const eckit::LocalConfiguration obsopconf(typeconf, "obs operator");
+    eckit::LocalConfiguration skipconf(obsopconf);
+    skipconf.set("skip rejected observations", true);
+
+    ObsOperator hop(ospace, obsopconf);
+    LinearObsOperator hopAll(ospace, obsopconf);
+    LinearObsOperator hopSkip(ospace, skipconf);
+    hopSkip.setQCFlags(qcflags);
+    // This operator reads the flags saved to the ObsSpace as the filters would save them.
+    LinearObsOperator hopSaved(ospace, skipconf);
+    qcflags.save("EffectiveQC0");
+
+    const eckit::LocalConfiguration gconf(typeconf, "geovals");
+    const GeoVaLs gval(gconf, ospace, hop.requiredVars());
+
+    eckit::LocalConfiguration biasconf = typeconf.getSubConfiguration("obs bias");
+    ObsBiasParameters biasparams;
+    biasparams.validateAndDeserialize(biasconf);
+    const ObsBias ybias(ospace, biasparams);
+    ObsBiasIncrement ybinc(ospace, biasparams);
+
+    hopAll.setTrajectory(gval, ybias);
+    hopSkip.setTrajectory(gval, ybias);
+    hopSaved.setTrajectory(gval, ybias);
+
+    GeoVaLs dx(gconf, ospace, hopSkip.requiredVars());
+    dx.random();
+    ioda::ObsVector dyAll(ospace);
+    ioda::ObsVector dySkip(ospace);
+    hopAll.simulateObsTL(dx, dyAll, ybinc);
+    hopSkip.simulateObsTL(dx, dySkip, ybinc);
+    ioda::ObsVector dySaved(ospace);
+    hopSaved.simulateObsTL(dx, dySaved, ybinc);
+    dySaved -= dySkip;
+    EXPECT(dySaved.rms() == 0.0);
+
+    // TL of rejected observations is zero; TL of the others is unchanged.
+    for (size_t jloc = 0; jloc < ospace.nlocs(); ++jloc) {
+      for (size_t jv = 0; jv < simulated.size(); ++jv) {
+        if (!rejected(jloc, jv)) continue;
+        const size_t jobs = jloc * simulated.size() + jv;
+        EXPECT(dySkip[jobs] == 0.0);
+        dyAll[jobs] = 0.0;
+      }
+    }
+    const double rmsAll = dyAll.rms();
+    dySkip -= dyAll;
+    oops::Log::test() << ospace.obsname() << ": rejected " << nrejected << " observations"
+                      << ", rms of TL differences at active observations: " << dySkip.rms()
+                      << ", rms of TL: " << rmsAll << std::endl;
+    EXPECT(dySkip.rms() <= typeconf.getDouble("tolerance TL") * rmsAll);
+
+    // Adjoint test.
+    dySkip.zero();
+    hopSkip.simulateObsTL(dx, dySkip, ybinc);
+    ioda::ObsVector dy(ospace);
+    dy.random();
+    GeoVaLs dxAD(gconf, ospace, hopSkip.requiredVars());
+    dxAD.zero();
+    hopSkip.simulateObsAD(dxAD, dy, ybinc);
+    const double dot1 = dx.dot_product_with(dxAD);
+    const double dot2 = dySkip.dot_product_with(dy);
+    oops::Log::test() << ospace.obsname() << ": <dx, H^T dy> = " << dot1
+                      << ", <H dx, dy> = " << dot2 << std::endl;
+    EXPECT(std::abs(dot1 - dot2) <= typeconf.getDouble("tolerance AD") * std::abs(dot2));
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+class SkipRejectedObservations : public oops::Test {
+ public:
+  SkipRejectedObservations() = default;
+  virtual ~SkipRejectedObservations() = default;
+ private:
+  std::string testid() const override {return "ufo::test::SkipRejectedObservations";}
+
+  void register_tests() const override {
+    std::vector<eckit::testing::Test>& ts = eckit::testing::specification();
+
+    ts.emplace_back(CASE("ufo/SkipRejectedObservations/testSkipRejectedObservations")
+      { testSkipRejectedObservations(); });
+  }
+
+  void clear() const override {}
+};
+
+// -----------------------------------------------------------------------------
+
+}  // namespace test
+}  // namespace ufo
+
+#endif  // TEST_UFO_SKIPREJECTEDOBSERVATIONS_H_
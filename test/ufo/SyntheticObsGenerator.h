@@ -0,0 +1,291 @@
+/*
+ * (C) Crown copyright 2021, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef TEST_UFO_SYNTHETICOBSGENERATOR_H_
+#define TEST_UFO_SYNTHETICOBSGENERATOR_H_
+
+#include <cmath>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#define ECKIT_TESTING_SELF_REGISTER_CASES 0
+
+#include "eckit/config/LocalConfiguration.h"
+#include "eckit/testing/Test.h"
+#include "ioda/ObsSpace.h"
+#include "oops/base/Variables.h"
+#include "oops/mpi/mpi.h"
+#include "oops/runs/Test.h"
+#include "oops/util/DateTime.h"
+#include "oops/util/Expect.h"
+#include "oops/util/FloatCompare.h"
+#include "test/TestEnvironment.h"
+#include "ufo/GeoVaLs.h"
+#include "ufo/Locations.h"
+#include "ufo/SyntheticObsGenerator.h"
+
+namespace ufo {
+namespace test {
+
+// -----------------------------------------------------------------------------
+
+/// Write the observations described by the `generator` section of \p conf (a collective operation
+/// on the world communicator).
+void writeObsFile(const eckit::LocalConfiguration &conf,
+                  const ufo::SyntheticObsGenerator &generator) {
+  const util::DateTime bgn(::test::TestEnvironment::config().getString("window begin"));
+  const util::DateTime end(::test::TestEnvironment::config().getString("window end"));
+  const eckit::LocalConfiguration obsSpaceConf(conf, "obs space");
+  generator.writeObsFile(oops::Variables(obsSpaceConf, "simulated variables"), bgn, end,
+                         oops::mpi::world());
+}
+
+/// Create an ObsSpace distributed over \p comm reading the observations written by
+/// writeObsFile().
+std::unique_ptr<ioda::ObsSpace> makeObsSpace(const eckit::LocalConfiguration &conf,
+                                             const ufo::SyntheticObsGenerator &generator,
+                                             const eckit::mpi::Comm &comm) {
+  const util::DateTime bgn(::test::TestEnvironment::config().getString("window begin"));
+  const util::DateTime end(::test::TestEnvironment::config().getString("window end"));
+  eckit::LocalConfiguration obsSpaceConf(conf, "obs space");
+  eckit::LocalConfiguration obsdatain;
+  if (obsSpaceConf.has("obsdatain"))
+    obsdatain = obsSpaceConf.getSubConfiguration("obsdatain");
+  obsdatain.set("obsfile", generator.obsFile());
+  obsSpaceConf.set("obsdatain", obsdatain);
+  return std::unique_ptr<ioda::ObsSpace>(
+        new ioda::ObsSpace(obsSpaceConf, comm, bgn, end, oops::mpi::myself()));
+}
+
+// -----------------------------------------------------------------------------
+
+/// Check the structure of the MetaData and the statistics of the generated observations.
+void testWriteObsFile(const eckit::LocalConfiguration &conf) {
+  const util::DateTime bgn(::test::TestEnvironment::config().getString("window begin"));
+  const util::DateTime end(::test::TestEnvironment::config().getString("window end"));
+
+  SyntheticObsGeneratorParameters options;
+  options.validateAndDeserialize(conf.getSubConfiguration("generator"));
+  const ufo::SyntheticObsGenerator generator(options);
+  writeObsFile(conf, generator);
+  const std::unique_ptr<ioda::ObsSpace> obsspacePtr =
+      makeObsSpace(conf, generator, oops::mpi::world());
+  ioda::ObsSpace &obsspace = *obsspacePtr;
+
+  // All locations lie in the window, so none has been discarded.
+  EXPECT_EQUAL(obsspace.globalNumLocs(), static_cast<size_t>(options.numLocations.value()));
+
+  const size_t nlocs = obsspace.nlocs();
+  const std::vector<size_t> & globalIndex = obsspace.index();
+  std::vector<float> lats(nlocs), lons(nlocs), pressures(nlocs);
+  std::vector<std::string> stationIds(nlocs);
+  std::vector<int> recordNumbers(nlocs);
+  std::vector<util::DateTime> times(nlocs);
+  obsspace.get_db("MetaData", "latitude", lats);
+  obsspace.get_db("MetaData", "longitude", lons);
+  obsspace.get_db("MetaData", "air_pressure", pressures);
+  obsspace.get_db("MetaData", "station_id", stationIds);
+  obsspace.get_db("MetaData", "record_number", recordNumbers);
+  obsspace.get_db("MetaData", "datetime", times);
+
+  const int levelsPerProfile = options.levelsPerProfile.value();
+  const int numStations = options.numStations.value();
+  for (size_t jloc = 0; jloc < nlocs; ++jloc) {
+    const int profile = globalIndex[jloc] / levelsPerProfile;
+    EXPECT_EQUAL(recordNumbers[jloc], profile);
+    EXPECT_EQUAL(stationIds[jloc], SyntheticObsGenerator::stationId(profile % numStations));
+    EXPECT(lats[jloc] >= options.minLatitude.value());
+    EXPECT(lats[jloc] <= options.maxLatitude.value());
+    EXPECT(lons[jloc] >= -180.0f && lons[jloc] < 180.0f);
+    EXPECT(pressures[jloc] >= 0.999 * options.topPressure.value() &&
+           pressures[jloc] <= 1.001 * options.surfacePressure.value());
+    EXPECT(times[jloc] > bgn && times[jloc] <= end);
+  }
+
+  // All locations of a station share the latitude of the station, and all locations of a
+  // profile share its time.
+  std::map<std::string, float> stationLats;
+  std::map<int, util::DateTime> profileTimes;
+  for (size_t jloc = 0; jloc < nlocs; ++jloc) {
+    const float stationLat = stationLats.emplace(stationIds[jloc], lats[jloc]).first->second;
+    EXPECT_EQUAL(lats[jloc], stationLat);
+    const util::DateTime & profileTime =
+        profileTimes.emplace(recordNumbers[jloc], times[jloc]).first->second;
+    EXPECT(times[jloc] == profileTime);
+  }
+
+  // If the ObsSpace groups locations by station, all locations of a record belong to the same
+  // station.
+  if (!obsspace.obs_group_vars().empty()) {
+    std::map<size_t, std::string> recordStations;
+    for (size_t jloc = 0; jloc < nlocs; ++jloc) {
+      const std::string & recordStation =
+          recordStations.emplace(obsspace.recnum()[jloc], stationIds[jloc]).first->second;
+      EXPECT_EQUAL(stationIds[jloc], recordStation);
+    }
+    EXPECT(recordStations.size() <= static_cast<size_t>(options.numStations.value()));
+  }
+
+  const oops::Variables & simulated = obsspace.obsvariables();
+  for (const SyntheticVariableParameters & varOptions : options.variables.value()) {
+    const std::string & var = varOptions.name.value();
+    if (!simulated.has(var))
+      continue;
+    std::vector<float> values(nlocs), errors(nlocs);
+    obsspace.get_db("ObsValue", var, values);
+    obsspace.get_db("ObsError", var, errors);
+
+    double count = nlocs, sum = 0.0, sumOfSquares = 0.0;
+    for (size_t jloc = 0; jloc < nlocs; ++jloc) {
+      EXPECT_EQUAL(errors[jloc], varOptions.obsError.value());
+      const double residual = values[jloc] -
+                              generator.field(var, lats[jloc], lons[jloc], pressures[jloc]);
+      if (varOptions.noise.value() == 0.0)
+        EXPECT(oops::is_close_absolute(residual, 0.0, 1e-5 * std::abs(values[jloc])));
+      sum += residual;
+      sumOfSquares += residual * residual;
+    }
+    if (varOptions.noise.value() > 0.0) {
+      obsspace.comm().allReduceInPlace(count, eckit::mpi::sum());
+      obsspace.comm().allReduceInPlace(sum, eckit::mpi::sum());
+      obsspace.comm().allReduceInPlace(sumOfSquares, eckit::mpi::sum());
+      const double noise = varOptions.noise.value();
+      EXPECT(std::abs(sum / count) < 5.0 * noise / std::sqrt(count));
+      EXPECT(oops::is_close_relative(std::sqrt(sumOfSquares / count), noise, 0.1));
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+/// Check that the observations seen by the MPI tasks don't depend on the number of tasks.
+void testDecompositionIndependence(const eckit::LocalConfiguration &conf) {
+  SyntheticObsGeneratorParameters options;
+  options.validateAndDeserialize(conf.getSubConfiguration("generator"));
+  const ufo::SyntheticObsGenerator generator(options);
+  writeObsFile(conf, generator);
+
+  // Sum the observed values of the first simulated variable weighted by the global index.
+  auto checksum = [&](ioda::ObsSpace & obsspace) {
+    std::vector<float> values(obsspace.nlocs());
+    obsspace.get_db("ObsValue", obsspace.obsvariables()[0], values);
+    double sum = 0.0;
+    for (size_t jloc = 0; jloc < values.size(); ++jloc)
+      sum += (obsspace.index()[jloc] + 1) * static_cast<double>(values[jloc]);
+    obsspace.comm().allReduceInPlace(sum, eckit::mpi::sum());
+    return sum;
+  };
+
+  const std::unique_ptr<ioda::ObsSpace> distributed =
+      makeObsSpace(conf, generator, oops::mpi::world());
+  const std::unique_ptr<ioda::ObsSpace> serial = makeObsSpace(conf, generator, oops::mpi::myself());
+  EXPECT_EQUAL(distributed->globalNumLocs(), serial->globalNumLocs());
+  EXPECT(oops::is_close_relative(checksum(*distributed), checksum(*serial), 1e-10));
+}
+
+// -----------------------------------------------------------------------------
+
+/// Check the vertical structure of the generated GeoVaLs.
+void testFillGeoVaLs(const eckit::LocalConfiguration &conf) {
+  SyntheticObsGeneratorParameters options;
+  options.validateAndDeserialize(conf.getSubConfiguration("generator"));
+  const ufo::SyntheticObsGenerator generator(options);
+  writeObsFile(conf, generator);
+  const std::unique_ptr<ioda::ObsSpace> obsspacePtr =
+      makeObsSpace(conf, generator, oops::mpi::world());
+  ioda::ObsSpace &obsspace = *obsspacePtr;
+
+  const size_t nlocs = obsspace.nlocs();
+  std::vector<float> lats(nlocs), lons(nlocs);
+  std::vector<util::DateTime> times(nlocs);
+  obsspace.get_db("MetaData", "latitude", lats);
+  obsspace.get_db("MetaData", "longitude", lons);
+  obsspace.get_db("MetaData", "datetime", times);
+  const Locations locs(lons, lats, times, obsspace.distribution());
+
+  const oops::Variables vars(conf.getStringVector("geovals variables"));
+  GeoVaLs geovals(locs, vars);
+  generator.fillGeoVaLs(locs, geovals);
+
+  const size_t nlevs = options.modelLevels.value();
+  for (size_t jvar = 0; jvar < vars.size(); ++jvar) {
+    if (vars[jvar] == "air_pressure_levels")
+      EXPECT_EQUAL(geovals.nlevs(vars[jvar]), nlevs + 1);
+    else if (vars[jvar] == "surface_pressure")
+      EXPECT_EQUAL(geovals.nlevs(vars[jvar]), static_cast<size_t>(1));
+    else
+      EXPECT_EQUAL(geovals.nlevs(vars[jvar]), nlevs);
+  }
+
+  // Pressure increases from the top to the bottom of the atmosphere.
+  std::vector<double> upper(nlocs), lower(nlocs);
+  for (size_t jlev = 1; jlev < nlevs; ++jlev) {
+    geovals.get(upper, "air_pressure", jlev - 1);
+    geovals.get(lower, "air_pressure", jlev);
+    for (size_t jloc = 0; jloc < nlocs; ++jloc)
+      EXPECT(upper[jloc] < lower[jloc]);
+  }
+  geovals.get(upper, "air_pressure", 0);
+  for (size_t jloc = 0; jloc < nlocs; ++jloc)
+    EXPECT(upper[jloc] > options.topPressure.value());
+
+  // Model fields follow the analytic formula used for observations.
+  std::vector<double> values(nlocs);
+  for (size_t jvar = 0; jvar < vars.size(); ++jvar) {
+    const std::string & var = vars[jvar];
+    if (var == "air_pressure" || var == "air_pressure_levels" || var == "surface_pressure")
+      continue;
+    geovals.get(lower, "air_pressure", nlevs - 1);
+    geovals.get(values, var, nlevs - 1);
+    for (size_t jloc = 0; jloc < nlocs; ++jloc)
+      EXPECT(oops::is_close_relative(values[jloc],
+                                     generator.field(var, lats[jloc], lons[jloc], lower[jloc]),
+                                     1e-6));
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+class SyntheticObsGenerator : public oops::Test {
+ private:
+  std::string testid() const override {return "ufo::test::SyntheticObsGenerator";}
+
+  void register_tests() const override {
+    std::vector<eckit::testing::Test>& ts = eckit::testing::specification();
+
+    const eckit::LocalConfiguration conf(::test::TestEnvironment::config());
+    for (const eckit::LocalConfiguration & testCaseConf : conf.getSubConfigurations("test cases")) {
+      const std::string testCaseName = testCaseConf.getString("name");
+      ts.emplace_back(CASE("ufo/SyntheticObsGenerator/writeObsFile/" + testCaseName,
+                           testCaseConf)
+                      {
+                        testWriteObsFile(testCaseConf);
+                      });
+      ts.emplace_back(CASE("ufo/SyntheticObsGenerator/decompositionIndependence/" +
+                           testCaseName, testCaseConf)
+                      {
+                        testDecompositionIndependence(testCaseConf);
+                      });
+      ts.emplace_back(CASE("ufo/SyntheticObsGenerator/fillGeoVaLs/" + testCaseName,
+                           testCaseConf)
+                      {
+                        testFillGeoVaLs(testCaseConf);
+                      });
+    }
+  }
+
+  void clear() const override {}
+};
+
+// -----------------------------------------------------------------------------
+
+}  // namespace test
+}  // namespace ufo
+
+#endif  // TEST_UFO_SYNTHETICOBSGENERATOR_H_
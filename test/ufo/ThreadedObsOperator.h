@@ -0,0 +1,229 @@
+/*
+ * (C) Crown copyright 2021, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef TEST_UFO_THREADEDOBSOPERATOR_H_
+#define TEST_UFO_THREADEDOBSOPERATOR_H_
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#define ECKIT_TESTING_SELF_REGISTER_CASES 0
+
+#include "eckit/config/LocalConfiguration.h"
+#include "eckit/testing/Test.h"
+#include "ioda/ObsSpace.h"
+#include "ioda/ObsVector.h"
+#include "oops/base/Variables.h"
+#include "oops/mpi/mpi.h"
+#include "oops/runs/Test.h"
+#include "oops/util/Logger.h"
+#include "test/TestEnvironment.h"
+#include "ufo/GeoVaLs.h"
+#include "ufo/LinearObsOperator.h"
+#include "ufo/Locations.h"
+#include "ufo/ObsBias.h"
+#include "ufo/ObsBiasIncrement.h"
+#include "ufo/ObsDiagnostics.h"
+#include "ufo/ObsOperator.h"
+
+namespace ufo {
+namespace test {
+
+// -----------------------------------------------------------------------------
+
+/// Number of OpenMP threads set through OMP_NUM_THREADS (1 without OpenMP).
+int maxThreads() {
+#ifdef _OPENMP
+  return omp_get_max_threads();
+#else
+  return 1;
+#endif
+}
+
+void setThreads(int nthreads) {
+#ifdef _OPENMP
+  omp_set_num_threads(nthreads);
+#endif
+}
+
+/// Return the number of elements of \p threaded differing from those of \p serial.
+size_t countDifferences(const ioda::ObsSpace & ospace, const ioda::ObsVector & threaded,
+                        const ioda::ObsVector & serial) {
+  const size_t nobs = ospace.nlocs() * ospace.obsvariables().size();
+  size_t ndiff = 0;
+  for (size_t jobs = 0; jobs < nobs; ++jobs)
+    ndiff += threaded[jobs] != serial[jobs];
+  return ndiff;
+}
+
+// -----------------------------------------------------------------------------
+
+/// Compare H(x) and the `obs diagnostics` computed with the number of OpenMP threads set by the
+/// test (which must be greater than one) with those computed with a single thread. Operators
+/// splitting the locations into chunks processed by different threads must give the same
+/// results whichever thread processes a chunk, so the two must be identical.
+void testThreadedHofX() {
+  const eckit::LocalConfiguration conf(::test::TestEnvironment::config());
+  util::DateTime bgn(conf.getString("window begin"));
+  util::DateTime end(conf.getString("window end"));
+
+  const int nthreads = maxThreads();
+  EXPECT(nthreads > 1);
+
+  std::vector<eckit::LocalConfiguration> typeconfs;
+  conf.get("observations", typeconfs);
+  for (const eckit::LocalConfiguration & typeconf : typeconfs) {
+    const eckit::LocalConfiguration obsconf(typeconf, "obs space");
+    ioda::ObsSpace ospace(obsconf, oops::mpi::world(), bgn, end, oops::mpi::myself());
+    const size_t nlocs = ospace.nlocs();
+
+    const eckit::LocalConfiguration obsopconf(typeconf, "obs operator");
+    ObsOperator hop(ospace, obsopconf);
+
+    const eckit::LocalConfiguration gconf(typeconf, "geovals");
+    const GeoVaLs gval(gconf, ospace, hop.requiredVars());
+
+    eckit::LocalConfiguration biasconf = typeconf.getSubConfiguration("obs bias");
+    ObsBiasParameters biasparams;
+    biasparams.validateAndDeserialize(biasconf);
+    const ObsBias ybias(ospace, biasparams);
+
+    const eckit::LocalConfiguration diagconf(typeconf, "obs diagnostics");
+    const oops::Variables diagvars(diagconf, "variables");
+    EXPECT(diagvars.size() > 0);
+    std::unique_ptr<Locations> locs(hop.locations());
+
+    ioda::ObsVector hofxSerial(ospace);
+    ObsDiagnostics diagsSerial(ospace, *locs, diagvars);
+    setThreads(1);
+    hop.simulateObs(gval, hofxSerial, ybias, diagsSerial);
+
+    ioda::ObsVector hofx(ospace);
+    ObsDiagnostics diags(ospace, *locs, diagvars);
+    setThreads(nthreads);
+    hop.simulateObs(gval, hofx, ybias, diags);
+
+    const size_t ndiff = countDifferences(ospace, hofx, hofxSerial);
+    oops::Log::test() << ospace.obsname() << ": " << nthreads << " threads, "
+                      << ndiff << " H(x) values differ from the serial ones" << std::endl;
+    EXPECT(ndiff == 0);
+
+    for (size_t jvar = 0; jvar < diagvars.size(); ++jvar) {
+      const size_t nlevs = diagsSerial.nlevs(diagvars[jvar]);
+      EXPECT(diags.nlevs(diagvars[jvar]) == nlevs);
+      std::vector<float> serial(nlocs);
+      std::vector<float> threaded(nlocs);
+      size_t ndiffDiag = 0;
+      for (size_t jlev = 1; jlev <= nlevs; ++jlev) {
+        diagsSerial.get(serial, diagvars[jvar], jlev);
+        diags.get(threaded, diagvars[jvar], jlev);
+        for (size_t jloc = 0; jloc < nlocs; ++jloc)
+          ndiffDiag += threaded[jloc] != serial[jloc];
+      }
+      oops::Log::test() << ospace.obsname() << ": " << diagvars[jvar] << ", " << nlevs
+                        << " levels, " << ndiffDiag << " values differ from the serial ones"
+                        << std::endl;
+      EXPECT(ndiffDiag == 0);
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+/// Compare the TL and AD of the linear operator whose trajectory is set with the number of
+/// OpenMP threads set by the test with those of the linear operator whose trajectory is set
+/// with a single thread. The two must be identical.
+void testThreadedTLAD() {
+  const eckit::LocalConfiguration conf(::test::TestEnvironment::config());
+  util::DateTime bgn(conf.getString("window begin"));
+  util::DateTime end(conf.getString("window end"));
+
+  const int nthreads = maxThreads();
+  EXPECT(nthreads > 1);
+
+  std::vector<eckit::LocalConfiguration> typeconfs;
+  conf.get("observations", typeconfs);
+  for (const eckit::LocalConfiguration & typeconf : typeconfs) {
+    const eckit::LocalConfiguration obsconf(typeconf, "obs space");
+    ioda::ObsSpace ospace(obsconf, oops::mpi::world(), bgn, end, oops::mpi::myself());
+
+    const eckit::LocalConfiguration obsopconf(typeconf, "obs operator");
+    ObsOperator hop(ospace, obsopconf);
+    LinearObsOperator hoptl(ospace, obsopconf);
+
+    const eckit::LocalConfiguration gconf(typeconf, "geovals");
+    const GeoVaLs gval(gconf, ospace, hop.requiredVars());
+
+    eckit::LocalConfiguration biasconf = typeconf.getSubConfiguration("obs bias");
+    ObsBiasParameters biasparams;
+    biasparams.validateAndDeserialize(biasconf);
+    const ObsBias ybias(ospace, biasparams);
+    ObsBiasIncrement ybinc(ospace, biasparams);
+
+    GeoVaLs dx(gconf, ospace, hoptl.requiredVars());
+    dx.random();
+    ioda::ObsVector dy(ospace);
+    dy.random();
+
+    setThreads(1);
+    hoptl.setTrajectory(gval, ybias);
+    ioda::ObsVector dyTLSerial(ospace);
+    hoptl.simulateObsTL(dx, dyTLSerial, ybinc);
+    GeoVaLs dxADSerial(gconf, ospace, hoptl.requiredVars());
+    dxADSerial.zero();
+    hoptl.simulateObsAD(dxADSerial, dy, ybinc);
+
+    setThreads(nthreads);
+    hoptl.setTrajectory(gval, ybias);
+    ioda::ObsVector dyTL(ospace);
+    hoptl.simulateObsTL(dx, dyTL, ybinc);
+    GeoVaLs dxAD(gconf, ospace, hoptl.requiredVars());
+    dxAD.zero();
+    hoptl.simulateObsAD(dxAD, dy, ybinc);
+
+    const size_t ndiff = countDifferences(ospace, dyTL, dyTLSerial);
+    dxAD -= dxADSerial;
+    oops::Log::test() << ospace.obsname() << ": " << nthreads << " threads, "
+                      << ndiff << " TL values differ from the serial ones"
+                      << ", rms of AD differences: " << dxAD.rms() << std::endl;
+    EXPECT(ndiff == 0);
+    EXPECT(dxAD.rms() == 0.0);
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+class ThreadedObsOperator : public oops::Test {
+ public:
+  ThreadedObsOperator() = default;
+  virtual ~ThreadedObsOperator() = default;
+ private:
+  std::string testid() const override {return "ufo::test::ThreadedObsOperator";}
+
+  void register_tests() const override {
+    std::vector<eckit::testing::Test>& ts = eckit::testing::specification();
+
+    ts.emplace_back(CASE("ufo/ThreadedObsOperator/testThreadedHofX")
+      { testThreadedHofX(); });
+    ts.emplace_back(CASE("ufo/ThreadedObsOperator/testThreadedTLAD")
+      { testThreadedTLAD(); });
+  }
+
+  void clear() const override {}
+};
+
+// -----------------------------------------------------------------------------
+
+}  // namespace test
+}  // namespace ufo
+
+#endif  // TEST_UFO_THREADEDOBSOPERATOR_H_